@@ -0,0 +1,160 @@
+#ifndef LIBPROJET_H
+#define LIBPROJET_H
+
+// Interface de la bibliothèque libprojet (make lib : lib/libprojet.a et lib/libprojet.so).
+// Un génome est chargé et indexé une fois, puis interrogé autant de fois que nécessaire. Les fonctions
+// n'affichent rien et renvoient leurs résultats dans des structures ; les requêtes ne modifient pas le
+// génome et peuvent être lancées depuis plusieurs threads à la fois.
+
+/**
+ * @brief Génome chargé et indexé (structure opaque).
+ */
+typedef struct GenomeProjet GenomeProjet;
+
+/**
+ * @struct ProjetGene
+ * @brief Alignement d'un gène sur le génome.
+ */
+typedef struct {
+    int debut;                     ///< Première base alignée dans le génome (0-indexée)
+    int fin;                       ///< Position suivant la dernière base alignée
+    int score;                     ///< Score de l'alignement (+2/-3, gaps 5/2)
+    double identite;               ///< Identités / longueur de l'alignement (gaps compris)
+    char *cigar;                   ///< CIGAR de l'alignement (libéré par projet_liberer_genes)
+    char brin;                     ///< '+', ou '-' si le complément inverse du gène est aligné
+} ProjetGene;
+
+/**
+ * @struct ProjetPaireConsensus
+ * @brief Paire de boîtes consensus -35 / -10.
+ */
+typedef struct {
+    int position_35;               ///< Position de la boîte -35 (0-indexée)
+    int position_10;               ///< Position de la boîte -10
+} ProjetPaireConsensus;
+
+/**
+ * @struct ProjetMotif
+ * @brief Motif du génome et son nombre de copies.
+ */
+typedef struct {
+    int position;                  ///< Position du motif (0-indexée)
+    int longueur;                  ///< Longueur du motif
+    int occurrences;               ///< Copies dans le génome, hors de celles qui commencent dans le motif
+} ProjetMotif;
+
+/**
+ * @brief Répartit les requêtes suivantes sur un pool de threads commun (appel facultatif, à faire avant les
+ * requêtes). Le pool précédent est détruit ; le changement est refusé tant qu'une requête s'en sert.
+ * @param nombre_threads Le nombre de threads de calcul (1 : exécution dans le thread appelant).
+ * @return 0 en cas de succès, -1 en cas d'erreur ou si une requête est en cours.
+ */
+int projet_definir_threads(int nombre_threads);
+
+/**
+ * @brief Charge un génome FASTA (texte, gzip ou BGZF) et l'indexe.
+ * @param chemin_fasta Le chemin du fichier.
+ * @return Le génome (à fermer avec projet_fermer_genome), ou NULL en cas d'erreur.
+ */
+GenomeProjet* projet_ouvrir_genome(const char *chemin_fasta);
+
+/**
+ * @brief Indexe une séquence déjà en mémoire (elle est copiée).
+ * @param sequence La séquence (A, C, G, T).
+ * @param longueur Sa longueur.
+ * @return Le génome (à fermer avec projet_fermer_genome), ou NULL en cas d'erreur.
+ */
+GenomeProjet* projet_creer_genome(const char *sequence, int longueur);
+
+/**
+ * @brief Libère un génome et ses index.
+ * @param genome Le génome (NULL : rien à faire).
+ */
+void projet_fermer_genome(GenomeProjet *genome);
+
+/**
+ * @brief Longueur d'un génome.
+ * @param genome Le génome.
+ * @return Le nombre de bases.
+ */
+int projet_longueur_genome(const GenomeProjet *genome);
+
+/**
+ * @brief Séquence d'un génome.
+ * @param genome Le génome.
+ * @return La séquence, terminée par '\0' (valide jusqu'à projet_fermer_genome).
+ */
+const char* projet_sequence_genome(const GenomeProjet *genome);
+
+/**
+ * @brief Recherche un gène sur les deux brins par graines et alignement en bande (indels tolérés).
+ *
+ * Un gène plus court que les graines (LONGUEUR_GRAINE_GENE bases) est cherché sans indels (CIGAR "<n>M").
+ * @param genome Le génome.
+ * @param gene La séquence du gène.
+ * @param identite_min L'identité minimale d'un alignement retenu (0.90 dans le programme).
+ * @param resultats Reçoit les alignements retenus (à libérer avec projet_liberer_genes).
+ * @param nombre_max La capacité de `resultats`.
+ * @return Le nombre d'alignements trouvés (éventuellement supérieur à `nombre_max`), ou -1 en cas d'erreur.
+ */
+int projet_rechercher_gene(const GenomeProjet *genome, const char *gene, double identite_min, ProjetGene *resultats,
+                           int nombre_max);
+
+/**
+ * @brief Libère les CIGAR des alignements renvoyés par projet_rechercher_gene.
+ * @param resultats Les alignements.
+ * @param nombre Le nombre d'alignements remplis (au plus la capacité passée à la recherche).
+ */
+void projet_liberer_genes(ProjetGene *resultats, int nombre);
+
+/**
+ * @brief Relève les paires de boîtes consensus d'une région (une différence tolérée par boîte, boîte -10 de 15
+ * à 19 bases après la -35).
+ * @param genome Le génome.
+ * @param debut Début de la région.
+ * @param fin Position suivant sa fin.
+ * @param boite_35 La boîte -35 (NULL : TTGACA).
+ * @param boite_10 La boîte -10 (NULL : TATAAT).
+ * @param paires Reçoit les paires trouvées, dans l'ordre des positions.
+ * @param nombre_max La capacité de `paires`.
+ * @return Le nombre de paires trouvées (éventuellement supérieur à `nombre_max`), ou -1 si la région est invalide.
+ */
+int projet_rechercher_consensus(const GenomeProjet *genome, int debut, int fin, const char *boite_35,
+                                const char *boite_10, ProjetPaireConsensus *paires, int nombre_max);
+
+/**
+ * @brief Compte les occurrences d'un motif.
+ * @param genome Le génome.
+ * @param motif Le motif (A, C, G, T).
+ * @param longueur La longueur du motif.
+ * @param mismatches Le nombre maximal de mésappariements (0 à 3).
+ * @return Le nombre d'occurrences, ou -1 si le motif ou le nombre de mésappariements est invalide.
+ */
+int projet_compter_motif(const GenomeProjet *genome, const char *motif, int longueur, int mismatches);
+
+/**
+ * @brief Positions des occurrences d'un motif.
+ * @param genome Le génome.
+ * @param motif Le motif (A, C, G, T).
+ * @param longueur La longueur du motif.
+ * @param mismatches Le nombre maximal de mésappariements (0 à 3).
+ * @param nombre Reçoit le nombre d'occurrences.
+ * @return Les positions croissantes (à libérer avec free), ou NULL en cas d'erreur.
+ */
+int* projet_positions_motif(const GenomeProjet *genome, const char *motif, int longueur, int mismatches,
+                            int *nombre);
+
+/**
+ * @brief Étend un motif du génome une base à la fois, à gauche puis à droite, tant qu'il garde au moins
+ * `copies_min` copies ailleurs dans le génome (celles qui commencent dans le motif lui-même ne comptent pas).
+ * @param genome Le génome.
+ * @param position La position du motif de départ.
+ * @param longueur Sa longueur.
+ * @param copies_min Le nombre minimal de copies du motif étendu (20 dans le programme).
+ * @param resultat Reçoit le motif étendu (le motif de départ si aucune extension n'est possible).
+ * @return Le nombre de bases ajoutées, ou -1 si le motif sort du génome.
+ */
+int projet_etendre_motif(const GenomeProjet *genome, int position, int longueur, int copies_min,
+                         ProjetMotif *resultat);
+
+#endif // LIBPROJET_H
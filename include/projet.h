@@ -5,6 +5,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 // Constantes Générales
 #define FOLD_CHANGE_MIN 1.5       ///< Seuil minimum du fold change pour l'enregistrement du motif dans le tableau des motifs retenu
@@ -18,6 +19,50 @@
 #define LONGEUR_SEQUENCE_ETUDIE_CONSENSUS 200  ///< Longueur de la région (en amont du gène d'intérêt) qui sera analysée pour trouver des séquences consensus
 #define BOITE_35 "TTGACA"       ///< Séquence consensus (-35) de l'organisme étudié
 #define BOITE_10 "TATAAT"       ///< Séquence consensus (-10) de l'organisme étudié
+#define ESPACEMENT_MIN_CONSENSUS 15 ///< Bases au moins entre la fin de la boîte -35 et le début de la boîte -10
+#define ESPACEMENT_MAX_CONSENSUS 19 ///< Bases au plus entre les deux boîtes
+
+#define LONGUEUR_GRAINE_GENE 11     ///< Longueur des k-mers de l'index utilisé par la recherche de gène avec gaps
+#define OCCURRENCES_MAX_GRAINE 512  ///< Les k-mers plus fréquents que ce seuil ne servent pas de graines
+#define NOMBRE_MIN_GRAINES 2        ///< Nombre minimal de graines sur des diagonales voisines avant alignement
+#define LARGEUR_MIN_BANDE 16        ///< Demi-largeur minimale de la bande d'alignement (en diagonales)
+
+#define TAILLE_FENETRE_FLUX (64 * 1024 * 1024)  ///< Nombre de bases par fenêtre en mode flux
+#define LONGUEUR_MAX_KMER_FLUX 13   ///< Longueur maximale des k-mers comptés en mode flux (table de 4^k compteurs)
+#define NOMBRE_MAX_GENES_FENETRE 16 ///< Nombre maximal de copies du gène relevées par fenêtre en mode flux
+
+#define TAILLE_FENETRE_DENSITE 10000 ///< Taille des fenêtres pour la densité des copies d'un motif
+
+#define LONGUEUR_MAX_KMER_CODE 32   ///< Longueur maximale d'un k-mer codé sur 2 bits par base (64 bits)
+
+#define LONGUEUR_MAX_KMER_SPECTRE 31 ///< Longueur maximale des k-mers du spectre du génome
+#define ORDRE_MODELE_FOND 3         ///< Ordre du modèle de Markov de fond servant à repérer les k-mers surreprésentés
+#define ORDRE_MAX_MODELE_FOND 12    ///< Ordre maximal de ce modèle (tables de 4^(ordre+1) compteurs)
+#define NOMBRE_KMERS_SURREPRESENTES 50 ///< Nombre de k-mers surreprésentés écrits avec le spectre
+
+#define FENETRE_DUST 64             ///< Taille des fenêtres du filtre de faible complexité (DUST)
+#define SEUIL_DUST 20               ///< Score DUST au-delà duquel une fenêtre est masquée
+
+#define TAILLE_BLOC_PARALLELE (1 << 16) ///< Positions par bloc des parcours parallèles du génome (indépendant du nombre de threads)
+
+#define EMPREINTE_INITIALE 0xcbf29ce484222325ULL ///< Valeur de départ des empreintes FNV-1a du cache des résultats
+
+#define TACHES_SIMULTANEES 4        ///< Étapes du programme principal exécutées en même temps (lectures, index, recherches)
+
+#define COMPTEURS_PROGRESSION_MAX 16     ///< Compteurs de progression ouverts en même temps
+#define LONGUEUR_NOM_PROGRESSION 32      ///< Taille du nom d'un compteur de progression (zéro final compris)
+#define PERIODE_BARRE_PROGRESSION_MS 100 ///< Intervalle de rafraîchissement de la barre de progression (terminal)
+#define PERIODE_LIGNES_PROGRESSION_MS 2000 ///< Intervalle entre deux lignes de progression (sortie redirigée)
+
+#define GRAINE_VERIFICATION 20241  ///< Graine des génomes de --verifier-moteurs (make test)
+
+#define MISMATCHES_CONSERVATION 3   ///< Mésappariements tolérés pour la copie d'un motif en amont de l'orthologue d'une souche
+
+#define DISTANCE_GROUPE_BLAST 1000  ///< Écart maximal (en bases) entre deux hits BLAST d'un même groupe
+
+#define CLIENTS_MAX_SERVEUR 64      ///< Nombre maximal de clients connectés en même temps au serveur de requêtes
+#define TAILLE_MAX_REQUETE 65536    ///< Taille maximale d'une ligne de requête (au-delà, le client est déconnecté)
+#define TAILLE_MAX_SORTIE_CLIENT (1 << 22) ///< Octets de réponses non lus par un client au-delà desquels il est déconnecté
 
 // Définition de la structure pour stocker un motif étendu
 /**
@@ -31,8 +76,544 @@ typedef struct {
     double fold_change;            ///< Valeur du fold change
     int occurrences_reelles;       ///< Nombre d'occurrences réelles du motif
     int occurrences_aleatoires;    ///< Nombre d'occurrences dans la séquence aléatoire
+    struct DistributionMotif *distribution; ///< Répartition des copies dans le génome (NULL si non calculée)
+    int occurrences_approchees_reelles;    ///< Occurrences à au plus `mismatches_max` mésappariements (-1 si non calculées)
+    int occurrences_approchees_aleatoires; ///< Idem dans la séquence aléatoire
 } Motif;
 
+/**
+ * @brief Critère de tri et de sélection des motifs d'un stock.
+ */
+typedef enum {
+    CRITERE_POSITION,              ///< Position croissante
+    CRITERE_FOLD_CHANGE,           ///< Fold change décroissant
+    CRITERE_LONGUEUR,              ///< Longueur décroissante
+    CRITERE_DISTANCE_GENE          ///< Distance croissante à une position de référence (le gène)
+} CritereMotifs;
+
+/**
+ * @struct StockMotifs
+ * @brief Motifs rangés en colonnes (un tableau par champ), agrandies ensemble par doublement.
+ *
+ * Les séquences ne sont pas allouées une à une : ce sont des sous-chaînes du génome (lues à leur position)
+ * ou, sans génome, des tranches d'une réserve unique. Elles ne sont pas terminées par '\0'.
+ */
+typedef struct {
+    const char *genome;            ///< Génome dont les motifs sont des sous-chaînes (NULL : séquences dans la réserve)
+    int nombre;                    ///< Nombre de motifs
+    int capacite;                  ///< Capacité des colonnes
+    int32_t *positions;            ///< Position du premier nucléotide de chaque motif
+    int32_t *longueurs;            ///< Longueur de chaque motif
+    double *fold_changes;          ///< Fold change de chaque motif
+    int32_t *occurrences_reelles;  ///< Occurrences dans le génome réel
+    int32_t *occurrences_aleatoires; ///< Occurrences dans le génome aléatoire
+    int32_t *approchees_reelles;   ///< Occurrences approchées réelles (-1 si non calculées)
+    int32_t *approchees_aleatoires; ///< Occurrences approchées aléatoires (-1 si non calculées)
+    struct DistributionMotif **distributions; ///< Répartition des copies (NULL si non calculée)
+    int64_t *decalages;            ///< Début de chaque séquence dans la réserve (sans génome)
+    char *reserve;                 ///< Séquences mises bout à bout (sans génome)
+    int64_t taille_reserve;        ///< Octets utilisés de la réserve
+    int64_t capacite_reserve;      ///< Capacité de la réserve
+} StockMotifs;
+
+/**
+ * @struct IndexSuffixes
+ * @brief Table des suffixes d'un génome : positions de ses suffixes dans l'ordre lexicographique.
+ *
+ * Les occurrences d'un motif forment un intervalle contigu de la table, trouvé par recherche dichotomique.
+ */
+typedef struct {
+    const char *genome;            ///< Génome indexé (non copié : doit rester valide)
+    int longueur_genome;           ///< Longueur du génome
+    int32_t *suffixes;             ///< Positions de début des suffixes, triés
+} IndexSuffixes;
+
+/**
+ * @struct MasqueExclusion
+ * @brief Régions du génome dont les occurrences ne sont pas comptées (répétitions, îlots, région étudiée...).
+ *
+ * Chaque position masquée a son bit à 1 ; les intervalles, disjoints et triés, servent à sauter les régions
+ * masquées lors d'un parcours du génome.
+ */
+typedef struct {
+    int longueur_genome;           ///< Longueur du génome masqué
+    uint64_t *bits;                ///< Un bit par position (1 : masquée)
+    int *debuts;                   ///< Débuts des intervalles masqués, croissants
+    int *fins;                     ///< Positions suivant la fin de chaque intervalle
+    int nombre_intervalles;        ///< Nombre d'intervalles (fusionnés s'ils se chevauchent ou se touchent)
+    int capacite;                  ///< Capacité des tableaux d'intervalles
+} MasqueExclusion;
+
+/**
+ * @struct TableKmers
+ * @brief Table de hachage (adressage ouvert) associant à des k-mers, codés sur 2 bits par base, un compteur.
+ */
+typedef struct {
+    int longueur_kmer;             ///< Longueur des k-mers (1 à LONGUEUR_MAX_KMER_CODE)
+    uint64_t *codes;               ///< Code de chaque case occupée
+    int32_t *comptes;              ///< Compteur de chaque case (-1 : case vide)
+    int capacite;                  ///< Nombre de cases (puissance de 2)
+    int nombre;                    ///< Nombre de k-mers insérés
+} TableKmers;
+
+/**
+ * @struct SpectreKmers
+ * @brief Comptes de tous les k-mers d'un génome, et nombre de k-mers distincts par nombre d'occurrences.
+ */
+typedef struct {
+    int longueur_kmer;             ///< Longueur des k-mers (1 à LONGUEUR_MAX_KMER_SPECTRE)
+    int64_t nombre_total;          ///< Nombre de k-mers du génome (positions sans base autre que ACGT)
+    int64_t nombre_distincts;      ///< Nombre de k-mers distincts
+    uint64_t *codes;               ///< Codes 2 bits des k-mers distincts, croissants
+    int32_t *comptes;              ///< Nombre d'occurrences de chacun
+    int64_t *spectre;              ///< spectre[c] : nombre de k-mers distincts présents c fois
+    int occurrences_max;           ///< Plus grand nombre d'occurrences (taille du spectre - 1)
+} SpectreKmers;
+
+/**
+ * @struct KmerSurrepresente
+ * @brief Un k-mer plus fréquent que ne le prévoit le modèle de fond.
+ */
+typedef struct {
+    uint64_t code;                 ///< Code 2 bits du k-mer
+    int occurrences;               ///< Occurrences observées
+    double attendues;              ///< Occurrences attendues sous le modèle de Markov de fond
+    double score;                  ///< (observées - attendues) / racine(attendues)
+} KmerSurrepresente;
+
+/**
+ * @brief Pool de threads permanent partagé par les parcours du génome (structure opaque).
+ */
+typedef struct PoolThreads PoolThreads;
+
+/**
+ * @struct BlocParallele
+ * @brief Bloc d'une boucle parallèle : les positions [debut, fin) lui appartiennent, et il peut lire
+ * jusqu'à fin_lecture pour les motifs qui commencent près de sa fin.
+ */
+typedef struct {
+    int64_t indice;                ///< Rang du bloc (les résultats sont fusionnés dans cet ordre)
+    int64_t debut;                 ///< Première position du bloc
+    int64_t fin;                   ///< Position suivant la dernière
+    int64_t fin_lecture;           ///< fin + chevauchement
+} BlocParallele;
+
+/**
+ * @brief Traitement d'un bloc d'une boucle parallèle.
+ */
+typedef void (*FonctionBloc)(const BlocParallele *bloc, void *contexte);
+
+/**
+ * @enum FiltreConsensus
+ * @brief Implémentation du pré-filtre des boîtes consensus (parcourir_paires_consensus).
+ */
+typedef enum {
+    FILTRE_CONSENSUS_AUTO,         ///< La plus rapide disponible sur le processeur (AVX2, SSE2, sinon la référence)
+    FILTRE_CONSENSUS_REFERENCE,    ///< Sans masque : comparaison complète à chaque position
+    FILTRE_CONSENSUS_SCALAIRE,     ///< Masques calculés position par position (vérification des versions vectorielles)
+    FILTRE_CONSENSUS_SSE2,         ///< 16 positions par instruction, deux vecteurs par mot de 32 positions
+    FILTRE_CONSENSUS_AVX2          ///< 32 positions par instruction
+} FiltreConsensus;
+
+/**
+ * @brief Reçoit une paire de boîtes consensus trouvée par parcourir_paires_consensus.
+ */
+typedef void (*FonctionPaireConsensus)(int64_t position_boite_35, int64_t position_boite_10, void *contexte);
+
+/**
+ * @brief Graphe des étapes d'un traitement et de leurs dépendances (structure opaque).
+ */
+typedef struct GrapheTaches GrapheTaches;
+
+/**
+ * @brief Une étape d'un graphe de tâches.
+ * @return 0 en cas de succès ; toute autre valeur annule les étapes qui en dépendent.
+ */
+typedef int (*FonctionTache)(void *contexte);
+
+/**
+ * @enum EtatTache
+ * @brief Avancement d'une étape d'un graphe de tâches.
+ */
+typedef enum {
+    TACHE_EN_ATTENTE,              ///< Prérequis pas encore tous réussis
+    TACHE_EN_COURS,
+    TACHE_REUSSIE,
+    TACHE_ECHOUEE,                 ///< La fonction de l'étape a renvoyé une erreur
+    TACHE_ANNULEE                  ///< Un prérequis a échoué ou a été annulé
+} EtatTache;
+
+/**
+ * @brief Compteur de progression d'un traitement, avancé sans verrou par les threads de calcul (structure opaque).
+ */
+typedef struct CompteurProgression CompteurProgression;
+
+/**
+ * @enum ModeProgression
+ * @brief Affichage des compteurs de progression par le rapporteur.
+ */
+typedef enum {
+    PROGRESSION_AUTO,              ///< Barre sur un terminal, lignes périodiques sinon
+    PROGRESSION_BARRE,             ///< Barre réécrite sur place
+    PROGRESSION_LIGNES,            ///< Une ligne par intervalle, lisible dans un fichier
+    PROGRESSION_AUCUNE
+} ModeProgression;
+
+/**
+ * @struct EtatProgression
+ * @brief Relevé d'un compteur de progression.
+ */
+typedef struct {
+    char nom[LONGUEUR_NOM_PROGRESSION]; ///< Nom du traitement suivi
+    int64_t fait;                  ///< Unités traitées
+    int64_t total;                 ///< Unités à traiter
+    double duree;                  ///< Secondes depuis l'ouverture du compteur
+} EtatProgression;
+
+/**
+ * @struct GeneAnnote
+ * @brief Un gène d'un fichier d'annotation.
+ */
+typedef struct {
+    int debut;                     ///< Première base du gène (0-indexée)
+    int fin;                       ///< Position suivant la dernière base
+    char brin;                     ///< '+' ou '-'
+    char *nom;                     ///< Nom (attribut Name ou ID en GFF3, première colonne en TSV)
+} GeneAnnote;
+
+/**
+ * @struct AnnotationGenes
+ * @brief Gènes annotés d'un génome, triés par position de début.
+ */
+typedef struct {
+    GeneAnnote *genes;             ///< Gènes triés par début
+    int nombre;                    ///< Nombre de gènes
+    int *fin_max;                  ///< fin_max[g] : plus grande fin parmi les gènes 0..g (gènes chevauchants)
+} AnnotationGenes;
+
+/**
+ * @struct DistributionMotif
+ * @brief Répartition des copies d'un motif dans le génome.
+ */
+typedef struct DistributionMotif {
+    int *positions;                ///< Positions (0-indexées) de toutes les copies, croissantes
+    int nombre_occurrences;        ///< Nombre de copies
+    int ecart_min;                 ///< Plus petit écart entre deux copies consécutives (-1 si moins de 2 copies)
+    int ecart_median;              ///< Écart médian
+    int ecart_max;                 ///< Plus grand écart
+    double ecart_moyen;            ///< Écart moyen
+    int taille_fenetre;            ///< Taille des fenêtres de densité (en bases)
+    int nombre_fenetres;           ///< Nombre de fenêtres couvrant le génome
+    int *densites;                 ///< Nombre de copies par fenêtre
+    int densite_max;               ///< Plus grand nombre de copies dans une fenêtre
+    int fenetre_densite_max;       ///< Indice de cette fenêtre
+    int *distances_genes;          ///< Distance de chaque copie au gène annoté le plus proche (NULL sans annotation)
+    int distance_min_gene;         ///< Plus petite de ces distances (-1 sans annotation)
+    double distance_moyenne_gene;  ///< Distance moyenne (-1 sans annotation)
+    double fraction_intergenique;  ///< Part des copies qui ne chevauchent aucun gène
+} DistributionMotif;
+
+/**
+ * @brief Format du fichier de résultats des motifs.
+ */
+typedef enum {
+    FORMAT_TSV,                    ///< Une ligne par motif, colonnes séparées par des tabulations (avec en-tête)
+    FORMAT_JSONL,                  ///< Un objet JSON par ligne
+    FORMAT_BINAIRE                 ///< En-tête "MOTIFS3" puis, par motif, ses champs en petit-boutiste, sa séquence et sa répartition
+} FormatResultats;
+
+/**
+ * @brief Moteur de découverte des motifs de la région promotrice.
+ */
+typedef enum {
+    MOTEUR_REPETITIONS,            ///< Répétitions maximales, en un parcours de la table LCP (par défaut)
+    MOTEUR_GLOUTON                 ///< Extension gloutonne de chaque graine (k-uplet), à gauche puis à droite
+} MoteurMotifs;
+
+/**
+ * @struct RepetitionMaximale
+ * @brief Répétition maximale (non prolongeable à gauche ni à droite sans perdre de copies) du génome.
+ */
+typedef struct {
+    int position;                  ///< Dernière de ses occurrences commençant avant la fin de la région étudiée
+    int longueur;                  ///< Longueur de la répétition
+    int copies;                    ///< Nombre d'occurrences dans le génome
+} RepetitionMaximale;
+
+/**
+ * @struct BilanVerification
+ * @brief Comparaisons des moteurs rapides avec les fonctions de référence, et divergences relevées.
+ */
+typedef struct {
+    int64_t comparaisons;          ///< Nombre de résultats comparés
+    int64_t divergences;           ///< Nombre de résultats différents de la référence
+} BilanVerification;
+
+/**
+ * @enum BrinContextes
+ * @brief Brins dont les occurrences d'un motif sont extraites.
+ */
+typedef enum {
+    BRIN_PLUS,                     ///< Copies du motif sur le brin direct
+    BRIN_MOINS,                    ///< Copies de son complément inverse (contexte écrit en complément inverse)
+    BRIN_DEUX                      ///< Les deux
+} BrinContextes;
+
+/**
+ * @struct ParametresContextes
+ * @brief Extraction des occurrences des motifs retenus en FASTA.
+ */
+typedef struct {
+    const char *identifiant;       ///< Identifiant du génome dans les en-têtes (premier mot de son en-tête FASTA)
+    const char *description;       ///< Suite de l'en-tête (NULL : aucune)
+    int flanc;                     ///< Bases ajoutées de chaque côté de l'occurrence (tronquées aux bords du génome)
+    BrinContextes brin;            ///< Brins extraits
+} ParametresContextes;
+
+/**
+ * @struct ParametresSortie
+ * @brief Destination des résultats de l'analyse des motifs.
+ */
+typedef struct {
+    const char *chemin_resultats;  ///< Fichier recevant tous les motifs retenus (NULL : aucun)
+    FormatResultats format;        ///< Format de ce fichier
+    const char *chemin_motifs_retenus; ///< FASTA des trois meilleurs motifs, relu par --aligner (NULL : aucun)
+    int affichage_console;         ///< Affiche chaque motif retenu dans la console
+    int calcul_distribution;       ///< Calcule la répartition des copies de chaque motif retenu
+    const AnnotationGenes *annotation; ///< Gènes annotés pour les distances (NULL : aucune)
+    int taille_fenetre_densite;    ///< Taille des fenêtres de densité (en bases)
+    int mismatches_max;            ///< Mésappariements tolérés pour les occurrences approchées (0 : non calculées)
+    const MasqueExclusion *masque; ///< Positions du génome réel dont les occurrences sont ignorées (NULL : aucune)
+    int masquer_region;            ///< Ignore aussi les occurrences dans toute la région étudiée, pas seulement le k-uplet
+    int masquer_faible_complexite; ///< Ignore les k-uplets chevauchant une région de faible complexité (DUST)
+    int copies_max_graine;         ///< Ignore les k-uplets chevauchant un k-mer plus fréquent que ce seuil (0 : aucun)
+    MoteurMotifs moteur;           ///< Moteur de découverte des motifs
+    double fold_change_min;        ///< Fold change au-delà duquel un motif est retenu (FOLD_CHANGE_MIN par défaut)
+    const char *dossier_cache;     ///< Dossier du cache des motifs candidats (NULL : aucun cache)
+    const char *chemin_contextes;  ///< FASTA des occurrences des motifs retenus (NULL : aucun)
+    ParametresContextes contextes; ///< Flancs, brins et en-têtes de ce fichier
+    double taux_verification;      ///< Part des motifs retenus recomptés par les fonctions de référence (0 : aucune)
+    BilanVerification *verification; ///< Reçoit le bilan de ces vérifications (NULL : aucune vérification)
+    IndexSuffixes *index_reel;     ///< Table des suffixes du génome réel déjà construite (NULL : construite au besoin)
+    IndexSuffixes *index_aleatoire; ///< Table des suffixes du génome aléatoire déjà construite (NULL : construite au besoin)
+} ParametresSortie;
+
+/**
+ * @brief Écrivain tamponné des résultats des motifs (structure opaque).
+ */
+typedef struct EcrivainResultats EcrivainResultats;
+
+/**
+ * @struct SequenceFasta
+ * @brief Un enregistrement d'un fichier FASTA (identifiant et séquence nettoyée).
+ */
+typedef struct {
+    char *nom;                     ///< Identifiant : premier mot de la ligne d'en-tête
+    char *sequence;                ///< Séquence en majuscules (A, C, G, T uniquement)
+    int longueur;                  ///< Longueur de la séquence
+} SequenceFasta;
+
+/**
+ * @struct ParametresAlignement
+ * @brief Barème et seuils de l'alignement local (valeurs par défaut de blastn).
+ */
+typedef struct {
+    int score_match;               ///< Score d'une identité
+    int penalite_mismatch;         ///< Pénalité d'un mésappariement (positive)
+    int ouverture_gap;             ///< Coût d'ouverture d'un gap
+    int extension_gap;             ///< Coût de chaque base du gap
+    double evalue_max;             ///< E-value maximale d'un hit retenu
+    int taille_graine;             ///< Taille des mots graines (0 = balayage exhaustif du génome)
+} ParametresAlignement;
+
+/**
+ * @struct HitAlignement
+ * @brief Un hit d'alignement local, avec les colonnes du format tabulaire BLAST.
+ */
+typedef struct {
+    int indice_motif;              ///< Indice du motif aligné
+    int indice_sujet;              ///< Indice de la séquence du génome (sujet)
+    int score;                     ///< Score brut
+    double evalue;                 ///< E-value
+    float score_bits;              ///< Score en bits
+    float identite;                ///< Pourcentage d'identité
+    int longueur_alignement;       ///< Longueur de l'alignement (gaps compris)
+    int mesappariements;           ///< Nombre de mésappariements
+    int ouvertures_gap;            ///< Nombre d'ouvertures de gap
+    int debut_requete;             ///< Début sur le motif (1-indexé)
+    int fin_requete;               ///< Fin sur le motif
+    int64_t debut_sujet;           ///< Début sur le sujet (1-indexé, supérieur à la fin sur le brin -)
+    int64_t fin_sujet;             ///< Fin sur le sujet
+} HitAlignement;
+
+/**
+ * @struct ConservationSouche
+ * @brief Conservation des motifs retenus dans le génome d'une souche.
+ */
+typedef struct {
+    int longueur_genome;           ///< Nombre de bases du génome de la souche
+    int position_gene;             ///< Début de l'orthologue du gène (0-indexé), -1 s'il est absent
+    char brin_gene;                ///< Brin de l'orthologue ('+' ou '-', '.' s'il est absent)
+    int *copies;                   ///< Copies exactes de chaque motif dans le génome, deux brins
+    int *copie_amont;              ///< 1 si une copie exacte du motif est dans la région en amont de l'orthologue (-1 : orthologue absent)
+    double *conservation;          ///< Identité de la meilleure copie de cette région (0 au-delà de MISMATCHES_CONSERVATION, -1 : orthologue absent)
+} ConservationSouche;
+
+/**
+ * @struct IndexKmers
+ * @brief Index des positions de tous les k-mers d'un génome (tri par comptage sur le code 2 bits).
+ */
+typedef struct {
+    int k;                         ///< Longueur des k-mers
+    int longueur_genome;           ///< Longueur du génome indexé
+    uint32_t *debut;               ///< 4^k + 1 bornes : les positions du k-mer de code c sont dans [debut[c], debut[c+1])
+    uint32_t *positions;           ///< Positions (0-indexées) de tous les k-mers, groupées par code
+} IndexKmers;
+
+/**
+ * @struct AlignementGene
+ * @brief Alignement avec gaps d'un gène sur le génome.
+ */
+typedef struct {
+    int debut;                     ///< Première base alignée dans le génome (0-indexée)
+    int fin;                       ///< Position suivant la dernière base alignée
+    int score;                     ///< Score de l'alignement (+2/-3, gaps 5/2)
+    double identite;               ///< Identités / longueur de l'alignement (gaps compris)
+    int longueur_alignement;       ///< Nombre de colonnes de l'alignement
+    char *cigar;                   ///< CIGAR (M, I = base du gène absente du génome, D = base du génome absente du gène)
+    char brin;                     ///< '+', ou '-' si c'est le complément inverse du gène qui est aligné (CIGAR dans ce sens)
+} AlignementGene;
+
+/**
+ * @brief Source d'octets d'un fichier texte, gzip ou BGZF, décompressé à la volée (structure opaque).
+ */
+typedef struct SourceSequence SourceSequence;
+
+/**
+ * @brief Lecteur séquentiel des nucléotides d'un fichier FASTA (structure opaque).
+ */
+typedef struct LecteurFlux LecteurFlux;
+
+/**
+ * @struct FenetreFlux
+ * @brief Fenêtre glissante sur un génome lu en flux : deux fenêtres consécutives partagent `chevauchement` bases.
+ *
+ * Un objet commençant à une position p est traité dans la fenêtre telle que debut <= p < fin_propre :
+ * chaque objet est ainsi vu une seule fois, et entièrement, s'il mesure au plus `chevauchement` bases.
+ * Une fenêtre s'arrête à la fin de chaque enregistrement d'un FASTA multiple et la suivante repart sans
+ * chevauchement : les positions restent celles des enregistrements mis bout à bout.
+ */
+typedef struct {
+    LecteurFlux *lecteur;          ///< Lecteur du fichier FASTA
+    char *sequence;                ///< Bases de la fenêtre courante (terminées par '\0')
+    int64_t longueur;              ///< Nombre de bases dans la fenêtre
+    int64_t debut;                 ///< Position (0-indexée) de la première base dans le génome
+    int64_t fin_propre;            ///< Position à partir de laquelle les objets relèvent de la fenêtre suivante
+    int64_t taille_fenetre;        ///< Nombre maximal de bases par fenêtre
+    int64_t chevauchement;         ///< Nombre de bases reprises de la fenêtre précédente
+    int numero;                    ///< Nombre de fenêtres déjà lues
+    int derniere;                  ///< La fenêtre courante atteint la fin du fichier
+} FenetreFlux;
+
+/**
+ * @struct ResultatsFlux
+ * @brief Résultats cumulés de l'analyse d'un génome fenêtre par fenêtre.
+ */
+typedef struct {
+    int64_t longueur_genome;       ///< Nombre total de bases lues
+    int nombre_fenetres;           ///< Nombre de fenêtres traitées
+    int64_t *positions_genes;      ///< Positions (0-indexées) des copies du gène
+    int nombre_genes;              ///< Nombre de copies du gène
+    int capacite_genes;            ///< Capacité allouée pour `positions_genes`
+    int64_t nombre_consensus;      ///< Nombre de paires de boîtes -35/-10 dans tout le génome
+    int longueur_kmer;             ///< Longueur des k-mers comptés
+    uint64_t *comptes_kmers;       ///< 4^k compteurs, indexés par le code 2 bits du k-mer
+} ResultatsFlux;
+
+/**
+ * @struct DictionnaireNoms
+ * @brief Dictionnaire d'identifiants (requêtes ou sujets BLAST) associant chaque nom à un indice.
+ */
+typedef struct {
+    char **noms;                   ///< Noms indexés par leur indice
+    int nombre;                    ///< Nombre de noms distincts
+    int capacite;                  ///< Capacité allouée pour `noms`
+    int *table;                    ///< Table de hachage (adressage ouvert) des indices
+    int taille_table;              ///< Taille de la table de hachage (puissance de 2)
+    int dernier;                   ///< Indice du dernier nom trouvé (les hits sont groupés par sujet)
+} DictionnaireNoms;
+
+/**
+ * @struct TableBlast
+ * @brief Résultats BLAST tabulaires (outfmt 6/7) stockés en colonnes : une case par hit dans chaque tableau.
+ */
+typedef struct {
+    int nombre_hits;               ///< Nombre de hits chargés
+    int capacite;                  ///< Capacité allouée pour chaque colonne
+    int *indice_requete;           ///< Indice de la requête dans `requetes`
+    int *indice_sujet;             ///< Indice du sujet dans `sujets`
+    float *identite;               ///< Pourcentage d'identité
+    int *longueur_alignement;      ///< Longueur de l'alignement
+    int *mesappariements;          ///< Nombre de mésappariements
+    int *ouvertures_gap;           ///< Nombre d'ouvertures de gap
+    int *debut_requete;            ///< Début de l'alignement sur la requête
+    int *fin_requete;              ///< Fin de l'alignement sur la requête
+    int64_t *debut_sujet;          ///< Début de l'alignement sur le sujet (supérieur à la fin sur le brin -)
+    int64_t *fin_sujet;            ///< Fin de l'alignement sur le sujet
+    double *evalue;                ///< E-value
+    float *score_bits;             ///< Score en bits
+    DictionnaireNoms requetes;     ///< Identifiants des requêtes
+    DictionnaireNoms sujets;       ///< Identifiants des sujets (souches)
+} TableBlast;
+
+/**
+ * @struct GroupeHitsBlast
+ * @brief Groupe de hits proches les uns des autres sur un même sujet.
+ */
+typedef struct {
+    int indice_sujet;              ///< Sujet sur lequel se trouve le groupe
+    int64_t debut;                 ///< Position du premier hit du groupe
+    int64_t fin;                   ///< Position du dernier hit du groupe
+    int nombre_hits;               ///< Nombre de hits dans le groupe
+} GroupeHitsBlast;
+
+/**
+ * @struct EcartMotifsBlast
+ * @brief Écart, sur un sujet, entre les hits d'un motif A et les hits les plus proches d'un motif B.
+ */
+typedef struct {
+    int nombre_paires;             ///< Nombre de hits de A pour lesquels un hit de B existe (0 si aucun)
+    int64_t ecart_min;             ///< Plus petit écart (-1 si aucun)
+    int64_t ecart_max;             ///< Plus grand écart (-1 si aucun)
+    double ecart_moyen;            ///< Écart moyen
+} EcartMotifsBlast;
+
+/**
+ * @struct ServeurGenome
+ * @brief Génome chargé et indexé une fois pour toutes par le serveur de requêtes, et statistiques de latence.
+ */
+typedef struct {
+    const char *genome;            ///< Séquence du génome
+    int longueur_genome;           ///< Longueur du génome
+    IndexSuffixes *index;          ///< Table des suffixes (COUNT, POS)
+    IndexKmers *index_kmers;       ///< Index des k-mers de LONGUEUR_GRAINE_GENE bases (GENE)
+    const AnnotationGenes *annotation; ///< Annotation pour la recherche de gène par nom (NULL : aucune)
+    const MasqueExclusion *masque; ///< Positions masquées, ignorées par COUNT et POS (NULL : aucun)
+    int64_t requetes;              ///< Nombre de requêtes traitées
+    double latence_totale_us;      ///< Somme des latences (µs, de la réception à la réponse)
+    double latence_max_us;         ///< Plus grande latence
+} ServeurGenome;
+
+/**
+ * @enum ActionServeur
+ * @brief Suite à donner après la réponse à une requête.
+ */
+typedef enum {
+    ACTION_CONTINUER,              ///< Attendre la requête suivante
+    ACTION_FERMER,                 ///< Fermer la connexion du client (QUIT)
+    ACTION_ARRETER                 ///< Arrêter le serveur (ARRET)
+} ActionServeur;
+
 // Prototypes des fonctions :
 
 // Génération de séquence aléatoire
@@ -50,6 +631,15 @@ char generer_nucleotide();
  */
 char* generer_sequence(int longueur_seq);
 
+/**
+ * @brief Comme generer_sequence, par blocs répartis sur les threads du pool global ; chaque bloc a son propre
+ * générateur, initialisé à partir de la graine et de son indice (même séquence quel que soit le nombre de threads).
+ * @param longueur_seq La longueur de la séquence à générer.
+ * @param graine La graine du tirage.
+ * @return La séquence générée (à libérer), ou NULL en cas d'erreur.
+ */
+char* generer_sequence_parallele(int longueur_seq, uint64_t graine);
+
 /**
  * @brief Écrit une séquence de nucléotides dans un fichier spécifié.
  * @param sequence La séquence de nucléotides à écrire.
@@ -61,11 +651,26 @@ void ecrire_fichier_sequence(const char *sequence, const char *chemin_fichier);
 
 /**
  * @brief Lit le contenu d'un fichier et renvoie une chaîne de caractères contenant les données.
- * @param chemin_fichier Le chemin vers le fichier à lire.
+ * @param chemin_fichier Le chemin vers le fichier à lire (éventuellement compressé en gzip ou BGZF).
  * @return Un pointeur vers la chaîne contenant le contenu du fichier (doit être libéré après utilisation).
  */
 char* lire_fichier(const char* chemin_fichier);
 
+/**
+ * @brief Lit un fichier FASTA contenant plusieurs enregistrements.
+ * @param chemin_fichier Le chemin vers le fichier à lire (éventuellement compressé en gzip ou BGZF).
+ * @param nombre_sequences Reçoit le nombre d'enregistrements lus.
+ * @return Le tableau des enregistrements (à libérer avec liberer_sequences_fasta), ou NULL en cas d'erreur.
+ */
+SequenceFasta* lire_fichier_multi_fasta(const char* chemin_fichier, int *nombre_sequences);
+
+/**
+ * @brief Libère les enregistrements renvoyés par lire_fichier_multi_fasta.
+ * @param sequences Le tableau des enregistrements.
+ * @param nombre_sequences Le nombre d'enregistrements.
+ */
+void liberer_sequences_fasta(SequenceFasta *sequences, int nombre_sequences);
+
 /**
  * @brief Recherche rapidement le nombre d'occurrences d'un motif dans une séquence complète, en excluant une sous-séquence spécifiée.
  * @param motif Le motif à rechercher.
@@ -76,6 +681,30 @@ char* lire_fichier(const char* chemin_fichier);
  */
 int rechercher_motif_rapide(char *motif, char *sequence_complete, int start_sous_seq, int longueur_sous_sequence);
 
+/**
+ * @brief Compte les occurrences d'un motif à au plus `mismatches_max` mésappariements en parcourant la séquence.
+ * @param motif Le motif à rechercher.
+ * @param sequence_complete La séquence dans laquelle rechercher.
+ * @param mismatches_max Le nombre maximal de mésappariements.
+ * @param start_sous_seq Début de la région dont les occurrences sont ignorées.
+ * @param longueur_sous_sequence Longueur de cette région.
+ * @return Le nombre d'occurrences.
+ */
+int rechercher_motif_approche(const char *motif, const char *sequence_complete, int mismatches_max,
+                              int start_sous_seq, int longueur_sous_sequence);
+
+/**
+ * @brief Comme rechercher_motif_rapide, en ignorant en plus les occurrences commençant à une position masquée.
+ * @param motif Le motif à rechercher.
+ * @param sequence_complete La séquence complète dans laquelle rechercher.
+ * @param start_sous_seq La position de début de la sous-séquence à exclure.
+ * @param longueur_sous_sequence La longueur de la sous-séquence à exclure.
+ * @param masque Les régions masquées (NULL : aucune).
+ * @return Le nombre d'occurrences retenues.
+ */
+int rechercher_motif_masque(const char *motif, const char *sequence_complete, int start_sous_seq,
+                            int longueur_sous_sequence, const MasqueExclusion *masque);
+
 /**
  * @brief Calcule le fold change entre les occurrences réelles et aléatoires d'un motif.
  * @param occurrences_reelles Le nombre d'occurrences du motif dans la séquence réelle.
@@ -94,6 +723,15 @@ double calculer_fold_change(int occurrences_reelles, int occurrences_aleatoires)
  */
 int etendre_k_uplet(char *sequence_complete, int longueur_total_genome, Motif *motif, int *occurrences_reelles);
 
+/**
+ * @brief Comme etendre_k_uplet, les occurrences étant comptées dans la table des suffixes du génome.
+ * @param index La table des suffixes de la séquence complète.
+ * @param motif Un pointeur vers le motif à étendre.
+ * @param occurrences_reelles Un pointeur vers le nombre d'occurrences réelles du motif (sera mis à jour).
+ * @return 1 si une extension a été faite, 0 si aucune extension n'est possible, -1 en cas d'erreur.
+ */
+int etendre_k_uplet_index(const IndexSuffixes *index, Motif *motif, int *occurrences_reelles);
+
 /**
  * @brief Fonction de comparaison pour trier les motifs par position de départ.
  * @param a Pointeur vers le premier motif à comparer.
@@ -104,11 +742,10 @@ int comparer_motifs(const void *a, const void *b);
 
 /**
  * @brief Affiche une interface graphique résumant les motifs potentiels trouvés.
- * @param motifs_potentiels Un tableau de motifs potentiels.
- * @param nombre_motifs Le nombre de motifs dans le tableau.
+ * @param stock Les motifs potentiels.
  * @param position_gene La position du gène d'intérêt dans la séquence.
  */
-void afficher_interface_graphique(Motif* motifs_potentiels, int nombre_motifs, int position_gene);
+void afficher_interface_graphique(const StockMotifs *stock, int position_gene);
 
 /**
  * @brief Traite les k-uplets dans une région de la séquence pour identifier des motifs potentiels.
@@ -120,17 +757,11 @@ void afficher_interface_graphique(Motif* motifs_potentiels, int nombre_motifs, i
  * @param longueur_min_motif La longueur minimale pour qu'un motif soit considéré.
  * @param sequence_aleatoire Une séquence aléatoire pour comparaison.
  * @param position_gene La position du gène d'intérêt dans la séquence complète.
+ * @param sortie Les fichiers de résultats et l'affichage console (NULL : parametres_sortie_defaut()).
  */
 void traiter_k_uplets(char* sous_sequence, int longueur_sous_sequence, char* sequence_complete,
                       int longueur_total_genome, int longueur_k_uplet, int longueur_min_motif,
-                      char* sequence_aleatoire, int position_gene);
-
-/**
- * @brief Affiche une barre de progression dans la console.
- * @param current La valeur actuelle de progression.
- * @param total La valeur totale correspondant à 100% de progression.
- */
-void afficher_progression(int current, int total);
+                      char* sequence_aleatoire, int position_gene, const ParametresSortie *sortie);
 
 // Recherche de gène
 
@@ -152,73 +783,1431 @@ float calculer_identite(const char* seq1, const char *seq2, int longueur);
  */
 int rechercher_gene(const char* sequence_genome, const char *sequence_gene, double identite_min);
 
-// Recherche de séquence consensus
-
 /**
- * @brief Compare une sous-séquence avec une séquence consensus avec une marge d'erreur de 1 base.
- * @param sous_sequence La sous-séquence extraite du génome.
- * @param sequence_consensus La séquence consensus à comparer.
- * @param taille_consensus La longueur de la séquence consensus.
- * @return true si les séquences correspondent avec au plus 1 différence, false sinon.
+ * @brief Comme rechercher_gene, par blocs répartis sur les threads du pool global (mêmes messages, même résultat).
+ * @param sequence_genome La séquence génomique complète.
+ * @param sequence_gene La séquence du gène à rechercher.
+ * @param identite_min Le pourcentage d'identité minimale requis pour considérer une correspondance.
+ * @return La position du gène (1-indexée), ou -1 si non trouvé ou trouvé plusieurs fois.
  */
-bool comparer_avec_marge_erreur(const char* sous_sequence, const char* sequence_consensus, int taille_consensus);
+int rechercher_gene_parallele(const char* sequence_genome, const char* sequence_gene, double identite_min);
 
 /**
- * @brief Recherche les séquences consensus de type boîte -35 et boîte -10 en amont d'un gène.
+ * @brief Relève, sans rien afficher, toutes les copies sans indels d'un gène (brin +) sur le pool global.
  * @param sequence_genome La séquence génomique complète.
- * @param boite_35 La séquence consensus de la boîte -35.
- * @param boite_10 La séquence consensus de la boîte -10.
- * @param position_gene La position du gène dans la séquence génomique.
- * @param bases_amont Le nombre de bases en amont du gène à analyser.
- * @return Le nombre de paires de boîtes consensus trouvées, ou -1 si aucune n'est trouvée.
+ * @param sequence_gene La séquence du gène à rechercher.
+ * @param identite_min L'identité minimale d'une copie retenue.
+ * @param positions Reçoit les positions (0-indexées) des `nombre_max` premières copies, croissantes.
+ * @param identites Reçoit leurs identités.
+ * @param nombre_max La capacité de `positions` et `identites`.
+ * @return Le nombre de copies (éventuellement supérieur à `nombre_max`), ou -1 en cas d'erreur.
  */
-int rechercher_seq_consensus(const char* sequence_genome, const char* boite_35, const char* boite_10,
-                             int position_gene, int bases_amont);
-
-// Tests des fonctions :
+int lister_copies_gene_parallele(const char* sequence_genome, const char* sequence_gene, double identite_min,
+                                 int *positions, float *identites, int nombre_max);
 
-// Tests de séquences consensus
+// Recherche de gène avec gaps (graines et extension)
 
 /**
- * @brief Teste la détection de boîtes consensus avec une distance de 15 nucléotides entre les boîtes -35 et -10.
+ * @brief Construit l'index de tous les k-mers d'un génome (k <= 15).
+ * @param sequence_genome La séquence génomique.
+ * @param longueur_genome La longueur du génome.
+ * @param k La longueur des k-mers.
+ * @return L'index (à libérer avec liberer_index_kmers), ou NULL en cas d'erreur.
  */
-void test_seq_consensus_distance_15();
+IndexKmers* construire_index_kmers(const char *sequence_genome, int longueur_genome, int k);
 
 /**
- * @brief Teste la détection de boîtes consensus avec une distance de 19 nucléotides entre les boîtes -35 et -10.
+ * @brief Libère un index de k-mers.
+ * @param index L'index à libérer.
  */
-void test_seq_consensus_distance_19();
+void liberer_index_kmers(IndexKmers *index);
 
 /**
- * @brief Teste la détection de boîtes consensus chevauchantes avec des distances variables.
+ * @brief Libère le CIGAR d'un alignement de gène.
+ * @param alignement L'alignement.
  */
-void test_seq_consensus_chevauchante();
+void liberer_alignement_gene(AlignementGene *alignement);
 
 /**
- * @brief Teste la robustesse de la détection de boîtes consensus dans des séquences riches en boîtes -35 et -10.
+ * @brief Recherche un gène sur les deux brins par graines et alignement en bande autour des groupes de graines.
+ * @param index L'index des k-mers du génome.
+ * @param sequence_genome La séquence génomique indexée.
+ * @param sequence_gene La séquence du gène.
+ * @param identite_min L'identité minimale d'un alignement retenu.
+ * @param resultats Reçoit les alignements retenus (CIGAR à libérer avec liberer_alignement_gene).
+ * @param nombre_max_resultats La taille du tableau `resultats`.
+ * @return Le nombre d'alignements retenus (éventuellement supérieur à `nombre_max_resultats`), ou -1 en cas d'erreur.
  */
-void test_seq_consensus_critique_seq();
+int rechercher_gene_graines(const IndexKmers *index, const char *sequence_genome, const char *sequence_gene,
+                            double identite_min, AlignementGene *resultats, int nombre_max_resultats);
 
 /**
- * @brief Teste la recherche de boîtes consensus en amont avec une limitation du nombre de bases à analyser.
+ * @brief Recherche un gène sur les deux brins avec un index des k-mers déjà construit (même contrat que rechercher_gene).
+ *
+ * Un gène plus court que les k-mers de l'index est cherché par rechercher_gene_parallele, sans indels, sur le brin +.
+ * @param index L'index des k-mers du génome (LONGUEUR_GRAINE_GENE bases).
+ * @param sequence_genome La séquence génomique indexée.
+ * @param sequence_gene La séquence du gène à rechercher.
+ * @param identite_min Le pourcentage d'identité minimale requis (gaps compris).
+ * @param brin Reçoit le brin du gène ('+', '-', ou '.' s'il n'est pas trouvé une seule fois) ; peut être NULL.
+ * @return La position 1-indexée de la première base alignée sur le brin +, ou -1 si non trouvé ou trouvé plusieurs fois.
  */
-void test_rechercher_seq_consensus_en_amont();
+int rechercher_gene_index(const IndexKmers *index, const char *sequence_genome, const char *sequence_gene,
+                          double identite_min, char *brin);
 
 /**
- * @brief Teste la recherche de boîtes consensus avec un gène chevauchant la fin de la boîte -10.
+ * @brief Recherche un gène en tolérant les indels (même contrat que rechercher_gene), en construisant l'index des
+ * k-mers pour ce seul appel (voir rechercher_gene_index pour des recherches répétées sur le même génome).
+ * @param sequence_genome La séquence génomique complète.
+ * @param sequence_gene La séquence du gène à rechercher.
+ * @param identite_min Le pourcentage d'identité minimale requis (gaps compris).
+ * @return La position 1-indexée du gène, ou -1 si non trouvé ou trouvé plusieurs fois.
  */
-void test_rechercher_seq_consensus_en_amont_critique();
+int rechercher_gene_gappee(const char* sequence_genome, const char *sequence_gene, double identite_min);
 
-// Tests de recherche de gène
+// Recherche de séquence consensus
 
 /**
- * @brief Teste la détection d'un gène présent avec une identité parfaite.
- * @return 0 si le test est réussi.
+ * @brief Compare une sous-séquence avec une séquence consensus avec une marge d'erreur de 1 base.
+ * @param sous_sequence La sous-séquence extraite du génome.
+ * @param sequence_consensus La séquence consensus à comparer.
+ * @param taille_consensus La longueur de la séquence consensus.
+ * @return true si les séquences correspondent avec au plus 1 différence, false sinon.
  */
-int test_presence_gene();
+bool comparer_avec_marge_erreur(const char* sous_sequence, const char* sequence_consensus, int taille_consensus);
 
 /**
- * @brief Teste la détection d'un gène présent plusieurs fois dans le génome.
+ * @brief Recherche les séquences consensus de type boîte -35 et boîte -10 en amont d'un gène.
+ * @param sequence_genome La séquence génomique complète.
+ * @param boite_35 La séquence consensus de la boîte -35.
+ * @param boite_10 La séquence consensus de la boîte -10.
+ * @param position_gene La position du gène dans la séquence génomique.
+ * @param bases_amont Le nombre de bases en amont du gène à analyser.
+ * @return Le nombre de paires de boîtes consensus trouvées, ou -1 si aucune n'est trouvée.
+ */
+int rechercher_seq_consensus(const char* sequence_genome, const char* boite_35, const char* boite_10,
+                             int position_gene, int bases_amont);
+
+/**
+ * @brief Comme rechercher_seq_consensus, par blocs répartis sur les threads du pool global ; les paires trouvées
+ * sont affichées dans l'ordre du parcours séquentiel.
+ * @param sequence_genome La séquence génomique complète.
+ * @param boite_35 La séquence consensus de la boîte -35.
+ * @param boite_10 La séquence consensus de la boîte -10.
+ * @param position_gene La position du gène dans la séquence génomique.
+ * @param bases_amont Le nombre de bases en amont du gène à analyser (0 : tout le génome).
+ * @return Le nombre de paires de boîtes consensus trouvées, ou -1 si aucune n'est trouvée.
+ */
+int rechercher_seq_consensus_parallele(const char* sequence_genome, const char* boite_35, const char* boite_10,
+                                       int position_gene, int bases_amont);
+
+/**
+ * @brief Relève, sans rien afficher, les paires de boîtes consensus d'une région (mêmes règles que
+ * rechercher_seq_consensus).
+ * @param sequence_genome La séquence génomique complète.
+ * @param debut Début de la région.
+ * @param fin Position suivant la fin de la région (les deux boîtes doivent s'y trouver).
+ * @param boite_35 La séquence consensus de la boîte -35.
+ * @param boite_10 La séquence consensus de la boîte -10.
+ * @param positions Reçoit les positions des boîtes -35 et -10, deux à deux (au plus `nombre_max` paires).
+ * @param nombre_max La capacité de `positions`, en paires.
+ * @return Le nombre total de paires trouvées (éventuellement supérieur à `nombre_max`).
+ */
+int lister_paires_consensus(const char* sequence_genome, int debut, int fin, const char* boite_35,
+                            const char* boite_10, int *positions, int nombre_max);
+
+/**
+ * @brief Parcourt les paires de boîtes consensus (au plus un mésappariement par boîte, boîte -10 de 15 à 19 bases
+ * après la -35) avec un pré-filtre vectoriel.
+ *
+ * Les mésappariements de chaque boîte sont comptés pour 32 positions à la fois et donnent un masque de bits par
+ * boîte ; le masque de la boîte -10, décalé des cinq espacements possibles, est combiné mot à mot avec celui
+ * de la boîte -35, et seules les positions restantes sont examinées une à une. Les paires sont transmises dans
+ * l'ordre du parcours position par position (boîte -35, puis espacement croissant).
+ * @param sequence La séquence.
+ * @param debut Première position possible d'une boîte -35.
+ * @param fin Position suivant la dernière position possible d'une boîte -35.
+ * @param limite Position suivant la dernière base lisible : les deux boîtes doivent finir avant.
+ * @param boite_35 La séquence consensus de la boîte -35.
+ * @param boite_10 La séquence consensus de la boîte -10.
+ * @param fonction Reçoit chaque paire (NULL : paires seulement comptées).
+ * @param contexte Les données passées à `fonction`.
+ * @return Le nombre de paires.
+ */
+int64_t parcourir_paires_consensus(const char *sequence, int64_t debut, int64_t fin, int64_t limite,
+                                   const char *boite_35, const char *boite_10, FonctionPaireConsensus fonction,
+                                   void *contexte);
+
+/**
+ * @brief Impose une implémentation du pré-filtre (comparaisons et mesures).
+ * @param filtre L'implémentation (FILTRE_CONSENSUS_AUTO : choix selon le processeur, par défaut).
+ * @return 0 en cas de succès, -1 si le processeur ou la compilation ne la permettent pas.
+ */
+int choisir_filtre_consensus(FiltreConsensus filtre);
+
+/**
+ * @brief Implémentation du pré-filtre utilisée par parcourir_paires_consensus.
+ * @return L'implémentation imposée, ou la plus rapide disponible.
+ */
+FiltreConsensus filtre_consensus_actif(void);
+
+// Lecture des fichiers compressés (gzip, BGZF)
+
+/**
+ * @brief Ouvre un fichier en détectant sa compression : gzip est décompressé par un thread dédié,
+ * BGZF par blocs en parallèle sur le pool global (celui en place à l'ouverture, qui doit le rester jusqu'à
+ * fermer_source), pendant que l'appelant traite les données déjà produites.
+ * @param chemin_fichier Le chemin vers le fichier (texte, .gz ou BGZF).
+ * @return La source (à fermer avec fermer_source), ou NULL en cas d'erreur.
+ */
+SourceSequence* ouvrir_source(const char *chemin_fichier);
+
+/**
+ * @brief Lit les octets décompressés suivants, comme fread.
+ * @param source La source.
+ * @param destination Le tampon de destination.
+ * @param taille Le nombre maximal d'octets à lire.
+ * @return Le nombre d'octets lus, 0 à la fin du fichier.
+ */
+size_t lire_source(SourceSequence *source, char *destination, size_t taille);
+
+/**
+ * @brief Lit la ligne suivante, comme getline.
+ * @param source La source.
+ * @param ligne Le tampon de la ligne, réalloué si nécessaire (à libérer par l'appelant).
+ * @param capacite La capacité du tampon.
+ * @return La longueur de la ligne ('\n' compris), ou -1 à la fin du fichier.
+ */
+int64_t lire_ligne_source(SourceSequence *source, char **ligne, size_t *capacite);
+
+/**
+ * @brief Indique si une erreur de lecture ou de décompression s'est produite.
+ * @param source La source.
+ * @return Une valeur non nulle en cas d'erreur.
+ */
+int erreur_source(SourceSequence *source);
+
+/**
+ * @brief Ferme une source et arrête ses threads de décompression.
+ * @param source La source à fermer.
+ */
+void fermer_source(SourceSequence *source);
+
+// Écriture des résultats des motifs
+
+/**
+ * @brief Renvoie les paramètres de sortie par défaut (console, sans fichier).
+ * @return Les paramètres de sortie.
+ */
+ParametresSortie parametres_sortie_defaut();
+
+/**
+ * @brief Convertit un nom de format ("tsv", "jsonl" ou "bin").
+ * @param nom Le nom du format.
+ * @param format Reçoit le format correspondant.
+ * @return 0 si le nom est reconnu, -1 sinon.
+ */
+int format_resultats_depuis_nom(const char *nom, FormatResultats *format);
+
+/**
+ * @brief Ouvre un fichier de résultats ; les motifs sont accumulés dans un tampon et écrits par gros blocs.
+ * @param chemin_fichier Le chemin du fichier à créer.
+ * @param format Le format du fichier.
+ * @return L'écrivain (à fermer avec fermer_ecrivain_resultats), ou NULL en cas d'erreur.
+ */
+EcrivainResultats* ouvrir_ecrivain_resultats(const char *chemin_fichier, FormatResultats format);
+
+/**
+ * @brief Ajoute un motif (tous ses champs) au fichier de résultats.
+ * @param ecrivain L'écrivain.
+ * @param motif Le motif ; seuls `length` caractères de sa séquence sont lus.
+ * @return 0 en cas de succès, -1 en cas d'erreur d'écriture.
+ */
+int ecrire_motif_resultat(EcrivainResultats *ecrivain, const Motif *motif);
+
+/**
+ * @brief Vide le tampon et ferme le fichier de résultats.
+ * @param ecrivain L'écrivain.
+ * @return 0 si toutes les écritures ont réussi, -1 sinon.
+ */
+int fermer_ecrivain_resultats(EcrivainResultats *ecrivain);
+
+/**
+ * @brief Relit un fichier de résultats au format binaire.
+ * @param chemin_fichier Le chemin du fichier.
+ * @param nombre_motifs Reçoit le nombre de motifs lus (0 en cas d'erreur).
+ * @return Les motifs (séquences, répartitions et tableau à libérer par l'appelant, alloué même sans motif), ou
+ * NULL en cas d'erreur, y compris si un enregistrement est tronqué ou corrompu : aucun motif n'est alors rendu.
+ */
+Motif* lire_motifs_binaires(const char *chemin_fichier, int *nombre_motifs);
+
+// Index des suffixes et répartition des motifs
+
+/**
+ * @brief Construit la table des suffixes d'un génome (doublement des préfixes et tris par comptage).
+ * @param sequence_genome Le génome (A, C, G, T), qui doit rester valide tant que l'index est utilisé.
+ * @param longueur_genome La longueur du génome.
+ * @return L'index (à libérer avec liberer_index_suffixes), ou NULL en cas d'erreur ou de génome vide.
+ */
+IndexSuffixes* construire_index_suffixes(const char *sequence_genome, int longueur_genome);
+
+/**
+ * @brief Libère un index des suffixes.
+ * @param index L'index à libérer.
+ */
+void liberer_index_suffixes(IndexSuffixes *index);
+
+/**
+ * @brief Calcule la table LCP d'un index des suffixes (algorithme de Kasai, temps linéaire).
+ * @param index L'index.
+ * @return lcp[r] : longueur du préfixe commun aux suffixes de rangs r - 1 et r (lcp[0] = 0), à libérer
+ * avec free, ou NULL en cas d'erreur d'allocation.
+ */
+int32_t* calculer_lcp(const IndexSuffixes *index);
+
+/**
+ * @brief Trouve l'intervalle de la table des suffixes commençant par un motif.
+ * @param index L'index.
+ * @param motif Le motif (non nécessairement terminé par '\0').
+ * @param longueur_motif La longueur du motif.
+ * @param debut Reçoit le premier indice de l'intervalle.
+ * @param fin Reçoit l'indice suivant le dernier.
+ * @return Le nombre d'occurrences du motif (chevauchantes comprises).
+ */
+int intervalle_suffixes(const IndexSuffixes *index, const char *motif, int longueur_motif, int *debut, int *fin);
+
+/**
+ * @brief Compte les occurrences d'un motif, comme rechercher_motif_rapide mais sans parcourir le génome.
+ * @param index L'index.
+ * @param motif Le motif.
+ * @param longueur_motif La longueur du motif.
+ * @param start_exclusion Début de la région dont les occurrences sont ignorées.
+ * @param longueur_exclusion Longueur de cette région (0 : aucune exclusion).
+ * @param masque Positions masquées, ignorées elles aussi (NULL : aucune).
+ * @return Le nombre d'occurrences hors de la région exclue et du masque.
+ */
+int compter_occurrences_index(const IndexSuffixes *index, const char *motif, int longueur_motif,
+                              int start_exclusion, int longueur_exclusion, const MasqueExclusion *masque);
+
+/**
+ * @brief Renvoie les positions de toutes les occurrences d'un motif.
+ * @param index L'index.
+ * @param motif Le motif.
+ * @param longueur_motif La longueur du motif.
+ * @param masque Positions masquées, dont les occurrences sont omises (NULL : aucune).
+ * @param nombre Reçoit le nombre d'occurrences.
+ * @return Les positions croissantes (0-indexées, à libérer), ou NULL en cas d'erreur.
+ */
+int* positions_occurrences(const IndexSuffixes *index, const char *motif, int longueur_motif,
+                           const MasqueExclusion *masque, int *nombre);
+
+/**
+ * @brief Compte les occurrences d'un motif à au plus `mismatches_max` mésappariements, par descente dans la
+ * table des suffixes (les quatre bases sont essayées tant que le budget le permet, puis recherche exacte).
+ * @param index L'index.
+ * @param motif Le motif.
+ * @param longueur_motif La longueur du motif.
+ * @param mismatches_max Le nombre maximal de mésappariements (1 à 3 en pratique).
+ * @param start_exclusion Début de la région dont les occurrences sont ignorées.
+ * @param longueur_exclusion Longueur de cette région (0 : aucune exclusion).
+ * @param masque Positions masquées, ignorées elles aussi (NULL : aucune).
+ * @return Le nombre d'occurrences hors de la région exclue et du masque.
+ */
+int compter_occurrences_approchees(const IndexSuffixes *index, const char *motif, int longueur_motif,
+                                   int mismatches_max, int start_exclusion, int longueur_exclusion,
+                                   const MasqueExclusion *masque);
+
+/**
+ * @brief Renvoie les positions des occurrences d'un motif à au plus `mismatches_max` mésappariements.
+ * @param index L'index.
+ * @param motif Le motif.
+ * @param longueur_motif La longueur du motif.
+ * @param mismatches_max Le nombre maximal de mésappariements.
+ * @param masque Positions masquées, dont les occurrences sont omises (NULL : aucune).
+ * @param nombre Reçoit le nombre d'occurrences.
+ * @return Les positions croissantes (à libérer), ou NULL en cas d'erreur.
+ */
+int* positions_occurrences_approchees(const IndexSuffixes *index, const char *motif, int longueur_motif,
+                                      int mismatches_max, const MasqueExclusion *masque, int *nombre);
+
+/**
+ * @brief Charge les gènes d'un fichier GFF3 (lignes de type "gene") ou TSV (nom, début, fin, brin facultatif).
+ * @param chemin_fichier Le chemin du fichier d'annotation (positions 1-indexées, bornes incluses).
+ * @return L'annotation (à libérer avec liberer_annotation_genes), ou NULL en cas d'erreur.
+ */
+AnnotationGenes* charger_annotation_genes(const char *chemin_fichier);
+
+/**
+ * @brief Libère une annotation.
+ * @param annotation L'annotation à libérer.
+ */
+void liberer_annotation_genes(AnnotationGenes *annotation);
+
+/**
+ * @brief Distance entre un intervalle du génome et le gène annoté le plus proche.
+ * @param annotation L'annotation.
+ * @param debut Début de l'intervalle (0-indexé).
+ * @param fin Position suivant la fin de l'intervalle.
+ * @return 0 si l'intervalle chevauche un gène, la distance en bases sinon, -1 sans gène annoté.
+ */
+int distance_gene_annote(const AnnotationGenes *annotation, int debut, int fin);
+
+/**
+ * @brief Calcule la répartition des copies d'un motif : positions, écarts, densité par fenêtre, distance aux gènes.
+ * @param index L'index du génome.
+ * @param motif Le motif.
+ * @param longueur_motif La longueur du motif.
+ * @param masque Positions masquées, dont les copies sont omises (NULL : aucune).
+ * @param annotation Les gènes annotés (NULL : pas de distances).
+ * @param taille_fenetre La taille des fenêtres de densité (0 : pas de densité).
+ * @return La répartition (à libérer avec liberer_distribution_motif), ou NULL en cas d'erreur.
+ */
+DistributionMotif* calculer_distribution_motif(const IndexSuffixes *index, const char *motif, int longueur_motif,
+                                               const MasqueExclusion *masque, const AnnotationGenes *annotation,
+                                               int taille_fenetre);
+
+/**
+ * @brief Libère une répartition de motif.
+ * @param distribution La répartition à libérer.
+ */
+void liberer_distribution_motif(DistributionMotif *distribution);
+
+// Masques d'exclusion
+
+/**
+ * @brief Crée un masque vide couvrant un génome.
+ * @param longueur_genome La longueur du génome.
+ * @return Le masque (à libérer avec liberer_masque_exclusion), ou NULL en cas d'erreur d'allocation.
+ */
+MasqueExclusion* creer_masque_exclusion(int longueur_genome);
+
+/**
+ * @brief Libère un masque.
+ * @param masque Le masque à libérer.
+ */
+void liberer_masque_exclusion(MasqueExclusion *masque);
+
+/**
+ * @brief Masque l'intervalle [debut, fin), ramené aux bornes du génome et fusionné avec ses voisins.
+ * @param masque Le masque.
+ * @param debut Première position masquée (0-indexée).
+ * @param fin Position suivant la dernière.
+ * @return 0 en cas de succès, -1 en cas d'erreur d'allocation.
+ */
+int ajouter_intervalle_masque(MasqueExclusion *masque, int debut, int fin);
+
+/**
+ * @brief Indique si une position est masquée.
+ * @param masque Le masque (NULL : aucune position masquée).
+ * @param position La position (0-indexée).
+ * @return true si la position est masquée.
+ */
+bool position_masquee(const MasqueExclusion *masque, int position);
+
+/**
+ * @brief Renvoie la première position non masquée à partir d'une position.
+ * @param masque Le masque.
+ * @param position La position.
+ * @return La fin de l'intervalle masqué contenant `position`, ou `position` si elle n'est pas masquée.
+ */
+int fin_intervalle_masque(const MasqueExclusion *masque, int position);
+
+/**
+ * @brief Ajoute au masque les régions d'un fichier BED (chromosome, début, fin) ou de lignes "début fin".
+ * @param masque Le masque.
+ * @param chemin_fichier Le chemin du fichier (positions 0-indexées, fin exclue, comme en BED).
+ * @return Le nombre de régions lues, ou -1 en cas d'erreur.
+ */
+int charger_masque_exclusion(MasqueExclusion *masque, const char *chemin_fichier);
+
+/**
+ * @brief Nombre total de positions masquées.
+ * @param masque Le masque.
+ * @return Le nombre de bases masquées.
+ */
+int64_t bases_masquees(const MasqueExclusion *masque);
+
+/**
+ * @brief Indique si un intervalle contient au moins une position masquée.
+ * @param masque Le masque (NULL : aucune position masquée).
+ * @param debut Début de l'intervalle (0-indexé).
+ * @param fin Position suivant la fin de l'intervalle.
+ * @return true si l'intervalle chevauche une région masquée.
+ */
+bool chevauche_masque(const MasqueExclusion *masque, int debut, int fin);
+
+/**
+ * @brief Masque les régions de faible complexité (homopolymères, courtes répétitions) selon le score DUST,
+ * calculé en temps linéaire sur une fenêtre glissante de triplets.
+ * @param masque Le masque complété.
+ * @param sequence La séquence (A, C, G, T).
+ * @param longueur La longueur de la séquence.
+ * @param fenetre La taille des fenêtres (FENETRE_DUST).
+ * @param seuil Le score au-delà duquel une fenêtre est masquée (SEUIL_DUST).
+ * @return 0 en cas de succès, -1 en cas d'erreur d'allocation.
+ */
+int masquer_faible_complexite(MasqueExclusion *masque, const char *sequence, int longueur, int fenetre, int seuil);
+
+/**
+ * @brief Masque toutes les copies des k-mers présents plus de `copies_max` fois dans le génome.
+ * @param masque Le masque complété.
+ * @param index La table des suffixes du génome.
+ * @param longueur_kmer La longueur des k-mers.
+ * @param copies_max Le nombre de copies au-delà duquel un k-mer est masqué.
+ * @return 0 en cas de succès, -1 en cas d'erreur d'allocation.
+ */
+int masquer_kmers_frequents(MasqueExclusion *masque, const IndexSuffixes *index, int longueur_kmer, int copies_max);
+
+// Analyse en flux (génomes plus grands que la mémoire)
+
+/**
+ * @brief Ouvre un lecteur séquentiel des nucléotides d'un fichier FASTA.
+ * @param chemin_fichier Le chemin vers le fichier FASTA.
+ * @return Le lecteur (à fermer avec fermer_lecteur_flux), ou NULL en cas d'erreur.
+ */
+LecteurFlux* ouvrir_lecteur_flux(const char *chemin_fichier);
+
+/**
+ * @brief Indique si la lecture ou la décompression du fichier a échoué (à vérifier une fois les bases lues).
+ * @param lecteur Le lecteur.
+ * @return Une valeur non nulle en cas d'erreur.
+ */
+int erreur_lecteur_flux(LecteurFlux *lecteur);
+
+/**
+ * @brief Ferme un lecteur séquentiel.
+ * @param lecteur Le lecteur à fermer.
+ */
+void fermer_lecteur_flux(LecteurFlux *lecteur);
+
+/**
+ * @brief Lit les nucléotides suivants (mêmes règles de filtrage que lire_fichier, enregistrements mis bout à bout).
+ * @param lecteur Le lecteur.
+ * @param destination Le tampon de destination (non terminé par '\0').
+ * @param maximum Le nombre maximal de nucléotides à copier.
+ * @return Le nombre de nucléotides copiés, 0 à la fin du fichier.
+ */
+int64_t lire_bases_flux(LecteurFlux *lecteur, char *destination, int64_t maximum);
+
+/**
+ * @brief Prépare la lecture d'un génome en fenêtres chevauchantes.
+ * @param fenetre La fenêtre à initialiser.
+ * @param chemin_fichier Le chemin vers le fichier FASTA.
+ * @param taille_fenetre Le nombre maximal de bases par fenêtre (au plus INT32_MAX).
+ * @param chevauchement Le nombre de bases partagées par deux fenêtres consécutives.
+ * @return 0 en cas de succès, -1 en cas d'erreur.
+ */
+int initialiser_fenetre_flux(FenetreFlux *fenetre, const char *chemin_fichier, int64_t taille_fenetre,
+                             int64_t chevauchement);
+
+/**
+ * @brief Charge la fenêtre suivante du génome.
+ * @param fenetre La fenêtre.
+ * @return 1 si une fenêtre a été chargée, 0 à la fin du génome, -1 si la lecture du fichier a échoué.
+ */
+int fenetre_suivante(FenetreFlux *fenetre);
+
+/**
+ * @brief Libère une fenêtre et ferme son fichier.
+ * @param fenetre La fenêtre.
+ */
+void liberer_fenetre_flux(FenetreFlux *fenetre);
+
+/**
+ * @brief Analyse un génome fenêtre par fenêtre : copies du gène, paires de boîtes consensus et comptage des k-mers.
+ * @param chemin_genome Le chemin vers le génome FASTA.
+ * @param sequence_gene La séquence du gène à rechercher (NULL pour ne pas le rechercher).
+ * @param longueur_kmer La longueur des k-mers à compter (1 à LONGUEUR_MAX_KMER_FLUX).
+ * @param taille_fenetre Le nombre de bases par fenêtre.
+ * @param resultats Reçoit les résultats (à libérer avec liberer_resultats_flux).
+ * @return 0 en cas de succès, -1 en cas d'erreur.
+ */
+int analyser_genome_flux(const char *chemin_genome, const char *sequence_gene, int longueur_kmer,
+                         int64_t taille_fenetre, ResultatsFlux *resultats);
+
+/**
+ * @brief Libère les résultats d'une analyse en flux.
+ * @param resultats Les résultats.
+ */
+void liberer_resultats_flux(ResultatsFlux *resultats);
+
+/**
+ * @brief Décode un k-mer à partir de son code 2 bits (A=0, C=1, G=2, T=3).
+ * @param code Le code du k-mer.
+ * @param k La longueur du k-mer.
+ * @param kmer Reçoit le k-mer (k + 1 caractères).
+ */
+void decoder_kmer(uint64_t code, int k, char *kmer);
+
+/**
+ * @brief Écrit les comptes non nuls des k-mers (k-mer, tabulation, nombre) dans un fichier.
+ * @param resultats Les résultats de l'analyse en flux.
+ * @param chemin_fichier Le chemin vers le fichier de sortie.
+ * @return 0 en cas de succès, -1 en cas d'erreur.
+ */
+int ecrire_comptes_kmers_flux(const ResultatsFlux *resultats, const char *chemin_fichier);
+
+// Lecture et agrégation des résultats BLAST
+
+/**
+ * @brief Charge un fichier BLAST tabulaire (outfmt 6 ou 7) dans une table en colonnes.
+ * @param chemin_fichier Le chemin vers le fichier BLAST.
+ * @return La table chargée (à libérer avec liberer_table_blast), ou NULL en cas d'erreur.
+ */
+TableBlast* charger_table_blast(const char *chemin_fichier);
+
+/**
+ * @brief Libère une table BLAST et tous ses tableaux.
+ * @param table La table à libérer.
+ */
+void liberer_table_blast(TableBlast *table);
+
+/**
+ * @brief Compte les hits de chaque sujet.
+ * @param table La table BLAST.
+ * @param indice_requete L'indice de la requête à considérer, ou -1 pour toutes les requêtes.
+ * @return Un tableau de `table->sujets.nombre` compteurs (doit être libéré après utilisation).
+ */
+int* blast_hits_par_sujet(const TableBlast *table, int indice_requete);
+
+/**
+ * @brief Calcule la distribution du nombre de copies : case c = nombre de sujets ayant exactement c hits.
+ * @param table La table BLAST.
+ * @param indice_requete L'indice de la requête à considérer, ou -1 pour toutes les requêtes.
+ * @param copies_max Reçoit le plus grand nombre de copies observé (taille du tableau - 1).
+ * @return L'histogramme (doit être libéré après utilisation), ou NULL en cas d'erreur.
+ */
+int* blast_distribution_copies(const TableBlast *table, int indice_requete, int *copies_max);
+
+/**
+ * @brief Regroupe, sujet par sujet, les hits séparés d'au plus `distance_max` bases.
+ * @param table La table BLAST.
+ * @param indice_requete L'indice de la requête à considérer, ou -1 pour toutes les requêtes.
+ * @param distance_max L'écart maximal entre deux hits consécutifs d'un même groupe.
+ * @param nombre_groupes Reçoit le nombre de groupes.
+ * @return Le tableau des groupes triés par sujet puis par position (doit être libéré après utilisation, alloué
+ * même sans groupe), ou NULL en cas d'erreur.
+ */
+GroupeHitsBlast* blast_regrouper_positions(const TableBlast *table, int indice_requete, int64_t distance_max,
+                                           int *nombre_groupes);
+
+/**
+ * @brief Mesure, pour chaque sujet, l'écart entre les hits de deux motifs voisins.
+ * @param table La table BLAST.
+ * @param requete_a L'indice de la requête du premier motif.
+ * @param requete_b L'indice de la requête du second motif.
+ * @return Un tableau de `table->sujets.nombre` écarts (doit être libéré après utilisation).
+ */
+EcartMotifsBlast* blast_ecart_motifs(const TableBlast *table, int requete_a, int requete_b);
+
+/**
+ * @brief Affiche un résumé de la table : distribution des copies et groupes de hits par requête.
+ * @param table La table BLAST.
+ * @param distance_groupe L'écart maximal entre deux hits d'un même groupe.
+ */
+void afficher_resume_blast(const TableBlast *table, int64_t distance_groupe);
+
+// Alignement local des motifs (Smith-Waterman vectorisé)
+
+/**
+ * @brief Retourne les paramètres d'alignement par défaut (+2/-3, gaps 5/2, e-value 10, graines de 11).
+ * @return Les paramètres par défaut.
+ */
+ParametresAlignement parametres_alignement_defaut(void);
+
+/**
+ * @brief Calcule l'e-value d'un score brut (statistiques de Karlin-Altschul du barème blastn).
+ * @param score Le score brut de l'alignement.
+ * @param longueur_requete La longueur du motif.
+ * @param longueur_base La longueur totale du génome interrogé.
+ * @return L'e-value.
+ */
+double calculer_evalue_alignement(int score, int longueur_requete, int64_t longueur_base);
+
+/**
+ * @brief Convertit un score brut en score en bits.
+ * @param score Le score brut de l'alignement.
+ * @return Le score en bits.
+ */
+double calculer_score_bits(int score);
+
+/**
+ * @brief Écrit le complément inverse d'une séquence (toute base autre que A, C, G, T devient N).
+ * @param sequence La séquence.
+ * @param longueur Sa longueur.
+ * @param destination Reçoit les `longueur` bases (non terminées par '\0').
+ */
+void ecrire_complement_inverse(const char *sequence, int longueur, char *destination);
+
+/**
+ * @brief Smith-Waterman scalaire (une colonne à la fois) : renvoie la fin et le score de chaque hit au-dessus du seuil.
+ * @param requete La requête.
+ * @param longueur_requete La longueur de la requête.
+ * @param cible La séquence cible.
+ * @param longueur_cible La longueur de la cible.
+ * @param seuil Le score minimal d'un hit.
+ * @param p Les paramètres d'alignement.
+ * @param fins Reçoit la position (0-indexée) de la dernière base de chaque hit.
+ * @param scores Reçoit le score de chaque hit.
+ * @param capacite La taille des tableaux `fins` et `scores`.
+ * @return Le nombre de hits trouvés (éventuellement supérieur à `capacite`), ou -1 en cas d'erreur.
+ */
+int balayer_sw_scalaire(const char *requete, int longueur_requete, const char *cible, int longueur_cible,
+                        int seuil, const ParametresAlignement *p, int *fins, int *scores, int capacite);
+
+/**
+ * @brief Aligne chaque motif (deux brins) sur les séquences d'un génome.
+ * @param motifs Les motifs à aligner.
+ * @param nombre_motifs Le nombre de motifs.
+ * @param sujets Les séquences du génome (chromosome, plasmides...).
+ * @param nombre_sujets Le nombre de séquences.
+ * @param premier_indice_sujet L'indice attribué à la première séquence dans les hits.
+ * @param p Les paramètres d'alignement.
+ * @param nombre_hits Reçoit le nombre de hits.
+ * @return Les hits triés par motif, sujet puis e-value (doit être libéré après utilisation).
+ */
+HitAlignement* aligner_motifs_genome(const SequenceFasta *motifs, int nombre_motifs,
+                                     const SequenceFasta *sujets, int nombre_sujets,
+                                     int premier_indice_sujet, const ParametresAlignement *p, int *nombre_hits);
+
+/**
+ * @brief Aligne les motifs d'un fichier FASTA sur une liste de génomes et écrit les hits au format tabulaire BLAST.
+ * @param chemin_motifs Le fichier FASTA des motifs (par exemple motif_retenu.txt).
+ * @param chemin_liste_genomes Un fichier texte contenant un chemin de génome FASTA par ligne.
+ * @param chemin_sortie Le fichier de sortie (colonnes de BLAST outfmt 7).
+ * @param p Les paramètres d'alignement.
+ * @return Le nombre de hits écrits, ou -1 en cas d'erreur.
+ */
+int aligner_motifs_genomes(const char *chemin_motifs, const char *chemin_liste_genomes,
+                           const char *chemin_sortie, const ParametresAlignement *p);
+
+// Conservation des motifs entre souches
+
+/**
+ * @brief Compte, dans l'index d'une souche construit une fois, les copies de chaque motif (deux brins, motifs
+ * répartis sur le pool de threads), et cherche la meilleure copie de chacun dans les LONGEUR_REGION_ETUIE_MOTIFS
+ * bases en amont de l'orthologue du gène (meilleur alignement du gène sur l'un ou l'autre brin).
+ * @param genome Le génome de la souche.
+ * @param longueur_genome Sa longueur.
+ * @param motifs Les motifs.
+ * @param nombre_motifs Le nombre de motifs.
+ * @param sequence_gene Le gène dont l'orthologue est cherché (NULL : aucun).
+ * @param resultat Reçoit la conservation (à libérer avec liberer_conservation_souche).
+ * @return 0 en cas de succès, -1 en cas d'erreur d'allocation.
+ */
+int conservation_souche(const char *genome, int longueur_genome, const SequenceFasta *motifs, int nombre_motifs,
+                        const char *sequence_gene, ConservationSouche *resultat);
+
+/**
+ * @brief Libère les colonnes d'une conservation.
+ * @param resultat La conservation.
+ */
+void liberer_conservation_souche(ConservationSouche *resultat);
+
+/**
+ * @brief Écrit la matrice souches × motifs : pour chaque génome de la liste (ses enregistrements mis bout à
+ * bout), la position de l'orthologue du gène et, pour chaque motif, ses copies, la présence d'une copie exacte en
+ * amont de l'orthologue et l'identité de la meilleure copie de cette région.
+ * @param chemin_motifs Le fichier FASTA des motifs (par exemple motif_retenu.txt).
+ * @param chemin_liste_genomes Un fichier texte contenant un chemin de génome FASTA par ligne.
+ * @param sequence_gene Le gène dont l'orthologue est cherché dans chaque souche (NULL : aucun).
+ * @param chemin_sortie Le fichier TSV écrit (une ligne par souche).
+ * @return Le nombre de souches écrites, ou -1 en cas d'erreur.
+ */
+int comparer_souches(const char *chemin_motifs, const char *chemin_liste_genomes, const char *sequence_gene,
+                     const char *chemin_sortie);
+
+// Table de comptage des k-mers (codes 2 bits glissants)
+
+/**
+ * @brief Code 2 bits d'un nucléotide (A = 0, C = 1, G = 2, T = 3).
+ * @param nucleotide Le nucléotide.
+ * @return Son code, ou -1 pour un autre caractère.
+ */
+int code_nucleotide(char nucleotide);
+
+/**
+ * @brief Masque des 2k bits de poids faible, appliqué au code glissant après chaque décalage.
+ * @param longueur_kmer La longueur k des k-mers (au plus LONGUEUR_MAX_KMER_CODE).
+ * @return Le masque.
+ */
+uint64_t masque_code_kmer(int longueur_kmer);
+
+/**
+ * @brief Code 2 bits d'un k-mer, première base en poids fort.
+ * @param kmer Le k-mer.
+ * @param longueur_kmer Sa longueur (au plus LONGUEUR_MAX_KMER_CODE).
+ * @param code Reçoit le code.
+ * @return 0 en cas de succès, -1 si le k-mer contient autre chose que A, C, G ou T.
+ */
+int coder_kmer(const char *kmer, int longueur_kmer, uint64_t *code);
+
+/**
+ * @brief Crée une table de k-mers vide.
+ * @param longueur_kmer La longueur des k-mers (1 à LONGUEUR_MAX_KMER_CODE).
+ * @param nombre_max Le nombre maximal de k-mers distincts qui y seront insérés.
+ * @return La table (à libérer avec liberer_table_kmers), ou NULL en cas d'erreur.
+ */
+TableKmers* creer_table_kmers(int longueur_kmer, int nombre_max);
+
+/**
+ * @brief Libère une table de k-mers.
+ * @param table La table à libérer.
+ */
+void liberer_table_kmers(TableKmers *table);
+
+/**
+ * @brief Insère un k-mer (compteur à 0) s'il n'est pas déjà présent.
+ * @param table La table.
+ * @param code Le code du k-mer.
+ * @return 0 en cas de succès, -1 si la table est pleine.
+ */
+int inserer_kmer(TableKmers *table, uint64_t code);
+
+/**
+ * @brief Cherche le compteur d'un k-mer.
+ * @param table La table.
+ * @param code Le code du k-mer.
+ * @return Un pointeur vers son compteur, ou NULL s'il n'a pas été inséré.
+ */
+int32_t* trouver_kmer(const TableKmers *table, uint64_t code);
+
+/**
+ * @brief Compte, en un seul parcours à code glissant, les occurrences dans une séquence des k-mers de la table.
+ * @param table La table, dont les compteurs sont incrémentés.
+ * @param sequence La séquence parcourue.
+ * @param longueur Sa longueur.
+ * @param masque Les positions de début à ignorer (NULL : aucune).
+ */
+void compter_kmers_genome(TableKmers *table, const char *sequence, int longueur, const MasqueExclusion *masque);
+
+/**
+ * @brief Comme compter_kmers_genome, par blocs répartis sur les threads du pool global.
+ * @param table La table, dont les compteurs sont incrémentés.
+ * @param sequence La séquence parcourue.
+ * @param longueur Sa longueur.
+ * @param masque Les positions de début à ignorer (NULL : aucune).
+ */
+void compter_kmers_genome_parallele(TableKmers *table, const char *sequence, int longueur,
+                                    const MasqueExclusion *masque);
+
+// Spectre des k-mers du génome
+
+/**
+ * @brief Compte tous les k-mers d'un génome sur les threads du pool global.
+ *
+ * Les codes sont répartis par blocs du génome dans des partitions selon leurs premières bases, puis chaque
+ * partition est triée et comptée séparément ; le résultat ne dépend pas du nombre de threads.
+ * @param sequence Le génome.
+ * @param longueur Sa longueur.
+ * @param longueur_kmer La longueur k des k-mers (1 à LONGUEUR_MAX_KMER_SPECTRE).
+ * @return Le spectre (à libérer avec liberer_spectre_kmers), ou NULL en cas d'erreur.
+ */
+SpectreKmers* calculer_spectre_kmers(const char *sequence, int longueur, int longueur_kmer);
+
+/**
+ * @brief Libère un spectre de k-mers.
+ * @param spectre Le spectre.
+ */
+void liberer_spectre_kmers(SpectreKmers *spectre);
+
+/**
+ * @brief Nombre d'occurrences d'un k-mer dans le génome (recherche dichotomique).
+ * @param spectre Le spectre.
+ * @param code Le code 2 bits du k-mer.
+ * @return Son nombre d'occurrences (0 s'il est absent).
+ */
+int occurrences_kmer_spectre(const SpectreKmers *spectre, uint64_t code);
+
+/**
+ * @brief Occurrences attendues d'un k-mer sous un modèle de Markov d'ordre m estimé sur le génome :
+ * produit des comptes de ses (m+1)-mers divisé par celui de ses m-mers intérieurs.
+ * @param code Le code 2 bits du k-mer.
+ * @param longueur_kmer Sa longueur (au moins ordre + 2).
+ * @param ordre L'ordre m du modèle.
+ * @param comptes_ordre Les comptes des m-mers du génome, indexés par code (ignorés pour l'ordre 0).
+ * @param comptes_ordre_plus_un Les comptes des (m+1)-mers du génome, indexés par code.
+ * @param nombre_positions Le nombre de bases du génome (utilisé pour l'ordre 0).
+ * @return Le nombre d'occurrences attendues.
+ */
+double occurrences_attendues_kmer(uint64_t code, int longueur_kmer, int ordre, const int64_t *comptes_ordre,
+                                  const int64_t *comptes_ordre_plus_un, int64_t nombre_positions);
+
+/**
+ * @brief Sélectionne les k-mers les plus surreprésentés par rapport au modèle de fond.
+ * @param spectre Le spectre du génome.
+ * @param sequence Le génome (pour estimer le modèle).
+ * @param longueur Sa longueur.
+ * @param ordre L'ordre du modèle de Markov (ramené à k - 2 s'il est plus grand, au plus ORDRE_MAX_MODELE_FOND).
+ * @param nombre_max Le nombre maximal de k-mers retenus.
+ * @param nombre Reçoit le nombre de k-mers retenus.
+ * @return Les k-mers, par score décroissant (à libérer avec free), ou NULL en cas d'erreur.
+ */
+KmerSurrepresente* kmers_surrepresentes(const SpectreKmers *spectre, const char *sequence, int longueur,
+                                        int ordre, int nombre_max, int *nombre);
+
+/**
+ * @brief Écrit le spectre (occurrences, tabulation, nombre de k-mers distincts) dans un fichier.
+ * @param spectre Le spectre.
+ * @param chemin_fichier Le chemin vers le fichier de sortie.
+ * @return 0 en cas de succès, -1 en cas d'erreur.
+ */
+int ecrire_spectre_kmers(const SpectreKmers *spectre, const char *chemin_fichier);
+
+/**
+ * @brief Écrit les k-mers surreprésentés (k-mer, observées, attendues, rapport, score) dans un fichier.
+ * @param kmers Les k-mers.
+ * @param nombre Leur nombre.
+ * @param longueur_kmer Leur longueur.
+ * @param chemin_fichier Le chemin vers le fichier de sortie.
+ * @return 0 en cas de succès, -1 en cas d'erreur.
+ */
+int ecrire_kmers_surrepresentes(const KmerSurrepresente *kmers, int nombre, int longueur_kmer,
+                                const char *chemin_fichier);
+
+// Répétitions maximales
+
+/**
+ * @brief Énumère, en un parcours ascendant des intervalles LCP, les répétitions maximales du génome qui
+ * chevauchent une région.
+ * @param index La table des suffixes du génome.
+ * @param lcp Sa table LCP (calculer_lcp).
+ * @param debut_region Début de la région.
+ * @param fin_region Position suivant sa fin.
+ * @param longueur_min La longueur minimale des répétitions.
+ * @param copies_min Le nombre minimal d'occurrences dans le génome.
+ * @param nombre Reçoit le nombre de répétitions trouvées.
+ * @return Les répétitions (à libérer avec free), ou NULL en cas d'erreur d'allocation.
+ */
+RepetitionMaximale* rechercher_repetitions_maximales(const IndexSuffixes *index, const int32_t *lcp,
+                                                     int debut_region, int fin_region, int longueur_min,
+                                                     int copies_min, int *nombre);
+
+// Stock de motifs en colonnes
+
+/**
+ * @brief Crée un stock de motifs vide.
+ * @param genome Le génome dont les motifs sont des sous-chaînes (NULL : séquences copiées dans une réserve).
+ * @param capacite_initiale Le nombre de motifs prévus (0 : capacité par défaut au premier ajout).
+ * @return Le stock (à libérer avec liberer_stock_motifs), ou NULL en cas d'erreur.
+ */
+StockMotifs* creer_stock_motifs(const char *genome, int capacite_initiale);
+
+/**
+ * @brief Libère un stock de motifs et les répartitions de ses motifs.
+ * @param stock Le stock.
+ */
+void liberer_stock_motifs(StockMotifs *stock);
+
+/**
+ * @brief Agrandit les colonnes d'un stock pour qu'elles puissent contenir `capacite` motifs.
+ * @param stock Le stock.
+ * @param capacite La capacité voulue.
+ * @return 0 en cas de succès, -1 en cas d'erreur d'allocation.
+ */
+int reserver_stock_motifs(StockMotifs *stock, int capacite);
+
+/**
+ * @brief Ajoute un motif (occurrences approchées non calculées, sans répartition).
+ * @param stock Le stock.
+ * @param sequence La séquence du motif, copiée dans la réserve (ignorée si le stock a un génome).
+ * @param position Sa position dans le génome.
+ * @param longueur Sa longueur.
+ * @param fold_change Son fold change.
+ * @param occurrences_reelles Ses occurrences dans le génome réel.
+ * @param occurrences_aleatoires Ses occurrences dans le génome aléatoire.
+ * @return L'indice du motif, ou -1 en cas d'erreur.
+ */
+int ajouter_motif_stock(StockMotifs *stock, const char *sequence, int position, int longueur, double fold_change,
+                        int occurrences_reelles, int occurrences_aleatoires);
+
+/**
+ * @brief Séquence d'un motif du stock (longueurs[i] caractères, non terminée par '\0').
+ * @param stock Le stock.
+ * @param i L'indice du motif.
+ * @return Un pointeur vers la séquence, dans le génome ou la réserve.
+ */
+const char* sequence_motif_stock(const StockMotifs *stock, int i);
+
+/**
+ * @brief Motif du stock sous forme de structure Motif, pour les fonctions qui en prennent une.
+ * @param stock Le stock.
+ * @param i L'indice du motif.
+ * @return Le motif ; sa séquence, non terminée par '\0', appartient au stock et ne doit pas être libérée.
+ */
+Motif vue_motif_stock(const StockMotifs *stock, int i);
+
+/**
+ * @brief Trie les motifs du stock (tri stable : à égalité, l'ordre d'ajout est conservé).
+ * @param stock Le stock.
+ * @param critere Le critère de tri, meilleurs motifs en tête.
+ * @param position_reference La position du gène (pour CRITERE_DISTANCE_GENE).
+ * @return 0 en cas de succès, -1 en cas d'erreur d'allocation.
+ */
+int trier_stock_motifs(StockMotifs *stock, CritereMotifs critere, int position_reference);
+
+/**
+ * @brief Sélectionne les meilleurs motifs selon un critère, en un parcours et sans trier le stock.
+ * @param stock Le stock.
+ * @param critere Le critère.
+ * @param position_reference La position du gène (pour CRITERE_DISTANCE_GENE).
+ * @param nombre_max Le nombre de motifs voulus.
+ * @param indices Reçoit les indices des meilleurs motifs, du meilleur au moins bon (à égalité, le premier ajouté).
+ * @return Le nombre de motifs sélectionnés.
+ */
+int meilleurs_motifs_stock(const StockMotifs *stock, CritereMotifs critere, int position_reference, int nombre_max,
+                           int *indices);
+
+/**
+ * @brief Ne garde, dans l'ordre, que les motifs atteignant les seuils donnés.
+ * @param stock Le stock.
+ * @param fold_change_min Le fold change minimal.
+ * @param longueur_min La longueur minimale.
+ * @param occurrences_min Le nombre minimal d'occurrences réelles.
+ * @return Le nombre de motifs conservés.
+ */
+int filtrer_stock_motifs(StockMotifs *stock, double fold_change_min, int longueur_min, int occurrences_min);
+
+// Serveur de requêtes
+
+/**
+ * @brief Charge un génome dans un serveur de requêtes : construit la table des suffixes et l'index des k-mers.
+ * @param genome La séquence du génome (conservée par le serveur, non copiée).
+ * @param longueur_genome Sa longueur.
+ * @param annotation L'annotation des gènes (NULL : aucune).
+ * @param masque Les positions masquées (NULL : aucun).
+ * @return Le serveur (à libérer avec liberer_serveur_genome), ou NULL en cas d'erreur.
+ */
+ServeurGenome* creer_serveur_genome(const char *genome, int longueur_genome, const AnnotationGenes *annotation,
+                                    const MasqueExclusion *masque);
+
+/**
+ * @brief Libère les index d'un serveur de requêtes (le génome, l'annotation et le masque restent à l'appelant).
+ * @param serveur Le serveur.
+ */
+void liberer_serveur_genome(ServeurGenome *serveur);
+
+/**
+ * @brief Répond à une ligne de requête : COUNT <motif> [mésappariements], POS <motif> [nombre max],
+ * GENE <séquence|nom> [identité], PROMOTEUR <position> [bases amont], STATS, QUIT ou ARRET.
+ * @param serveur Le serveur.
+ * @param ligne La requête, sans fin de ligne.
+ * @param reponse Reçoit la réponse « OK ... » ou « ERR ... » (à libérer, NULL en cas d'erreur d'allocation).
+ * @return La suite à donner.
+ */
+ActionServeur repondre_requete(const ServeurGenome *serveur, const char *ligne, char **reponse);
+
+/**
+ * @brief Ouvre une socket Unix d'écoute (une socket laissée au même chemin est remplacée).
+ * @param chemin_socket Le chemin de la socket.
+ * @return Le descripteur de la socket, ou -1 en cas d'erreur.
+ */
+int ouvrir_socket_serveur(const char *chemin_socket);
+
+/**
+ * @brief Sert les requêtes reçues sur une socket d'écoute jusqu'à une requête ARRET. Les lignes reçues de
+ * tous les clients depuis le dernier réveil forment un lot, réparti sur les threads du pool global ; chaque
+ * réponse est suivie de sa latence. Les sockets des clients sont non bloquantes : les réponses qu'un client ne
+ * lit pas attendent dans un tampon, et il est déconnecté au-delà de TAILLE_MAX_SORTIE_CLIENT octets.
+ * @param serveur Le serveur (ses statistiques sont mises à jour).
+ * @param socket_ecoute La socket ouverte par ouvrir_socket_serveur.
+ * @return 0 à l'arrêt du serveur.
+ */
+int servir_requetes(ServeurGenome *serveur, int socket_ecoute);
+
+// Extraction des occurrences des motifs
+
+/**
+ * @brief Lit l'en-tête du premier enregistrement d'un fichier FASTA (éventuellement compressé).
+ * @param chemin_fichier Le chemin du fichier.
+ * @return L'en-tête sans '>' ni fin de ligne (à libérer), ou NULL si le fichier n'en a pas.
+ */
+char* lire_entete_fasta(const char *chemin_fichier);
+
+/**
+ * @brief Écrit en FASTA le contexte de chaque occurrence des motifs d'un stock, une séquence par ligne, avec
+ * des en-têtes `>identifiant:début-fin description` (brin -, `>identifiant:cfin-début`, coordonnées 1-indexées
+ * comme dans les résultats de BLAST). Les séquences du brin + sont écrites directement depuis le génome, par
+ * écritures vectorisées, sans copie. Avec les deux brins, un motif égal à son complément inverse n'est écrit
+ * qu'une fois par occurrence, sur le brin +.
+ * @param index La table des suffixes du génome dont les motifs sont issus.
+ * @param motifs Les motifs.
+ * @param masque Positions masquées, dont les occurrences sont omises (NULL : aucune).
+ * @param parametres Les flancs, brins et en-têtes.
+ * @param chemin_fichier Le fichier FASTA écrit.
+ * @return Le nombre d'occurrences écrites, ou -1 en cas d'erreur.
+ */
+int64_t ecrire_contextes_occurrences(const IndexSuffixes *index, const StockMotifs *motifs,
+                                     const MasqueExclusion *masque, const ParametresContextes *parametres,
+                                     const char *chemin_fichier);
+
+// Vérification des moteurs rapides
+
+/**
+ * @brief Tire un échantillon de façon reproductible : la décision ne dépend que de la clé.
+ * @param cle La clé de l'élément (par exemple sa position et sa longueur).
+ * @param taux La part des éléments retenus (0 à 1).
+ * @return true si l'élément est retenu.
+ */
+bool echantillon_retenu(uint64_t cle, double taux);
+
+/**
+ * @brief Compare les comptes et positions d'un motif lus dans la table des suffixes avec ceux des parcours de
+ * référence (rechercher_motif_masque, rechercher_motif_approche) ; chaque divergence est affichée.
+ * @param bilan Reçoit les comparaisons et les divergences.
+ * @param index La table des suffixes d'un génome terminé par '\0'.
+ * @param motif Le motif.
+ * @param longueur_motif Sa longueur.
+ * @param start_exclusion Début de la région dont les occurrences sont ignorées.
+ * @param longueur_exclusion Longueur de cette région (0 : aucune exclusion).
+ * @param masque Positions masquées (NULL : aucune).
+ * @param mismatches_max Mésappariements des comptes approchés vérifiés aussi (0 : aucun).
+ * @return Le nombre de divergences relevées, ou -1 en cas d'erreur d'allocation.
+ */
+int verifier_comptage_motif(BilanVerification *bilan, const IndexSuffixes *index, const char *motif,
+                            int longueur_motif, int start_exclusion, int longueur_exclusion,
+                            const MasqueExclusion *masque, int mismatches_max);
+
+/**
+ * @brief Vérifie les moteurs rapides (comptes et positions dans la table des suffixes, extension des motifs,
+ * répétitions maximales, comptage des k-mers) sur des génomes aléatoires et adverses : homopolymères,
+ * répétitions en tandem, copies plantées aux bords du génome, masques et exclusions touchant ces bords.
+ * @param graine La graine des génomes et des requêtes.
+ * @param nombre_genomes Le nombre de génomes générés.
+ * @param bilan Reçoit les comparaisons et les divergences.
+ * @return 0 si tous les moteurs s'accordent avec les références, 1 sinon, -1 en cas d'erreur d'allocation.
+ */
+int verifier_moteurs(uint64_t graine, int nombre_genomes, BilanVerification *bilan);
+
+// Cache des résultats intermédiaires
+
+/**
+ * @brief Prolonge une empreinte FNV-1a de 64 bits avec des données.
+ * @param donnees Les données.
+ * @param taille Leur taille en octets.
+ * @param empreinte L'empreinte des données précédentes (EMPREINTE_INITIALE au départ).
+ * @return La nouvelle empreinte.
+ */
+uint64_t empreinte_donnees(const void *donnees, size_t taille, uint64_t empreinte);
+
+/**
+ * @brief Prolonge une empreinte avec un entier (paramètre d'une étape).
+ * @param valeur L'entier.
+ * @param empreinte L'empreinte précédente.
+ * @return La nouvelle empreinte.
+ */
+uint64_t empreinte_entier(int64_t valeur, uint64_t empreinte);
+
+/**
+ * @brief Graine du génome aléatoire tirée du contenu du génome réel (avec le cache, sans graine fixée) : les
+ * exécutions sur les mêmes données génèrent le même génome aléatoire, et les candidats sont relus du cache.
+ * @param sequence_genome Le génome réel.
+ * @param longueur_genome Sa longueur.
+ * @return La graine.
+ */
+uint64_t graine_depuis_genome(const char *sequence_genome, int longueur_genome);
+
+/**
+ * @brief Lit une entrée du cache (fichier `<dossier>/<etape>_<clé>.bin`).
+ * @param dossier Le dossier du cache.
+ * @param etape Le nom de l'étape.
+ * @param cle L'empreinte des entrées de l'étape.
+ * @param donnees Reçoit le contenu de l'entrée (à libérer avec free).
+ * @param taille Reçoit sa taille.
+ * @return 0 si l'entrée existe et est intacte, -1 sinon.
+ */
+int lire_cache(const char *dossier, const char *etape, uint64_t cle, void **donnees, size_t *taille);
+
+/**
+ * @brief Écrit une entrée du cache (le dossier est créé au besoin, l'entrée remplacée d'un seul coup).
+ * @param dossier Le dossier du cache.
+ * @param etape Le nom de l'étape.
+ * @param cle L'empreinte des entrées de l'étape.
+ * @param donnees Le contenu.
+ * @param taille Sa taille.
+ * @return 0 en cas de succès, -1 en cas d'erreur.
+ */
+int ecrire_cache(const char *dossier, const char *etape, uint64_t cle, const void *donnees, size_t taille);
+
+/**
+ * @brief Comme rechercher_gene_index, la position et le brin étant lus dans le cache si le génome, le gène et
+ * l'identité minimale n'ont pas changé (l'index des k-mers n'est alors pas construit).
+ * @param dossier_cache Le dossier du cache (NULL : aucun cache).
+ * @param sequence_genome La séquence génomique complète.
+ * @param sequence_gene La séquence du gène.
+ * @param identite_min L'identité minimale.
+ * @param brin Reçoit le brin du gène ('+', '-' ou '.') ; peut être NULL.
+ * @return La position 1-indexée du gène, ou -1 si non trouvé ou trouvé plusieurs fois.
+ */
+int rechercher_gene_cache(const char *dossier_cache, const char *sequence_genome, const char *sequence_gene,
+                          double identite_min, char *brin);
+
+/**
+ * @brief Ajoute à un stock les motifs candidats d'une entrée du cache (fold change recalculé).
+ * @param dossier_cache Le dossier du cache.
+ * @param cle L'empreinte des entrées de la découverte.
+ * @param stock Le stock, dont les séquences sont lues dans le génome.
+ * @return Le nombre de motifs ajoutés, ou -1 si l'entrée est absente ou illisible.
+ */
+int lire_motifs_cache(const char *dossier_cache, uint64_t cle, StockMotifs *stock);
+
+/**
+ * @brief Enregistre dans le cache les positions, longueurs et comptes des motifs d'un stock.
+ * @param dossier_cache Le dossier du cache.
+ * @param cle L'empreinte des entrées de la découverte.
+ * @param stock Le stock.
+ * @return 0 en cas de succès, -1 en cas d'erreur.
+ */
+int ecrire_motifs_cache(const char *dossier_cache, uint64_t cle, const StockMotifs *stock);
+
+// Pool de threads et boucles parallèles
+
+/**
+ * @brief Crée un pool de threads permanent.
+ * @param nombre_threads Le nombre de threads de calcul, dont celui qui lance les boucles (1 : aucun thread lancé).
+ * @return Le pool (à détruire avec detruire_pool_threads), ou NULL en cas d'erreur.
+ */
+PoolThreads* creer_pool_threads(int nombre_threads);
+
+/**
+ * @brief Arrête les threads du pool et le libère.
+ * @param pool Le pool.
+ */
+void detruire_pool_threads(PoolThreads *pool);
+
+/**
+ * @brief Nombre de threads de calcul d'un pool.
+ * @param pool Le pool (NULL : exécution séquentielle).
+ * @return Le nombre de threads.
+ */
+int nombre_threads_pool(const PoolThreads *pool);
+
+/**
+ * @brief Nombre de blocs d'une boucle parallèle, pour dimensionner les résultats par bloc.
+ * @param debut Première position.
+ * @param fin Position suivant la dernière.
+ * @param taille_bloc Nombre de positions par bloc.
+ * @return Le nombre de blocs.
+ */
+int64_t nombre_blocs_parallele(int64_t debut, int64_t fin, int64_t taille_bloc);
+
+/**
+ * @brief Découpe [debut, fin) en blocs de `taille_bloc` positions, traités par les threads du pool.
+ *
+ * Le découpage ne dépend pas du nombre de threads : chaque bloc range ses résultats à son indice, et leur
+ * fusion dans l'ordre des blocs donne le même résultat quel que soit ce nombre. Appelée depuis un bloc,
+ * la boucle s'exécute dans le thread courant.
+ * @param pool Le pool (NULL : exécution séquentielle dans le thread courant).
+ * @param debut Première position.
+ * @param fin Position suivant la dernière.
+ * @param taille_bloc Nombre de positions par bloc.
+ * @param chevauchement Nombre de positions lisibles au-delà de la fin de chaque bloc (longueur du motif - 1).
+ * @param fonction Le traitement d'un bloc.
+ * @param contexte Les données partagées, passées à chaque bloc.
+ */
+void pool_parallel_for(PoolThreads *pool, int64_t debut, int64_t fin, int64_t taille_bloc, int64_t chevauchement,
+                       FonctionBloc fonction, void *contexte);
+
+/**
+ * @brief Choisit le pool utilisé par toutes les étapes du programme.
+ * @param pool Le pool (NULL : exécution séquentielle).
+ */
+void definir_pool_global(PoolThreads *pool);
+
+/**
+ * @brief Pool utilisé par toutes les étapes du programme.
+ * @return Le pool choisi par definir_pool_global, ou NULL.
+ */
+PoolThreads* pool_global(void);
+
+/**
+ * @brief Nombre de cœurs disponibles.
+ * @return Le nombre de cœurs (au moins 1).
+ */
+int nombre_coeurs_disponibles(void);
+
+// Graphe de tâches (étapes du programme principal)
+
+/**
+ * @brief Crée un graphe de tâches vide.
+ * @return Le graphe (à libérer avec liberer_graphe_taches), ou NULL en cas d'erreur.
+ */
+GrapheTaches* creer_graphe_taches(void);
+
+/**
+ * @brief Libère un graphe de tâches (les contextes des étapes restent à la charge de l'appelant).
+ * @param graphe Le graphe.
+ */
+void liberer_graphe_taches(GrapheTaches *graphe);
+
+/**
+ * @brief Ajoute une étape au graphe.
+ * @param graphe Le graphe.
+ * @param nom Le nom de l'étape, repris par afficher_bilan_taches (non copié).
+ * @param fonction Le traitement de l'étape.
+ * @param contexte Les données passées à ce traitement.
+ * @return L'identifiant de l'étape, ou -1 en cas d'erreur.
+ */
+int ajouter_tache(GrapheTaches *graphe, const char *nom, FonctionTache fonction, void *contexte);
+
+/**
+ * @brief Déclare qu'une étape ne peut commencer qu'après la réussite d'une autre.
+ * @param graphe Le graphe.
+ * @param tache L'étape qui attend.
+ * @param prerequis L'étape attendue.
+ * @return 0 en cas de succès, -1 si un identifiant est invalide ou en cas d'erreur.
+ */
+int ajouter_dependance(GrapheTaches *graphe, int tache, int prerequis);
+
+/**
+ * @brief Exécute les étapes dès que leurs prérequis ont réussi, jusqu'à `nombre_threads` à la fois.
+ *
+ * Parmi les étapes prêtes, celle de plus petit identifiant passe en premier : avec un seul thread, l'ordre
+ * d'exécution est celui des ajouts compatible avec les dépendances. L'échec d'une étape annule les étapes
+ * qui en dépendent, les autres se poursuivent.
+ * @param graphe Le graphe.
+ * @param nombre_threads Le nombre d'étapes exécutées en même temps (thread appelant compris).
+ * @return 0 si toutes les étapes ont réussi, -1 sinon (étape échouée ou annulée, dépendances cycliques).
+ */
+int executer_graphe_taches(GrapheTaches *graphe, int nombre_threads);
+
+/**
+ * @brief État d'une étape après executer_graphe_taches.
+ * @param graphe Le graphe.
+ * @param tache L'identifiant de l'étape.
+ * @return L'état de l'étape.
+ */
+EtatTache etat_tache(const GrapheTaches *graphe, int tache);
+
+/**
+ * @brief Durée d'exécution d'une étape.
+ * @param graphe Le graphe.
+ * @param tache L'identifiant de l'étape.
+ * @return La durée en secondes (0 pour une étape non exécutée).
+ */
+double duree_tache(const GrapheTaches *graphe, int tache);
+
+/**
+ * @brief Durée de la plus longue chaîne d'étapes dépendantes, borne inférieure du temps d'exécution du graphe.
+ * @param graphe Le graphe exécuté.
+ * @return La somme des durées des étapes de cette chaîne, en secondes.
+ */
+double duree_chemin_critique(const GrapheTaches *graphe);
+
+/**
+ * @brief Affiche la durée totale, la plus longue chaîne et le début et la fin de chaque étape.
+ * @param graphe Le graphe exécuté.
+ */
+void afficher_bilan_taches(const GrapheTaches *graphe);
+
+// Progression des traitements
+
+/**
+ * @brief Ouvre un compteur de progression, visible par le rapporteur et par lire_progression.
+ * @param nom Le nom du traitement (copié, tronqué à LONGUEUR_NOM_PROGRESSION - 1 caractères).
+ * @param total Le nombre d'unités à traiter.
+ * @return Le compteur (à fermer avec fermer_compteur_progression), ou NULL si COMPTEURS_PROGRESSION_MAX
+ * compteurs sont déjà ouverts ; les autres fonctions acceptent NULL.
+ */
+CompteurProgression* ouvrir_compteur_progression(const char *nom, int64_t total);
+
+/**
+ * @brief Ajoute des unités traitées à un compteur (addition atomique, appelable depuis n'importe quel thread).
+ * @param compteur Le compteur (NULL : rien).
+ * @param increment Le nombre d'unités.
+ */
+void avancer_progression(CompteurProgression *compteur, int64_t increment);
+
+/**
+ * @brief Ferme un compteur ; sa barre, si elle est affichée, est terminée par un retour à la ligne.
+ * @param compteur Le compteur (NULL : rien).
+ */
+void fermer_compteur_progression(CompteurProgression *compteur);
+
+/**
+ * @brief Relève les compteurs ouverts, sans attendre le rapporteur.
+ * @param etats Reçoit les relevés.
+ * @param nombre_max Le nombre de places de `etats`.
+ * @return Le nombre de compteurs relevés.
+ */
+int lire_progression(EtatProgression *etats, int nombre_max);
+
+/**
+ * @brief Met des relevés en forme sur une ligne, comme le rapporteur.
+ * @param etats Les relevés.
+ * @param nombre Leur nombre.
+ * @param mode PROGRESSION_BARRE pour des barres, sinon les comptes et les durées.
+ * @param destination Reçoit la ligne (tronquée à `taille` - 1 caractères).
+ * @param taille La taille de `destination`.
+ * @return Le nombre de caractères écrits.
+ */
+int formater_progression(const EtatProgression *etats, int nombre, ModeProgression mode, char *destination,
+                         size_t taille);
+
+/**
+ * @brief Lance le thread qui affiche les compteurs ouverts à intervalle fixe (sans effet s'il est déjà lancé).
+ * @param mode Le mode d'affichage (PROGRESSION_AUCUNE : aucun thread lancé).
+ * @return 0 en cas de succès, -1 si le thread n'a pas pu être créé.
+ */
+int demarrer_rapporteur_progression(ModeProgression mode);
+
+/**
+ * @brief Arrête le rapporteur et termine sa dernière ligne.
+ */
+void arreter_rapporteur_progression(void);
+
+/**
+ * @brief Convertit un nom de mode (barre, lignes, aucune).
+ * @param nom Le nom.
+ * @param mode Reçoit le mode.
+ * @return 0 en cas de succès, -1 si le nom est inconnu.
+ */
+int mode_progression_depuis_nom(const char *nom, ModeProgression *mode);
+
+// Tests des fonctions :
+
+// Tests de séquences consensus
+
+/**
+ * @brief Teste la détection de boîtes consensus avec une distance de 15 nucléotides entre les boîtes -35 et -10.
+ */
+void test_seq_consensus_distance_15();
+
+/**
+ * @brief Teste la détection de boîtes consensus avec une distance de 19 nucléotides entre les boîtes -35 et -10.
+ */
+void test_seq_consensus_distance_19();
+
+/**
+ * @brief Teste la détection de boîtes consensus chevauchantes avec des distances variables.
+ */
+void test_seq_consensus_chevauchante();
+
+/**
+ * @brief Teste la robustesse de la détection de boîtes consensus dans des séquences riches en boîtes -35 et -10.
+ */
+void test_seq_consensus_critique_seq();
+
+/**
+ * @brief Teste la recherche de boîtes consensus en amont avec une limitation du nombre de bases à analyser.
+ */
+void test_rechercher_seq_consensus_en_amont();
+
+/**
+ * @brief Teste la recherche de boîtes consensus avec un gène chevauchant la fin de la boîte -10.
+ */
+void test_rechercher_seq_consensus_en_amont_critique();
+
+// Tests de recherche de gène
+
+/**
+ * @brief Teste la détection d'un gène présent avec une identité parfaite.
+ * @return 0 si le test est réussi.
+ */
+int test_presence_gene();
+
+/**
+ * @brief Teste la détection d'un gène présent plusieurs fois dans le génome.
  * @return 0 si le test est réussi.
  */
 int test_presence_multiple_gene();
@@ -235,6 +2224,11 @@ int test_abscence_gene();
  */
 int test_abscence_gene_critique();
 
+/**
+ * @brief Teste la recherche avec gaps d'un gène portant une délétion, absent ou présent plusieurs fois.
+ */
+void test_recherche_gene_gappee();
+
 // Tests d'analyse de motifs
 
 /**
@@ -252,4 +2246,166 @@ void test_calculer_fold_change();
  */
 void test_etendre_et_traiter_k_uplets();
 
+// Tests de l'analyse en flux
+
+/**
+ * @brief Teste l'analyse en flux avec de petites fenêtres : mêmes résultats qu'en mémoire, sans double comptage.
+ */
+void test_analyse_flux();
+
+// Tests de l'index des suffixes
+
+/**
+ * @brief Teste la table des suffixes (comptes identiques à rechercher_motif_rapide), les positions et la répartition.
+ */
+void test_index_suffixes();
+
+/**
+ * @brief Teste le comptage avec mésappariements par l'index (mêmes résultats que le parcours du génome).
+ */
+void test_occurrences_approchees();
+
+// Tests des masques d'exclusion
+
+/**
+ * @brief Teste la fusion des intervalles, la lecture BED et le respect du masque par les comptages.
+ */
+void test_masque_exclusion();
+
+/**
+ * @brief Teste le filtre de faible complexité et le masquage des k-mers fréquents.
+ */
+void test_masquage_graines();
+
+// Tests de la table des k-mers
+
+/**
+ * @brief Teste les codes glissants et le comptage des k-mers (mêmes comptes que l'index des suffixes).
+ */
+void test_table_kmers();
+
+// Tests du pool de threads
+
+/**
+ * @brief Teste les boucles parallèles et les variantes parallèles des parcours (mêmes résultats qu'en séquentiel).
+ */
+void test_pool_threads();
+
+// Tests des répétitions maximales
+
+/**
+ * @brief Teste la table LCP et l'énumération des répétitions maximales (comparées à une recherche exhaustive).
+ */
+void test_repetitions_maximales();
+
+// Tests du serveur de requêtes
+
+/**
+ * @brief Teste les réponses du serveur de requêtes, puis un échange complet sur une socket Unix.
+ */
+void test_serveur_requetes();
+
+// Tests du cache des résultats
+
+/**
+ * @brief Teste le cache des résultats (empreintes, entrées altérées, motifs candidats, position du gène).
+ */
+void test_cache_resultats();
+
+// Tests de l'extraction des occurrences
+
+/**
+ * @brief Teste l'écriture des contextes des occurrences (en-têtes, deux brins, flancs tronqués, masque).
+ */
+void test_contextes_occurrences();
+
+// Tests de la vérification des moteurs
+
+/**
+ * @brief Teste la vérification des moteurs rapides (quelques génomes ; make test en vérifie davantage).
+ */
+void test_verification_moteurs();
+
+// Tests de la conservation entre souches
+
+/**
+ * @brief Teste la conservation des motifs entre souches (orthologue sur chaque brin ou absent, copies approchées).
+ */
+void test_conservation_souches();
+
+// Tests du graphe de tâches
+
+/**
+ * @brief Teste le graphe de tâches (ordre des dépendances, étapes simultanées, annulation, cycle refusé).
+ */
+void test_graphe_taches();
+
+// Tests de la progression
+
+/**
+ * @brief Teste les compteurs de progression (avance depuis plusieurs threads, relevés, mise en forme, rapporteur).
+ */
+void test_progression();
+
+// Tests du pré-filtre des boîtes consensus
+
+/**
+ * @brief Teste le pré-filtre des boîtes consensus (chaque implémentation comparée au parcours de référence).
+ */
+void test_filtre_consensus();
+
+// Tests de la bibliothèque
+
+/**
+ * @brief Teste la bibliothèque libprojet (génome chargé une fois, requêtes concurrentes).
+ */
+void test_libprojet();
+
+// Tests du stock de motifs
+
+/**
+ * @brief Teste le stock de motifs en colonnes (ajout, tri stable, meilleurs motifs, filtrage).
+ */
+void test_stock_motifs();
+
+// Tests du spectre des k-mers
+
+/**
+ * @brief Teste le spectre des k-mers (comptes, partitions, déterminisme) et le modèle de fond.
+ */
+void test_spectre_kmers();
+
+// Tests de l'écriture des résultats
+
+/**
+ * @brief Teste l'écriture tamponnée des motifs en TSV, JSON-lines et binaire (relecture comprise).
+ */
+void test_ecriture_resultats();
+
+// Tests de lecture des fichiers compressés
+
+/**
+ * @brief Teste la lecture des fichiers gzip (multi-membres) et BGZF, et la détection d'un fichier tronqué.
+ */
+void test_lecture_compressee();
+
+// Tests de lecture des résultats BLAST
+
+/**
+ * @brief Teste le chargement en colonnes et les agrégations d'un petit fichier BLAST tabulaire.
+ */
+void test_table_blast();
+
+// Tests de l'alignement local
+
+/**
+ * @brief Teste l'alignement local d'un motif (copie exacte, brin -, délétion) en mode exhaustif et par graines.
+ */
+void test_alignement_local();
+
+/**
+ * @brief Lance tous les tests des fonctions (option --tests, make test) ; un test qui échoue interrompt le programme.
+ */
+void executer_tests_projet(void);
+
 #endif // PROJET_H
@@ -0,0 +1,861 @@
+// alignement_local.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "projet.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Paramètres statistiques de Karlin-Altschul pour le barème blastn (+2/-3, gaps 5/2)
+#define LAMBDA_BLASTN 0.625
+#define K_BLASTN 0.41
+
+#define SCORE_INFINI_NEGATIF -30000  ///< Valeur "moins l'infini" des scores 16 bits
+#define MARGE_FENETRE_GRAINE 16      ///< Marge (en plus de la longueur du motif) autour d'une graine
+
+// Codage des nucléotides : A=0, C=1, G=2, T=3, autre=4
+static int coder_nucleotide(char nucleotide) {
+    switch (nucleotide) {
+        case 'A': return 0;
+        case 'C': return 1;
+        case 'G': return 2;
+        case 'T': return 3;
+        default: return 4;
+    }
+}
+
+static char complementer_nucleotide(char nucleotide) {
+    switch (nucleotide) {
+        case 'A': return 'T';
+        case 'C': return 'G';
+        case 'G': return 'C';
+        case 'T': return 'A';
+        default: return 'N';
+    }
+}
+
+ParametresAlignement parametres_alignement_defaut(void) {
+    ParametresAlignement parametres = {2, 3, 5, 2, 10.0, 11};
+    return parametres;
+}
+
+static int score_paire(const ParametresAlignement *p, int code_a, int code_b) {
+    return (code_a == code_b && code_a < 4) ? p->score_match : -p->penalite_mismatch;
+}
+
+double calculer_evalue_alignement(int score, int longueur_requete, int64_t longueur_base) {
+    return K_BLASTN * (double)longueur_requete * (double)longueur_base * exp(-LAMBDA_BLASTN * score);
+}
+
+double calculer_score_bits(int score) {
+    return (LAMBDA_BLASTN * score - log(K_BLASTN)) / log(2.0);
+}
+
+// Plus petit score brut dont l'e-value reste inférieure au seuil demandé
+static int score_minimal(const ParametresAlignement *p, int longueur_requete, int64_t longueur_base) {
+    double s = (log(K_BLASTN * (double)longueur_requete * (double)longueur_base) - log(p->evalue_max)) / LAMBDA_BLASTN;
+    int seuil = (int)ceil(s);
+    return seuil < 1 ? 1 : seuil;
+}
+
+// ==================== Détection des pics de score ====================
+
+typedef struct {
+    int fin;       ///< Position (dans la cible) de la dernière base alignée
+    int score;     ///< Score du meilleur alignement local se terminant en `fin`
+} PicScore;
+
+typedef struct {
+    PicScore *pics;
+    int nombre;
+    int capacite;
+    int en_cours;          ///< Une série de colonnes au-dessus du seuil est en cours
+    PicScore meilleur;     ///< Meilleure colonne de la série en cours
+} DetecteurPics;
+
+static int detecteur_emettre(DetecteurPics *d) {
+    if (d->nombre == d->capacite) {
+        int capacite = d->capacite == 0 ? 16 : d->capacite * 2;
+        PicScore *p = realloc(d->pics, capacite * sizeof(PicScore));
+        if (p == NULL) return -1;
+        d->pics = p;
+        d->capacite = capacite;
+    }
+    d->pics[d->nombre++] = d->meilleur;
+    d->en_cours = 0;
+    return 0;
+}
+
+// Une série de colonnes consécutives au-dessus du seuil correspond à un seul hit : on garde son maximum
+static int detecteur_colonne(DetecteurPics *d, int colonne, int score_colonne, int seuil) {
+    if (score_colonne >= seuil) {
+        if (!d->en_cours || score_colonne > d->meilleur.score) {
+            d->meilleur.fin = colonne;
+            d->meilleur.score = score_colonne;
+        }
+        d->en_cours = 1;
+    } else if (d->en_cours) {
+        return detecteur_emettre(d);
+    }
+    return 0;
+}
+
+static int detecteur_terminer(DetecteurPics *d) {
+    return d->en_cours ? detecteur_emettre(d) : 0;
+}
+
+// ==================== Smith-Waterman vectorisé (Farrar) ====================
+
+/**
+ * Profil de la requête au format "strié" : la position i de la requête est placée dans le segment
+ * i % segments, voie i / segments. Un vecteur de 8 scores 16 bits par segment et par nucléotide.
+ */
+typedef struct {
+    int longueur;
+    int segments;
+    int16_t *profil;     ///< 5 * segments * 8 scores
+    const char *requete;
+} ProfilRequete;
+
+#define VOIES_16 8
+
+static int construire_profil(ProfilRequete *profil, const char *requete, int longueur, const ParametresAlignement *p) {
+    profil->longueur = longueur;
+    profil->segments = (longueur + VOIES_16 - 1) / VOIES_16;
+    profil->requete = requete;
+    profil->profil = NULL;
+    // Motif vide : aucun segment, balayer_sw n'aligne rien (score 0)
+    if (longueur == 0) return 0;
+    size_t taille = (size_t)5 * profil->segments * VOIES_16 * sizeof(int16_t);
+    profil->profil = aligned_alloc(16, taille);
+    if (profil->profil == NULL) return -1;
+
+    for (int c = 0; c < 5; c++) {
+        int16_t *ligne = profil->profil + (size_t)c * profil->segments * VOIES_16;
+        for (int s = 0; s < profil->segments; s++) {
+            for (int v = 0; v < VOIES_16; v++) {
+                int i = v * profil->segments + s;
+                // Les positions de remplissage au-delà de la requête ne doivent jamais contribuer
+                ligne[s * VOIES_16 + v] = (int16_t)(i < longueur ? score_paire(p, coder_nucleotide(requete[i]), c)
+                                                                : SCORE_INFINI_NEGATIF);
+            }
+        }
+    }
+    return 0;
+}
+
+static void liberer_profil(ProfilRequete *profil) {
+    free(profil->profil);
+    profil->profil = NULL;
+}
+
+#ifdef __SSE2__
+static int balayer_sw_strie(const ProfilRequete *profil, const char *cible, int longueur_cible,
+                            int seuil, const ParametresAlignement *p, DetecteurPics *detecteur) {
+    int segments = profil->segments;
+    __m128i *tampon = aligned_alloc(16, (size_t)3 * segments * sizeof(__m128i));
+    if (tampon == NULL) return -1;
+    __m128i *pvHStore = tampon;
+    __m128i *pvHLoad = tampon + segments;
+    __m128i *pvE = tampon + 2 * segments;
+
+    const __m128i vZero = _mm_setzero_si128();
+    const __m128i vGapO = _mm_set1_epi16((int16_t)(p->ouverture_gap + p->extension_gap));
+    const __m128i vGapE = _mm_set1_epi16((int16_t)p->extension_gap);
+    const __m128i vSeuil = _mm_set1_epi16((int16_t)(seuil - 1));
+    const __m128i vInfiniVoie0 = _mm_set_epi16(0, 0, 0, 0, 0, 0, 0, SCORE_INFINI_NEGATIF);
+    const __m128i *vProfil = (const __m128i*)profil->profil;
+
+    for (int i = 0; i < segments; i++) {
+        pvHStore[i] = vZero;
+        pvHLoad[i] = vZero;
+        pvE[i] = vZero;
+    }
+
+    for (int j = 0; j < longueur_cible; j++) {
+        const __m128i *vP = vProfil + coder_nucleotide(cible[j]) * segments;
+        __m128i vF = _mm_set1_epi16(SCORE_INFINI_NEGATIF);
+        __m128i vMaxCol = vZero;
+
+        // H diagonal pour le segment 0 : colonne précédente décalée d'une voie
+        __m128i vH = _mm_slli_si128(pvHStore[segments - 1], 2);
+        __m128i *echange = pvHLoad;
+        pvHLoad = pvHStore;
+        pvHStore = echange;
+
+        for (int i = 0; i < segments; i++) {
+            vH = _mm_adds_epi16(vH, vP[i]);
+            __m128i vE = pvE[i];
+            vH = _mm_max_epi16(vH, vE);
+            vH = _mm_max_epi16(vH, vF);
+            vH = _mm_max_epi16(vH, vZero);
+            vMaxCol = _mm_max_epi16(vMaxCol, vH);
+            pvHStore[i] = vH;
+
+            vH = _mm_subs_epi16(vH, vGapO);
+            vE = _mm_subs_epi16(vE, vGapE);
+            pvE[i] = _mm_max_epi16(vE, vH);
+            vF = _mm_subs_epi16(vF, vGapE);
+            vF = _mm_max_epi16(vF, vH);
+
+            vH = pvHLoad[i];
+        }
+
+        // Boucle "lazy F" : propage les gaps verticaux qui traversent les frontières de segments
+        for (int passe = 0; passe < VOIES_16; passe++) {
+            vF = _mm_or_si128(_mm_slli_si128(vF, 2), vInfiniVoie0);
+            int i;
+            for (i = 0; i < segments; i++) {
+                vH = pvHStore[i];
+                // Plus rien à propager si F ne dépasse H - ouverture dans aucune voie
+                if (!_mm_movemask_epi8(_mm_cmpgt_epi16(vF, _mm_subs_epi16(vH, vGapO)))) {
+                    break;
+                }
+                vH = _mm_max_epi16(vH, vF);
+                pvHStore[i] = vH;
+                vMaxCol = _mm_max_epi16(vMaxCol, vH);
+                vH = _mm_subs_epi16(vH, vGapO);
+                pvE[i] = _mm_max_epi16(pvE[i], vH);
+                vF = _mm_subs_epi16(vF, vGapE);
+            }
+            if (i < segments) break;
+        }
+
+        // Le maximum horizontal n'est calculé que si une voie atteint le seuil
+        int score_colonne = 0;
+        if (_mm_movemask_epi8(_mm_cmpgt_epi16(vMaxCol, vSeuil))) {
+            __m128i v = _mm_max_epi16(vMaxCol, _mm_srli_si128(vMaxCol, 8));
+            v = _mm_max_epi16(v, _mm_srli_si128(v, 4));
+            v = _mm_max_epi16(v, _mm_srli_si128(v, 2));
+            score_colonne = (int16_t)_mm_extract_epi16(v, 0);
+        }
+        if (detecteur_colonne(detecteur, j, score_colonne, seuil) != 0) {
+            free(tampon);
+            return -1;
+        }
+    }
+
+    free(tampon);
+    return detecteur_terminer(detecteur);
+}
+#endif
+
+// Version scalaire (Gotoh, une colonne à la fois) : repli sans SSE2 et référence pour la vérification
+int balayer_sw_scalaire(const char *requete, int longueur_requete, const char *cible, int longueur_cible,
+                        int seuil, const ParametresAlignement *p, int *fins, int *scores, int capacite) {
+    // Requête vide : aucune colonne ne dépasse le score 0
+    if (longueur_requete <= 0) return 0;
+    int *H = malloc(longueur_requete * sizeof(int));
+    int *E = malloc(longueur_requete * sizeof(int));
+    if (H == NULL || E == NULL) {
+        free(H);
+        free(E);
+        return -1;
+    }
+    for (int i = 0; i < longueur_requete; i++) {
+        H[i] = 0;
+        E[i] = SCORE_INFINI_NEGATIF;
+    }
+
+    int ouverture = p->ouverture_gap + p->extension_gap;
+    DetecteurPics detecteur = {0};
+
+    for (int j = 0; j < longueur_cible; j++) {
+        int code_cible = coder_nucleotide(cible[j]);
+        int h_diagonale = 0;
+        int f = SCORE_INFINI_NEGATIF;
+        int score_colonne = 0;
+        for (int i = 0; i < longueur_requete; i++) {
+            int e = E[i] - p->extension_gap;
+            if (H[i] - ouverture > e) e = H[i] - ouverture;
+            E[i] = e;
+
+            int h = h_diagonale + score_paire(p, coder_nucleotide(requete[i]), code_cible);
+            h_diagonale = H[i];
+            if (e > h) h = e;
+            if (f > h) h = f;
+            if (h < 0) h = 0;
+            H[i] = h;
+
+            f -= p->extension_gap;
+            if (h - ouverture > f) f = h - ouverture;
+            if (h > score_colonne) score_colonne = h;
+        }
+        if (detecteur_colonne(&detecteur, j, score_colonne, seuil) != 0) break;
+    }
+    detecteur_terminer(&detecteur);
+
+    int nombre = detecteur.nombre;
+    for (int k = 0; k < nombre && k < capacite; k++) {
+        fins[k] = detecteur.pics[k].fin;
+        scores[k] = detecteur.pics[k].score;
+    }
+    free(detecteur.pics);
+    free(H);
+    free(E);
+    return nombre;
+}
+
+static int balayer_sw(const ProfilRequete *profil, const char *cible, int longueur_cible,
+                      int seuil, const ParametresAlignement *p, DetecteurPics *detecteur) {
+    // Motif vide : score 0 partout, aucun pic (et pvHStore[segments - 1] n'existerait pas)
+    if (profil->segments == 0) return 0;
+#ifdef __SSE2__
+    return balayer_sw_strie(profil, cible, longueur_cible, seuil, p, detecteur);
+#else
+    int capacite = longueur_cible > 0 ? longueur_cible : 1;
+    int *fins = malloc(capacite * sizeof(int));
+    int *scores = malloc(capacite * sizeof(int));
+    if (fins == NULL || scores == NULL) {
+        free(fins);
+        free(scores);
+        return -1;
+    }
+    int nombre = balayer_sw_scalaire(profil->requete, profil->longueur, cible, longueur_cible, seuil, p,
+                                     fins, scores, capacite);
+    for (int k = 0; k < nombre; k++) {
+        detecteur->meilleur.fin = fins[k];
+        detecteur->meilleur.score = scores[k];
+        detecteur_emettre(detecteur);
+    }
+    free(fins);
+    free(scores);
+    return nombre < 0 ? -1 : 0;
+#endif
+}
+
+// ==================== Retour sur trace ====================
+
+/**
+ * Aligne la requête sur une petite fenêtre de la cible se terminant en `fin` (Gotoh complet) et
+ * remplit les statistiques du hit (identité, longueur, mésappariements, gaps, bornes).
+ */
+static int retracer_alignement(const char *requete, int longueur_requete, const char *cible, int debut_fenetre,
+                               int fin, const ParametresAlignement *p, HitAlignement *hit) {
+    int m = longueur_requete;
+    int n = fin - debut_fenetre + 1;
+    int largeur = n + 1;
+    int *H = malloc((size_t)(m + 1) * largeur * sizeof(int));
+    int *E = malloc((size_t)(m + 1) * largeur * sizeof(int));
+    int *F = malloc((size_t)(m + 1) * largeur * sizeof(int));
+    if (H == NULL || E == NULL || F == NULL) {
+        free(H); free(E); free(F);
+        return -1;
+    }
+
+    int ouverture = p->ouverture_gap + p->extension_gap;
+    for (int j = 0; j <= n; j++) {
+        H[j] = 0;
+        E[j] = SCORE_INFINI_NEGATIF;
+        F[j] = SCORE_INFINI_NEGATIF;
+    }
+    for (int i = 1; i <= m; i++) {
+        H[i * largeur] = 0;
+        E[i * largeur] = SCORE_INFINI_NEGATIF;
+        F[i * largeur] = SCORE_INFINI_NEGATIF;
+        int code_requete = coder_nucleotide(requete[i - 1]);
+        for (int j = 1; j <= n; j++) {
+            int k = i * largeur + j;
+            int e = E[k - 1] - p->extension_gap;
+            if (H[k - 1] - ouverture > e) e = H[k - 1] - ouverture;
+            int f = F[k - largeur] - p->extension_gap;
+            if (H[k - largeur] - ouverture > f) f = H[k - largeur] - ouverture;
+            int h = H[k - largeur - 1] + score_paire(p, code_requete, coder_nucleotide(cible[debut_fenetre + j - 1]));
+            if (e > h) h = e;
+            if (f > h) h = f;
+            if (h < 0) h = 0;
+            H[k] = h;
+            E[k] = e;
+            F[k] = f;
+        }
+    }
+
+    // Le hit se termine dans la dernière colonne : on part de la meilleure cellule de cette colonne
+    int i = 0;
+    for (int r = 1; r <= m; r++) {
+        if (H[r * largeur + n] > H[i * largeur + n]) i = r;
+    }
+    int j = n;
+    hit->score = H[i * largeur + n];
+    hit->fin_requete = i;
+    hit->fin_sujet = debut_fenetre + n;  // 1-indexée
+
+    int longueur = 0, identiques = 0, mesappariements = 0, ouvertures = 0;
+    int etat = 0;  // 0 = H, 1 = E (gap dans la requête), 2 = F (gap dans la cible)
+    while (i > 0 && j > 0) {
+        int k = i * largeur + j;
+        if (etat == 0) {
+            if (H[k] == 0) break;
+            int code_requete = coder_nucleotide(requete[i - 1]);
+            int code_cible = coder_nucleotide(cible[debut_fenetre + j - 1]);
+            if (H[k] == H[k - largeur - 1] + score_paire(p, code_requete, code_cible)) {
+                if (code_requete == code_cible && code_requete < 4) identiques++;
+                else mesappariements++;
+                longueur++;
+                i--;
+                j--;
+            } else if (H[k] == E[k]) {
+                etat = 1;
+                ouvertures++;
+            } else {
+                etat = 2;
+                ouvertures++;
+            }
+        } else if (etat == 1) {
+            longueur++;
+            if (E[k] == H[k - 1] - ouverture) etat = 0;
+            j--;
+        } else {
+            longueur++;
+            if (F[k] == H[k - largeur] - ouverture) etat = 0;
+            i--;
+        }
+    }
+
+    hit->debut_requete = i + 1;
+    hit->debut_sujet = debut_fenetre + j + 1;
+    hit->longueur_alignement = longueur;
+    hit->mesappariements = mesappariements;
+    hit->ouvertures_gap = ouvertures;
+    hit->identite = longueur > 0 ? 100.0f * identiques / longueur : 0.0f;
+
+    free(H); free(E); free(F);
+    return 0;
+}
+
+// ==================== Alignement des motifs sur un génome ====================
+
+typedef struct {
+    HitAlignement *hits;
+    int nombre;
+    int capacite;
+} ListeHits;
+
+static int ajouter_hit(ListeHits *liste, const HitAlignement *hit) {
+    if (liste->nombre == liste->capacite) {
+        int capacite = liste->capacite == 0 ? 64 : liste->capacite * 2;
+        HitAlignement *p = realloc(liste->hits, capacite * sizeof(HitAlignement));
+        if (p == NULL) return -1;
+        liste->hits = p;
+        liste->capacite = capacite;
+    }
+    liste->hits[liste->nombre++] = *hit;
+    return 0;
+}
+
+// Aligne une requête (un brin) sur une région de sujet et ajoute les hits retenus
+static int aligner_region(const ProfilRequete *profil, const SequenceFasta *sujet, int debut, int fin,
+                          int seuil, int64_t longueur_base, const ParametresAlignement *p,
+                          int indice_motif, int indice_sujet, int brin_moins, ListeHits *liste) {
+    DetecteurPics detecteur = {0};
+    if (balayer_sw(profil, sujet->sequence + debut, fin - debut, seuil, p, &detecteur) != 0) {
+        free(detecteur.pics);
+        return -1;
+    }
+
+    int m = profil->longueur;
+    for (int k = 0; k < detecteur.nombre; k++) {
+        int fin_hit = debut + detecteur.pics[k].fin;
+        int debut_fenetre = fin_hit - 2 * m - MARGE_FENETRE_GRAINE;
+        if (debut_fenetre < 0) debut_fenetre = 0;
+
+        HitAlignement hit;
+        memset(&hit, 0, sizeof(hit));
+        if (retracer_alignement(profil->requete, m, sujet->sequence, debut_fenetre, fin_hit, p, &hit) != 0) {
+            free(detecteur.pics);
+            return -1;
+        }
+        hit.indice_motif = indice_motif;
+        hit.indice_sujet = indice_sujet;
+        hit.evalue = calculer_evalue_alignement(hit.score, m, longueur_base);
+        hit.score_bits = (float)calculer_score_bits(hit.score);
+
+        // Sur le brin -, la requête alignée est le complément inverse : on ramène les coordonnées
+        // dans le repère de la requête d'origine et on inverse les bornes du sujet (convention BLAST)
+        if (brin_moins) {
+            int debut_requete = m - hit.fin_requete + 1;
+            int fin_requete = m - hit.debut_requete + 1;
+            int64_t debut_sujet = hit.fin_sujet;
+            hit.debut_requete = debut_requete;
+            hit.fin_requete = fin_requete;
+            hit.fin_sujet = hit.debut_sujet;
+            hit.debut_sujet = debut_sujet;
+        }
+        if (ajouter_hit(liste, &hit) != 0) {
+            free(detecteur.pics);
+            return -1;
+        }
+    }
+    free(detecteur.pics);
+    return 0;
+}
+
+/**
+ * Index des graines des requêtes : chaque mot de `taille_graine` bases de chaque requête (deux brins)
+ * est rangé par code 2 bits, pour retrouver en O(1) les requêtes concernées par un mot du génome.
+ */
+typedef struct {
+    uint64_t code;
+    int requete;      ///< 2 * indice_motif + brin
+    int decalage;     ///< Position du mot dans la requête
+} EntreeGraine;
+
+typedef struct {
+    EntreeGraine *entrees;
+    int nombre;
+    int *table;        ///< Table de hachage : indice de la première entrée d'un code, -1 si vide
+    int taille_table;
+} IndexGraines;
+
+static int comparer_entrees_graines(const void *a, const void *b) {
+    const EntreeGraine *x = a;
+    const EntreeGraine *y = b;
+    if (x->code != y->code) return x->code < y->code ? -1 : 1;
+    if (x->requete != y->requete) return x->requete - y->requete;
+    return x->decalage - y->decalage;
+}
+
+static uint32_t hacher_code(uint64_t code, int taille_table) {
+    return (uint32_t)((code * 0x9E3779B97F4A7C15ull) >> 32) & (taille_table - 1);
+}
+
+static int construire_index_graines(IndexGraines *index, char **requetes, const int *longueurs,
+                                    int nombre_requetes, int taille_graine) {
+    int total = 0;
+    for (int r = 0; r < nombre_requetes; r++) {
+        if (longueurs[r] >= taille_graine) total += longueurs[r] - taille_graine + 1;
+    }
+    index->entrees = malloc((total > 0 ? total : 1) * sizeof(EntreeGraine));
+    if (index->entrees == NULL) return -1;
+
+    int n = 0;
+    for (int r = 0; r < nombre_requetes; r++) {
+        for (int i = 0; i + taille_graine <= longueurs[r]; i++) {
+            uint64_t code = 0;
+            int valide = 1;
+            for (int k = 0; k < taille_graine; k++) {
+                int c = coder_nucleotide(requetes[r][i + k]);
+                if (c > 3) {
+                    valide = 0;
+                    break;
+                }
+                code = (code << 2) | (uint64_t)c;
+            }
+            if (!valide) continue;
+            index->entrees[n].code = code;
+            index->entrees[n].requete = r;
+            index->entrees[n].decalage = i;
+            n++;
+        }
+    }
+    index->nombre = n;
+    qsort(index->entrees, n, sizeof(EntreeGraine), comparer_entrees_graines);
+
+    index->taille_table = 16;
+    while (index->taille_table < 2 * n) index->taille_table *= 2;
+    index->table = malloc(index->taille_table * sizeof(int));
+    if (index->table == NULL) return -1;
+    for (int i = 0; i < index->taille_table; i++) index->table[i] = -1;
+
+    for (int i = 0; i < n; i++) {
+        if (i > 0 && index->entrees[i].code == index->entrees[i - 1].code) continue;
+        uint32_t h = hacher_code(index->entrees[i].code, index->taille_table);
+        while (index->table[h] != -1) h = (h + 1) & (index->taille_table - 1);
+        index->table[h] = i;
+    }
+    return 0;
+}
+
+static int chercher_graine(const IndexGraines *index, uint64_t code) {
+    uint32_t h = hacher_code(code, index->taille_table);
+    while (index->table[h] != -1) {
+        if (index->entrees[index->table[h]].code == code) return index->table[h];
+        h = (h + 1) & (index->taille_table - 1);
+    }
+    return -1;
+}
+
+static void liberer_index_graines(IndexGraines *index) {
+    free(index->entrees);
+    free(index->table);
+}
+
+typedef struct {
+    int debut;
+    int fin;
+} Fenetre;
+
+typedef struct {
+    Fenetre *fenetres;
+    int nombre;
+    int capacite;
+} ListeFenetres;
+
+static int comparer_fenetres(const void *a, const void *b) {
+    const Fenetre *x = a;
+    const Fenetre *y = b;
+    return (x->debut > y->debut) - (x->debut < y->debut);
+}
+
+static int ajouter_fenetre(ListeFenetres *liste, int debut, int fin) {
+    // Les graines d'un même hit arrivent à la suite : on prolonge la dernière fenêtre si possible
+    if (liste->nombre > 0) {
+        Fenetre *derniere = &liste->fenetres[liste->nombre - 1];
+        if (debut >= derniere->debut && debut <= derniere->fin) {
+            if (fin > derniere->fin) derniere->fin = fin;
+            return 0;
+        }
+    }
+    if (liste->nombre == liste->capacite) {
+        int capacite = liste->capacite == 0 ? 16 : liste->capacite * 2;
+        Fenetre *p = realloc(liste->fenetres, capacite * sizeof(Fenetre));
+        if (p == NULL) return -1;
+        liste->fenetres = p;
+        liste->capacite = capacite;
+    }
+    liste->fenetres[liste->nombre].debut = debut;
+    liste->fenetres[liste->nombre].fin = fin;
+    liste->nombre++;
+    return 0;
+}
+
+// Trie et fusionne les fenêtres qui se chevauchent
+static void fusionner_fenetres(ListeFenetres *liste) {
+    if (liste->nombre == 0) return;
+    qsort(liste->fenetres, liste->nombre, sizeof(Fenetre), comparer_fenetres);
+    int n = 0;
+    for (int i = 1; i < liste->nombre; i++) {
+        if (liste->fenetres[i].debut <= liste->fenetres[n].fin) {
+            if (liste->fenetres[i].fin > liste->fenetres[n].fin) liste->fenetres[n].fin = liste->fenetres[i].fin;
+        } else {
+            liste->fenetres[++n] = liste->fenetres[i];
+        }
+    }
+    liste->nombre = n + 1;
+}
+
+void ecrire_complement_inverse(const char *sequence, int longueur, char *destination) {
+    for (int i = 0; i < longueur; i++) {
+        destination[i] = complementer_nucleotide(sequence[longueur - 1 - i]);
+    }
+}
+
+static char* complement_inverse(const char *sequence, int longueur) {
+    char *inverse = malloc(longueur + 1);
+    if (inverse == NULL) return NULL;
+    ecrire_complement_inverse(sequence, longueur, inverse);
+    inverse[longueur] = '\0';
+    return inverse;
+}
+
+static int comparer_hits(const void *a, const void *b) {
+    const HitAlignement *x = a;
+    const HitAlignement *y = b;
+    if (x->indice_motif != y->indice_motif) return x->indice_motif - y->indice_motif;
+    if (x->indice_sujet != y->indice_sujet) return x->indice_sujet - y->indice_sujet;
+    if (x->evalue != y->evalue) return x->evalue < y->evalue ? -1 : 1;
+    return (x->debut_sujet > y->debut_sujet) - (x->debut_sujet < y->debut_sujet);
+}
+
+HitAlignement* aligner_motifs_genome(const SequenceFasta *motifs, int nombre_motifs,
+                                     const SequenceFasta *sujets, int nombre_sujets,
+                                     int premier_indice_sujet, const ParametresAlignement *p, int *nombre_hits) {
+    int nombre_requetes = 2 * nombre_motifs;
+    char **requetes = calloc(nombre_requetes, sizeof(char*));
+    int *longueurs = calloc(nombre_requetes, sizeof(int));
+    ProfilRequete *profils = calloc(nombre_requetes, sizeof(ProfilRequete));
+    ListeFenetres *fenetres = calloc(nombre_requetes, sizeof(ListeFenetres));
+    ListeHits liste = {0};
+    IndexGraines index = {0};
+    int erreur = (requetes == NULL || longueurs == NULL || profils == NULL || fenetres == NULL);
+
+    // Requêtes : le motif (brin +) puis son complément inverse (brin -)
+    for (int r = 0; !erreur && r < nombre_requetes; r++) {
+        const SequenceFasta *motif = &motifs[r / 2];
+        requetes[r] = (r % 2 == 0) ? strdup(motif->sequence) : complement_inverse(motif->sequence, motif->longueur);
+        longueurs[r] = motif->longueur;
+        if (requetes[r] == NULL || construire_profil(&profils[r], requetes[r], longueurs[r], p) != 0) erreur = 1;
+    }
+    if (!erreur && p->taille_graine > 0 && p->taille_graine <= 31) {
+        erreur = construire_index_graines(&index, requetes, longueurs, nombre_requetes, p->taille_graine) != 0;
+    }
+
+    int64_t longueur_base = 0;
+    for (int s = 0; s < nombre_sujets; s++) longueur_base += sujets[s].longueur;
+
+    for (int s = 0; !erreur && s < nombre_sujets; s++) {
+        const SequenceFasta *sujet = &sujets[s];
+
+        if (p->taille_graine <= 0 || p->taille_graine > 31) {
+            // Mode exhaustif : chaque requête balaie tout le sujet
+            for (int r = 0; !erreur && r < nombre_requetes; r++) {
+                int seuil = score_minimal(p, longueurs[r], longueur_base);
+                erreur = aligner_region(&profils[r], sujet, 0, sujet->longueur, seuil, longueur_base, p,
+                                        r / 2, premier_indice_sujet + s, r % 2, &liste) != 0;
+            }
+            continue;
+        }
+
+        // Un seul passage sur le sujet : code 2 bits glissant, chaque graine ouvre une fenêtre d'alignement
+        uint64_t masque = (1ull << (2 * p->taille_graine)) - 1;
+        uint64_t code = 0;
+        int valides = 0;
+        for (int j = 0; !erreur && j < sujet->longueur; j++) {
+            int c = coder_nucleotide(sujet->sequence[j]);
+            if (c > 3) {
+                valides = 0;
+                continue;
+            }
+            code = ((code << 2) | (uint64_t)c) & masque;
+            if (++valides < p->taille_graine) continue;
+
+            int e = chercher_graine(&index, code);
+            if (e < 0) continue;
+            int debut_mot = j - p->taille_graine + 1;
+            for (; e < index.nombre && index.entrees[e].code == code; e++) {
+                int r = index.entrees[e].requete;
+                int diagonale = debut_mot - index.entrees[e].decalage;
+                int debut = diagonale - longueurs[r] - MARGE_FENETRE_GRAINE;
+                int fin = diagonale + 2 * longueurs[r] + MARGE_FENETRE_GRAINE;
+                if (debut < 0) debut = 0;
+                if (fin > sujet->longueur) fin = sujet->longueur;
+                if (ajouter_fenetre(&fenetres[r], debut, fin) != 0) erreur = 1;
+            }
+        }
+
+        for (int r = 0; !erreur && r < nombre_requetes; r++) {
+            fusionner_fenetres(&fenetres[r]);
+            int seuil = score_minimal(p, longueurs[r], longueur_base);
+            for (int w = 0; !erreur && w < fenetres[r].nombre; w++) {
+                erreur = aligner_region(&profils[r], sujet, fenetres[r].fenetres[w].debut, fenetres[r].fenetres[w].fin,
+                                        seuil, longueur_base, p, r / 2, premier_indice_sujet + s, r % 2, &liste) != 0;
+            }
+            fenetres[r].nombre = 0;
+        }
+    }
+
+    for (int r = 0; r < nombre_requetes; r++) {
+        if (requetes != NULL) free(requetes[r]);
+        if (profils != NULL) liberer_profil(&profils[r]);
+        if (fenetres != NULL) free(fenetres[r].fenetres);
+    }
+    free(requetes);
+    free(longueurs);
+    free(profils);
+    free(fenetres);
+    liberer_index_graines(&index);
+
+    if (erreur) {
+        printf("Erreur d'allocation mémoire lors de l'alignement local\n");
+        free(liste.hits);
+        *nombre_hits = 0;
+        return NULL;
+    }
+
+    if (liste.nombre > 0) qsort(liste.hits, liste.nombre, sizeof(HitAlignement), comparer_hits);
+    *nombre_hits = liste.nombre;
+    return liste.hits;
+}
+
+// Écrit les hits au format tabulaire BLAST (outfmt 7) : un bloc de commentaires par motif
+static void ecrire_hits_tabulaires(FILE *sortie, const HitAlignement *hits, int nombre_hits,
+                                   const SequenceFasta *motifs, int nombre_motifs, char **noms_sujets) {
+    int h = 0;
+    for (int m = 0; m < nombre_motifs; m++) {
+        int premier = h;
+        while (h < nombre_hits && hits[h].indice_motif == m) h++;
+
+        fprintf(sortie, "# alignement_local\n");
+        fprintf(sortie, "# Query: Motif_%d %s\n", m + 1, motifs[m].sequence);
+        fprintf(sortie, "# Fields: query acc.ver, subject acc.ver, %% identity, alignment length, mismatches, "
+                        "gap opens, q. start, q. end, s. start, s. end, evalue, bit score\n");
+        fprintf(sortie, "# %d hits found\n", h - premier);
+        for (int k = premier; k < h; k++) {
+            const HitAlignement *hit = &hits[k];
+            fprintf(sortie, "Motif_%d\t%s\t%.3f\t%d\t%d\t%d\t%d\t%d\t%lld\t%lld\t%.3g\t%.1f\n",
+                    m + 1, noms_sujets[hit->indice_sujet], hit->identite, hit->longueur_alignement,
+                    hit->mesappariements, hit->ouvertures_gap, hit->debut_requete, hit->fin_requete,
+                    (long long)hit->debut_sujet, (long long)hit->fin_sujet, hit->evalue, hit->score_bits);
+        }
+    }
+}
+
+int aligner_motifs_genomes(const char *chemin_motifs, const char *chemin_liste_genomes,
+                           const char *chemin_sortie, const ParametresAlignement *p) {
+    int nombre_motifs = 0;
+    SequenceFasta *motifs = lire_fichier_multi_fasta(chemin_motifs, &nombre_motifs);
+    if (motifs == NULL || nombre_motifs == 0) {
+        printf("Aucun motif à aligner dans %s\n", chemin_motifs);
+        liberer_sequences_fasta(motifs, nombre_motifs);
+        return -1;
+    }
+
+    FILE *liste_genomes = fopen(chemin_liste_genomes, "r");
+    if (liste_genomes == NULL) {
+        perror("Erreur lors de l'ouverture de la liste des génomes");
+        liberer_sequences_fasta(motifs, nombre_motifs);
+        return -1;
+    }
+
+    ListeHits tous = {0};
+    char **noms_sujets = NULL;
+    int nombre_noms = 0;
+    int erreur = 0;
+
+    // Les génomes sont traités un par un : seuls les motifs et un génome résident en mémoire
+    char chemin_genome[4096];
+    while (!erreur && fgets(chemin_genome, sizeof(chemin_genome), liste_genomes)) {
+        chemin_genome[strcspn(chemin_genome, "\r\n")] = '\0';
+        if (chemin_genome[0] == '\0' || chemin_genome[0] == '#') continue;
+
+        int nombre_sujets = 0;
+        SequenceFasta *sujets = lire_fichier_multi_fasta(chemin_genome, &nombre_sujets);
+        if (sujets == NULL) continue;
+
+        char **p_noms = realloc(noms_sujets, (nombre_noms + nombre_sujets + 1) * sizeof(char*));
+        if (p_noms == NULL) {
+            liberer_sequences_fasta(sujets, nombre_sujets);
+            erreur = 1;
+            break;
+        }
+        noms_sujets = p_noms;
+        int premier_indice = nombre_noms;
+        for (int s = 0; s < nombre_sujets; s++) {
+            noms_sujets[nombre_noms++] = strdup(sujets[s].nom);
+        }
+
+        int nombre_hits = 0;
+        HitAlignement *hits = aligner_motifs_genome(motifs, nombre_motifs, sujets, nombre_sujets,
+                                                    premier_indice, p, &nombre_hits);
+        for (int k = 0; hits != NULL && k < nombre_hits; k++) {
+            if (ajouter_hit(&tous, &hits[k]) != 0) erreur = 1;
+        }
+        printf("%s : %d hit(s)\n", chemin_genome, nombre_hits);
+        free(hits);
+        liberer_sequences_fasta(sujets, nombre_sujets);
+    }
+    fclose(liste_genomes);
+
+    int resultat = -1;
+    if (!erreur) {
+        if (tous.nombre > 0) qsort(tous.hits, tous.nombre, sizeof(HitAlignement), comparer_hits);
+        FILE *sortie = fopen(chemin_sortie, "w");
+        if (sortie == NULL) {
+            perror("Erreur lors de l'ouverture du fichier de sortie de l'alignement");
+        } else {
+            ecrire_hits_tabulaires(sortie, tous.hits, tous.nombre, motifs, nombre_motifs, noms_sujets);
+            fclose(sortie);
+            printf("%d hit(s) écrits dans %s\n", tous.nombre, chemin_sortie);
+            resultat = tous.nombre;
+        }
+    }
+
+    for (int s = 0; s < nombre_noms; s++) free(noms_sujets[s]);
+    free(noms_sujets);
+    free(tous.hits);
+    liberer_sequences_fasta(motifs, nombre_motifs);
+    return resultat;
+}
@@ -1,7 +1,34 @@
 // assert_projet.c
 #include <stdio.h>
 #include <assert.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <zlib.h>
 #include "projet.h"  
+#include "libprojet.h"
+
+// Sortie standard envoyée vers /dev/null pendant les appels dont l'échec est attendu : leurs messages d'erreur ne
+// doivent pas se lire comme des erreurs des tests (ceux d'assert, sur la sortie d'erreur, restent affichés)
+static int sortie_sauvegardee = -1;
+
+static void couper_sortie(void) {
+    fflush(stdout);
+    int nul = open("/dev/null", O_WRONLY);
+    sortie_sauvegardee = dup(STDOUT_FILENO);
+    assert(nul >= 0 && sortie_sauvegardee >= 0 && dup2(nul, STDOUT_FILENO) >= 0);
+    close(nul);
+}
+
+static void retablir_sortie(void) {
+    fflush(stdout);
+    assert(dup2(sortie_sauvegardee, STDOUT_FILENO) >= 0);
+    close(sortie_sauvegardee);
+    sortie_sauvegardee = -1;
+}
 
 // assert recherche_consensus_box.c
 
@@ -118,6 +145,49 @@ int test_abscence_gene_critique() {
     return 0;
 }
 
+// assert recherche_gene_gappee.c
+
+// Test d'un gène dont la copie génomique a perdu une base : introuvable sans gaps, retrouvé avec
+void test_recherche_gene_gappee() {
+    const char* genome = "TCAGTTAAATGGCAGAAAACTGGCAGGGCTTTTAGTCGTGGGATGATCAGTGGGTAAAGGTGGCGCGGGGTAACGCGCGCCCGTAATGCCTTTCC"
+                         "CTAACAGAGTTTTTCAACTCGTGTTGTCGAGCGACGGAATTAGATAAGGCTCAGCTGCAACGCGGAGCTGGTGTGTTATCCATTCATGGCAGACA"
+                         "ACTAATACGCATAAGCGTAGCCAACCGCA";
+    const char* gene = "CCGTAATGCCTTTCCCTAACAGAGTTTTTCGAACTCGTGTTGTCGAGCGACGGAATTAGA";  // Un G de plus en position 31
+
+    assert(rechercher_gene(genome, gene, 0.9) == -1);
+    assert(rechercher_gene_gappee(genome, gene, 0.9) == 81);
+
+    IndexKmers *index = construire_index_kmers(genome, strlen(genome), LONGUEUR_GRAINE_GENE);
+    assert(index != NULL);
+    AlignementGene alignement;
+    assert(rechercher_gene_graines(index, genome, gene, 0.9, &alignement, 1) == 1);
+    assert(alignement.debut == 80 && alignement.fin == 139);
+    assert(strcmp(alignement.cigar, "30M1I29M") == 0);
+    assert(alignement.identite > 0.983 && alignement.identite < 0.984);
+    assert(alignement.brin == '+');
+    liberer_alignement_gene(&alignement);
+
+    // Gène sur le brin - : son complément inverse est aligné, en coordonnées du brin +, avec le même index
+    char gene_inverse[64];
+    int longueur_gene = strlen(gene);
+    ecrire_complement_inverse(gene, longueur_gene, gene_inverse);
+    gene_inverse[longueur_gene] = '\0';
+    char brin = '.';
+    assert(rechercher_gene_index(index, genome, gene_inverse, 0.9, &brin) == 81 && brin == '-');
+    assert(rechercher_gene_graines(index, genome, gene_inverse, 0.9, &alignement, 1) == 1);
+    assert(alignement.brin == '-' && alignement.debut == 80 && alignement.fin == 139);
+    liberer_alignement_gene(&alignement);
+    assert(rechercher_gene_index(index, genome, gene, 0.9, &brin) == 81 && brin == '+');
+    // Gène plus court qu'une graine : balayage sans indels du brin +
+    assert(rechercher_gene_index(index, genome, "CCGTAATGCC", 1.0, &brin) == 81 && brin == '+');
+    liberer_index_kmers(index);
+
+    // Mêmes cas limites que la recherche sans gaps : gène absent, gène présent deux fois
+    assert(rechercher_gene_gappee(genome, "GGGGGGGGGGGGGGGGGGGGGGGG", 0.9) == -1);
+    const char* genome_double = "ACGTACGTCCCACTAACGTCCAATCTATATGGATCATGTTACCCCATCGGAGTACGTACTACGTTAACGTCCAATCTATATGGATCATGTTACCCCATCGGAGTACTACGTATTTCGTACGT";
+    assert(rechercher_gene_gappee(genome_double, "ACGTCCAATCTATATGGATCATGTTACCCCATCGGAGTA", 1.0) == -1);
+}
+
 // assert motif_analyse.c
 
 // Test de la fonction rechercher_motif_rapide avec des printf pour le débogage
@@ -207,7 +277,7 @@ void test_etendre_et_traiter_k_uplets() {
         printf("Erreur d'allocation mémoire pour la sous-séquence\n");
         return;
     }
-    strncpy(sous_sequence, &sequence_reelle[position_gene - taille_region], taille_region);
+    memcpy(sous_sequence, &sequence_reelle[position_gene - taille_region], taille_region);
     sous_sequence[taille_region] = '\0';
 
     // Paramètres pour l'analyse des k-uplets
@@ -218,7 +288,7 @@ void test_etendre_et_traiter_k_uplets() {
     printf("=== Test 1 : Appel de traiter_k_uplets avec des séquences courtes ===\n");
     traiter_k_uplets(sous_sequence, taille_region, sequence_reelle,
                      longueur_sequence_reelle, longueur_k_uplet, longueur_min_motif,
-                     sequence_alea, position_gene);
+                     sequence_alea, position_gene, NULL);
 
     // Test 2 : Extension d'un motif particulier après analyse
     printf("\n=== Test 2 : Test de l'extension d'un motif ===\n");
@@ -245,4 +315,2038 @@ void test_etendre_et_traiter_k_uplets() {
     free(sous_sequence);
 
     printf("\n=== Fin des tests combinés de etendre_k_uplet et traiter_k_uplets ===\n");
-}
\ No newline at end of file
+}
+// assert resultats_blast.c
+
+// Test du chargement en colonnes d'un petit fichier BLAST et des agrégations
+void test_table_blast() {
+    printf("=== Début du test de charger_table_blast ===\n");
+
+    const char *chemin = "test_table_blast.tmp";
+    FILE *fichier = fopen(chemin, "w");
+    assert(fichier != NULL);
+    fprintf(fichier, "# blastn\n# Fields: query acc.ver, subject acc.ver, %% identity, alignment length, mismatches, gap opens, q. start, q. end, s. start, s. end, evalue, bit score\n");
+    fprintf(fichier, "Q1\tS1\t100.000\t29\t0\t0\t1\t29\t100\t128\t2.00e-05\t58.0\n");
+    fprintf(fichier, "Q1\tS1\t96.552\t29\t1\t0\t1\t29\t250\t222\t0.005\t50.1\n");
+    fprintf(fichier, "Q1\tS1\t100.000\t29\t0\t0\t1\t29\t5000\t5028\t2.00e-05\t58.0\n");
+    fprintf(fichier, "Q1\tS2\t92.000\t25\t2\t0\t1\t25\t1979706\t1979682\t290\t34.2\n");
+    fprintf(fichier, "Q2\tS1\t100.000\t20\t0\t0\t1\t20\t300\t319\t1e-3\t40.1\n");
+    fclose(fichier);
+
+    TableBlast *table = charger_table_blast(chemin);
+    remove(chemin);
+    assert(table != NULL);
+    assert(table->nombre_hits == 5);
+    assert(table->requetes.nombre == 2 && table->sujets.nombre == 2);
+    assert(table->fin_sujet[3] == 1979682);
+    assert(table->evalue[1] > 0.0049 && table->evalue[1] < 0.0051);
+
+    // Trois hits de Q1 sur S1, un sur S2
+    int *compte = blast_hits_par_sujet(table, 0);
+    assert(compte[0] == 3 && compte[1] == 1);
+    free(compte);
+
+    int copies_max = 0;
+    int *histogramme = blast_distribution_copies(table, 0, &copies_max);
+    assert(copies_max == 3 && histogramme[1] == 1 && histogramme[3] == 1);
+    free(histogramme);
+
+    // Les hits en 100 et 222 sont groupés, celui en 5000 est isolé
+    int nombre_groupes = 0;
+    GroupeHitsBlast *groupes = blast_regrouper_positions(table, 0, 200, &nombre_groupes);
+    assert(nombre_groupes == 3);
+    assert(groupes[0].nombre_hits == 2 && groupes[0].debut == 100 && groupes[0].fin == 222);
+    free(groupes);
+    // Requête sans hit : aucun groupe, mais pas d'erreur
+    groupes = blast_regrouper_positions(table, 2, 200, &nombre_groupes);
+    assert(groupes != NULL && nombre_groupes == 0);
+    free(groupes);
+
+    // Sur S1, le hit de Q2 (300) est à 200, 78 et 4700 bases des hits de Q1
+    EcartMotifsBlast *ecarts = blast_ecart_motifs(table, 0, 1);
+    assert(ecarts[0].nombre_paires == 3 && ecarts[0].ecart_min == 78 && ecarts[0].ecart_max == 4700);
+    assert(ecarts[1].nombre_paires == 0 && ecarts[1].ecart_min == -1);
+    free(ecarts);
+
+    liberer_table_blast(table);
+    printf("Test de charger_table_blast passé avec succès.\n");
+}
+
+// assert alignement_local.c
+
+// Test de l'alignement local : une copie exacte, une copie sur le brin - et une copie avec une délétion
+void test_alignement_local() {
+    printf("=== Début du test de aligner_motifs_genome ===\n");
+
+    char genome[] = "GCTAAAGACAATTACATAACATACACGTCAGCACGAAACTTGTTGGCCCAGTAGGCCTGATAAGCGTAGCGCATCAGGCTGATGCATAC"
+                    "GCCTTTACTTGCTGTGTCCACCCCATCGGACTGGCATTTTTATTACACTCAGAAACAGAACTCGGGTAATTTTGACAGGTCACGCAGAGG"
+                    "CGCGCCCTCCTGAAGTGCGTGGCCTGATGCGCTACGCTTATCAGGCCTACACTCTGCCAAACTCCAGCGCGGTCAGTTCCATCACCCTAA"
+                    "GTAACCGAATAATGCGTTCGCTCTATTGACTACGACGCGCTCATTCCCTTGGTAGGCCTGATAAGCTAGCGCATCAGGCCTGAGACTAGA"
+                    "AGACAGATAGTGCACACGACCGGCGTCGGAGAAACTCTATT";
+    char motif[] = "GTAGGCCTGATAAGCGTAGCGCATCAGGC";
+    SequenceFasta sujet = {"sujet_test", genome, (int)strlen(genome)};
+    SequenceFasta requete = {"motif_test", motif, (int)strlen(motif)};
+
+    ParametresAlignement parametres = parametres_alignement_defaut();
+    parametres.evalue_max = 1e-5;
+
+    // Le mode exhaustif et le mode par graines doivent trouver les mêmes hits
+    for (int graine = 0; graine <= 11; graine += 11) {
+        parametres.taille_graine = graine;
+        int nombre_hits = 0;
+        HitAlignement *hits = aligner_motifs_genome(&requete, 1, &sujet, 1, 0, &parametres, &nombre_hits);
+        assert(hits != NULL && nombre_hits == 3);
+
+        int copie_exacte = 0, copie_moins = 0, copie_deletion = 0;
+        for (int k = 0; k < nombre_hits; k++) {
+            HitAlignement *h = &hits[k];
+            if (h->debut_sujet == 51 && h->fin_sujet == 79 && h->identite > 99.9f) copie_exacte = 1;
+            if (h->debut_sujet == 229 && h->fin_sujet == 201 && h->debut_requete == 1 && h->fin_requete == 29) copie_moins = 1;
+            if (h->debut_sujet == 321 && h->fin_sujet == 348 && h->ouvertures_gap == 1 && h->longueur_alignement == 29) copie_deletion = 1;
+        }
+        assert(copie_exacte && copie_moins && copie_deletion);
+        free(hits);
+    }
+
+    // La version scalaire trouve les mêmes fins de hits que la version vectorisée
+    int fins[8], scores[8];
+    int nombre = balayer_sw_scalaire(motif, strlen(motif), genome, strlen(genome), 32, &parametres, fins, scores, 8);
+    assert(nombre == 2 && fins[0] == 78 && scores[0] == 58 && fins[1] == 347 && scores[1] == 49);
+
+    // Un motif vide n'a aucun hit, sans lecture hors du profil
+    assert(balayer_sw_scalaire("", 0, genome, strlen(genome), 1, &parametres, fins, scores, 8) == 0);
+    SequenceFasta requete_vide = {"motif_vide", "", 0};
+    parametres.taille_graine = 0;
+    int nombre_hits_vide = -1;
+    HitAlignement *hits_vide = aligner_motifs_genome(&requete_vide, 1, &sujet, 1, 0, &parametres, &nombre_hits_vide);
+    assert(nombre_hits_vide == 0);
+    free(hits_vide);
+
+    printf("Test de aligner_motifs_genome passé avec succès.\n");
+}
+
+// assert flux_genome.c
+
+// Test de l'analyse en flux : de petites fenêtres doivent donner les mêmes résultats que l'analyse en mémoire
+void test_analyse_flux() {
+    printf("=== Début du test de analyser_genome_flux ===\n");
+
+    const char* genome = "TTGACATACGGGAGGGGGGGGTATAATGCGTACACGTACGTCCCACTACGTACTACGTTAACGTCCAATCTATATGGATCATGTTACCCC"
+                         "ATCGGAGTACTACGTATTTCGTACGTTTGACATATTGACATTTGACACGGTATAATATAATTGCTTGACATCGATCGAGAGTAAGATCATA"
+                         "TAATGCGTACGGATCCGATTACAGGCATTGACATACGGGAGGGGGGGGTATAATGCGTAC";
+    const char* gene = "ACGTCCAATCTATATGGATCATGTTACCCCATCGGAGTA";
+    int longueur = strlen(genome);
+
+    // Écriture du génome en FASTA, en minuscules et sur des lignes de 13 bases
+    const char *chemin = "test_analyse_flux.tmp";
+    FILE *fichier = fopen(chemin, "w");
+    assert(fichier != NULL);
+    fprintf(fichier, ">genome_test description\n");
+    for (int i = 0; i < longueur; i++) {
+        fputc(i % 2 ? genome[i] : genome[i] + ('a' - 'A'), fichier);
+        if ((i + 1) % 13 == 0) fputc('\n', fichier);
+    }
+    fputc('\n', fichier);
+    fclose(fichier);
+
+    int k = 3;
+    ResultatsFlux resultats;
+    assert(analyser_genome_flux(chemin, gene, k, 100, &resultats) == 0);
+    remove(chemin);
+
+    assert(resultats.longueur_genome == longueur);
+    assert(resultats.nombre_fenetres > 3);
+
+    // Le gène est vu dans plusieurs fenêtres mais compté une seule fois
+    assert(resultats.nombre_genes == 1);
+    assert(resultats.positions_genes[0] + 1 == rechercher_gene_gappee(genome, gene, IDENTITE_MIN));
+
+    // Mêmes paires de boîtes consensus que la recherche sur tout le génome
+    assert(resultats.nombre_consensus == rechercher_seq_consensus(genome, BOITE_35, BOITE_10, longueur, 0));
+
+    // Chaque k-mer du génome est compté exactement une fois
+    uint64_t total = 0;
+    for (int code = 0; code < (1 << (2 * k)); code++) total += resultats.comptes_kmers[code];
+    assert(total == (uint64_t)(longueur - k + 1));
+    assert(resultats.comptes_kmers[0x3A] == (uint64_t)rechercher_motif_rapide("TGG", (char*)genome, 0, 0));  // TGG = 3,2,2
+    liberer_resultats_flux(&resultats);
+
+    // FASTA multiple : les fenêtres s'arrêtent à chaque enregistrement, aucun k-mer ne chevauche deux contigs
+    int coupure = 123;
+    char premier[128], second[256];
+    memcpy(premier, genome, coupure);
+    premier[coupure] = '\0';
+    strcpy(second, genome + coupure);
+    fichier = fopen(chemin, "w");
+    assert(fichier != NULL);
+    fprintf(fichier, ">contig_1\n%s\n>contig_vide\n>contig_2\n%.50s\n%s\n", premier, second, second + 50);
+    fclose(fichier);
+    assert(analyser_genome_flux(chemin, NULL, k, 100, &resultats) == 0);
+    remove(chemin);
+    assert(resultats.longueur_genome == longueur);
+    total = 0;
+    for (int code = 0; code < (1 << (2 * k)); code++) total += resultats.comptes_kmers[code];
+    assert(total == (uint64_t)(coupure - k + 1) + (uint64_t)(longueur - coupure - k + 1));
+    assert(resultats.comptes_kmers[0x3A] == (uint64_t)(rechercher_motif_rapide("TGG", premier, 0, 0) +
+                                                       rechercher_motif_rapide("TGG", second, 0, 0)));
+    assert(resultats.nombre_consensus == rechercher_seq_consensus(premier, BOITE_35, BOITE_10, coupure, 0) +
+                                         rechercher_seq_consensus(second, BOITE_35, BOITE_10, longueur - coupure, 0));
+    liberer_resultats_flux(&resultats);
+
+    printf("Test de analyser_genome_flux passé avec succès.\n");
+}
+
+// assert decompression.c
+
+// Écrit un bloc BGZF (membre gzip dont l'extra "BC" donne la taille totale du bloc)
+static void ecrire_bloc_bgzf(FILE *fichier, const char *donnees, int taille) {
+    unsigned char compresse[65536];
+    z_stream flux = {0};
+    assert(deflateInit2(&flux, 6, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) == Z_OK);
+    flux.next_in = (unsigned char*)donnees;
+    flux.avail_in = taille;
+    flux.next_out = compresse;
+    flux.avail_out = sizeof(compresse);
+    assert(deflate(&flux, Z_FINISH) == Z_STREAM_END);
+    int taille_compresse = flux.total_out;
+    deflateEnd(&flux);
+
+    int taille_bloc = 18 + taille_compresse + 8;
+    unsigned char entete[18] = {0x1f, 0x8b, 8, 4, 0, 0, 0, 0, 0, 0xff, 6, 0, 'B', 'C', 2, 0,
+                                (taille_bloc - 1) & 0xff, (taille_bloc - 1) >> 8};
+    uint32_t crc = crc32(0L, (const unsigned char*)donnees, taille);
+    unsigned char pied[8] = {crc & 0xff, (crc >> 8) & 0xff, (crc >> 16) & 0xff, crc >> 24,
+                             taille & 0xff, (taille >> 8) & 0xff, 0, 0};
+    fwrite(entete, 1, sizeof(entete), fichier);
+    fwrite(compresse, 1, taille_compresse, fichier);
+    fwrite(pied, 1, sizeof(pied), fichier);
+}
+
+// Crée un fichier temporaire vide sous /tmp ; `chemin` reçoit son nom (au moins 32 octets)
+static void creer_fichier_temporaire(char *chemin, const char *prefixe) {
+    sprintf(chemin, "/tmp/%.16s_XXXXXX", prefixe);
+    int descripteur = mkstemp(chemin);
+    assert(descripteur >= 0);
+    close(descripteur);
+}
+
+// Test de la lecture transparente des fichiers gzip (multi-membres) et BGZF (plusieurs lots de blocs)
+void test_lecture_compressee() {
+    printf("=== Début du test de la lecture des fichiers compressés ===\n");
+
+    // FASTA de deux enregistrements, en minuscules par endroits, sur des lignes de 60 bases
+    int longueur = 1000000;
+    char *texte = malloc(longueur + longueur / 60 + 64);
+    assert(texte != NULL);
+    int taille = sprintf(texte, ">seq1 premier\n");
+    srand(7);
+    for (int i = 0; i < longueur; i++) {
+        if (i == longueur / 2) taille += sprintf(texte + taille, "\n>seq2 second\n");
+        char base = "ACGT"[rand() % 4];
+        texte[taille++] = i % 7 == 0 ? base + ('a' - 'A') : base;
+        if ((i + 1) % 60 == 0) texte[taille++] = '\n';
+    }
+    texte[taille++] = '\n';
+
+    char chemin_texte[32], chemin_gzip[32], chemin_bgzf[32];
+    creer_fichier_temporaire(chemin_texte, "lecture_fna");
+    creer_fichier_temporaire(chemin_gzip, "lecture_gz");
+    creer_fichier_temporaire(chemin_bgzf, "lecture_bgz");
+    FILE *fichier = fopen(chemin_texte, "w");
+    assert(fichier != NULL);
+    fwrite(texte, 1, taille, fichier);
+    fclose(fichier);
+
+    // gzip en deux membres concaténés
+    for (int membre = 0; membre < 2; membre++) {
+        gzFile gz = gzopen(chemin_gzip, membre == 0 ? "wb" : "ab");
+        assert(gz != NULL);
+        int debut = membre == 0 ? 0 : taille / 3;
+        int fin = membre == 0 ? taille / 3 : taille;
+        assert(gzwrite(gz, texte + debut, fin - debut) == fin - debut);
+        gzclose(gz);
+    }
+
+    // BGZF en blocs de 8000 octets (plus de 64 blocs par lot), suivis du bloc vide de fin
+    fichier = fopen(chemin_bgzf, "wb");
+    assert(fichier != NULL);
+    for (int debut = 0; debut < taille; debut += 8000) {
+        ecrire_bloc_bgzf(fichier, texte + debut, taille - debut < 8000 ? taille - debut : 8000);
+    }
+    ecrire_bloc_bgzf(fichier, "", 0);
+    fclose(fichier);
+
+    char *reference = lire_fichier(chemin_texte);
+    assert(reference != NULL && (int)strlen(reference) == longueur);
+    const char *chemins[2] = {chemin_gzip, chemin_bgzf};
+    for (int c = 0; c < 2; c++) {
+        char *sequence = lire_fichier(chemins[c]);
+        assert(sequence != NULL && strcmp(sequence, reference) == 0);
+        free(sequence);
+
+        int nombre = 0;
+        SequenceFasta *sequences = lire_fichier_multi_fasta(chemins[c], &nombre);
+        assert(nombre == 2);
+        assert(strcmp(sequences[0].nom, "seq1") == 0 && strcmp(sequences[1].nom, "seq2") == 0);
+        assert(sequences[0].longueur == longueur / 2 && sequences[1].longueur == longueur - longueur / 2);
+        assert(strncmp(sequences[1].sequence, reference + longueur / 2, longueur - longueur / 2) == 0);
+        liberer_sequences_fasta(sequences, nombre);
+    }
+
+    // Un fichier tronqué est signalé
+    fichier = fopen(chemin_bgzf, "r+b");
+    assert(fichier != NULL);
+    assert(ftruncate(fileno(fichier), 5000) == 0);
+    fclose(fichier);
+    SourceSequence *source = ouvrir_source(chemin_bgzf);
+    assert(source != NULL);
+    char tampon[4096];
+    while (lire_source(source, tampon, sizeof(tampon)) > 0) {}
+    assert(erreur_source(source));
+    fermer_source(source);
+
+    // ... et aucun lecteur ne renvoie la partie lue avant la troncature comme une séquence complète
+    fichier = fopen(chemin_gzip, "r+b");
+    assert(fichier != NULL);
+    fseek(fichier, 0, SEEK_END);
+    assert(ftruncate(fileno(fichier), ftell(fichier) / 2) == 0);
+    fclose(fichier);
+    couper_sortie();
+    for (int c = 0; c < 2; c++) {
+        assert(lire_fichier(chemins[c]) == NULL);
+        int nombre = -1;
+        assert(lire_fichier_multi_fasta(chemins[c], &nombre) == NULL && nombre == 0);
+        ResultatsFlux resultats;
+        assert(analyser_genome_flux(chemins[c], NULL, 3, 100000, &resultats) != 0);
+        assert(projet_ouvrir_genome(chemins[c]) == NULL);
+    }
+    retablir_sortie();
+
+    remove(chemin_texte);
+    remove(chemin_gzip);
+    remove(chemin_bgzf);
+    free(reference);
+    free(texte);
+    printf("Test de la lecture des fichiers compressés passé avec succès.\n");
+}
+
+// assert ecriture_resultats.c
+
+// Lit un fichier texte tel quel (sans le filtrage de lire_fichier)
+static char* lire_fichier_texte(const char *chemin) {
+    FILE *fichier = fopen(chemin, "r");
+    assert(fichier != NULL);
+    char *contenu = calloc(4096, 1);
+    assert(contenu != NULL);
+    fread(contenu, 1, 4095, fichier);
+    fclose(fichier);
+    return contenu;
+}
+
+// Test de l'écriture des motifs dans les trois formats (séquences non terminées par '\0')
+void test_ecriture_resultats() {
+    printf("=== Début du test de l'écriture des résultats ===\n");
+
+    char genome[] = "ACGTTGCAAGGCTTAC";
+    Motif motifs[2] = {
+        {genome, 0, 4, 2.5, 30, 12, NULL, 41, 15},    // "ACGT" : la séquence pointe dans le génome
+        {genome + 8, 8, 6, 1.75, 21, 0, NULL, -1, -1}, // "AGGCTT"
+    };
+
+    // TSV
+    const char *chemin = "test_resultats.tmp";
+    EcrivainResultats *ecrivain = ouvrir_ecrivain_resultats(chemin, FORMAT_TSV);
+    assert(ecrivain != NULL);
+    for (int i = 0; i < 2; i++) assert(ecrire_motif_resultat(ecrivain, &motifs[i]) == 0);
+    assert(fermer_ecrivain_resultats(ecrivain) == 0);
+    char *contenu = lire_fichier_texte(chemin);
+    assert(strcmp(contenu, "sequence\tposition\tlongueur\tfold_change\toccurrences_reelles\toccurrences_aleatoires"
+                           "\toccurrences_approchees_reelles\toccurrences_approchees_aleatoires\tcopies\tecart_moyen\tecart_median\tdensite_max\tdistance_min_gene"
+                           "\tdistance_moyenne_gene\tfraction_intergenique\n"
+                           "ACGT\t0\t4\t2.5\t30\t12\t41\t15\tNA\tNA\tNA\tNA\tNA\tNA\tNA\n"
+                           "AGGCTT\t8\t6\t1.75\t21\t0\tNA\tNA\tNA\tNA\tNA\tNA\tNA\tNA\tNA\n") == 0);
+    free(contenu);
+
+    // JSON-lines
+    FormatResultats format;
+    assert(format_resultats_depuis_nom("jsonl", &format) == 0 && format == FORMAT_JSONL);
+    assert(format_resultats_depuis_nom("xml", &format) == -1);
+    ecrivain = ouvrir_ecrivain_resultats(chemin, FORMAT_JSONL);
+    assert(ecrivain != NULL);
+    assert(ecrire_motif_resultat(ecrivain, &motifs[1]) == 0);
+    assert(fermer_ecrivain_resultats(ecrivain) == 0);
+    contenu = lire_fichier_texte(chemin);
+    assert(strcmp(contenu, "{\"sequence\":\"AGGCTT\",\"position\":8,\"longueur\":6,\"fold_change\":1.75,"
+                           "\"occurrences_reelles\":21,\"occurrences_aleatoires\":0}\n") == 0);
+    free(contenu);
+
+    // Binaire : relecture à l'identique, répartition comprise
+    int positions[] = {0, 9}, densites[] = {1, 1}, distances[] = {0, 3};
+    DistributionMotif distribution = {positions, 2, 9, 9, 9, 9.0, 8, 2, densites, 1, 0, distances, 0, 1.5, 0.5};
+    motifs[1].distribution = &distribution;
+    ecrivain = ouvrir_ecrivain_resultats(chemin, FORMAT_BINAIRE);
+    assert(ecrivain != NULL);
+    for (int i = 0; i < 2; i++) assert(ecrire_motif_resultat(ecrivain, &motifs[i]) == 0);
+    assert(fermer_ecrivain_resultats(ecrivain) == 0);
+    int nombre = 0;
+    Motif *relus = lire_motifs_binaires(chemin, &nombre);
+    assert(nombre == 2);
+    assert(strcmp(relus[0].sequence, "ACGT") == 0 && strcmp(relus[1].sequence, "AGGCTT") == 0);
+    assert(relus[1].start_pos == 8 && relus[1].length == 6 && relus[1].fold_change == 1.75);
+    assert(relus[0].occurrences_reelles == 30 && relus[0].occurrences_aleatoires == 12);
+    assert(relus[0].occurrences_approchees_reelles == 41 && relus[1].occurrences_approchees_aleatoires == -1);
+    assert(relus[0].distribution == NULL);
+    const DistributionMotif *relue = relus[1].distribution;
+    assert(relue != NULL && relue->nombre_occurrences == 2 && relue->ecart_median == 9 && relue->ecart_moyen == 9.0);
+    assert(relue->taille_fenetre == 8 && relue->nombre_fenetres == 2 && relue->densite_max == 1);
+    assert(relue->positions[1] == 9 && relue->densites[0] == 1 && relue->distances_genes[1] == 3);
+    assert(relue->distance_moyenne_gene == 1.5 && relue->fraction_intergenique == 0.5);
+    // Les champs sont en petit-boutiste, sans remplissage : position du premier motif juste après la signature
+    FILE *fichier = fopen(chemin, "rb");
+    assert(fichier != NULL);
+    unsigned char octets[16];
+    assert(fread(octets, 1, sizeof(octets), fichier) == sizeof(octets));
+    fclose(fichier);
+    assert(memcmp(octets, "MOTIFS3", 8) == 0 && octets[8] == 0 && octets[12] == 4 && octets[13] == 0);
+    // Fichier tronqué dans l'en-tête du second enregistrement (signature, 40 + 4 octets du premier) : erreur,
+    // aucun motif rendu
+    assert(truncate(chemin, 8 + 40 + 4 + 10) == 0);
+    int nombre_tronque = -1;
+    couper_sortie();
+    assert(lire_motifs_binaires(chemin, &nombre_tronque) == NULL && nombre_tronque == 0);
+    retablir_sortie();
+    for (int i = 0; i < nombre; i++) {
+        free(relus[i].sequence);
+        liberer_distribution_motif(relus[i].distribution);
+    }
+    free(relus);
+
+    remove(chemin);
+    printf("Test de l'écriture des résultats passé avec succès.\n");
+}
+
+// assert index_suffixes.c
+
+// Test de la table des suffixes et de la répartition des copies d'un motif
+void test_index_suffixes() {
+    printf("=== Début du test de l'index des suffixes ===\n");
+
+    // Génome aléatoire contenant des copies d'un motif, à comparer avec la recherche par strstr
+    int longueur = 200000;
+    char *genome = malloc(longueur + 1);
+    assert(genome != NULL);
+    srand(11);
+    for (int i = 0; i < longueur; i++) genome[i] = "ACGT"[rand() % 4];
+    genome[longueur] = '\0';
+    const char *motif = "GATTACAGATTACAGG";
+    int copies[] = {100, 5000, 5016, 5032, 120000, 199984};  // Trois copies accolées, une en fin de génome
+    for (int c = 0; c < 6; c++) memcpy(genome + copies[c], motif, strlen(motif));
+    // Région répétée pour les longs préfixes communs
+    memset(genome + 150000, 'A', 3000);
+
+    IndexSuffixes *index = construire_index_suffixes(genome, longueur);
+    assert(index != NULL);
+
+    // Les suffixes sont triés
+    for (int j = 1; j < longueur; j += 997) {
+        assert(strcmp(genome + index->suffixes[j - 1], genome + index->suffixes[j]) < 0);
+    }
+
+    // Mêmes comptes que rechercher_motif_rapide, avec et sans région exclue
+    const char *requetes[] = {"GATTACA", "AAAAAAAAAA", "CG", "TTT", "GATTACAGATTACAGG", "ACGTACGTACGTACGTAC"};
+    for (int q = 0; q < 6; q++) {
+        int m = strlen(requetes[q]);
+        assert(compter_occurrences_index(index, requetes[q], m, 0, 0, NULL) ==
+               rechercher_motif_rapide((char*)requetes[q], genome, 0, 0));
+        assert(compter_occurrences_index(index, requetes[q], m, 5000, 20, NULL) ==
+               rechercher_motif_rapide((char*)requetes[q], genome, 5000, 20));
+    }
+
+    int nombre = 0;
+    int *positions = positions_occurrences(index, motif, strlen(motif), NULL, &nombre);
+    assert(nombre == 6);
+    for (int c = 0; c < 6; c++) assert(positions[c] == copies[c]);
+    free(positions);
+
+    // Annotation TSV : deux gènes, dont un contenant la copie à 5000
+    const char *chemin = "test_annotation.tmp";
+    FILE *fichier = fopen(chemin, "w");
+    assert(fichier != NULL);
+    fprintf(fichier, "nom\tdebut\tfin\tbrin\ngeneB\t4001\t6000\t-\ngeneA\t1001\t2000\t+\n");
+    fclose(fichier);
+    AnnotationGenes *annotation = charger_annotation_genes(chemin);
+    remove(chemin);
+    assert(annotation != NULL && annotation->nombre == 2);
+    assert(strcmp(annotation->genes[0].nom, "geneA") == 0 && annotation->genes[0].debut == 1000);
+    assert(annotation->genes[1].brin == '-');
+
+    DistributionMotif *distribution = calculer_distribution_motif(index, motif, strlen(motif), NULL, annotation, 10000);
+    assert(distribution != NULL && distribution->nombre_occurrences == 6);
+    assert(distribution->ecart_min == 16 && distribution->ecart_max == 114968);
+    assert(distribution->nombre_fenetres == 20 && distribution->densite_max == 4 && distribution->fenetre_densite_max == 0);
+    assert(distribution->distances_genes[0] == 1000 - (100 + 16));  // Copie à 100 : 884 bases avant geneA
+    assert(distribution->distances_genes[1] == 0 && distribution->distance_min_gene == 0);
+    assert(distribution->distances_genes[4] == 120000 - 6000);
+    assert(distribution->fraction_intergenique == 0.5);
+
+    liberer_distribution_motif(distribution);
+    liberer_annotation_genes(annotation);
+    liberer_index_suffixes(index);
+    free(genome);
+    printf("Test de l'index des suffixes passé avec succès.\n");
+}
+
+// Test du comptage avec mésappariements : l'index donne les mêmes comptes que le parcours du génome
+void test_occurrences_approchees() {
+    printf("=== Début du test des occurrences approchées ===\n");
+
+    int longueur = 50000;
+    char *genome = malloc(longueur + 1);
+    assert(genome != NULL);
+    srand(13);
+    for (int i = 0; i < longueur; i++) genome[i] = "ACGT"[rand() % 4];
+    genome[longueur] = '\0';
+
+    // Copies dégénérées d'un motif : 0, 1, 2 et 3 mésappariements, dont une en fin de génome
+    const char *motif = "GCGCCTGATGCGACGCTT";
+    int m = strlen(motif);
+    int copies[] = {1000, 2000, 3000, 4000, longueur - m};
+    int differences[] = {0, 1, 2, 3, 1};
+    for (int c = 0; c < 5; c++) {
+        memcpy(genome + copies[c], motif, m);
+        for (int d = 0; d < differences[c]; d++) {
+            char *base = genome + copies[c] + 3 + 5 * d;
+            *base = *base == 'A' ? 'C' : 'A';
+        }
+    }
+
+    IndexSuffixes *index = construire_index_suffixes(genome, longueur);
+    assert(index != NULL);
+    for (int d = 0; d <= 3; d++) {
+        int attendu = rechercher_motif_approche(motif, genome, d, 0, 0);
+        assert(compter_occurrences_approchees(index, motif, m, d, 0, 0, NULL) == attendu);
+        assert(compter_occurrences_approchees(index, motif, m, d, 2000, m, NULL) ==
+               rechercher_motif_approche(motif, genome, d, 2000, m));
+    }
+    assert(compter_occurrences_approchees(index, motif, m, 0, 0, 0, NULL) == compter_occurrences_index(index, motif, m, 0, 0, NULL));
+    assert(rechercher_motif_approche(motif, genome, 2, 0, 0) >= 4);
+
+    // Motifs courts : beaucoup d'occurrences, mêmes comptes
+    const char *courts[] = {"ACGTAC", "TTTT", "GATTACA"};
+    for (int q = 0; q < 3; q++) {
+        for (int d = 1; d <= 2; d++) {
+            assert(compter_occurrences_approchees(index, courts[q], strlen(courts[q]), d, 100, 50, NULL) ==
+                   rechercher_motif_approche(courts[q], genome, d, 100, 50));
+        }
+    }
+
+    // Positions : copies à au plus 1 mésappariement
+    int nombre = 0;
+    int *positions = positions_occurrences_approchees(index, motif, m, 1, NULL, &nombre);
+    assert(positions != NULL && nombre == rechercher_motif_approche(motif, genome, 1, 0, 0));
+    assert(positions[0] == 1000 && positions[1] == 2000 && positions[nombre - 1] == longueur - m);
+    free(positions);
+
+    liberer_index_suffixes(index);
+    free(genome);
+    printf("Test des occurrences approchées passé avec succès.\n");
+}
+
+// assert masque_exclusion.c
+
+// Test des masques : fusion des intervalles, lecture BED, comptages identiques au parcours hors positions masquées
+void test_masque_exclusion() {
+    printf("=== Début du test des masques d'exclusion ===\n");
+
+    MasqueExclusion *masque = creer_masque_exclusion(1000);
+    assert(masque != NULL);
+    assert(ajouter_intervalle_masque(masque, 100, 200) == 0);
+    assert(ajouter_intervalle_masque(masque, 300, 400) == 0);
+    assert(ajouter_intervalle_masque(masque, 50, 60) == 0);
+    assert(masque->nombre_intervalles == 3 && masque->debuts[0] == 50);
+    // Un intervalle touchant le premier et chevauchant le second les fusionne
+    assert(ajouter_intervalle_masque(masque, 60, 150) == 0);
+    assert(masque->nombre_intervalles == 2 && masque->debuts[0] == 50 && masque->fins[0] == 200);
+    // Intervalle ramené aux bornes du génome, intervalle vide ignoré
+    assert(ajouter_intervalle_masque(masque, 990, 5000) == 0 && ajouter_intervalle_masque(masque, 500, 500) == 0);
+    assert(masque->nombre_intervalles == 3 && masque->fins[2] == 1000);
+    assert(bases_masquees(masque) == 150 + 100 + 10);
+    assert(position_masquee(masque, 50) && position_masquee(masque, 199) && !position_masquee(masque, 200));
+    assert(position_masquee(masque, 63) && position_masquee(masque, 64) && !position_masquee(masque, 49));
+    assert(!position_masquee(NULL, 100));
+    assert(fin_intervalle_masque(masque, 120) == 200 && fin_intervalle_masque(masque, 250) == 250);
+    liberer_masque_exclusion(masque);
+
+    // Génome aléatoire avec des copies d'un motif, dont deux dans des régions masquées par un fichier BED
+    int longueur = 100000;
+    char *genome = malloc(longueur + 1);
+    assert(genome != NULL);
+    srand(17);
+    for (int i = 0; i < longueur; i++) genome[i] = "ACGT"[rand() % 4];
+    genome[longueur] = '\0';
+    const char *motif = "CATGGTACCATTGA";
+    int m = strlen(motif);
+    int copies[] = {500, 20000, 20100, 61000, 90000};
+    for (int c = 0; c < 5; c++) memcpy(genome + copies[c], motif, m);
+    // Copie à un mésappariement, hors des régions masquées
+    memcpy(genome + 40000, motif, m);
+    genome[40006] = genome[40006] == 'A' ? 'C' : 'A';
+
+    const char *chemin = "test_masque.tmp";
+    FILE *fichier = fopen(chemin, "w");
+    assert(fichier != NULL);
+    fprintf(fichier, "# régions répétées\ntrack name=repetitions\nchr1\t19990\t20050\nchr1\t60000\t62000\tIS1\n"
+                     "70000 70500\n");
+    fclose(fichier);
+    masque = creer_masque_exclusion(longueur);
+    assert(masque != NULL);
+    assert(charger_masque_exclusion(masque, chemin) == 3);
+    remove(chemin);
+    assert(masque->nombre_intervalles == 3 && bases_masquees(masque) == 60 + 2000 + 500);
+
+    IndexSuffixes *index = construire_index_suffixes(genome, longueur);
+    assert(index != NULL);
+
+    // Oracle : parcours de toutes les positions en sautant les débuts masqués
+    const char *requetes[] = {motif, "ACGT", "TTTTTT", "GG"};
+    for (int q = 0; q < 4; q++) {
+        int lq = strlen(requetes[q]);
+        int attendu = 0;
+        for (int i = 0; i + lq <= longueur; i++) {
+            if (!position_masquee(masque, i) && !(i >= 500 && i < 500 + lq) && strncmp(genome + i, requetes[q], lq) == 0) {
+                attendu++;
+            }
+        }
+        assert(compter_occurrences_index(index, requetes[q], lq, 500, lq, masque) == attendu);
+        assert(rechercher_motif_masque(requetes[q], genome, 500, lq, masque) == attendu);
+    }
+    assert(compter_occurrences_index(index, motif, m, 0, 0, masque) == 3);
+    assert(compter_occurrences_index(index, motif, m, 0, 0, NULL) == 5);
+
+    int nombre = 0;
+    int *positions = positions_occurrences(index, motif, m, masque, &nombre);
+    assert(nombre == 3 && positions[0] == 500 && positions[1] == 20100 && positions[2] == 90000);
+    free(positions);
+
+    // Occurrences approchées : mêmes comptes que le parcours, sans les positions masquées
+    for (int d = 1; d <= 2; d++) {
+        int attendu = 0;
+        for (int i = 0; i + m <= longueur; i++) {
+            if (position_masquee(masque, i)) continue;
+            int erreurs = 0;
+            for (int j = 0; j < m && erreurs <= d; j++) erreurs += genome[i + j] != motif[j];
+            if (erreurs <= d) attendu++;
+        }
+        assert(compter_occurrences_approchees(index, motif, m, d, 0, 0, masque) == attendu);
+    }
+    assert(compter_occurrences_approchees(index, motif, m, 1, 0, 0, masque) == 4);
+    positions = positions_occurrences_approchees(index, motif, m, 1, masque, &nombre);
+    assert(positions != NULL && nombre == 4 && positions[2] == 40000 && positions[3] == 90000);
+    free(positions);
+
+    liberer_index_suffixes(index);
+    liberer_masque_exclusion(masque);
+    free(genome);
+    printf("Test des masques d'exclusion passé avec succès.\n");
+}
+
+// Test de la pré-passe de masquage des graines : DUST et k-mers fréquents, comparés à un calcul direct
+void test_masquage_graines() {
+    printf("=== Début du test du masquage des graines ===\n");
+
+    int longueur = 100000;
+    char *genome = malloc(longueur + 1);
+    assert(genome != NULL);
+    srand(19);
+    for (int i = 0; i < longueur; i++) genome[i] = "ACGT"[rand() % 4];
+    genome[longueur] = '\0';
+    // Homopolymère, homopolymère imparfait et répétition d'un k-mer
+    memset(genome + 1000, 'A', 100);
+    memset(genome + 30000, 'T', 80);
+    for (int i = 30005; i < 30080; i += 17) genome[i] = 'G';
+    const char *repete = "GATTAC";
+    for (int c = 0; c < 150; c++) memcpy(genome + 50000 + 40 * c, repete, strlen(repete));
+
+    MasqueExclusion *masque = creer_masque_exclusion(longueur);
+    assert(masque != NULL);
+    assert(masquer_faible_complexite(masque, genome, longueur, FENETRE_DUST, SEUIL_DUST) == 0);
+
+    // Oracle : score DUST recalculé pour chaque fenêtre
+    char *attendu = calloc(longueur, 1);
+    assert(attendu != NULL);
+    for (int debut = 0; debut + FENETRE_DUST <= longueur; debut++) {
+        int comptes[64] = {0};
+        long somme = 0;
+        for (int j = debut; j + 2 < debut + FENETRE_DUST; j++) {
+            int code = 0;
+            for (int b = 0; b < 3; b++) code = code * 4 + (int)(strchr("ACGT", genome[j + b]) - "ACGT");
+            somme += comptes[code]++;
+        }
+        if (somme > (long)SEUIL_DUST * (FENETRE_DUST - 3)) memset(attendu + debut, 1, FENETRE_DUST);
+    }
+    for (int i = 0; i < longueur; i++) assert(position_masquee(masque, i) == attendu[i]);
+    assert(position_masquee(masque, 1000) && position_masquee(masque, 1099) && position_masquee(masque, 30040));
+    assert(bases_masquees(masque) < 1000);  // Le génome aléatoire n'est pas masqué
+    assert(chevauche_masque(masque, 990, 1001) && !chevauche_masque(masque, 500, 506));
+    assert(!chevauche_masque(NULL, 0, longueur));
+    liberer_masque_exclusion(masque);
+
+    // k-mers fréquents : chaque copie d'un k-mer présent plus de 100 fois est masquée
+    IndexSuffixes *index = construire_index_suffixes(genome, longueur);
+    assert(index != NULL);
+    masque = creer_masque_exclusion(longueur);
+    assert(masque != NULL);
+    int k = strlen(repete), copies_max = 100;
+    assert(masquer_kmers_frequents(masque, index, k, copies_max) == 0);
+    memset(attendu, 0, longueur);
+    for (int p = 0; p + k <= longueur; p++) {
+        if (compter_occurrences_index(index, genome + p, k, 0, 0, NULL) > copies_max) memset(attendu + p, 1, k);
+    }
+    for (int i = 0; i < longueur; i++) assert(position_masquee(masque, i) == attendu[i]);
+    assert(position_masquee(masque, 50000) && position_masquee(masque, 50000 + 40 * 149 + 5));
+    assert(chevauche_masque(masque, 49995, 50001) && position_masquee(masque, 1010));
+
+    free(attendu);
+    liberer_masque_exclusion(masque);
+    liberer_index_suffixes(index);
+    free(genome);
+    printf("Test du masquage des graines passé avec succès.\n");
+}
+
+// assert table_kmers.c
+
+// Test des codes glissants et de la table des k-mers, comparés à l'index des suffixes
+void test_table_kmers() {
+    printf("=== Début du test de la table des k-mers ===\n");
+
+    uint64_t code = 0;
+    assert(coder_kmer("ACGT", 4, &code) == 0 && code == 0x1B);
+    assert(coder_kmer("ACNT", 4, &code) == -1);
+    assert(masque_code_kmer(3) == 63 && masque_code_kmer(32) == UINT64_MAX);
+    assert(creer_table_kmers(33, 10) == NULL);
+
+    int longueur = 60000;
+    char *genome = malloc(longueur + 1);
+    assert(genome != NULL);
+    srand(23);
+    for (int i = 0; i < longueur; i++) genome[i] = "ACGT"[rand() % 4];
+    genome[longueur] = '\0';
+    memset(genome + 1000, 'T', 40);  // poly-T : code 2^64 - 1 pour k = 32
+    memcpy(genome + 20000, genome + 500, 600);  // La région est copiée ailleurs
+
+    IndexSuffixes *index = construire_index_suffixes(genome, longueur);
+    assert(index != NULL);
+    MasqueExclusion *masque = creer_masque_exclusion(longueur);
+    assert(masque != NULL && ajouter_intervalle_masque(masque, 20100, 20200) == 0);
+
+    // Pour chaque longueur, les k-mers de la région [500, 1100) sont comptés en un parcours du génome
+    int longueurs[] = {1, 6, 11, 31, 32};
+    for (int l = 0; l < 5; l++) {
+        int k = longueurs[l];
+        TableKmers *table = creer_table_kmers(k, 600);
+        assert(table != NULL);
+        for (int p = 500; p + k <= 1100; p++) {
+            assert(coder_kmer(genome + p, k, &code) == 0 && inserer_kmer(table, code) == 0);
+        }
+        compter_kmers_genome(table, genome, longueur, masque);
+
+        // Le code glissant retrouve celui de chaque k-mer
+        uint64_t glissant = 0;
+        for (int p = 0; p < 1100; p++) {
+            glissant = ((glissant << 2) | (uint64_t)code_nucleotide(genome[p])) & masque_code_kmer(k);
+            if (p >= 500 + k - 1) {
+                assert(coder_kmer(genome + p - k + 1, k, &code) == 0 && code == glissant);
+                int32_t *compte = trouver_kmer(table, code);
+                assert(compte != NULL && *compte == compter_occurrences_index(index, genome + p - k + 1, k, 0, 0, masque));
+            }
+        }
+        assert(coder_kmer(genome + 5000, k, &code) == 0);
+        if (k >= 11) assert(trouver_kmer(table, code) == NULL);
+        liberer_table_kmers(table);
+    }
+
+    liberer_masque_exclusion(masque);
+    liberer_index_suffixes(index);
+    free(genome);
+    printf("Test de la table des k-mers passé avec succès.\n");
+}
+
+// assert pool_threads.c
+
+typedef struct {
+    PoolThreads *pool;
+    int64_t *sommes;
+    int64_t *sommes_imbriquees;
+    int erreurs;
+} BoucleTest;
+
+static void sommer_bloc_interne(const BlocParallele *bloc, void *contexte) {
+    int64_t *somme = contexte;
+    for (int64_t i = bloc->debut; i < bloc->fin; i++) *somme += i;
+}
+
+static void sommer_bloc(const BlocParallele *bloc, void *contexte) {
+    BoucleTest *test = contexte;
+    if (bloc->debut != 3 + bloc->indice * 4096 || bloc->fin_lecture != bloc->fin + 9) {
+        __atomic_fetch_add(&test->erreurs, 1, __ATOMIC_RELAXED);
+    }
+    for (int64_t i = bloc->debut; i < bloc->fin; i++) test->sommes[bloc->indice] += i;
+    // Boucle imbriquée : exécutée dans le thread du bloc, sans bloquer le pool
+    if (bloc->indice % 50 == 0) {
+        pool_parallel_for(test->pool, 0, 1000, 100, 0, sommer_bloc_interne, &test->sommes_imbriquees[bloc->indice]);
+    }
+}
+
+// Test du pool de threads : découpage, fusion ordonnée et résultats identiques aux parcours séquentiels
+void test_pool_threads() {
+    printf("=== Début du test du pool de threads ===\n");
+    PoolThreads *precedent = pool_global();
+    PoolThreads *pool = creer_pool_threads(4);
+    assert(pool != NULL && nombre_threads_pool(pool) >= 1 && nombre_threads_pool(NULL) == 1);
+
+    // Somme des positions par bloc, avec et sans threads
+    int64_t nombre_blocs = nombre_blocs_parallele(3, 1000003, 4096);
+    assert(nombre_blocs == 245 && nombre_blocs_parallele(5, 5, 10) == 0);
+    for (int essai = 0; essai < 2; essai++) {
+        BoucleTest test = {essai == 0 ? pool : NULL, calloc(nombre_blocs, sizeof(int64_t)),
+                           calloc(nombre_blocs, sizeof(int64_t)), 0};
+        assert(test.sommes != NULL && test.sommes_imbriquees != NULL);
+        pool_parallel_for(test.pool, 3, 1000003, 4096, 9, sommer_bloc, &test);
+        int64_t somme = 0;
+        for (int64_t b = 0; b < nombre_blocs; b++) {
+            somme += test.sommes[b];
+            assert(test.sommes_imbriquees[b] == (b % 50 == 0 ? 499500 : 0));
+        }
+        assert(test.erreurs == 0 && somme == (int64_t)1000000 * 1000005 / 2);
+        free(test.sommes);
+        free(test.sommes_imbriquees);
+    }
+
+    definir_pool_global(pool);
+
+    // Gène à cheval sur deux blocs, puis présent deux fois
+    int longueur = 140000;
+    char *genome = malloc(longueur + 1);
+    assert(genome != NULL);
+    srand(29);
+    for (int i = 0; i < longueur; i++) genome[i] = "ACGT"[rand() % 4];
+    genome[longueur] = '\0';
+    char gene[101];
+    memcpy(gene, genome + 1000, 100);
+    gene[100] = '\0';
+    int position = TAILLE_BLOC_PARALLELE - 50;
+    memcpy(genome + position, gene, 100);
+    genome[position + 70] = genome[position + 70] == 'A' ? 'C' : 'A';  // Copie à 99 % d'identité
+    memset(genome + 1000, 'T', 100);
+    assert(rechercher_gene_parallele(genome, gene, 0.98) == position + 1);
+    assert(rechercher_gene(genome, gene, 0.98) == position + 1);
+    memcpy(genome + 100000, gene, 100);
+    assert(rechercher_gene_parallele(genome, gene, 0.98) == -1 && rechercher_gene(genome, gene, 0.98) == -1);
+    int copies[1];
+    float identites_copies[1];
+    assert(lister_copies_gene_parallele(genome, gene, 0.98, copies, identites_copies, 1) == 2 && copies[0] == position);
+
+    // Boîtes consensus dans un génome sans A ni T, dont une paire à cheval sur deux blocs
+    for (int i = 0; i < longueur; i++) genome[i] = "CG"[rand() % 2];
+    int paires[] = {10, TAILLE_BLOC_PARALLELE - 20, 2 * TAILLE_BLOC_PARALLELE - 6};
+    for (int p = 0; p < 3; p++) {
+        memcpy(genome + paires[p], "TTGACA", 6);
+        memcpy(genome + paires[p] + 6 + 17, "TATAAT", 6);
+    }
+    assert(rechercher_seq_consensus_parallele(genome, BOITE_35, BOITE_10, 0, 0) == 3);
+    assert(rechercher_seq_consensus(genome, BOITE_35, BOITE_10, 0, 0) == 3);
+    assert(rechercher_seq_consensus_parallele(genome, BOITE_35, BOITE_10, paires[1] + 40, 60) == 1);
+
+    // Génération : même séquence quel que soit le nombre de threads
+    char *avec_pool = generer_sequence_parallele(longueur, 12345);
+    definir_pool_global(NULL);
+    char *sans_pool = generer_sequence_parallele(longueur, 12345);
+    char *autre_graine = generer_sequence_parallele(longueur, 54321);
+    definir_pool_global(pool);
+    assert(avec_pool != NULL && sans_pool != NULL && autre_graine != NULL);
+    assert(strcmp(avec_pool, sans_pool) == 0 && strcmp(avec_pool, autre_graine) != 0);
+    int compte_a = 0;
+    for (int i = 0; i < longueur; i++) {
+        assert(strchr("ACGT", avec_pool[i]) != NULL);
+        compte_a += avec_pool[i] == 'A';
+    }
+    assert(compte_a > longueur * 0.236 && compte_a < longueur * 0.256);
+
+    // Comptage des k-mers : mêmes comptes qu'en un seul parcours
+    TableKmers *sequentielle = creer_table_kmers(8, 1000);
+    TableKmers *parallele = creer_table_kmers(8, 1000);
+    assert(sequentielle != NULL && parallele != NULL);
+    uint64_t code;
+    for (int p = 100000; p < 101000; p++) {
+        assert(coder_kmer(avec_pool + p, 8, &code) == 0);
+        inserer_kmer(sequentielle, code);
+        inserer_kmer(parallele, code);
+    }
+    compter_kmers_genome(sequentielle, avec_pool, longueur, NULL);
+    compter_kmers_genome_parallele(parallele, avec_pool, longueur, NULL);
+    for (int c = 0; c < sequentielle->capacite; c++) {
+        if (sequentielle->comptes[c] < 0) continue;
+        int32_t *compte = trouver_kmer(parallele, sequentielle->codes[c]);
+        assert(compte != NULL && *compte == sequentielle->comptes[c]);
+    }
+
+    liberer_table_kmers(sequentielle);
+    liberer_table_kmers(parallele);
+    free(avec_pool);
+    free(sans_pool);
+    free(autre_graine);
+    free(genome);
+    definir_pool_global(precedent);
+    detruire_pool_threads(pool);
+    printf("Test du pool de threads passé avec succès.\n");
+}
+
+// assert repetitions_maximales.c
+
+// Nombre d'occurrences de la chaîne `motif` (longueur m), lu dans l'index
+static int compter_chaine(const IndexSuffixes *index, const char *motif, int m) {
+    return compter_occurrences_index(index, motif, m, 0, 0, NULL);
+}
+
+// Une chaîne est une répétition maximale si aucune base ajoutée à gauche ou à droite ne garde toutes ses copies
+static bool repetition_maximale_exhaustive(const IndexSuffixes *index, const char *motif, int m, int copies) {
+    char etendu[128];
+    for (int b = 0; b < 4; b++) {
+        etendu[0] = "ACGT"[b];
+        memcpy(etendu + 1, motif, m);
+        if (compter_chaine(index, etendu, m + 1) == copies) return false;
+        memcpy(etendu, motif, m);
+        etendu[m] = "ACGT"[b];
+        if (compter_chaine(index, etendu, m + 1) == copies) return false;
+    }
+    return true;
+}
+
+// Test de la table LCP et des répétitions maximales, comparées à une recherche exhaustive
+void test_repetitions_maximales() {
+    printf("=== Début du test des répétitions maximales ===\n");
+    int longueur = 3000;
+    char *genome = malloc(longueur + 1);
+    assert(genome != NULL);
+    srand(41);
+    for (int i = 0; i < longueur; i++) genome[i] = "ACGT"[rand() % 4];
+    genome[longueur] = '\0';
+
+    // Une répétition de 30 bases en 5 copies (l'originale, une en début de génome et une dans la région),
+    // et deux copies supplémentaires de ses 20 premières bases seulement
+    char repetition[31];
+    memcpy(repetition, genome + 500, 30);
+    int copies[] = {0, 1050, 1900, 2500};
+    for (int c = 0; c < 4; c++) memcpy(genome + copies[c], repetition, 30);
+    memcpy(genome + 2200, repetition, 20);
+    memcpy(genome + 2700, repetition, 20);
+    genome[2220] = repetition[20] == 'A' ? 'C' : 'A';
+    genome[2720] = repetition[20] == 'G' ? 'T' : 'G';
+
+    IndexSuffixes *index = construire_index_suffixes(genome, longueur);
+    int32_t *lcp = calculer_lcp(index);
+    assert(index != NULL && lcp != NULL && lcp[0] == 0);
+    for (int r = 1; r < longueur; r++) {
+        int p = index->suffixes[r - 1], q = index->suffixes[r], h = 0;
+        while (p + h < longueur && q + h < longueur && genome[p + h] == genome[q + h]) h++;
+        assert(lcp[r] == h);
+    }
+
+    int debut_region = 1000, fin_region = 1200, longueur_min = 8, copies_min = 3;
+    int nombre;
+    RepetitionMaximale *repetitions = rechercher_repetitions_maximales(index, lcp, debut_region, fin_region,
+                                                                       longueur_min, copies_min, &nombre);
+    assert(repetitions != NULL);
+
+    // Chaque répétition trouvée est maximale, chevauche la région, et sa position est la dernière possible
+    bool repetition_longue = false, prefixe = false;
+    for (int r = 0; r < nombre; r++) {
+        const char *motif = genome + repetitions[r].position;
+        int m = repetitions[r].longueur;
+        assert(m >= longueur_min && m < 100);
+        assert(repetitions[r].position < fin_region && repetitions[r].position + m > debut_region);
+        assert(compter_chaine(index, motif, m) == repetitions[r].copies && repetitions[r].copies >= copies_min);
+        assert(repetition_maximale_exhaustive(index, motif, m, repetitions[r].copies));
+        int nombre_positions_test;
+        int *positions_motif = positions_occurrences(index, motif, m, NULL, &nombre_positions_test);
+        for (int j = 0; j < nombre_positions_test; j++) {
+            assert(positions_motif[j] <= repetitions[r].position || positions_motif[j] >= fin_region);
+        }
+        free(positions_motif);
+        repetition_longue |= m == 30 && repetitions[r].position == 1050 && repetitions[r].copies == 5;
+        prefixe |= m == 20 && repetitions[r].copies == 7;
+    }
+    assert(repetition_longue && prefixe);
+
+    // Recherche exhaustive : chaque sous-chaîne chevauchant la région qui est une répétition maximale est trouvée
+    int attendues = 0;
+    for (int p = debut_region - 60; p < fin_region; p++) {
+        for (int m = longueur_min; m <= 60 && p + m <= longueur; m++) {
+            if (p + m <= debut_region) continue;
+            int c = compter_chaine(index, genome + p, m);
+            if (c < copies_min || !repetition_maximale_exhaustive(index, genome + p, m, c)) continue;
+            // Une seule fois par chaîne : à sa dernière occurrence avant la fin de la région
+            bool derniere = true;
+            for (int q = p + 1; q < fin_region && derniere; q++) derniere = memcmp(genome + q, genome + p, m) != 0;
+            if (!derniere) continue;
+            attendues++;
+            bool trouvee = false;
+            for (int r = 0; r < nombre && !trouvee; r++) {
+                trouvee = repetitions[r].position == p && repetitions[r].longueur == m;
+            }
+            assert(trouvee);
+        }
+    }
+    assert(attendues == nombre);
+
+    free(repetitions);
+    free(lcp);
+    liberer_index_suffixes(index);
+    free(genome);
+    printf("Test des répétitions maximales passé avec succès.\n");
+}
+
+// assert stock_motifs.c
+
+// Test du stock de motifs : colonnes, séquences lues dans le génome ou la réserve, tri, sélection et filtrage
+void test_stock_motifs() {
+    printf("=== Début du test du stock de motifs ===\n");
+    const char *genome = "ACGTTGCAAGGCTTAACCGGTTAAGCTAGCTAGGATCC";
+    StockMotifs *stock = creer_stock_motifs(genome, 2);
+    assert(stock != NULL && stock->capacite == 2);
+
+    // Agrandissement des colonnes au fil des ajouts
+    int positions[] = {20, 4, 12, 0, 8};
+    int longueurs[] = {6, 5, 8, 5, 4};
+    double fold_changes[] = {3.0, 7.5, 7.5, 2.0, 1.6};
+    for (int i = 0; i < 5; i++) {
+        assert(ajouter_motif_stock(stock, NULL, positions[i], longueurs[i], fold_changes[i], 30 + i, 4) == i);
+    }
+    assert(stock->nombre == 5 && stock->capacite >= 5);
+    assert(strncmp(sequence_motif_stock(stock, 1), "TGCAA", 5) == 0 && stock->approchees_reelles[1] == -1);
+    Motif vue = vue_motif_stock(stock, 2);
+    assert(vue.start_pos == 12 && vue.length == 8 && strncmp(vue.sequence, "TTAACCGG", 8) == 0);
+
+    // Meilleurs motifs : à égalité de fold change, le premier ajouté passe devant
+    int indices[3];
+    assert(meilleurs_motifs_stock(stock, CRITERE_FOLD_CHANGE, 0, 3, indices) == 3);
+    assert(indices[0] == 1 && indices[1] == 2 && indices[2] == 0);
+    assert(meilleurs_motifs_stock(stock, CRITERE_DISTANCE_GENE, 10, 1, indices) == 1 && indices[0] == 2);
+    assert(meilleurs_motifs_stock(stock, CRITERE_LONGUEUR, 0, 3, indices) == 3 && indices[0] == 2 && indices[1] == 0);
+
+    // Tri stable par fold change puis par position : toutes les colonnes suivent
+    stock->occurrences_aleatoires[3] = 9;
+    assert(trier_stock_motifs(stock, CRITERE_FOLD_CHANGE, 0) == 0);
+    assert(stock->positions[0] == 4 && stock->positions[1] == 12 && stock->positions[4] == 8);
+    assert(trier_stock_motifs(stock, CRITERE_POSITION, 0) == 0);
+    for (int i = 1; i < stock->nombre; i++) assert(stock->positions[i - 1] < stock->positions[i]);
+    assert(stock->positions[0] == 0 && stock->occurrences_aleatoires[0] == 9 && stock->occurrences_reelles[0] == 33);
+    assert(strncmp(sequence_motif_stock(stock, 0), "ACGTT", 5) == 0);
+
+    // Filtrage en place, dans l'ordre
+    assert(filtrer_stock_motifs(stock, 2.5, 5, 0) == 3);
+    assert(stock->positions[0] == 4 && stock->positions[1] == 12 && stock->positions[2] == 20);
+    liberer_stock_motifs(stock);
+
+    // Sans génome : séquences copiées dans une réserve unique, qui suit les tris
+    stock = creer_stock_motifs(NULL, 0);
+    assert(stock != NULL);
+    char sequence[32];
+    for (int i = 0; i < 1000; i++) {
+        snprintf(sequence, sizeof(sequence), "M%04d", i);
+        assert(ajouter_motif_stock(stock, sequence, 1000 - i, 5, i % 7, 20, 1) == i);
+    }
+    assert(ajouter_motif_stock(stock, NULL, 0, 5, 1.0, 20, 1) == -1 && stock->nombre == 1000);
+    assert(trier_stock_motifs(stock, CRITERE_POSITION, 0) == 0);
+    assert(strncmp(sequence_motif_stock(stock, 0), "M0999", 5) == 0 && stock->positions[0] == 1);
+    assert(filtrer_stock_motifs(stock, 6, 0, 0) == 142);
+    assert(strncmp(sequence_motif_stock(stock, 0), "M0993", 5) == 0);
+    liberer_stock_motifs(stock);
+    printf("Test du stock de motifs passé avec succès.\n");
+}
+
+// assert spectre_kmers.c
+
+// Test du spectre : comptes identiques à l'index des suffixes, quel que soit le nombre de threads
+void test_spectre_kmers() {
+    printf("=== Début du test du spectre des k-mers ===\n");
+    PoolThreads *precedent = pool_global();
+    PoolThreads *pool = creer_pool_threads(4);
+    assert(pool != NULL);
+    definir_pool_global(pool);
+
+    // Génome aléatoire contenant 40 copies d'un 12-mer
+    int longueur = 200000;
+    char *genome = generer_sequence_parallele(longueur, 2024);
+    assert(genome != NULL);
+    const char *plante = "GATTACAGGCTA";
+    for (int c = 0; c < 40; c++) memcpy(genome + 1000 + c * 4000, plante, 12);
+
+    SpectreKmers *spectre = calculer_spectre_kmers(genome, longueur, 12);
+    assert(spectre != NULL && spectre->nombre_total == longueur - 11);
+    int64_t total = 0, distincts = 0;
+    for (int c = 1; c <= spectre->occurrences_max; c++) {
+        total += (int64_t)c * spectre->spectre[c];
+        distincts += spectre->spectre[c];
+    }
+    assert(total == spectre->nombre_total && distincts == spectre->nombre_distincts);
+    for (int64_t i = 1; i < spectre->nombre_distincts; i++) assert(spectre->codes[i - 1] < spectre->codes[i]);
+
+    IndexSuffixes *index = construire_index_suffixes(genome, longueur);
+    assert(index != NULL);
+    uint64_t code;
+    for (int p = 0; p + 12 <= longueur; p += 997) {
+        assert(coder_kmer(genome + p, 12, &code) == 0);
+        assert(occurrences_kmer_spectre(spectre, code) ==
+               compter_occurrences_index(index, genome + p, 12, 0, 0, NULL));
+    }
+    assert(coder_kmer(plante, 12, &code) == 0 && occurrences_kmer_spectre(spectre, code) >= 40);
+
+    // Même spectre sans threads
+    definir_pool_global(NULL);
+    SpectreKmers *sequentiel = calculer_spectre_kmers(genome, longueur, 12);
+    definir_pool_global(pool);
+    assert(sequentiel != NULL && sequentiel->nombre_distincts == spectre->nombre_distincts);
+    assert(memcmp(sequentiel->codes, spectre->codes, spectre->nombre_distincts * sizeof(uint64_t)) == 0);
+    assert(memcmp(sequentiel->comptes, spectre->comptes, spectre->nombre_distincts * sizeof(int32_t)) == 0);
+    liberer_spectre_kmers(sequentiel);
+
+    // Le k-mer planté est le plus surreprésenté par rapport au modèle d'ordre 3
+    int nombre;
+    KmerSurrepresente *kmers = kmers_surrepresentes(spectre, genome, longueur, ORDRE_MODELE_FOND, 5, &nombre);
+    assert(kmers != NULL && nombre == 5 && kmers[0].code == code && kmers[0].occurrences >= 40);
+    for (int i = 1; i < nombre; i++) assert(kmers[i - 1].score >= kmers[i].score);
+    assert(kmers[0].attendues > 0 && kmers[0].attendues < 1);
+    free(kmers);
+    liberer_spectre_kmers(spectre);
+
+    // Grands k (aucune répétition fortuite) et petits k (moins de bases de partition)
+    spectre = calculer_spectre_kmers(genome, longueur, LONGUEUR_MAX_KMER_SPECTRE);
+    assert(spectre != NULL && spectre->occurrences_max < 40 && spectre->nombre_distincts > spectre->nombre_total - 100);
+    liberer_spectre_kmers(spectre);
+    spectre = calculer_spectre_kmers(genome, longueur, 2);
+    assert(spectre != NULL && spectre->nombre_distincts == 16);
+    assert(coder_kmer("AC", 2, &code) == 0 &&
+           occurrences_kmer_spectre(spectre, code) == compter_occurrences_index(index, "AC", 2, 0, 0, NULL));
+    liberer_spectre_kmers(spectre);
+    assert(calculer_spectre_kmers(genome, longueur, LONGUEUR_MAX_KMER_SPECTRE + 1) == NULL);
+
+    // Les bases autres que ACGT interrompent les k-mers ; modèle d'ordre 0 : N * produit des fréquences
+    spectre = calculer_spectre_kmers("AACGTNAACGTAAC", 14, 3);
+    assert(spectre != NULL && spectre->nombre_total == 9);
+    assert(coder_kmer("AAC", 3, &code) == 0 && occurrences_kmer_spectre(spectre, code) == 3);
+    assert(coder_kmer("GTA", 3, &code) == 0 && occurrences_kmer_spectre(spectre, code) == 1);
+    assert(coder_kmer("TNA", 3, &code) != 0);
+    int64_t comptes_bases[4] = {5, 3, 2, 2};
+    assert(coder_kmer("ACG", 3, &code) == 0);
+    double attendu = occurrences_attendues_kmer(code, 3, 0, NULL, comptes_bases, 12);
+    assert(attendu > 5.0 * 3 * 2 / 144 - 1e-9 && attendu < 5.0 * 3 * 2 / 144 + 1e-9);
+    liberer_spectre_kmers(spectre);
+
+    liberer_index_suffixes(index);
+    free(genome);
+    definir_pool_global(precedent);
+    detruire_pool_threads(pool);
+    printf("Test du spectre des k-mers passé avec succès.\n");
+}
+
+// assert serveur_requetes.c
+
+typedef struct {
+    ServeurGenome *serveur;
+    int socket_ecoute;
+} ServeurTest;
+
+static void* servir_requetes_test(void *argument) {
+    ServeurTest *test = argument;
+    servir_requetes(test->serveur, test->socket_ecoute);
+    return NULL;
+}
+
+static int connecter_client_test(const char *chemin_socket) {
+    struct sockaddr_un adresse;
+    memset(&adresse, 0, sizeof(adresse));
+    adresse.sun_family = AF_UNIX;
+    strcpy(adresse.sun_path, chemin_socket);
+    int descripteur = socket(AF_UNIX, SOCK_STREAM, 0);
+    assert(descripteur >= 0);
+    assert(connect(descripteur, (struct sockaddr*)&adresse, sizeof(adresse)) == 0);
+    return descripteur;
+}
+
+// Envoie des requêtes d'un seul bloc et lit autant de lignes de réponse
+static void echanger_requetes_test(int descripteur, const char *requetes, int nombre_lignes, char *reponses,
+                                   size_t taille) {
+    assert(write(descripteur, requetes, strlen(requetes)) == (ssize_t)strlen(requetes));
+    size_t lus = 0;
+    int lignes = 0;
+    while (lignes < nombre_lignes) {
+        ssize_t n = read(descripteur, reponses + lus, taille - 1 - lus);
+        assert(n > 0);
+        for (ssize_t i = 0; i < n; i++) lignes += reponses[lus + i] == '\n';
+        lus += n;
+    }
+    reponses[lus] = '\0';
+}
+
+// Test du serveur : réponses aux requêtes, puis échange sur une socket Unix
+void test_serveur_requetes() {
+    printf("=== Début du test du serveur de requêtes ===\n");
+    int longueur = 20000;
+    char *genome = generer_sequence_parallele(longueur, 41);
+    assert(genome != NULL);
+    memcpy(genome + 9000, "TTGACA", 6);
+    memcpy(genome + 9023, "TATAAT", 6);
+    char gene[301];
+    memcpy(gene, genome + 5000, 300);
+    gene[300] = '\0';
+    GeneAnnote genes[1] = {{5000, 5300, '+', "geneA"}};
+    int fin_max[1] = {5300};
+    AnnotationGenes annotation = {genes, 1, fin_max};
+
+    ServeurGenome *serveur = creer_serveur_genome(genome, longueur, &annotation, NULL);
+    assert(serveur != NULL);
+    char *reponse;
+    char attendu[64];
+
+    // COUNT et POS donnent les mêmes résultats que l'index
+    snprintf(attendu, sizeof(attendu), "OK %d", compter_occurrences_index(serveur->index, "ACGTA", 5, 0, 0, NULL));
+    assert(repondre_requete(serveur, "COUNT ACGTA", &reponse) == ACTION_CONTINUER && strcmp(reponse, attendu) == 0);
+    free(reponse);
+    snprintf(attendu, sizeof(attendu), "OK %d",
+             compter_occurrences_approchees(serveur->index, "ACGTAC", 6, 1, 0, 0, NULL));
+    assert(repondre_requete(serveur, "COUNT ACGTAC 1\r", &reponse) == ACTION_CONTINUER && strcmp(reponse, attendu) == 0);
+    free(reponse);
+    char requete[64];
+    snprintf(requete, sizeof(requete), "POS %.20s", genome + 12345);
+    assert(repondre_requete(serveur, requete, &reponse) == ACTION_CONTINUER && strcmp(reponse, "OK 1 12345") == 0);
+    free(reponse);
+
+    // GENE : alignement d'une séquence, ou recherche d'un nom dans l'annotation
+    char *requete_gene = malloc(strlen(gene) + 8);
+    assert(requete_gene != NULL);
+    sprintf(requete_gene, "GENE %s", gene);
+    assert(repondre_requete(serveur, requete_gene, &reponse) == ACTION_CONTINUER);
+    assert(strncmp(reponse, "OK 1 5000:5300:+:1.0000:300M", 28) == 0);
+    free(reponse);
+    free(requete_gene);
+    assert(repondre_requete(serveur, "GENE geneA", &reponse) == ACTION_CONTINUER && strcmp(reponse, "OK 1 5000:5300:+") == 0);
+    free(reponse);
+
+    // PROMOTEUR : paires de boîtes en amont d'une position
+    int paires[64];
+    int nombre_paires = lister_paires_consensus(genome, 9050 - 100, 9050, BOITE_35, BOITE_10, paires, 32);
+    assert(nombre_paires >= 1);
+    snprintf(attendu, sizeof(attendu), "OK %d", nombre_paires);
+    assert(repondre_requete(serveur, "PROMOTEUR 9050 100", &reponse) == ACTION_CONTINUER);
+    assert(strncmp(reponse, attendu, strlen(attendu)) == 0 && strstr(reponse, " 9000:9023") != NULL);
+    free(reponse);
+
+    // Erreurs et commandes de contrôle
+    assert(repondre_requete(serveur, "COUNT ACNGT", &reponse) == ACTION_CONTINUER && strncmp(reponse, "ERR", 3) == 0);
+    free(reponse);
+    assert(repondre_requete(serveur, "INCONNUE", &reponse) == ACTION_CONTINUER && strncmp(reponse, "ERR", 3) == 0);
+    free(reponse);
+    assert(repondre_requete(serveur, "PROMOTEUR 30000", &reponse) == ACTION_CONTINUER && strncmp(reponse, "ERR", 3) == 0);
+    free(reponse);
+    assert(repondre_requete(serveur, "QUIT", &reponse) == ACTION_FERMER);
+    free(reponse);
+    assert(repondre_requete(serveur, "ARRET", &reponse) == ACTION_ARRETER);
+    free(reponse);
+
+    // Échange sur une socket : un lot de deux requêtes, puis un second client qui arrête le serveur
+    char chemin_socket[64];
+    snprintf(chemin_socket, sizeof(chemin_socket), "/tmp/projet_bioinfo_test_%d.sock", (int)getpid());
+    ServeurTest test = {serveur, ouvrir_socket_serveur(chemin_socket)};
+    assert(test.socket_ecoute >= 0);
+    pthread_t thread;
+    assert(pthread_create(&thread, NULL, servir_requetes_test, &test) == 0);
+
+    char reponses[1024];
+    int client = connecter_client_test(chemin_socket);
+    snprintf(requete, sizeof(requete), "POS %.20s\nCOUNT ACGTA\n", genome + 12345);
+    echanger_requetes_test(client, requete, 2, reponses, sizeof(reponses));
+    snprintf(attendu, sizeof(attendu), "OK %d\tlatence_us=",
+             compter_occurrences_index(serveur->index, "ACGTA", 5, 0, 0, NULL));
+    assert(strncmp(reponses, "OK 1 12345\tlatence_us=", 22) == 0 && strstr(reponses, attendu) != NULL);
+    echanger_requetes_test(client, "QUIT\n", 1, reponses, sizeof(reponses));
+    assert(strncmp(reponses, "OK\t", 3) == 0);
+    close(client);
+
+    client = connecter_client_test(chemin_socket);
+    echanger_requetes_test(client, "STATS\n", 1, reponses, sizeof(reponses));
+    assert(strncmp(reponses, "OK requetes=3 ", 14) == 0);
+
+    // Un client qui ne lit pas ses réponses ne bloque pas les autres, et il est déconnecté
+    // (le message de la déconnexion est attendu)
+    couper_sortie();
+    int client_lent = connecter_client_test(chemin_socket);
+    int requetes_lentes = 2000;  // Réponses de plusieurs Ko chacune : bien plus que TAILLE_MAX_SORTIE_CLIENT
+    char *lot_lent = malloc(6 * requetes_lentes + 1);
+    assert(lot_lent != NULL);
+    for (int r = 0; r < requetes_lentes; r++) memcpy(lot_lent + 6 * r, "POS A\n", 6);
+    lot_lent[6 * requetes_lentes] = '\0';
+    assert(write(client_lent, lot_lent, 6 * requetes_lentes) == 6 * requetes_lentes);
+    free(lot_lent);
+    echanger_requetes_test(client, "COUNT ACGTA\n", 1, reponses, sizeof(reponses));
+    assert(strncmp(reponses, "OK ", 3) == 0);
+    char lecture[65536];
+    int lignes_lues = 0;
+    for (ssize_t n; (n = read(client_lent, lecture, sizeof(lecture))) > 0;) {
+        for (ssize_t i = 0; i < n; i++) lignes_lues += lecture[i] == '\n';
+    }
+    assert(lignes_lues < requetes_lentes);
+    close(client_lent);
+    retablir_sortie();
+
+    echanger_requetes_test(client, "ARRET\n", 1, reponses, sizeof(reponses));
+    close(client);
+    assert(pthread_join(thread, NULL) == 0);
+    assert(serveur->requetes > 5 && serveur->latence_max_us > 0);
+    close(test.socket_ecoute);
+    unlink(chemin_socket);
+
+    liberer_serveur_genome(serveur);
+    free(genome);
+    printf("Test du serveur de requêtes passé avec succès.\n");
+}
+
+// assert libprojet.c
+
+typedef struct {
+    const GenomeProjet *genome;
+    const int *attendus;
+    int erreurs;
+} RequetesParalleles;
+
+// Compte, depuis un thread, les 12-mers commençant tous les 50 bases
+static void* compter_motifs_thread(void *argument) {
+    RequetesParalleles *requetes = argument;
+    const char *sequence = projet_sequence_genome(requetes->genome);
+    for (int p = 0, i = 0; p + 12 <= projet_longueur_genome(requetes->genome); p += 50, i++) {
+        if (projet_compter_motif(requetes->genome, sequence + p, 12, i % 2) != requetes->attendus[i]) {
+            requetes->erreurs++;
+        }
+    }
+    return NULL;
+}
+
+// Test de la bibliothèque : génome chargé une fois, requêtes silencieuses, depuis plusieurs threads
+void test_libprojet() {
+    printf("=== Début du test de la bibliothèque libprojet ===\n");
+    int longueur = 30000;
+    char *sequence = generer_sequence_parallele(longueur, 42);
+    assert(sequence != NULL);
+    // 25 copies d'un 30-mer, et une paire de boîtes consensus
+    for (int c = 1; c < 25; c++) memcpy(sequence + 1000 * c, sequence + 100, 30);
+    memcpy(sequence + 27000, "TTGACA", 6);
+    memcpy(sequence + 27023, "TATAAT", 6);
+
+    GenomeProjet *genome = projet_creer_genome(sequence, longueur);
+    assert(genome != NULL && projet_longueur_genome(genome) == longueur);
+    assert(memcmp(projet_sequence_genome(genome), sequence, longueur) == 0);
+
+    // Gène
+    char gene[301];
+    memcpy(gene, sequence + 15000, 300);
+    gene[300] = '\0';
+    ProjetGene genes[4];
+    assert(projet_rechercher_gene(genome, gene, 0.9, genes, 4) == 1);
+    assert(genes[0].debut == 15000 && genes[0].fin == 15300 && genes[0].brin == '+' && strcmp(genes[0].cigar, "300M") == 0);
+    projet_liberer_genes(genes, 1);
+    // Gène plus court qu'une graine : balayage sans indels, dont le complément inverse placé en 21500 (dans une copie)
+    char gene_court[11] = "";
+    memcpy(gene_court, sequence + 20500, 10);
+    char *sequence_court = malloc(longueur);
+    assert(sequence_court != NULL);
+    memcpy(sequence_court, sequence, longueur);
+    ecrire_complement_inverse(gene_court, 10, sequence_court + 21500);
+    GenomeProjet *genome_court = projet_creer_genome(sequence_court, longueur);
+    assert(genome_court != NULL);
+    assert(projet_rechercher_gene(genome_court, gene_court, 1.0, genes, 4) == 2);
+    assert(genes[0].debut == 20500 && genes[0].brin == '+' && genes[1].debut == 21500 && genes[1].brin == '-');
+    assert(strcmp(genes[1].cigar, "10M") == 0 && genes[1].score == 20);
+    projet_liberer_genes(genes, 2);
+    assert(projet_rechercher_gene(genome_court, gene_court, 1.0, genes, 1) == 2 && genes[0].debut == 20500);
+    projet_liberer_genes(genes, 1);
+    // Pool de la bibliothèque : chaque changement détruit le précédent, puis le pool du programme est rétabli
+    PoolThreads *pool_programme = pool_global();
+    assert(projet_definir_threads(0) == -1);
+    assert(projet_definir_threads(3) == 0 && nombre_threads_pool(pool_global()) == 3);
+    assert(projet_definir_threads(2) == 0 && nombre_threads_pool(pool_global()) == 2);
+    assert(projet_rechercher_gene(genome_court, gene_court, 1.0, genes, 4) == 2 && genes[1].debut == 21500);
+    projet_liberer_genes(genes, 2);
+    assert(projet_definir_threads(1) == 0 && pool_global() == NULL);
+    definir_pool_global(pool_programme);
+    projet_fermer_genome(genome_court);
+    free(sequence_court);
+
+    // Boîtes consensus
+    ProjetPaireConsensus paires[16];
+    int nombre_paires = projet_rechercher_consensus(genome, 26950, 27050, NULL, NULL, paires, 16);
+    assert(nombre_paires >= 1);
+    bool trouvee = false;
+    for (int p = 0; p < nombre_paires && p < 16; p++) {
+        trouvee |= paires[p].position_35 == 27000 && paires[p].position_10 == 27023;
+    }
+    assert(trouvee && projet_rechercher_consensus(genome, 0, longueur + 1, NULL, NULL, paires, 16) == -1);
+
+    // Comptes et positions
+    assert(projet_compter_motif(genome, sequence + 100, 30, 0) == 25);
+    assert(projet_compter_motif(genome, "ACNT", 4, 0) == -1 && projet_compter_motif(genome, "ACGT", 4, 4) == -1);
+    int nombre;
+    int *positions = projet_positions_motif(genome, sequence + 100, 30, 1, &nombre);
+    assert(positions != NULL && nombre == 25 && positions[0] == 100 && positions[1] == 1000);
+    free(positions);
+
+    // Extension : un 12-mer de la répétition s'étend jusqu'à ses 30 bases
+    ProjetMotif motif;
+    assert(projet_etendre_motif(genome, 5010, 12, 20, &motif) == 18);
+    assert(motif.position == 5000 && motif.longueur == 30 && motif.occurrences == 24);
+    assert(projet_etendre_motif(genome, longueur - 5, 12, 20, &motif) == -1);
+
+    // Requêtes concurrentes : mêmes résultats qu'en séquentiel
+    int nombre_requetes = (longueur - 12) / 50 + 1;
+    int *attendus = malloc(nombre_requetes * sizeof(int));
+    assert(attendus != NULL);
+    for (int p = 0, i = 0; p + 12 <= longueur; p += 50, i++) {
+        attendus[i] = projet_compter_motif(genome, sequence + p, 12, i % 2);
+    }
+    pthread_t threads[4];
+    RequetesParalleles requetes[4];
+    for (int t = 0; t < 4; t++) {
+        requetes[t] = (RequetesParalleles){genome, attendus, 0};
+        assert(pthread_create(&threads[t], NULL, compter_motifs_thread, &requetes[t]) == 0);
+    }
+    for (int t = 0; t < 4; t++) {
+        assert(pthread_join(threads[t], NULL) == 0 && requetes[t].erreurs == 0);
+    }
+    free(attendus);
+
+    projet_fermer_genome(genome);
+    free(sequence);
+    printf("Test de la bibliothèque libprojet passé avec succès.\n");
+}
+
+// assert cache_resultats.c
+
+// Test du cache : relecture à l'identique, entrée altérée ignorée, candidats et position du gène relus
+void test_cache_resultats() {
+    printf("=== Début du test du cache des résultats ===\n");
+    char dossier[64];
+    snprintf(dossier, sizeof(dossier), "/tmp/projet_bioinfo_cache_%d", (int)getpid());
+
+    // Empreintes : sensibles au contenu et à l'ordre
+    uint64_t a = empreinte_donnees("ACGT", 4, EMPREINTE_INITIALE);
+    assert(a != empreinte_donnees("ACGA", 4, EMPREINTE_INITIALE));
+    assert(empreinte_entier(1, empreinte_entier(2, a)) != empreinte_entier(2, empreinte_entier(1, a)));
+
+    // Écriture puis lecture ; une autre clé ou une entrée altérée ne sont pas lues
+    int32_t valeurs[3] = {7, -1, 123456};
+    void *donnees;
+    size_t taille;
+    assert(lire_cache(dossier, "essai", a, &donnees, &taille) == -1 && donnees == NULL);
+    assert(ecrire_cache(dossier, "essai", a, valeurs, sizeof(valeurs)) == 0);
+    assert(lire_cache(dossier, "essai", a, &donnees, &taille) == 0 && taille == sizeof(valeurs));
+    assert(memcmp(donnees, valeurs, sizeof(valeurs)) == 0);
+    free(donnees);
+    assert(lire_cache(dossier, "essai", a + 1, &donnees, &taille) == -1);
+    char chemin[128];
+    snprintf(chemin, sizeof(chemin), "%s/essai_%016llx.bin", dossier, (unsigned long long)a);
+    FILE *fichier = fopen(chemin, "r+b");
+    assert(fichier != NULL && fseek(fichier, 20, SEEK_SET) == 0 && fputc('X', fichier) != EOF);
+    fclose(fichier);
+    assert(lire_cache(dossier, "essai", a, &donnees, &taille) == -1);
+    remove(chemin);
+
+    // Motifs candidats : positions, longueurs et comptes relus, fold change recalculé
+    int longueur = 5000;
+    char *genome = generer_sequence_parallele(longueur, 43);
+    assert(genome != NULL);
+    StockMotifs *stock = creer_stock_motifs(genome, 0);
+    assert(stock != NULL);
+    ajouter_motif_stock(stock, NULL, 100, 20, calculer_fold_change(30, 10), 30, 10);
+    ajouter_motif_stock(stock, NULL, 400, 25, calculer_fold_change(21, 0), 21, 0);
+    assert(ecrire_motifs_cache(dossier, a, stock) == 0);
+    StockMotifs *relu = creer_stock_motifs(genome, 0);
+    assert(relu != NULL && lire_motifs_cache(dossier, a, relu) == 2);
+    for (int i = 0; i < 2; i++) {
+        assert(relu->positions[i] == stock->positions[i] && relu->longueurs[i] == stock->longueurs[i]);
+        assert(relu->occurrences_reelles[i] == stock->occurrences_reelles[i]);
+        assert(relu->occurrences_aleatoires[i] == stock->occurrences_aleatoires[i]);
+        assert(relu->fold_changes[i] == stock->fold_changes[i]);
+    }
+    liberer_stock_motifs(relu);
+    liberer_stock_motifs(stock);
+    snprintf(chemin, sizeof(chemin), "%s/motifs_%016llx.bin", dossier, (unsigned long long)a);
+    remove(chemin);
+
+    // Position du gène : la seconde recherche est lue dans le cache
+    char gene[201];
+    memcpy(gene, genome + 3000, 200);
+    gene[200] = '\0';
+    char brin = '.', brin_cache = '.';
+    int position = rechercher_gene_cache(dossier, genome, gene, IDENTITE_MIN, &brin);
+    assert(position == 3001 && brin == '+');
+    assert(rechercher_gene_cache(dossier, genome, gene, IDENTITE_MIN, &brin_cache) == position && brin_cache == '+');
+    uint64_t cle = empreinte_donnees("gene", 4, EMPREINTE_INITIALE);
+    cle = empreinte_donnees(genome, longueur, cle);
+    cle = empreinte_entier(200, cle);
+    cle = empreinte_donnees(gene, 200, cle);
+    double identite = IDENTITE_MIN;
+    cle = empreinte_donnees(&identite, sizeof(identite), cle);
+    assert(lire_cache(dossier, "gene", cle, &donnees, &taille) == 0 && taille == 2 * sizeof(int32_t));
+    free(donnees);
+    snprintf(chemin, sizeof(chemin), "%s/gene_%016llx.bin", dossier, (unsigned long long)cle);
+    remove(chemin);
+
+    // Sans --graine, la graine du génome aléatoire est tirée du génome réel : deux exécutions sur les mêmes
+    // entrées ont la même clé, la seconde relit les candidats au lieu d'écrire une nouvelle entrée (un motif copié
+    // X_HIT_AVANT_ENTRE fois en aval de la région donne un candidat)
+    for (int copie = 0; copie < X_HIT_AVANT_ENTRE; copie++) memcpy(genome + 3300 + 60 * copie, genome + 2500, 30);
+    uint64_t graine = graine_depuis_genome(genome, longueur);
+    assert(graine == graine_depuis_genome(genome, longueur) && graine != graine_depuis_genome(genome, longueur - 1));
+    ParametresSortie sortie = parametres_sortie_defaut();
+    sortie.dossier_cache = dossier;
+    for (int execution = 0; execution < 2; execution++) {
+        char *aleatoire = generer_sequence_parallele(longueur, graine_depuis_genome(genome, longueur));
+        assert(aleatoire != NULL);
+        traiter_k_uplets(genome + 3000 - LONGEUR_REGION_ETUIE_MOTIFS, LONGEUR_REGION_ETUIE_MOTIFS, genome, longueur,
+                         8, 10, aleatoire, 3000, &sortie);
+        free(aleatoire);
+        int entrees = 0;
+        DIR *repertoire = opendir(dossier);
+        assert(repertoire != NULL);
+        for (struct dirent *entree = readdir(repertoire); entree != NULL; entree = readdir(repertoire)) {
+            if (strncmp(entree->d_name, "motifs_", 7) == 0 && strlen(entree->d_name) < 64) {
+                snprintf(chemin, sizeof(chemin), "%s/%.63s", dossier, entree->d_name);
+                entrees++;
+            }
+        }
+        closedir(repertoire);
+        assert(entrees == 1);
+    }
+    remove(chemin);
+    rmdir(dossier);
+
+    free(genome);
+    printf("Test du cache des résultats passé avec succès.\n");
+}
+
+// assert contexte_occurrences.c
+
+void test_contextes_occurrences() {
+    printf("=== Début du test des contextes des occurrences ===\n");
+    const char *motif = "ACGTTGCAAGGCTTAACCGA";
+    char inverse[20];
+    ecrire_complement_inverse(motif, 20, inverse);
+    assert(memcmp(inverse, "TCGGTTAAGCCTTGCAACGT", 20) == 0);
+
+    // Copies directes en 2 (flanc gauche tronqué), 1000 et 3000, complément inverse en 2000
+    int longueur = 5000;
+    char *genome = generer_sequence_parallele(longueur, 44);
+    assert(genome != NULL);
+    memcpy(genome + 2, motif, 20);
+    memcpy(genome + 1000, motif, 20);
+    memcpy(genome + 2000, inverse, 20);
+    memcpy(genome + 3000, motif, 20);
+    // Palindrome (égal à son complément inverse) en 4000 et 4500
+    const char *palindrome = "GAATTCCGATATCGGAATTC";
+    memcpy(genome + 4000, palindrome, 20);
+    memcpy(genome + 4500, palindrome, 20);
+    IndexSuffixes *index = construire_index_suffixes(genome, longueur);
+    StockMotifs *stock = creer_stock_motifs(genome, 0);
+    assert(index != NULL && stock != NULL);
+    ajouter_motif_stock(stock, NULL, 1000, 20, 3.0, 3, 1);
+
+    char chemin[64];
+    snprintf(chemin, sizeof(chemin), "/tmp/projet_bioinfo_contextes_%d.fa", (int)getpid());
+    ParametresContextes parametres = {"NC_essai", "genome d'essai", 5, BRIN_DEUX};
+    assert(ecrire_contextes_occurrences(index, stock, NULL, &parametres, chemin) == 4);
+
+    const char *entetes[4] = {">NC_essai:1-27 genome d'essai motif=1", ">NC_essai:996-1025 genome d'essai motif=1",
+                              ">NC_essai:c2025-1996 genome d'essai motif=1",
+                              ">NC_essai:2996-3025 genome d'essai motif=1"};
+    FILE *fichier = fopen(chemin, "r");
+    assert(fichier != NULL);
+    char ligne[256];
+    for (int r = 0; r < 4; r++) {
+        assert(fgets(ligne, sizeof(ligne), fichier) != NULL);
+        ligne[strcspn(ligne, "\n")] = '\0';
+        assert(strcmp(ligne, entetes[r]) == 0);
+        assert(fgets(ligne, sizeof(ligne), fichier) != NULL);
+        ligne[strcspn(ligne, "\n")] = '\0';
+        if (r == 0) {
+            // Flanc gauche réduit aux 2 premières bases du génome
+            assert(strlen(ligne) == 27 && memcmp(ligne, genome, 27) == 0);
+        } else {
+            // Brin - : le contexte est écrit en complément inverse, le motif y apparaît donc à l'endroit
+            assert(strlen(ligne) == 30 && memcmp(ligne + 5, motif, 20) == 0);
+        }
+        if (r == 2) {
+            char attendu[30];
+            ecrire_complement_inverse(genome + 1995, 30, attendu);
+            assert(memcmp(ligne, attendu, 30) == 0);
+        }
+    }
+    assert(fgets(ligne, sizeof(ligne), fichier) == NULL);
+    fclose(fichier);
+
+    // Brin + seul, sans description, copie en 3000 masquée
+    MasqueExclusion *masque = creer_masque_exclusion(longueur);
+    assert(masque != NULL && ajouter_intervalle_masque(masque, 3000, 3020) == 0);
+    ParametresContextes plus = {"NC_essai", NULL, 0, BRIN_PLUS};
+    assert(ecrire_contextes_occurrences(index, stock, masque, &plus, chemin) == 2);
+    fichier = fopen(chemin, "r");
+    assert(fichier != NULL);
+    assert(fgets(ligne, sizeof(ligne), fichier) != NULL && strcmp(ligne, ">NC_essai:3-22 motif=1\n") == 0);
+    assert(fgets(ligne, sizeof(ligne), fichier) != NULL && strncmp(ligne, motif, 20) == 0 && ligne[20] == '\n');
+    assert(fgets(ligne, sizeof(ligne), fichier) != NULL && strcmp(ligne, ">NC_essai:1001-1020 motif=1\n") == 0);
+    fclose(fichier);
+
+    // Palindrome sur les deux brins : chaque occurrence n'est écrite qu'une fois, sur le brin +
+    StockMotifs *stock_palindrome = creer_stock_motifs(genome, 0);
+    assert(stock_palindrome != NULL);
+    ajouter_motif_stock(stock_palindrome, NULL, 4000, 20, 2.0, 2, 1);
+    assert(ecrire_contextes_occurrences(index, stock_palindrome, NULL, &parametres, chemin) == 2);
+    fichier = fopen(chemin, "r");
+    assert(fichier != NULL);
+    assert(fgets(ligne, sizeof(ligne), fichier) != NULL &&
+           strcmp(ligne, ">NC_essai:3996-4025 genome d'essai motif=1\n") == 0);
+    assert(fgets(ligne, sizeof(ligne), fichier) != NULL);
+    assert(fgets(ligne, sizeof(ligne), fichier) != NULL &&
+           strcmp(ligne, ">NC_essai:4496-4525 genome d'essai motif=1\n") == 0);
+    fclose(fichier);
+    liberer_stock_motifs(stock_palindrome);
+    remove(chemin);
+
+    liberer_masque_exclusion(masque);
+    liberer_stock_motifs(stock);
+    liberer_index_suffixes(index);
+    free(genome);
+    printf("Test des contextes des occurrences passé avec succès.\n");
+}
+
+// assert verification_moteurs.c
+
+void test_verification_moteurs() {
+    printf("=== Début du test de la vérification des moteurs ===\n");
+
+    // Échantillon reproductible, de la taille demandée
+    int retenus = 0;
+    for (uint64_t cle = 0; cle < 10000; cle++) {
+        assert(echantillon_retenu(cle, 0.1) == echantillon_retenu(cle, 0.1));
+        assert(echantillon_retenu(cle, 1.0) && !echantillon_retenu(cle, 0.0));
+        retenus += echantillon_retenu(cle, 0.1);
+    }
+    assert(retenus > 800 && retenus < 1200);
+
+    // Les moteurs rapides s'accordent avec les fonctions de référence (un génome de chaque type, masqués ou non)
+    BilanVerification bilan = {0, 0};
+    assert(verifier_moteurs(GRAINE_VERIFICATION, 8, &bilan) == 0);
+    assert(bilan.comparaisons > 1000 && bilan.divergences == 0);
+
+    // Une table des suffixes altérée (l'occurrence d'un motif unique remplacée par la position suivante) est détectée
+    char *genome = generer_sequence_parallele(3000, 45);
+    assert(genome != NULL);
+    IndexSuffixes *index = construire_index_suffixes(genome, 3000);
+    assert(index != NULL);
+    int debut, fin;
+    assert(intervalle_suffixes(index, genome + 1000, 12, &debut, &fin) >= 1 && fin - debut == 1);
+    int32_t position = index->suffixes[debut];
+    index->suffixes[debut] = position + 1;
+    BilanVerification altere = {0, 0};
+    couper_sortie();
+    assert(verifier_comptage_motif(&altere, index, genome + 1000, 12, 0, 0, NULL, 0) >= 1);
+    retablir_sortie();
+    assert(altere.divergences >= 1);
+    index->suffixes[debut] = position;
+    assert(verifier_comptage_motif(&altere, index, genome + 1000, 12, 0, 0, NULL, 1) == 0);
+    liberer_index_suffixes(index);
+    free(genome);
+
+    printf("Test de la vérification des moteurs passé avec succès.\n");
+}
+
+// assert conservation_motifs.c
+
+void test_conservation_souches() {
+    printf("=== Début du test de la conservation entre souches ===\n");
+    char *gene = generer_sequence_parallele(600, 50);
+    char *souches[3] = {generer_sequence_parallele(20000, 51), generer_sequence_parallele(20000, 52),
+                        generer_sequence_parallele(20000, 53)};
+    assert(gene != NULL && souches[0] != NULL && souches[1] != NULL && souches[2] != NULL);
+    SequenceFasta motifs[2] = {{"A", "ACGTTGCAAGGCTTAACCGA", 20}, {"B", "GATTACAGATTACACCTTGG", 20}};
+    char inverse_a[21], inverse_b[21], inverse_gene[600];
+    ecrire_complement_inverse(motifs[0].sequence, 20, inverse_a);
+    ecrire_complement_inverse(motifs[1].sequence, 20, inverse_b);
+    ecrire_complement_inverse(gene, 600, inverse_gene);
+
+    // Souche 1 : gène en 10000 sur le brin +, A en amont (9500) et ailleurs, sur les deux brins
+    memcpy(souches[0] + 10000, gene, 600);
+    memcpy(souches[0] + 9500, motifs[0].sequence, 20);
+    memcpy(souches[0] + 2000, motifs[0].sequence, 20);
+    memcpy(souches[0] + 15000, motifs[0].sequence, 20);
+    memcpy(souches[0] + 5000, inverse_a, 20);
+    ConservationSouche resultat;
+    assert(conservation_souche(souches[0], 20000, motifs, 2, gene, &resultat) == 0);
+    assert(resultat.position_gene == 10000 && resultat.brin_gene == '+');
+    assert(resultat.copies[0] == 4 && resultat.copie_amont[0] == 1 && resultat.conservation[0] == 1.0);
+    assert(resultat.copies[1] == 0 && resultat.copie_amont[1] == 0 && resultat.conservation[1] == 0.0);
+    liberer_conservation_souche(&resultat);
+
+    // Souche 2 : gène sur le brin - (son amont suit sa fin), A à un mésappariement près et B exact en amont
+    memcpy(souches[1] + 8000, inverse_gene, 600);
+    memcpy(souches[1] + 9000, inverse_a, 20);
+    souches[1][9010] = souches[1][9010] == 'A' ? 'C' : 'A';
+    memcpy(souches[1] + 9100, inverse_b, 20);
+    assert(conservation_souche(souches[1], 20000, motifs, 2, gene, &resultat) == 0);
+    assert(resultat.position_gene == 8000 && resultat.brin_gene == '-');
+    assert(resultat.copies[0] == 0 && resultat.copie_amont[0] == 0 && resultat.conservation[0] == 0.95);
+    assert(resultat.copies[1] == 1 && resultat.copie_amont[1] == 1 && resultat.conservation[1] == 1.0);
+    liberer_conservation_souche(&resultat);
+
+    // Souche 3 : pas d'orthologue
+    memcpy(souches[2] + 100, motifs[0].sequence, 20);
+    assert(conservation_souche(souches[2], 20000, motifs, 2, gene, &resultat) == 0);
+    assert(resultat.position_gene == -1 && resultat.copies[0] == 1 && resultat.copie_amont[0] == -1);
+    liberer_conservation_souche(&resultat);
+
+    // Matrice écrite depuis une liste de fichiers (la souche 2 a un second enregistrement portant une copie de A)
+    char chemins[5][64];
+    for (int f = 0; f < 5; f++) snprintf(chemins[f], sizeof(chemins[f]), "/tmp/projet_bioinfo_souche_%d_%d", (int)getpid(), f);
+    FILE *fichier = fopen(chemins[3], "w");
+    assert(fichier != NULL);
+    for (int s = 0; s < 3; s++) {
+        FILE *genome = fopen(chemins[s], "w");
+        assert(genome != NULL);
+        fprintf(genome, ">souche_%d essai\n%s\n", s + 1, souches[s]);
+        if (s == 1) fprintf(genome, ">plasmide_%d\nTTTT%sTTTT\n", s + 1, motifs[0].sequence);
+        fclose(genome);
+        fprintf(fichier, "%s\n", chemins[s]);
+    }
+    fclose(fichier);
+    fichier = fopen(chemins[4], "w");
+    assert(fichier != NULL);
+    fprintf(fichier, ">Motif A\n%s\n\n>Motif B\n%s\n", motifs[0].sequence, motifs[1].sequence);
+    fclose(fichier);
+    char chemin_sortie[80];
+    snprintf(chemin_sortie, sizeof(chemin_sortie), "/tmp/projet_bioinfo_conservation_%d.tsv", (int)getpid());
+    gene[600] = '\0';
+    assert(comparer_souches(chemins[4], chemins[3], gene, chemin_sortie) == 3);
+
+    const char *lignes[4] = {
+        "souche\tlongueur\tposition_gene\tbrin_gene\tACGTTGCAAGGCTTAACCGA_copies\tACGTTGCAAGGCTTAACCGA_amont\t"
+        "ACGTTGCAAGGCTTAACCGA_conservation\tGATTACAGATTACACCTTGG_copies\tGATTACAGATTACACCTTGG_amont\t"
+        "GATTACAGATTACACCTTGG_conservation\n",
+        "souche_1\t20000\t10001\t+\t4\t1\t1.000\t0\t0\t0.000\n",
+        "souche_2\t20029\t8001\t-\t1\t0\t0.950\t1\t1\t1.000\n",
+        "souche_3\t20000\tNA\tNA\t1\tNA\tNA\t0\tNA\tNA\n"};
+    fichier = fopen(chemin_sortie, "r");
+    assert(fichier != NULL);
+    char ligne[512];
+    for (int l = 0; l < 4; l++) {
+        assert(fgets(ligne, sizeof(ligne), fichier) != NULL && strcmp(ligne, lignes[l]) == 0);
+    }
+    assert(fgets(ligne, sizeof(ligne), fichier) == NULL);
+    fclose(fichier);
+    remove(chemin_sortie);
+    for (int f = 0; f < 5; f++) remove(chemins[f]);
+
+    for (int s = 0; s < 3; s++) free(souches[s]);
+    free(gene);
+    printf("Test de la conservation entre souches passé avec succès.\n");
+}
+
+// assert ordonnanceur_taches.c
+
+typedef struct {
+    pthread_mutex_t verrou;
+    pthread_cond_t condition;
+    int ordre[8];
+    int nombre;
+    int presents;                  // Étapes arrivées au rendez-vous
+} JournalTaches;
+
+typedef struct {
+    JournalTaches *journal;
+    int numero;
+    int resultat;
+    bool rendez_vous;              // Attend qu'une autre étape soit en cours en même temps
+} EtapeTest;
+
+static int executer_etape_test(void *contexte) {
+    EtapeTest *etape = contexte;
+    JournalTaches *journal = etape->journal;
+    pthread_mutex_lock(&journal->verrou);
+    journal->ordre[journal->nombre++] = etape->numero;
+    if (etape->rendez_vous) {
+        journal->presents++;
+        pthread_cond_broadcast(&journal->condition);
+        while (journal->presents < 2) pthread_cond_wait(&journal->condition, &journal->verrou);
+    }
+    pthread_mutex_unlock(&journal->verrou);
+    return etape->resultat;
+}
+
+void test_graphe_taches() {
+    printf("=== Début du test du graphe de tâches ===\n");
+    JournalTaches journal = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, {0}, 0, 0};
+    EtapeTest etapes[5];
+    for (int e = 0; e < 5; e++) {
+        EtapeTest etape = {&journal, e, 0, false};
+        etapes[e] = etape;
+    }
+
+    // Losange 0 -> {1, 2} -> 3 déclaré à l'envers : un seul thread suit les dépendances, puis les identifiants
+    GrapheTaches *graphe = creer_graphe_taches();
+    assert(graphe != NULL);
+    int fin = ajouter_tache(graphe, "fin", executer_etape_test, &etapes[3]);
+    int droite = ajouter_tache(graphe, "droite", executer_etape_test, &etapes[2]);
+    int gauche = ajouter_tache(graphe, "gauche", executer_etape_test, &etapes[1]);
+    int debut = ajouter_tache(graphe, "debut", executer_etape_test, &etapes[0]);
+    assert(ajouter_dependance(graphe, fin, droite) == 0 && ajouter_dependance(graphe, fin, gauche) == 0);
+    assert(ajouter_dependance(graphe, droite, debut) == 0 && ajouter_dependance(graphe, gauche, debut) == 0);
+    assert(ajouter_dependance(graphe, fin, 7) == -1);
+    assert(executer_graphe_taches(graphe, 1) == 0);
+    int ordre_attendu[4] = {0, 2, 1, 3};
+    assert(journal.nombre == 4 && memcmp(journal.ordre, ordre_attendu, sizeof(ordre_attendu)) == 0);
+    assert(etat_tache(graphe, fin) == TACHE_REUSSIE);
+    assert(duree_chemin_critique(graphe) >= duree_tache(graphe, debut) + duree_tache(graphe, fin));
+
+    // Les deux branches ne se terminent que si elles s'exécutent en même temps
+    journal.nombre = 0;
+    etapes[1].rendez_vous = etapes[2].rendez_vous = true;
+    assert(executer_graphe_taches(graphe, 2) == 0);
+    assert(journal.nombre == 4 && journal.ordre[0] == 0 && journal.ordre[3] == 3 && journal.presents == 2);
+    liberer_graphe_taches(graphe);
+
+    // Une étape en échec annule ce qui en dépend, pas les étapes indépendantes
+    journal.nombre = 0;
+    etapes[1].rendez_vous = etapes[2].rendez_vous = false;
+    etapes[1].resultat = 1;
+    graphe = creer_graphe_taches();
+    int echec = ajouter_tache(graphe, "echec", executer_etape_test, &etapes[1]);
+    int suite = ajouter_tache(graphe, "suite", executer_etape_test, &etapes[2]);
+    int fin_suite = ajouter_tache(graphe, "fin_suite", executer_etape_test, &etapes[3]);
+    int independante = ajouter_tache(graphe, "independante", executer_etape_test, &etapes[4]);
+    ajouter_dependance(graphe, suite, echec);
+    ajouter_dependance(graphe, fin_suite, suite);
+    assert(executer_graphe_taches(graphe, 3) == -1);
+    assert(etat_tache(graphe, echec) == TACHE_ECHOUEE && etat_tache(graphe, suite) == TACHE_ANNULEE);
+    assert(etat_tache(graphe, fin_suite) == TACHE_ANNULEE && etat_tache(graphe, independante) == TACHE_REUSSIE);
+    assert(journal.nombre == 2 && duree_tache(graphe, suite) == 0);
+
+    // Un cycle est refusé avant toute exécution
+    journal.nombre = 0;
+    ajouter_dependance(graphe, echec, fin_suite);
+    couper_sortie();
+    assert(executer_graphe_taches(graphe, 2) == -1 && journal.nombre == 0);
+    retablir_sortie();
+    liberer_graphe_taches(graphe);
+    printf("Test du graphe de tâches passé avec succès.\n");
+}
+
+// assert progression.c
+
+static void avancer_progression_bloc(const BlocParallele *bloc, void *contexte) {
+    for (int64_t i = bloc->debut; i < bloc->fin; i++) avancer_progression(contexte, 1);
+}
+
+void test_progression() {
+    printf("=== Début du test de la progression ===\n");
+    EtatProgression etats[COMPTEURS_PROGRESSION_MAX];
+    int deja_ouverts = lire_progression(etats, COMPTEURS_PROGRESSION_MAX);
+
+    // Avance depuis tous les threads du pool : aucune unité perdue
+    PoolThreads *pool = creer_pool_threads(4);
+    CompteurProgression *graines = ouvrir_compteur_progression("graines", 10000);
+    CompteurProgression *genomes = ouvrir_compteur_progression("un nom bien plus long que la place prévue", 4);
+    assert(graines != NULL && genomes != NULL);
+    pool_parallel_for(pool, 0, 10000, 100, 0, avancer_progression_bloc, graines);
+    avancer_progression(genomes, 1);
+    avancer_progression(NULL, 1);
+    assert(lire_progression(etats, COMPTEURS_PROGRESSION_MAX) == deja_ouverts + 2);
+    int g = deja_ouverts;
+    if (strcmp(etats[g].nom, "graines") != 0) g++;
+    assert(strcmp(etats[g].nom, "graines") == 0 && etats[g].fait == 10000 && etats[g].total == 10000);
+    assert(strlen(etats[2 * deja_ouverts + 1 - g].nom) == LONGUEUR_NOM_PROGRESSION - 1);
+
+    // Mise en forme des relevés : barre à moitié pleine, ou comptes
+    EtatProgression moitie = {"graines", 50, 100, 1.25};
+    char ligne[128];
+    formater_progression(&moitie, 1, PROGRESSION_BARRE, ligne, sizeof(ligne));
+    assert(strcmp(ligne, "graines [===============               ]  50%") == 0);
+    formater_progression(&moitie, 1, PROGRESSION_LIGNES, ligne, sizeof(ligne));
+    assert(strcmp(ligne, "graines : 50/100 (50%, 1.2 s)") == 0);
+    assert(formater_progression(&moitie, 1, PROGRESSION_LIGNES, ligne, 8) == 7 && strcmp(ligne, "graines") == 0);
+
+    // Plus de COMPTEURS_PROGRESSION_MAX compteurs : les suivants ne sont pas suivis, sans erreur
+    CompteurProgression *ouverts[COMPTEURS_PROGRESSION_MAX];
+    int nombre_ouverts = 0;
+    CompteurProgression *compteur;
+    while ((compteur = ouvrir_compteur_progression("plein", 1)) != NULL) ouverts[nombre_ouverts++] = compteur;
+    assert(nombre_ouverts == COMPTEURS_PROGRESSION_MAX - deja_ouverts - 2);
+    for (int c = 0; c < nombre_ouverts; c++) fermer_compteur_progression(ouverts[c]);
+    fermer_compteur_progression(NULL);
+
+    // Le rapporteur sans affichage ne lance aucun thread ; fermé, un compteur n'est plus relevé
+    assert(demarrer_rapporteur_progression(PROGRESSION_AUCUNE) == 0);
+    arreter_rapporteur_progression();
+    fermer_compteur_progression(graines);
+    fermer_compteur_progression(genomes);
+    assert(lire_progression(etats, COMPTEURS_PROGRESSION_MAX) == deja_ouverts);
+
+    ModeProgression mode;
+    assert(mode_progression_depuis_nom("lignes", &mode) == 0 && mode == PROGRESSION_LIGNES);
+    assert(mode_progression_depuis_nom("barres", &mode) == -1);
+    detruire_pool_threads(pool);
+    printf("Test de la progression passé avec succès.\n");
+}
+
+// assert filtre_consensus.c
+
+typedef struct {
+    int64_t positions[2 * 4096];
+    int nombre;
+} PairesTest;
+
+static void ranger_paire_test(int64_t position_boite_35, int64_t position_boite_10, void *contexte) {
+    PairesTest *paires = contexte;
+    if (paires->nombre < 4096) {
+        paires->positions[2 * paires->nombre] = position_boite_35;
+        paires->positions[2 * paires->nombre + 1] = position_boite_10;
+    }
+    paires->nombre++;
+}
+
+void test_filtre_consensus() {
+    printf("=== Début du test du pré-filtre des boîtes consensus ===\n");
+    // Boîte -35 à 1 erreur (TTGAGA) et boîte -10 à 15 bases ; boîte -10 à 1 erreur (TATGAT) et à 19 bases
+    const char *promoteur_15 = "TTGAGACCCCCCCCCCCCCCCTATAATCC";
+    const char *promoteur_19 = "GTTGACACCCCCCCCCCCCCCCCCCCTATGAT";
+    PairesTest *paires = malloc(sizeof(PairesTest));
+    PairesTest *reference = malloc(sizeof(PairesTest));
+    assert(paires != NULL && reference != NULL);
+    paires->nombre = 0;
+    assert(parcourir_paires_consensus(promoteur_15, 0, 29, 29, BOITE_35, BOITE_10, ranger_paire_test, paires) == 1);
+    assert(parcourir_paires_consensus(promoteur_19, 0, 32, 32, BOITE_35, BOITE_10, ranger_paire_test, paires) == 1);
+    assert(paires->positions[0] == 0 && paires->positions[1] == 21);
+    assert(paires->positions[2] == 1 && paires->positions[3] == 26);
+    // Boîte -10 au-delà de la limite ; boîte -35 avant `debut`
+    assert(parcourir_paires_consensus(promoteur_15, 0, 29, 26, BOITE_35, BOITE_10, NULL, NULL) == 0);
+    assert(parcourir_paires_consensus(promoteur_15, 1, 29, 29, BOITE_35, BOITE_10, NULL, NULL) == 0);
+
+    // Génome aléatoire semé de promoteurs, parcouru par morceaux qui ne tombent pas sur des mots de 64 positions
+    int n = 200000;
+    char *genome = malloc(n + 1);
+    assert(genome != NULL);
+    srand(42);
+    for (int i = 0; i < n; i++) genome[i] = "ACGT"[rand() % 4];
+    genome[n] = '\0';
+    for (int p = 0; p < 300; p++) {
+        int debut = rand() % (n - 40);
+        memcpy(genome + debut, p % 3 == 0 ? "TTGACC" : "TTGACA", 6);
+        memcpy(genome + debut + 6 + 15 + rand() % 5, p % 5 == 0 ? "TATTAT" : "TATAAT", 6);
+    }
+    assert(choisir_filtre_consensus(FILTRE_CONSENSUS_REFERENCE) == 0);
+    reference->nombre = 0;
+    int64_t attendues = parcourir_paires_consensus(genome, 7, n - 3, n, BOITE_35, BOITE_10, ranger_paire_test,
+                                                   reference);
+    assert(attendues >= 300 && attendues == reference->nombre && attendues <= 4096);
+    const FiltreConsensus filtres[] = {FILTRE_CONSENSUS_SCALAIRE, FILTRE_CONSENSUS_SSE2, FILTRE_CONSENSUS_AVX2};
+    for (int f = 0; f < 3; f++) {
+        if (choisir_filtre_consensus(filtres[f]) != 0) continue;
+        assert(filtre_consensus_actif() == filtres[f]);
+        paires->nombre = 0;
+        for (int64_t debut = 7; debut < n - 3; debut += 12345) {
+            int64_t fin = debut + 12345 < n - 3 ? debut + 12345 : n - 3;
+            parcourir_paires_consensus(genome, debut, fin, n, BOITE_35, BOITE_10, ranger_paire_test, paires);
+        }
+        assert(paires->nombre == attendues);
+        assert(memcmp(paires->positions, reference->positions, 2 * attendues * sizeof(int64_t)) == 0);
+    }
+    assert(choisir_filtre_consensus(FILTRE_CONSENSUS_AUTO) == 0 && filtre_consensus_actif() != FILTRE_CONSENSUS_AUTO);
+
+    // Les recherches existantes passent par le pré-filtre : mêmes comptes que la référence
+    int positions[2];
+    assert(lister_paires_consensus(genome, 7, n, BOITE_35, BOITE_10, positions, 1) ==
+           parcourir_paires_consensus(genome, 7, n, n, BOITE_35, BOITE_10, NULL, NULL));
+    free(genome);
+    free(paires);
+    free(reference);
+    printf("Test du pré-filtre des boîtes consensus passé avec succès.\n");
+}
+
+// Lancement de tous les tests (--tests, make test) ; un test qui échoue interrompt le programme
+void executer_tests_projet(void) {
+    printf("\n========================================================================================\n");
+    printf("         Test des fonctions\n");
+    printf("========================================================================================\n\n");
+
+    // Tests des fonctions de recherche de séquences consensus
+    test_seq_consensus_distance_15();
+    test_seq_consensus_distance_19();
+    test_seq_consensus_chevauchante();
+    test_seq_consensus_critique_seq();
+    test_rechercher_seq_consensus_en_amont();
+    test_rechercher_seq_consensus_en_amont_critique();
+
+    // Tests des fonctions de recherche de gènes
+    test_presence_gene();
+    test_presence_multiple_gene();
+    test_abscence_gene();
+    test_abscence_gene_critique();
+    test_recherche_gene_gappee();
+
+    // Tests des fonctions de recherche de motifs
+    test_rechercher_motif_rapide();
+    test_calculer_fold_change();
+
+    // Tests de lecture des résultats BLAST
+    test_table_blast();
+
+    // Tests de l'analyse en flux
+    test_analyse_flux();
+
+    // Tests de l'index des suffixes
+    test_index_suffixes();
+    test_occurrences_approchees();
+    test_masque_exclusion();
+    test_masquage_graines();
+    test_table_kmers();
+
+    // Tests du pool de threads
+    test_pool_threads();
+    test_repetitions_maximales();
+    test_stock_motifs();
+    test_spectre_kmers();
+    test_serveur_requetes();
+    test_libprojet();
+    test_cache_resultats();
+    test_contextes_occurrences();
+    test_verification_moteurs();
+    test_conservation_souches();
+    test_graphe_taches();
+    test_progression();
+    test_filtre_consensus();
+
+    // Tests de l'écriture des résultats
+    test_ecriture_resultats();
+
+    // Tests de lecture des fichiers compressés
+    test_lecture_compressee();
+
+    // Tests de l'alignement local
+    test_alignement_local();
+
+    // ATTENTION, ces tests arriveront dans la prochaine version du programme.
+
+    // Tests des fonctions d'extention  et de traitement des k-uplets
+    //test_etendre_et_traiter_k_uplets();
+
+    // Message final indiquant que tous les tests sont réussis
+    printf("\n========================================================================================\n");
+    printf("   Tous les tests ont été passés avec succès\n");
+    printf("========================================================================================\n\n");
+}
@@ -0,0 +1,181 @@
+// cache_resultats.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "projet.h"
+
+#define MAGIQUE_CACHE "CACHE01\n"  // En-tête des fichiers du cache (8 octets)
+#define PREMIER_FNV 0x100000001b3ULL
+
+uint64_t empreinte_donnees(const void *donnees, size_t taille, uint64_t empreinte) {
+    // FNV-1a sur 64 bits
+    const unsigned char *octets = donnees;
+    for (size_t i = 0; i < taille; i++) {
+        empreinte ^= octets[i];
+        empreinte *= PREMIER_FNV;
+    }
+    return empreinte;
+}
+
+uint64_t empreinte_entier(int64_t valeur, uint64_t empreinte) {
+    return empreinte_donnees(&valeur, sizeof(valeur), empreinte);
+}
+
+uint64_t graine_depuis_genome(const char *sequence_genome, int longueur_genome) {
+    return empreinte_donnees(sequence_genome, longueur_genome, empreinte_donnees("graine", 6, EMPREINTE_INITIALE));
+}
+
+// -1 si le chemin de l'entrée ne tient pas dans `taille` octets
+static int chemin_fichier_cache(char *chemin, size_t taille, const char *dossier, const char *etape, uint64_t cle) {
+    int longueur = snprintf(chemin, taille, "%s/%s_%016llx.bin", dossier, etape, (unsigned long long)cle);
+    return longueur < 0 || (size_t)longueur >= taille ? -1 : 0;
+}
+
+int lire_cache(const char *dossier, const char *etape, uint64_t cle, void **donnees, size_t *taille) {
+    *donnees = NULL;
+    *taille = 0;
+    char chemin[PATH_MAX];
+    if (chemin_fichier_cache(chemin, sizeof(chemin), dossier, etape, cle) != 0) return -1;
+    FILE *fichier = fopen(chemin, "rb");
+    if (fichier == NULL) return -1;
+
+    // En-tête, taille, contenu, puis empreinte du contenu : un fichier tronqué ou altéré est ignoré
+    char magique[8];
+    uint64_t taille_contenu = 0, empreinte = 0;
+    void *contenu = NULL;
+    int valide = fread(magique, 1, 8, fichier) == 8 && memcmp(magique, MAGIQUE_CACHE, 8) == 0 &&
+                 fread(&taille_contenu, sizeof(uint64_t), 1, fichier) == 1 && taille_contenu < ((uint64_t)1 << 40);
+    if (valide) {
+        contenu = malloc(taille_contenu > 0 ? taille_contenu : 1);
+        valide = contenu != NULL && fread(contenu, 1, taille_contenu, fichier) == taille_contenu &&
+                 fread(&empreinte, sizeof(uint64_t), 1, fichier) == 1 &&
+                 empreinte == empreinte_donnees(contenu, taille_contenu, EMPREINTE_INITIALE);
+    }
+    fclose(fichier);
+    if (!valide) {
+        free(contenu);
+        return -1;
+    }
+    *donnees = contenu;
+    *taille = taille_contenu;
+    return 0;
+}
+
+int ecrire_cache(const char *dossier, const char *etape, uint64_t cle, const void *donnees, size_t taille) {
+    if (mkdir(dossier, 0755) != 0 && errno != EEXIST) {
+        perror("Erreur lors de la création du dossier du cache");
+        return -1;
+    }
+    char chemin[PATH_MAX], chemin_temporaire[PATH_MAX + 32];
+    if (chemin_fichier_cache(chemin, sizeof(chemin), dossier, etape, cle) != 0) {
+        printf("Erreur : chemin du cache trop long dans %s\n", dossier);
+        return -1;
+    }
+    snprintf(chemin_temporaire, sizeof(chemin_temporaire), "%s.%d.tmp", chemin, (int)getpid());
+
+    // Écriture dans un fichier temporaire renommé à la fin : un lecteur ne voit jamais d'entrée incomplète
+    FILE *fichier = fopen(chemin_temporaire, "wb");
+    if (fichier == NULL) {
+        perror("Erreur lors de l'écriture du cache");
+        return -1;
+    }
+    uint64_t taille_contenu = taille;
+    uint64_t empreinte = empreinte_donnees(donnees, taille, EMPREINTE_INITIALE);
+    int erreur = fwrite(MAGIQUE_CACHE, 1, 8, fichier) != 8 ||
+                 fwrite(&taille_contenu, sizeof(uint64_t), 1, fichier) != 1 ||
+                 fwrite(donnees, 1, taille, fichier) != taille ||
+                 fwrite(&empreinte, sizeof(uint64_t), 1, fichier) != 1;
+    erreur |= fclose(fichier) != 0;
+    if (erreur || rename(chemin_temporaire, chemin) != 0) {
+        perror("Erreur lors de l'écriture du cache");
+        unlink(chemin_temporaire);
+        return -1;
+    }
+    return 0;
+}
+
+// Recherche sur les deux brins, l'index des k-mers n'étant construit que si la position n'est pas en cache
+static int32_t rechercher_gene_genome(const char *sequence_genome, const char *sequence_gene, double identite_min,
+                                      char *brin) {
+    IndexKmers *index = construire_index_kmers(sequence_genome, strlen(sequence_genome), LONGUEUR_GRAINE_GENE);
+    if (index == NULL) {
+        printf("Erreur d'allocation mémoire pour l'index des k-mers\n");
+        return -1;
+    }
+    int32_t position = rechercher_gene_index(index, sequence_genome, sequence_gene, identite_min, brin);
+    liberer_index_kmers(index);
+    return position;
+}
+
+int rechercher_gene_cache(const char *dossier_cache, const char *sequence_genome, const char *sequence_gene,
+                          double identite_min, char *brin) {
+    if (dossier_cache == NULL) return rechercher_gene_genome(sequence_genome, sequence_gene, identite_min, brin);
+
+    uint64_t cle = empreinte_donnees("gene", 4, EMPREINTE_INITIALE);
+    cle = empreinte_donnees(sequence_genome, strlen(sequence_genome), cle);
+    cle = empreinte_entier(strlen(sequence_gene), cle);
+    cle = empreinte_donnees(sequence_gene, strlen(sequence_gene), cle);
+    cle = empreinte_donnees(&identite_min, sizeof(identite_min), cle);
+
+    // Entrée : position puis brin, deux entiers de 32 bits
+    void *donnees;
+    size_t taille;
+    int32_t entree[2];
+    if (lire_cache(dossier_cache, "gene", cle, &donnees, &taille) == 0 && taille == sizeof(entree)) {
+        memcpy(entree, donnees, sizeof(entree));
+        free(donnees);
+        printf("Position du gène lue dans le cache : %d (brin %c)\n", entree[0], (char)entree[1]);
+        if (brin != NULL) *brin = (char)entree[1];
+        return entree[0];
+    }
+    free(donnees);
+
+    char brin_trouve = '.';
+    entree[0] = rechercher_gene_genome(sequence_genome, sequence_gene, identite_min, &brin_trouve);
+    entree[1] = brin_trouve;
+    ecrire_cache(dossier_cache, "gene", cle, entree, sizeof(entree));
+    if (brin != NULL) *brin = brin_trouve;
+    return entree[0];
+}
+
+int lire_motifs_cache(const char *dossier_cache, uint64_t cle, StockMotifs *stock) {
+    // Seules les positions sont conservées : les séquences sont relues dans le génome du stock
+    if (stock->genome == NULL) return -1;
+    void *donnees;
+    size_t taille;
+    if (lire_cache(dossier_cache, "motifs", cle, &donnees, &taille) != 0) return -1;
+    // Quatre colonnes de 32 bits par motif : position, longueur, occurrences réelles et aléatoires
+    size_t nombre = taille / (4 * sizeof(int32_t));
+    if (taille % (4 * sizeof(int32_t)) != 0 || nombre > INT32_MAX) {
+        free(donnees);
+        return -1;
+    }
+    const int32_t *colonnes = donnees;
+    int erreur = reserver_stock_motifs(stock, stock->nombre + (int)nombre) != 0;
+    for (size_t i = 0; i < nombre && !erreur; i++) {
+        int32_t position = colonnes[i], longueur = colonnes[nombre + i];
+        int32_t occurrences_reelles = colonnes[2 * nombre + i], occurrences_aleatoires = colonnes[3 * nombre + i];
+        erreur = ajouter_motif_stock(stock, NULL, position, longueur,
+                                     calculer_fold_change(occurrences_reelles, occurrences_aleatoires),
+                                     occurrences_reelles, occurrences_aleatoires) < 0;
+    }
+    free(donnees);
+    return erreur ? -1 : (int)nombre;
+}
+
+int ecrire_motifs_cache(const char *dossier_cache, uint64_t cle, const StockMotifs *stock) {
+    size_t nombre = stock->nombre;
+    int32_t *colonnes = malloc(4 * (nombre > 0 ? nombre : 1) * sizeof(int32_t));
+    if (colonnes == NULL) return -1;
+    memcpy(colonnes, stock->positions, nombre * sizeof(int32_t));
+    memcpy(colonnes + nombre, stock->longueurs, nombre * sizeof(int32_t));
+    memcpy(colonnes + 2 * nombre, stock->occurrences_reelles, nombre * sizeof(int32_t));
+    memcpy(colonnes + 3 * nombre, stock->occurrences_aleatoires, nombre * sizeof(int32_t));
+    int resultat = ecrire_cache(dossier_cache, "motifs", cle, colonnes, 4 * nombre * sizeof(int32_t));
+    free(colonnes);
+    return resultat;
+}
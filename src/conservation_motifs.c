@@ -0,0 +1,263 @@
+// conservation_motifs.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "projet.h"
+
+#define ALIGNEMENTS_MAX_ORTHOLOGUE 8  // Alignements du gène examinés par brin pour trouver l'orthologue
+
+typedef struct {
+    const IndexSuffixes *index;
+    const SequenceFasta *motifs;
+    int debut_amont;              // Région en amont de l'orthologue (vide s'il est absent)
+    int fin_amont;
+    ConservationSouche *resultat;
+} ComptageSouche;
+
+// Plus petit nombre de mésappariements d'une copie de `motif` commençant dans [debut, fin - longueur]
+static int meilleure_copie(const char *genome, int debut, int fin, const char *motif, int longueur, int plafond) {
+    int meilleur = plafond + 1;
+    for (int i = debut; i + longueur <= fin && meilleur > 0; i++) {
+        int erreurs = 0;
+        for (int j = 0; j < longueur && erreurs < meilleur; j++) {
+            if (genome[i + j] != motif[j]) erreurs++;
+        }
+        if (erreurs < meilleur) meilleur = erreurs;
+    }
+    return meilleur;
+}
+
+// Chaque motif (deux brins) est cherché dans l'index partagé de la souche ; un bloc par motif
+static void compter_motif_souche(const BlocParallele *bloc, void *contexte) {
+    ComptageSouche *comptage = contexte;
+    ConservationSouche *resultat = comptage->resultat;
+    const char *genome = comptage->index->genome;
+    for (int64_t m = bloc->debut; m < bloc->fin; m++) {
+        const SequenceFasta *motif = &comptage->motifs[m];
+        char *inverse = malloc(motif->longueur + 1);
+        if (inverse == NULL) {
+            resultat->copies[m] = -1;
+            continue;
+        }
+        ecrire_complement_inverse(motif->sequence, motif->longueur, inverse);
+        inverse[motif->longueur] = '\0';
+        // Un motif palindromique n'est compté qu'une fois
+        bool palindrome = strcmp(inverse, motif->sequence) == 0;
+        resultat->copies[m] = compter_occurrences_index(comptage->index, motif->sequence, motif->longueur, 0, 0, NULL);
+        if (!palindrome) {
+            resultat->copies[m] += compter_occurrences_index(comptage->index, inverse, motif->longueur, 0, 0, NULL);
+        }
+
+        if (resultat->position_gene >= 0) {
+            int erreurs = meilleure_copie(genome, comptage->debut_amont, comptage->fin_amont, motif->sequence,
+                                          motif->longueur, MISMATCHES_CONSERVATION);
+            int erreurs_inverse = meilleure_copie(genome, comptage->debut_amont, comptage->fin_amont, inverse,
+                                                  motif->longueur, MISMATCHES_CONSERVATION);
+            if (erreurs_inverse < erreurs) erreurs = erreurs_inverse;
+            resultat->copie_amont[m] = erreurs == 0;
+            resultat->conservation[m] = erreurs <= MISMATCHES_CONSERVATION
+                                      ? 1.0 - (double)erreurs / motif->longueur : 0.0;
+        } else {
+            resultat->copie_amont[m] = -1;
+            resultat->conservation[m] = -1;
+        }
+        free(inverse);
+    }
+}
+
+// Meilleur alignement du gène sur l'un ou l'autre brin ; renvoie son score, ou -1 s'il n'y en a pas
+static int meilleur_alignement_gene(const IndexKmers *index_kmers, const char *genome, const char *gene,
+                                    AlignementGene *meilleur) {
+    AlignementGene alignements[ALIGNEMENTS_MAX_ORTHOLOGUE];
+    int nombre = rechercher_gene_graines(index_kmers, genome, gene, IDENTITE_MIN, alignements,
+                                         ALIGNEMENTS_MAX_ORTHOLOGUE);
+    int score = -1;
+    for (int a = 0; a < nombre && a < ALIGNEMENTS_MAX_ORTHOLOGUE; a++) {
+        if (alignements[a].score > score) {
+            score = alignements[a].score;
+            *meilleur = alignements[a];
+        }
+        liberer_alignement_gene(&alignements[a]);
+    }
+    meilleur->cigar = NULL;
+    return score;
+}
+
+int conservation_souche(const char *genome, int longueur_genome, const SequenceFasta *motifs, int nombre_motifs,
+                        const char *sequence_gene, ConservationSouche *resultat) {
+    memset(resultat, 0, sizeof(ConservationSouche));
+    resultat->longueur_genome = longueur_genome;
+    resultat->position_gene = -1;
+    resultat->brin_gene = '.';
+    resultat->copies = malloc((nombre_motifs > 0 ? nombre_motifs : 1) * sizeof(int));
+    resultat->copie_amont = malloc((nombre_motifs > 0 ? nombre_motifs : 1) * sizeof(int));
+    resultat->conservation = malloc((nombre_motifs > 0 ? nombre_motifs : 1) * sizeof(double));
+    IndexSuffixes *index = construire_index_suffixes(genome, longueur_genome);
+    IndexKmers *index_kmers = sequence_gene != NULL
+                            ? construire_index_kmers(genome, longueur_genome, LONGUEUR_GRAINE_GENE) : NULL;
+    if (resultat->copies == NULL || resultat->copie_amont == NULL || resultat->conservation == NULL ||
+        index == NULL || (sequence_gene != NULL && index_kmers == NULL)) {
+        liberer_index_suffixes(index);
+        liberer_index_kmers(index_kmers);
+        liberer_conservation_souche(resultat);
+        return -1;
+    }
+
+    // Orthologue du gène : meilleur alignement sur l'un ou l'autre brin
+    ComptageSouche comptage = {index, motifs, 0, 0, resultat};
+    AlignementGene orthologue;
+    if (sequence_gene != NULL && meilleur_alignement_gene(index_kmers, genome, sequence_gene, &orthologue) >= 0) {
+        resultat->position_gene = orthologue.debut;
+        resultat->brin_gene = orthologue.brin;
+        if (orthologue.brin == '+') {
+            // Brin + : la région étudiée précède le gène
+            comptage.debut_amont = orthologue.debut > LONGEUR_REGION_ETUIE_MOTIFS
+                                 ? orthologue.debut - LONGEUR_REGION_ETUIE_MOTIFS : 0;
+            comptage.fin_amont = orthologue.debut;
+        } else {
+            // Brin - : l'amont du gène suit sa fin dans les coordonnées du génome
+            comptage.debut_amont = orthologue.fin;
+            comptage.fin_amont = longueur_genome - orthologue.fin > LONGEUR_REGION_ETUIE_MOTIFS
+                               ? orthologue.fin + LONGEUR_REGION_ETUIE_MOTIFS : longueur_genome;
+        }
+    }
+
+    // Tous les motifs interrogent le même index, répartis sur le pool de threads
+    pool_parallel_for(pool_global(), 0, nombre_motifs, 1, 0, compter_motif_souche, &comptage);
+
+    int erreur = 0;
+    for (int m = 0; m < nombre_motifs; m++) erreur |= resultat->copies[m] < 0;
+    liberer_index_suffixes(index);
+    liberer_index_kmers(index_kmers);
+    if (erreur) {
+        liberer_conservation_souche(resultat);
+        return -1;
+    }
+    return 0;
+}
+
+void liberer_conservation_souche(ConservationSouche *resultat) {
+    free(resultat->copies);
+    free(resultat->copie_amont);
+    free(resultat->conservation);
+    resultat->copies = NULL;
+    resultat->copie_amont = NULL;
+    resultat->conservation = NULL;
+}
+
+// Enregistrements d'un fichier FASTA mis bout à bout, séparés par un 'N' (aucun motif ne chevauche deux
+// enregistrements) ; les positions du premier enregistrement sont inchangées
+static char* charger_souche(const char *chemin_genome, char **nom, int *longueur) {
+    int nombre = 0;
+    SequenceFasta *enregistrements = lire_fichier_multi_fasta(chemin_genome, &nombre);
+    if (enregistrements == NULL || nombre == 0) {
+        liberer_sequences_fasta(enregistrements, nombre);
+        return NULL;
+    }
+    int64_t total = 0;
+    for (int e = 0; e < nombre; e++) total += enregistrements[e].longueur + 1;
+    char *genome = total < INT32_MAX ? malloc(total) : NULL;
+    *nom = strdup(enregistrements[0].nom);
+    if (genome == NULL || *nom == NULL) {
+        free(genome);
+        free(*nom);
+        liberer_sequences_fasta(enregistrements, nombre);
+        return NULL;
+    }
+    int position = 0;
+    for (int e = 0; e < nombre; e++) {
+        if (e > 0) genome[position++] = 'N';
+        memcpy(genome + position, enregistrements[e].sequence, enregistrements[e].longueur);
+        position += enregistrements[e].longueur;
+    }
+    genome[position] = '\0';
+    *longueur = position;
+    liberer_sequences_fasta(enregistrements, nombre);
+    return genome;
+}
+
+int comparer_souches(const char *chemin_motifs, const char *chemin_liste_genomes, const char *sequence_gene,
+                     const char *chemin_sortie) {
+    int nombre_motifs = 0;
+    SequenceFasta *motifs = lire_fichier_multi_fasta(chemin_motifs, &nombre_motifs);
+    if (motifs == NULL || nombre_motifs == 0) {
+        printf("Aucun motif à comparer dans %s\n", chemin_motifs);
+        liberer_sequences_fasta(motifs, nombre_motifs);
+        return -1;
+    }
+    FILE *liste_genomes = fopen(chemin_liste_genomes, "r");
+    if (liste_genomes == NULL) {
+        perror("Erreur lors de l'ouverture de la liste des génomes");
+        liberer_sequences_fasta(motifs, nombre_motifs);
+        return -1;
+    }
+    FILE *sortie = fopen(chemin_sortie, "w");
+    if (sortie == NULL) {
+        perror("Erreur lors de l'ouverture du fichier de conservation");
+        fclose(liste_genomes);
+        liberer_sequences_fasta(motifs, nombre_motifs);
+        return -1;
+    }
+
+    // Une ligne par souche, trois colonnes par motif (nommées d'après sa séquence)
+    fprintf(sortie, "souche\tlongueur\tposition_gene\tbrin_gene");
+    for (int m = 0; m < nombre_motifs; m++) {
+        const char *s = motifs[m].sequence;
+        fprintf(sortie, "\t%s_copies\t%s_amont\t%s_conservation", s, s, s);
+    }
+    fprintf(sortie, "\n");
+
+    // Les souches sont traitées une par une : seuls les motifs et l'index d'une souche résident en mémoire
+    int nombre_souches = 0;
+    char chemin_genome[4096];
+    while (fgets(chemin_genome, sizeof(chemin_genome), liste_genomes)) {
+        chemin_genome[strcspn(chemin_genome, "\r\n")] = '\0';
+        if (chemin_genome[0] == '\0' || chemin_genome[0] == '#') continue;
+
+        char *nom = NULL;
+        int longueur = 0;
+        char *genome = charger_souche(chemin_genome, &nom, &longueur);
+        ConservationSouche resultat;
+        if (genome == NULL || conservation_souche(genome, longueur, motifs, nombre_motifs, sequence_gene,
+                                                  &resultat) != 0) {
+            printf("Souche ignorée : %s\n", chemin_genome);
+            free(genome);
+            free(nom);
+            continue;
+        }
+
+        fprintf(sortie, "%s\t%d\t", nom, longueur);
+        if (resultat.position_gene >= 0) fprintf(sortie, "%d\t%c", resultat.position_gene + 1, resultat.brin_gene);
+        else fprintf(sortie, "NA\tNA");
+        int conserves = 0;
+        for (int m = 0; m < nombre_motifs; m++) {
+            fprintf(sortie, "\t%d", resultat.copies[m]);
+            if (resultat.position_gene >= 0) {
+                fprintf(sortie, "\t%d\t%.3f", resultat.copie_amont[m], resultat.conservation[m]);
+                conserves += resultat.copie_amont[m];
+            } else {
+                fprintf(sortie, "\tNA\tNA");
+            }
+        }
+        fprintf(sortie, "\n");
+        if (resultat.position_gene >= 0) {
+            printf("%s : orthologue en %d (brin %c), %d motif(s) sur %d présent(s) en amont\n", nom,
+                   resultat.position_gene + 1, resultat.brin_gene, conserves, nombre_motifs);
+        } else {
+            printf("%s : orthologue du gène absent\n", nom);
+        }
+        nombre_souches++;
+        liberer_conservation_souche(&resultat);
+        free(genome);
+        free(nom);
+    }
+    fclose(liste_genomes);
+    int erreur = fclose(sortie) != 0;
+    liberer_sequences_fasta(motifs, nombre_motifs);
+    if (erreur) {
+        perror("Erreur lors de l'écriture du fichier de conservation");
+        return -1;
+    }
+    printf("%d souche(s) × %d motif(s) écrits dans %s\n", nombre_souches, nombre_motifs, chemin_sortie);
+    return nombre_souches;
+}
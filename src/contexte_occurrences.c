@@ -0,0 +1,191 @@
+// contexte_occurrences.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include "projet.h"
+
+#define VECTEURS_PAR_ECRITURE 1024       // Vecteurs passés à chaque writev (IOV_MAX vaut au moins 1024 sous Linux)
+#define CAPACITE_ARENE_CONTEXTES (1 << 20) // En-têtes et compléments inverses d'un lot
+
+char* lire_entete_fasta(const char *chemin_fichier) {
+    SourceSequence *source = ouvrir_source(chemin_fichier);
+    if (source == NULL) {
+        perror("Erreur lors de l'ouverture du fichier");
+        return NULL;
+    }
+    char *ligne = NULL;
+    size_t capacite = 0;
+    int64_t longueur = lire_ligne_source(source, &ligne, &capacite);
+    fermer_source(source);
+    if (longueur <= 0 || ligne[0] != '>') {
+        free(ligne);
+        return NULL;
+    }
+    while (longueur > 0 && (ligne[longueur - 1] == '\n' || ligne[longueur - 1] == '\r')) longueur--;
+    ligne[longueur] = '\0';
+    memmove(ligne, ligne + 1, longueur);
+    return ligne;
+}
+
+// Lot de vecteurs en attente : les séquences du brin + pointent dans le génome, le reste dans l'arène
+typedef struct {
+    int descripteur;
+    struct iovec vecteurs[VECTEURS_PAR_ECRITURE];
+    int nombre_vecteurs;
+    char *arene;
+    size_t capacite_arene;
+    size_t utilise_arene;
+} LotEcriture;
+
+static int vider_lot(LotEcriture *lot) {
+    struct iovec *vecteurs = lot->vecteurs;
+    int restants = lot->nombre_vecteurs;
+    while (restants > 0) {
+        ssize_t ecrits = writev(lot->descripteur, vecteurs, restants);
+        if (ecrits < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        // Écriture partielle : reprise au premier octet non écrit
+        while (restants > 0 && (size_t)ecrits >= vecteurs->iov_len) {
+            ecrits -= vecteurs->iov_len;
+            vecteurs++;
+            restants--;
+        }
+        if (restants > 0) {
+            vecteurs->iov_base = (char*)vecteurs->iov_base + ecrits;
+            vecteurs->iov_len -= ecrits;
+        }
+    }
+    lot->nombre_vecteurs = 0;
+    lot->utilise_arene = 0;
+    return 0;
+}
+
+// Garantit la place de trois vecteurs et de `taille` octets d'arène
+static int reserver_lot(LotEcriture *lot, size_t taille) {
+    if (lot->nombre_vecteurs + 3 > VECTEURS_PAR_ECRITURE || lot->utilise_arene + taille > lot->capacite_arene) {
+        if (vider_lot(lot) != 0) return -1;
+    }
+    if (taille > lot->capacite_arene) {
+        // Lot vide : aucun vecteur ne pointe plus dans l'arène
+        char *arene = realloc(lot->arene, taille);
+        if (arene == NULL) return -1;
+        lot->arene = arene;
+        lot->capacite_arene = taille;
+    }
+    return 0;
+}
+
+static void ajouter_vecteur(LotEcriture *lot, const void *donnees, size_t taille) {
+    lot->vecteurs[lot->nombre_vecteurs].iov_base = (void*)donnees;
+    lot->vecteurs[lot->nombre_vecteurs].iov_len = taille;
+    lot->nombre_vecteurs++;
+}
+
+static int ecrire_contexte(LotEcriture *lot, const char *genome, int longueur_genome, int position, int longueur,
+                           bool brin_moins, int numero_motif, const ParametresContextes *parametres) {
+    int debut = position - parametres->flanc > 0 ? position - parametres->flanc : 0;
+    int fin = (int64_t)position + longueur + parametres->flanc < longueur_genome
+            ? position + longueur + parametres->flanc : longueur_genome;
+    size_t taille_entete = strlen(parametres->identifiant) +
+                           (parametres->description != NULL ? strlen(parametres->description) : 0) + 64;
+    if (reserver_lot(lot, taille_entete + (brin_moins ? (size_t)(fin - debut) : 0)) != 0) return -1;
+
+    // En-tête au format des résultats de BLAST : coordonnées 1-indexées, brin - noté c<fin>-<début>
+    char *entete = lot->arene + lot->utilise_arene;
+    int ecrits = brin_moins
+               ? snprintf(entete, taille_entete, ">%s:c%d-%d", parametres->identifiant, fin, debut + 1)
+               : snprintf(entete, taille_entete, ">%s:%d-%d", parametres->identifiant, debut + 1, fin);
+    if (parametres->description != NULL) {
+        ecrits += snprintf(entete + ecrits, taille_entete - ecrits, " %s", parametres->description);
+    }
+    ecrits += snprintf(entete + ecrits, taille_entete - ecrits, " motif=%d\n", numero_motif);
+    lot->utilise_arene += ecrits;
+    ajouter_vecteur(lot, entete, ecrits);
+
+    if (brin_moins) {
+        char *inverse = lot->arene + lot->utilise_arene;
+        ecrire_complement_inverse(genome + debut, fin - debut, inverse);
+        lot->utilise_arene += fin - debut;
+        ajouter_vecteur(lot, inverse, fin - debut);
+    } else {
+        ajouter_vecteur(lot, genome + debut, fin - debut);
+    }
+    ajouter_vecteur(lot, "\n", 1);
+    return 0;
+}
+
+int64_t ecrire_contextes_occurrences(const IndexSuffixes *index, const StockMotifs *motifs,
+                                     const MasqueExclusion *masque, const ParametresContextes *parametres,
+                                     const char *chemin_fichier) {
+    if (parametres->flanc < 0 || parametres->identifiant == NULL) return -1;
+    LotEcriture *lot = calloc(1, sizeof(LotEcriture));
+    if (lot == NULL) return -1;
+    lot->capacite_arene = CAPACITE_ARENE_CONTEXTES;
+    lot->arene = malloc(lot->capacite_arene);
+    lot->descripteur = open(chemin_fichier, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (lot->arene == NULL || lot->descripteur < 0) {
+        if (lot->descripteur < 0) perror("Erreur lors de l'ouverture du fichier des contextes");
+        if (lot->descripteur >= 0) close(lot->descripteur);
+        free(lot->arene);
+        free(lot);
+        return -1;
+    }
+
+    bool plus = parametres->brin != BRIN_MOINS, moins = parametres->brin != BRIN_PLUS;
+    int64_t total = 0;
+    int erreur = 0;
+    char *inverse = NULL;
+    int capacite_inverse = 0;
+    for (int m = 0; m < motifs->nombre && !erreur; m++) {
+        int longueur = motifs->longueurs[m];
+        const char *sequence = sequence_motif_stock(motifs, m);
+        int nombre_plus = 0, nombre_moins = 0;
+        int *positions_plus = NULL, *positions_moins = NULL;
+        if (plus) {
+            positions_plus = positions_occurrences(index, sequence, longueur, masque, &nombre_plus);
+            erreur |= positions_plus == NULL && nombre_plus > 0;
+        }
+        if (moins && !erreur) {
+            if (longueur > capacite_inverse) {
+                char *agrandi = realloc(inverse, longueur);
+                if (agrandi == NULL) erreur = 1;
+                else {
+                    inverse = agrandi;
+                    capacite_inverse = longueur;
+                }
+            }
+            if (!erreur) ecrire_complement_inverse(sequence, longueur, inverse);
+            // Motif égal à son complément inverse : ses occurrences - sont celles du brin +, déjà écrites
+            if (!erreur && !(plus && memcmp(inverse, sequence, longueur) == 0)) {
+                positions_moins = positions_occurrences(index, inverse, longueur, masque, &nombre_moins);
+                erreur |= positions_moins == NULL && nombre_moins > 0;
+            }
+        }
+
+        // Fusion des deux brins dans l'ordre des positions (brin + d'abord à position égale)
+        int p = 0, q = 0;
+        while (!erreur && (p < nombre_plus || q < nombre_moins)) {
+            bool brin_moins = p == nombre_plus || (q < nombre_moins && positions_moins[q] < positions_plus[p]);
+            int position = brin_moins ? positions_moins[q++] : positions_plus[p++];
+            erreur = ecrire_contexte(lot, index->genome, index->longueur_genome, position, longueur, brin_moins,
+                                     m + 1, parametres) != 0;
+            total++;
+        }
+        free(positions_plus);
+        free(positions_moins);
+    }
+    free(inverse);
+
+    erreur = erreur || vider_lot(lot) != 0;
+    erreur |= close(lot->descripteur) != 0;
+    if (erreur) perror("Erreur lors de l'écriture des contextes");
+    free(lot->arene);
+    free(lot);
+    return erreur ? -1 : total;
+}
@@ -0,0 +1,420 @@
+// decompression.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <errno.h>
+#include <stdatomic.h>
+#include <zlib.h>
+#include "projet.h"
+
+#define NOMBRE_SEGMENTS 4                 // Segments décompressés en attente entre les deux threads
+#define TAILLE_SEGMENT_GZIP (1 << 20)     // Taille d'un segment pour un gzip classique
+#define TAILLE_ENTREE_GZIP (1 << 17)      // Taille des lectures compressées pour un gzip classique
+#define BLOCS_PAR_LOT_BGZF 64             // Blocs BGZF décompressés en parallèle par lot
+#define TAILLE_MAX_BLOC_BGZF 65536        // Taille maximale d'un bloc BGZF (compressé ou non)
+#define TAILLE_TAMPON_LIGNES (1 << 16)
+
+enum { SOURCE_TEXTE, SOURCE_GZIP, SOURCE_BGZF };
+
+typedef struct {
+    char *donnees;
+    size_t taille;
+    size_t capacite;
+} Segment;
+
+typedef struct {
+    unsigned char *compresse;   ///< Données compressées de chaque bloc du lot
+    size_t taille_compresse[BLOCS_PAR_LOT_BGZF];
+    uint32_t taille_sortie[BLOCS_PAR_LOT_BGZF];
+    uint32_t crc[BLOCS_PAR_LOT_BGZF];
+    size_t decalage_sortie[BLOCS_PAR_LOT_BGZF];
+    int nombre_blocs;
+    char *sortie;               ///< Segment de destination
+    _Atomic int erreur;         ///< Écrit par tous les threads de décompression du lot
+} LotBgzf;
+
+struct SourceSequence {
+    int type;
+    FILE *fichier;
+
+    // File de segments entre le thread de décompression (producteur) et le lecteur (consommateur)
+    pthread_t producteur;
+    int producteur_lance;
+    int initialise;             ///< Verrou et conditions initialisés (à détruire)
+    pthread_mutex_t verrou;
+    pthread_cond_t segment_disponible;
+    pthread_cond_t place_disponible;
+    Segment segments[NOMBRE_SEGMENTS];
+    int tete;
+    int nombre;
+    int fin_flux;
+    int arret;
+    int erreur;
+    size_t position_tete;       ///< Octets déjà lus dans le segment de tête
+
+    PoolThreads *pool;          ///< Pool global à l'ouverture, qui décompresse les lots BGZF
+
+    // Tampon de lire_ligne_source
+    char *tampon_lignes;
+    size_t taille_tampon_lignes;
+    size_t position_tampon_lignes;
+};
+
+// ==================== File de segments ====================
+
+static Segment* attendre_segment_libre(SourceSequence *source) {
+    pthread_mutex_lock(&source->verrou);
+    while (source->nombre == NOMBRE_SEGMENTS && !source->arret) {
+        pthread_cond_wait(&source->place_disponible, &source->verrou);
+    }
+    Segment *segment = source->arret ? NULL : &source->segments[(source->tete + source->nombre) % NOMBRE_SEGMENTS];
+    pthread_mutex_unlock(&source->verrou);
+    return segment;
+}
+
+static void publier_segment(SourceSequence *source) {
+    pthread_mutex_lock(&source->verrou);
+    source->nombre++;
+    pthread_cond_signal(&source->segment_disponible);
+    pthread_mutex_unlock(&source->verrou);
+}
+
+static void terminer_flux(SourceSequence *source, int erreur) {
+    pthread_mutex_lock(&source->verrou);
+    source->fin_flux = 1;
+    if (erreur) source->erreur = 1;
+    pthread_cond_broadcast(&source->segment_disponible);
+    pthread_mutex_unlock(&source->verrou);
+}
+
+// ==================== gzip classique : un thread de décompression ====================
+
+static void* produire_gzip(void *argument) {
+    SourceSequence *source = argument;
+    unsigned char *entree = malloc(TAILLE_ENTREE_GZIP);
+    z_stream flux;
+    memset(&flux, 0, sizeof(flux));
+    // 15 + 32 : fenêtre maximale et détection automatique de l'en-tête gzip
+    if (entree == NULL || inflateInit2(&flux, 15 + 32) != Z_OK) {
+        free(entree);
+        terminer_flux(source, 1);
+        return NULL;
+    }
+
+    int erreur = 0;
+    int fini = 0;
+    int membre_termine = 0;
+    while (!fini) {
+        Segment *segment = attendre_segment_libre(source);
+        if (segment == NULL) break;
+        segment->taille = 0;
+
+        while (segment->taille < segment->capacite) {
+            if (flux.avail_in == 0) {
+                size_t lus = fread(entree, 1, TAILLE_ENTREE_GZIP, source->fichier);
+                if (lus == 0) {
+                    // Fin du fichier au milieu d'un membre : fichier tronqué
+                    if (!membre_termine) erreur = 1;
+                    fini = 1;
+                    break;
+                }
+                flux.next_in = entree;
+                flux.avail_in = (uInt)lus;
+            }
+            if (membre_termine) {
+                // Plusieurs membres gzip concaténés : on enchaîne sur le suivant
+                inflateReset(&flux);
+                membre_termine = 0;
+            }
+
+            flux.next_out = (unsigned char*)segment->donnees + segment->taille;
+            flux.avail_out = (uInt)(segment->capacite - segment->taille);
+            int retour = inflate(&flux, Z_NO_FLUSH);
+            segment->taille = segment->capacite - flux.avail_out;
+
+            if (retour == Z_STREAM_END) {
+                membre_termine = 1;
+            } else if (retour != Z_OK && !(retour == Z_BUF_ERROR && flux.avail_in == 0)) {
+                erreur = 1;
+                fini = 1;
+                break;
+            }
+        }
+        publier_segment(source);
+    }
+
+    inflateEnd(&flux);
+    free(entree);
+    terminer_flux(source, erreur);
+    return NULL;
+}
+
+// ==================== BGZF : blocs indépendants décompressés en parallèle ====================
+
+// Lit l'en-tête d'un bloc BGZF et ses données ; retourne 0 à la fin du fichier, -1 en cas d'erreur
+static int lire_bloc_bgzf(FILE *fichier, unsigned char *compresse, size_t *taille_compresse,
+                          uint32_t *taille_sortie, uint32_t *crc) {
+    unsigned char entete[12];
+    size_t lus = fread(entete, 1, sizeof(entete), fichier);
+    if (lus == 0) return 0;
+    if (lus != sizeof(entete) || entete[0] != 0x1f || entete[1] != 0x8b || !(entete[3] & 4)) return -1;
+
+    int longueur_extra = entete[10] | (entete[11] << 8);
+    unsigned char extra[65536];
+    if (fread(extra, 1, longueur_extra, fichier) != (size_t)longueur_extra) return -1;
+
+    // Recherche du sous-champ "BC" donnant la taille totale du bloc
+    int taille_bloc = -1;
+    for (int i = 0; i + 4 <= longueur_extra;) {
+        int longueur_sous_champ = extra[i + 2] | (extra[i + 3] << 8);
+        if (extra[i] == 'B' && extra[i + 1] == 'C' && longueur_sous_champ == 2 && i + 6 <= longueur_extra) {
+            taille_bloc = (extra[i + 4] | (extra[i + 5] << 8)) + 1;
+        }
+        i += 4 + longueur_sous_champ;
+    }
+    if (taille_bloc < 0) return -1;
+
+    int taille_donnees = taille_bloc - 12 - longueur_extra - 8;
+    if (taille_donnees < 0 || taille_donnees > TAILLE_MAX_BLOC_BGZF) return -1;
+    unsigned char pied[8];
+    if (fread(compresse, 1, taille_donnees, fichier) != (size_t)taille_donnees ||
+        fread(pied, 1, sizeof(pied), fichier) != sizeof(pied)) {
+        return -1;
+    }
+
+    *taille_compresse = taille_donnees;
+    *crc = pied[0] | (pied[1] << 8) | (pied[2] << 16) | ((uint32_t)pied[3] << 24);
+    *taille_sortie = pied[4] | (pied[5] << 8) | (pied[6] << 16) | ((uint32_t)pied[7] << 24);
+    return *taille_sortie > TAILLE_MAX_BLOC_BGZF ? -1 : 1;
+}
+
+// Décompresse les blocs [debut, fin) du lot, avec un seul flux zlib
+static void decompresser_blocs_bgzf(const BlocParallele *bloc, void *contexte) {
+    LotBgzf *lot = contexte;
+    z_stream flux;
+    memset(&flux, 0, sizeof(flux));
+    if (inflateInit2(&flux, -15) != Z_OK) {
+        lot->erreur = 1;
+        return;
+    }
+
+    for (int64_t b = bloc->debut; b < bloc->fin; b++) {
+        inflateReset(&flux);
+        flux.next_in = lot->compresse + (size_t)b * TAILLE_MAX_BLOC_BGZF;
+        flux.avail_in = (uInt)lot->taille_compresse[b];
+        unsigned char *sortie = (unsigned char*)lot->sortie + lot->decalage_sortie[b];
+        flux.next_out = sortie;
+        flux.avail_out = lot->taille_sortie[b];
+        int retour = inflate(&flux, Z_FINISH);
+        if ((retour != Z_STREAM_END && !(retour == Z_BUF_ERROR && lot->taille_sortie[b] == 0)) ||
+            flux.total_out != lot->taille_sortie[b] ||
+            crc32(0L, sortie, lot->taille_sortie[b]) != lot->crc[b]) {
+            lot->erreur = 1;
+        }
+    }
+    inflateEnd(&flux);
+}
+
+static void* produire_bgzf(void *argument) {
+    SourceSequence *source = argument;
+    LotBgzf lot;
+    memset(&lot, 0, sizeof(lot));
+    lot.compresse = malloc((size_t)BLOCS_PAR_LOT_BGZF * TAILLE_MAX_BLOC_BGZF);
+    if (lot.compresse == NULL) {
+        terminer_flux(source, 1);
+        return NULL;
+    }
+
+    int erreur = 0;
+    int fini = 0;
+    while (!fini && !erreur) {
+        // Lecture séquentielle d'un lot de blocs (en-têtes et données compressées)
+        lot.nombre_blocs = 0;
+        size_t total = 0;
+        while (lot.nombre_blocs < BLOCS_PAR_LOT_BGZF) {
+            int b = lot.nombre_blocs;
+            int statut = lire_bloc_bgzf(source->fichier, lot.compresse + (size_t)b * TAILLE_MAX_BLOC_BGZF,
+                                        &lot.taille_compresse[b], &lot.taille_sortie[b], &lot.crc[b]);
+            if (statut <= 0) {
+                if (statut < 0) erreur = 1;
+                fini = 1;
+                break;
+            }
+            lot.decalage_sortie[b] = total;
+            total += lot.taille_sortie[b];
+            lot.nombre_blocs++;
+        }
+        if (lot.nombre_blocs == 0) break;
+
+        Segment *segment = attendre_segment_libre(source);
+        if (segment == NULL) break;
+        lot.sortie = segment->donnees;
+        lot.erreur = 0;
+
+        // Décompression parallèle sur le pool : une part des blocs par thread, le producteur compris
+        int nombre_threads = nombre_threads_pool(source->pool);
+        pool_parallel_for(source->pool, 0, lot.nombre_blocs, (lot.nombre_blocs + nombre_threads - 1) / nombre_threads,
+                          0, decompresser_blocs_bgzf, &lot);
+
+        if (lot.erreur) erreur = 1;
+        segment->taille = total;
+        publier_segment(source);
+    }
+
+    free(lot.compresse);
+    terminer_flux(source, erreur);
+    return NULL;
+}
+
+// ==================== Interface ====================
+
+// Détecte le format à partir des premiers octets (gzip : 1f 8b ; BGZF : sous-champ "BC" dans l'extra)
+static int detecter_type(FILE *fichier) {
+    unsigned char entete[18];
+    size_t lus = fread(entete, 1, sizeof(entete), fichier);
+    rewind(fichier);
+    if (lus < 2 || entete[0] != 0x1f || entete[1] != 0x8b) return SOURCE_TEXTE;
+    if (lus == sizeof(entete) && (entete[3] & 4) && entete[12] == 'B' && entete[13] == 'C') return SOURCE_BGZF;
+    return SOURCE_GZIP;
+}
+
+SourceSequence* ouvrir_source(const char *chemin_fichier) {
+    FILE *fichier = fopen(chemin_fichier, "rb");
+    if (fichier == NULL) return NULL;
+    SourceSequence *source = calloc(1, sizeof(SourceSequence));
+    if (source == NULL) {
+        fclose(fichier);
+        return NULL;
+    }
+    source->fichier = fichier;
+    source->type = detecter_type(fichier);
+    if (source->type == SOURCE_TEXTE) return source;
+
+    source->pool = pool_global();
+
+    size_t capacite = source->type == SOURCE_BGZF ? (size_t)BLOCS_PAR_LOT_BGZF * TAILLE_MAX_BLOC_BGZF : TAILLE_SEGMENT_GZIP;
+    for (int s = 0; s < NOMBRE_SEGMENTS; s++) {
+        source->segments[s].donnees = malloc(capacite);
+        source->segments[s].capacite = capacite;
+        if (source->segments[s].donnees == NULL) {
+            fermer_source(source);
+            return NULL;
+        }
+    }
+
+    pthread_mutex_init(&source->verrou, NULL);
+    pthread_cond_init(&source->segment_disponible, NULL);
+    pthread_cond_init(&source->place_disponible, NULL);
+    source->initialise = 1;
+    void* (*producteur)(void*) = source->type == SOURCE_BGZF ? produire_bgzf : produire_gzip;
+    int erreur_thread = pthread_create(&source->producteur, NULL, producteur, source);
+    if (erreur_thread != 0) {
+        fermer_source(source);
+        errno = erreur_thread;
+        return NULL;
+    }
+    source->producteur_lance = 1;
+    return source;
+}
+
+size_t lire_source(SourceSequence *source, char *destination, size_t taille) {
+    if (source->type == SOURCE_TEXTE) return fread(destination, 1, taille, source->fichier);
+
+    size_t copies = 0;
+    while (copies < taille) {
+        pthread_mutex_lock(&source->verrou);
+        while (source->nombre == 0 && !source->fin_flux) {
+            pthread_cond_wait(&source->segment_disponible, &source->verrou);
+        }
+        if (source->nombre == 0) {
+            pthread_mutex_unlock(&source->verrou);
+            break;
+        }
+        Segment *segment = &source->segments[source->tete];
+        pthread_mutex_unlock(&source->verrou);
+
+        // Le segment de tête n'est plus modifié par le producteur : copie hors verrou
+        size_t disponibles = segment->taille - source->position_tete;
+        size_t n = taille - copies < disponibles ? taille - copies : disponibles;
+        memcpy(destination + copies, segment->donnees + source->position_tete, n);
+        copies += n;
+        source->position_tete += n;
+
+        if (source->position_tete == segment->taille) {
+            pthread_mutex_lock(&source->verrou);
+            source->tete = (source->tete + 1) % NOMBRE_SEGMENTS;
+            source->nombre--;
+            source->position_tete = 0;
+            pthread_cond_signal(&source->place_disponible);
+            pthread_mutex_unlock(&source->verrou);
+        }
+    }
+    return copies;
+}
+
+int erreur_source(SourceSequence *source) {
+    if (source->type == SOURCE_TEXTE) return ferror(source->fichier);
+    pthread_mutex_lock(&source->verrou);
+    int erreur = source->erreur;
+    pthread_mutex_unlock(&source->verrou);
+    return erreur;
+}
+
+int64_t lire_ligne_source(SourceSequence *source, char **ligne, size_t *capacite) {
+    if (source->tampon_lignes == NULL) {
+        source->tampon_lignes = malloc(TAILLE_TAMPON_LIGNES);
+        if (source->tampon_lignes == NULL) return -1;
+    }
+
+    int64_t longueur = 0;
+    for (;;) {
+        if (source->position_tampon_lignes == source->taille_tampon_lignes) {
+            source->taille_tampon_lignes = lire_source(source, source->tampon_lignes, TAILLE_TAMPON_LIGNES);
+            source->position_tampon_lignes = 0;
+            if (source->taille_tampon_lignes == 0) break;
+        }
+        char *debut = source->tampon_lignes + source->position_tampon_lignes;
+        size_t disponibles = source->taille_tampon_lignes - source->position_tampon_lignes;
+        char *fin_ligne = memchr(debut, '\n', disponibles);
+        size_t n = fin_ligne != NULL ? (size_t)(fin_ligne - debut) + 1 : disponibles;
+
+        if ((size_t)longueur + n + 1 > *capacite) {
+            size_t nouvelle_capacite = *capacite == 0 ? 256 : *capacite;
+            while ((size_t)longueur + n + 1 > nouvelle_capacite) nouvelle_capacite *= 2;
+            char *p = realloc(*ligne, nouvelle_capacite);
+            if (p == NULL) return -1;
+            *ligne = p;
+            *capacite = nouvelle_capacite;
+        }
+        memcpy(*ligne + longueur, debut, n);
+        longueur += n;
+        source->position_tampon_lignes += n;
+        if (fin_ligne != NULL) break;
+    }
+
+    if (longueur == 0) return -1;
+    (*ligne)[longueur] = '\0';
+    return longueur;
+}
+
+void fermer_source(SourceSequence *source) {
+    if (source == NULL) return;
+    if (source->producteur_lance) {
+        // Réveille le producteur s'il attend une place libre, puis attend sa fin
+        pthread_mutex_lock(&source->verrou);
+        source->arret = 1;
+        pthread_cond_broadcast(&source->place_disponible);
+        pthread_mutex_unlock(&source->verrou);
+        pthread_join(source->producteur, NULL);
+    }
+    if (source->initialise) {
+        pthread_mutex_destroy(&source->verrou);
+        pthread_cond_destroy(&source->segment_disponible);
+        pthread_cond_destroy(&source->place_disponible);
+    }
+    for (int s = 0; s < NOMBRE_SEGMENTS; s++) free(source->segments[s].donnees);
+    free(source->tampon_lignes);
+    fclose(source->fichier);
+    free(source);
+}
@@ -0,0 +1,387 @@
+// ecriture_resultats.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include "projet.h"
+
+#define TAILLE_TAMPON_RESULTATS (1 << 20)  // Les résultats sont écrits par blocs de 1 Mo
+#define TAILLE_MAX_CHAMPS 160              // Place réservée aux champs numériques d'un motif
+#define SIGNATURE_BINAIRE "MOTIFS3"        // En-tête du format binaire (8 octets avec le '\0')
+#define TAILLE_ENTETE_BINAIRE 40           // Champs fixes d'un motif, avant sa séquence
+#define TAILLE_FIXE_DISTRIBUTION 64        // Champs fixes d'un bloc de répartition, avant ses tableaux
+
+struct EcrivainResultats {
+    FILE *fichier;
+    FormatResultats format;
+    char *tampon;
+    size_t taille;
+    int erreur;
+};
+
+ParametresSortie parametres_sortie_defaut() {
+    ParametresSortie sortie = {NULL, FORMAT_TSV, NULL, 1, 1, NULL, TAILLE_FENETRE_DENSITE, 0, NULL, 0, 0, 0,
+                               MOTEUR_REPETITIONS, FOLD_CHANGE_MIN, NULL, NULL, {NULL, NULL, 0, BRIN_DEUX}, 0, NULL,
+                               NULL, NULL};
+    return sortie;
+}
+
+int format_resultats_depuis_nom(const char *nom, FormatResultats *format) {
+    if (strcmp(nom, "tsv") == 0) {
+        *format = FORMAT_TSV;
+    } else if (strcmp(nom, "jsonl") == 0) {
+        *format = FORMAT_JSONL;
+    } else if (strcmp(nom, "bin") == 0) {
+        *format = FORMAT_BINAIRE;
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+static void vider_tampon(EcrivainResultats *ecrivain) {
+    if (ecrivain->taille > 0 && fwrite(ecrivain->tampon, 1, ecrivain->taille, ecrivain->fichier) != ecrivain->taille) {
+        ecrivain->erreur = 1;
+    }
+    ecrivain->taille = 0;
+}
+
+// Ajoute des octets au tampon ; un bloc plus grand que le tampon est écrit directement
+static void ajouter(EcrivainResultats *ecrivain, const void *donnees, size_t taille) {
+    if (ecrivain->taille + taille > TAILLE_TAMPON_RESULTATS) vider_tampon(ecrivain);
+    if (taille > TAILLE_TAMPON_RESULTATS) {
+        if (fwrite(donnees, 1, taille, ecrivain->fichier) != taille) ecrivain->erreur = 1;
+        return;
+    }
+    memcpy(ecrivain->tampon + ecrivain->taille, donnees, taille);
+    ecrivain->taille += taille;
+}
+
+static void ajouter_texte(EcrivainResultats *ecrivain, const char *texte) {
+    ajouter(ecrivain, texte, strlen(texte));
+}
+
+// Formate des champs numériques directement dans le tampon
+static void ajouter_champs(EcrivainResultats *ecrivain, const char *format, ...) {
+    if (ecrivain->taille + TAILLE_MAX_CHAMPS > TAILLE_TAMPON_RESULTATS) vider_tampon(ecrivain);
+    va_list arguments;
+    va_start(arguments, format);
+    int n = vsnprintf(ecrivain->tampon + ecrivain->taille, TAILLE_MAX_CHAMPS, format, arguments);
+    va_end(arguments);
+    if (n < 0 || n >= TAILLE_MAX_CHAMPS) {
+        ecrivain->erreur = 1;
+        return;
+    }
+    ecrivain->taille += n;
+}
+
+// Format binaire : chaque champ est écrit octet par octet en petit-boutiste, sans remplissage,
+// pour que le fichier se relise à l'identique quelle que soit la machine
+static void ajouter_entier64(EcrivainResultats *ecrivain, uint64_t valeur, int taille) {
+    unsigned char octets[8];
+    for (int i = 0; i < taille; i++) octets[i] = (unsigned char)(valeur >> (8 * i));
+    ajouter(ecrivain, octets, taille);
+}
+
+static void ajouter_entier32(EcrivainResultats *ecrivain, int32_t valeur) {
+    ajouter_entier64(ecrivain, (uint32_t)valeur, 4);
+}
+
+static void ajouter_reel64(EcrivainResultats *ecrivain, double valeur) {
+    uint64_t bits;
+    memcpy(&bits, &valeur, sizeof(bits));
+    ajouter_entier64(ecrivain, bits, 8);
+}
+
+static void ajouter_entiers32(EcrivainResultats *ecrivain, const int *valeurs, int nombre) {
+    for (int i = 0; i < nombre; i++) ajouter_entier32(ecrivain, valeurs[i]);
+}
+
+// Taille du bloc de répartition d'un motif (0 sans répartition)
+static int64_t taille_distribution_binaire(const DistributionMotif *d) {
+    if (d == NULL) return 0;
+    int64_t entiers = (int64_t)d->nombre_occurrences * (d->distances_genes != NULL ? 2 : 1) + d->nombre_fenetres;
+    return TAILLE_FIXE_DISTRIBUTION + 4 * entiers;
+}
+
+// Bloc de répartition : résumé, puis positions, densités par fenêtre et distances aux gènes (si annotées)
+static void ecrire_distribution_binaire(EcrivainResultats *ecrivain, const DistributionMotif *d) {
+    ajouter_entier32(ecrivain, d->nombre_occurrences);
+    ajouter_entier32(ecrivain, d->ecart_min);
+    ajouter_entier32(ecrivain, d->ecart_median);
+    ajouter_entier32(ecrivain, d->ecart_max);
+    ajouter_reel64(ecrivain, d->ecart_moyen);
+    ajouter_entier32(ecrivain, d->taille_fenetre);
+    ajouter_entier32(ecrivain, d->nombre_fenetres);
+    ajouter_entier32(ecrivain, d->densite_max);
+    ajouter_entier32(ecrivain, d->fenetre_densite_max);
+    ajouter_entier32(ecrivain, d->distances_genes != NULL);
+    ajouter_entier32(ecrivain, d->distance_min_gene);
+    ajouter_reel64(ecrivain, d->distance_moyenne_gene);
+    ajouter_reel64(ecrivain, d->fraction_intergenique);
+    ajouter_entiers32(ecrivain, d->positions, d->nombre_occurrences);
+    ajouter_entiers32(ecrivain, d->densites, d->nombre_fenetres);
+    if (d->distances_genes != NULL) ajouter_entiers32(ecrivain, d->distances_genes, d->nombre_occurrences);
+}
+
+// Objet "distribution" d'une ligne JSON : résumé puis listes des positions et des distances aux gènes
+static void ecrire_distribution_json(EcrivainResultats *ecrivain, const DistributionMotif *d) {
+    ajouter_champs(ecrivain, ",\"distribution\":{\"copies\":%d,\"ecart_min\":%d,\"ecart_median\":%d,"
+                   "\"ecart_max\":%d,\"ecart_moyen\":%.10g,", d->nombre_occurrences, d->ecart_min,
+                   d->ecart_median, d->ecart_max, d->ecart_moyen);
+    ajouter_champs(ecrivain, "\"taille_fenetre\":%d,\"densite_max\":%d,\"fenetre_densite_max\":%d,",
+                   d->taille_fenetre, d->densite_max, d->fenetre_densite_max);
+    if (d->distances_genes != NULL) {
+        ajouter_champs(ecrivain, "\"distance_min_gene\":%d,\"distance_moyenne_gene\":%.10g,"
+                       "\"fraction_intergenique\":%.10g,", d->distance_min_gene, d->distance_moyenne_gene,
+                       d->fraction_intergenique);
+    }
+    ajouter_texte(ecrivain, "\"positions\":[");
+    for (int i = 0; i < d->nombre_occurrences; i++) {
+        ajouter_champs(ecrivain, i == 0 ? "%d" : ",%d", d->positions[i]);
+    }
+    ajouter_texte(ecrivain, "]");
+    if (d->distances_genes != NULL) {
+        ajouter_texte(ecrivain, ",\"distances_genes\":[");
+        for (int i = 0; i < d->nombre_occurrences; i++) {
+            ajouter_champs(ecrivain, i == 0 ? "%d" : ",%d", d->distances_genes[i]);
+        }
+        ajouter_texte(ecrivain, "]");
+    }
+    ajouter_texte(ecrivain, "}");
+}
+
+EcrivainResultats* ouvrir_ecrivain_resultats(const char *chemin_fichier, FormatResultats format) {
+    EcrivainResultats *ecrivain = calloc(1, sizeof(EcrivainResultats));
+    if (ecrivain == NULL) return NULL;
+    ecrivain->format = format;
+    ecrivain->tampon = malloc(TAILLE_TAMPON_RESULTATS);
+    ecrivain->fichier = fopen(chemin_fichier, format == FORMAT_BINAIRE ? "wb" : "w");
+    if (ecrivain->tampon == NULL || ecrivain->fichier == NULL) {
+        if (ecrivain->fichier == NULL) perror("Impossible de créer le fichier de résultats");
+        if (ecrivain->fichier != NULL) fclose(ecrivain->fichier);
+        free(ecrivain->tampon);
+        free(ecrivain);
+        return NULL;
+    }
+
+    if (format == FORMAT_TSV) {
+        const char *entete = "sequence\tposition\tlongueur\tfold_change\toccurrences_reelles\toccurrences_aleatoires"
+                             "\toccurrences_approchees_reelles\toccurrences_approchees_aleatoires"
+                             "\tcopies\tecart_moyen\tecart_median\tdensite_max\tdistance_min_gene"
+                             "\tdistance_moyenne_gene\tfraction_intergenique\n";
+        ajouter_texte(ecrivain, entete);
+    } else if (format == FORMAT_BINAIRE) {
+        ajouter(ecrivain, SIGNATURE_BINAIRE, sizeof(SIGNATURE_BINAIRE));
+    }
+    return ecrivain;
+}
+
+int ecrire_motif_resultat(EcrivainResultats *ecrivain, const Motif *motif) {
+    switch (ecrivain->format) {
+        case FORMAT_TSV:
+            ajouter(ecrivain, motif->sequence, motif->length);
+            ajouter_champs(ecrivain, "\t%d\t%d\t%.10g\t%d\t%d", motif->start_pos, motif->length,
+                           motif->fold_change, motif->occurrences_reelles, motif->occurrences_aleatoires);
+            if (motif->occurrences_approchees_reelles >= 0) {
+                ajouter_champs(ecrivain, "\t%d\t%d", motif->occurrences_approchees_reelles,
+                               motif->occurrences_approchees_aleatoires);
+            } else {
+                ajouter_texte(ecrivain, "\tNA\tNA");
+            }
+            if (motif->distribution != NULL) {
+                const DistributionMotif *d = motif->distribution;
+                ajouter_champs(ecrivain, "\t%d\t%.10g\t%d\t%d", d->nombre_occurrences, d->ecart_moyen,
+                               d->ecart_median, d->densite_max);
+                if (d->distances_genes != NULL) {
+                    ajouter_champs(ecrivain, "\t%d\t%.10g\t%.10g\n", d->distance_min_gene,
+                                   d->distance_moyenne_gene, d->fraction_intergenique);
+                } else {
+                    ajouter_texte(ecrivain, "\tNA\tNA\tNA\n");
+                }
+            } else {
+                ajouter_texte(ecrivain, "\tNA\tNA\tNA\tNA\tNA\tNA\tNA\n");
+            }
+            break;
+        case FORMAT_JSONL:
+            // Les séquences ne contiennent que A, C, G, T : aucun caractère à échapper
+            ajouter_texte(ecrivain, "{\"sequence\":\"");
+            ajouter(ecrivain, motif->sequence, motif->length);
+            ajouter_champs(ecrivain, "\",\"position\":%d,\"longueur\":%d,\"fold_change\":%.10g,"
+                           "\"occurrences_reelles\":%d,\"occurrences_aleatoires\":%d",
+                           motif->start_pos, motif->length, motif->fold_change,
+                           motif->occurrences_reelles, motif->occurrences_aleatoires);
+            if (motif->occurrences_approchees_reelles >= 0) {
+                ajouter_champs(ecrivain, ",\"occurrences_approchees_reelles\":%d,\"occurrences_approchees_aleatoires\":%d",
+                               motif->occurrences_approchees_reelles, motif->occurrences_approchees_aleatoires);
+            }
+            if (motif->distribution != NULL) ecrire_distribution_json(ecrivain, motif->distribution);
+            ajouter_texte(ecrivain, "}\n");
+            break;
+        case FORMAT_BINAIRE:
+            ajouter_entier32(ecrivain, motif->start_pos);
+            ajouter_entier32(ecrivain, motif->length);
+            ajouter_reel64(ecrivain, motif->fold_change);
+            ajouter_entier32(ecrivain, motif->occurrences_reelles);
+            ajouter_entier32(ecrivain, motif->occurrences_aleatoires);
+            ajouter_entier32(ecrivain, motif->occurrences_approchees_reelles);
+            ajouter_entier32(ecrivain, motif->occurrences_approchees_aleatoires);
+            ajouter_entier64(ecrivain, (uint64_t)taille_distribution_binaire(motif->distribution), 8);
+            ajouter(ecrivain, motif->sequence, motif->length);
+            if (motif->distribution != NULL) ecrire_distribution_binaire(ecrivain, motif->distribution);
+            break;
+    }
+    return ecrivain->erreur ? -1 : 0;
+}
+
+int fermer_ecrivain_resultats(EcrivainResultats *ecrivain) {
+    if (ecrivain == NULL) return -1;
+    vider_tampon(ecrivain);
+    if (fclose(ecrivain->fichier) != 0) ecrivain->erreur = 1;
+    int statut = ecrivain->erreur ? -1 : 0;
+    if (statut != 0) printf("Erreur lors de l'écriture du fichier de résultats\n");
+    free(ecrivain->tampon);
+    free(ecrivain);
+    return statut;
+}
+
+static uint64_t lire_entier64(const unsigned char *octets, int taille) {
+    uint64_t valeur = 0;
+    for (int i = 0; i < taille; i++) valeur |= (uint64_t)octets[i] << (8 * i);
+    return valeur;
+}
+
+static int32_t lire_entier32(const unsigned char *octets) {
+    return (int32_t)(uint32_t)lire_entier64(octets, 4);
+}
+
+static double lire_reel64(const unsigned char *octets) {
+    uint64_t bits = lire_entier64(octets, 8);
+    double valeur;
+    memcpy(&valeur, &bits, sizeof(valeur));
+    return valeur;
+}
+
+// Tableau de `nombre` entiers du bloc (au moins une case allouée, comme calculer_distribution_motif)
+static int* lire_entiers32(const unsigned char *octets, int nombre) {
+    int *valeurs = malloc((nombre > 0 ? nombre : 1) * sizeof(int));
+    if (valeurs == NULL) return NULL;
+    for (int i = 0; i < nombre; i++) valeurs[i] = lire_entier32(octets + 4 * i);
+    return valeurs;
+}
+
+// Décode un bloc de répartition de `taille` octets ; NULL s'il est incohérent
+static DistributionMotif* decoder_distribution_binaire(const unsigned char *bloc, int64_t taille) {
+    if (taille < TAILLE_FIXE_DISTRIBUTION) return NULL;
+    DistributionMotif *d = calloc(1, sizeof(DistributionMotif));
+    if (d == NULL) return NULL;
+    d->nombre_occurrences = lire_entier32(bloc);
+    d->ecart_min = lire_entier32(bloc + 4);
+    d->ecart_median = lire_entier32(bloc + 8);
+    d->ecart_max = lire_entier32(bloc + 12);
+    d->ecart_moyen = lire_reel64(bloc + 16);
+    d->taille_fenetre = lire_entier32(bloc + 24);
+    d->nombre_fenetres = lire_entier32(bloc + 28);
+    d->densite_max = lire_entier32(bloc + 32);
+    d->fenetre_densite_max = lire_entier32(bloc + 36);
+    int avec_genes = lire_entier32(bloc + 40);
+    d->distance_min_gene = lire_entier32(bloc + 44);
+    d->distance_moyenne_gene = lire_reel64(bloc + 48);
+    d->fraction_intergenique = lire_reel64(bloc + 56);
+
+    int n = d->nombre_occurrences;
+    int64_t attendue = TAILLE_FIXE_DISTRIBUTION + 4 * ((int64_t)n * (avec_genes ? 2 : 1) + d->nombre_fenetres);
+    if (n < 0 || d->nombre_fenetres < 0 || attendue != taille) {
+        free(d);
+        return NULL;
+    }
+    const unsigned char *tableaux = bloc + TAILLE_FIXE_DISTRIBUTION;
+    d->positions = lire_entiers32(tableaux, n);
+    d->densites = lire_entiers32(tableaux + 4 * (int64_t)n, d->nombre_fenetres);
+    if (avec_genes) d->distances_genes = lire_entiers32(tableaux + 4 * ((int64_t)n + d->nombre_fenetres), n);
+    if (d->positions == NULL || d->densites == NULL || (avec_genes && d->distances_genes == NULL)) {
+        liberer_distribution_motif(d);
+        return NULL;
+    }
+    return d;
+}
+
+Motif* lire_motifs_binaires(const char *chemin_fichier, int *nombre_motifs) {
+    *nombre_motifs = 0;
+    FILE *fichier = fopen(chemin_fichier, "rb");
+    if (fichier == NULL) {
+        perror("Erreur lors de l'ouverture du fichier");
+        return NULL;
+    }
+    char signature[sizeof(SIGNATURE_BINAIRE)];
+    if (fread(signature, 1, sizeof(signature), fichier) != sizeof(signature) ||
+        memcmp(signature, SIGNATURE_BINAIRE, sizeof(signature)) != 0) {
+        printf("Erreur : %s n'est pas un fichier de résultats binaire\n", chemin_fichier);
+        fclose(fichier);
+        return NULL;
+    }
+
+    // Tableau alloué même sans motif : NULL signale seulement une erreur
+    int nombre = 0;
+    int capacite = 64;
+    Motif *motifs = malloc(capacite * sizeof(Motif));
+    bool erreur = motifs == NULL;
+    unsigned char entete[TAILLE_ENTETE_BINAIRE];
+    while (!erreur) {
+        // Fin du fichier seulement entre deux enregistrements ; un en-tête incomplet est une troncature
+        size_t octets_entete = fread(entete, 1, sizeof(entete), fichier);
+        if (octets_entete == 0 && feof(fichier)) break;
+        if (octets_entete != sizeof(entete)) {
+            printf("Erreur : fichier de résultats binaire tronqué ou corrompu\n");
+            erreur = true;
+            break;
+        }
+        if (nombre == capacite) {
+            capacite *= 2;
+            Motif *p = realloc(motifs, capacite * sizeof(Motif));
+            if (p == NULL) {
+                printf("Erreur d'allocation mémoire pour les motifs\n");
+                erreur = true;
+                break;
+            }
+            motifs = p;
+        }
+        Motif motif = {NULL, lire_entier32(entete), lire_entier32(entete + 4), lire_reel64(entete + 8),
+                       lire_entier32(entete + 16), lire_entier32(entete + 20), NULL, lire_entier32(entete + 24),
+                       lire_entier32(entete + 28)};
+        int64_t taille_distribution = (int64_t)lire_entier64(entete + 32, 8);
+
+        motif.sequence = motif.length >= 0 ? malloc(motif.length + 1) : NULL;
+        unsigned char *bloc = taille_distribution > 0 ? malloc(taille_distribution) : NULL;
+        bool lu = motif.sequence != NULL && taille_distribution >= 0 &&
+                  fread(motif.sequence, 1, motif.length, fichier) == (size_t)motif.length &&
+                  (taille_distribution == 0 ||
+                   (bloc != NULL && fread(bloc, 1, taille_distribution, fichier) == (size_t)taille_distribution));
+        if (lu && bloc != NULL) {
+            motif.distribution = decoder_distribution_binaire(bloc, taille_distribution);
+            lu = motif.distribution != NULL;
+        }
+        free(bloc);
+        if (!lu) {
+            printf("Erreur : fichier de résultats binaire tronqué ou corrompu\n");
+            free(motif.sequence);
+            erreur = true;
+            break;
+        }
+        motif.sequence[motif.length] = '\0';
+        motifs[nombre++] = motif;
+    }
+    fclose(fichier);
+
+    // Enregistrement incomplet : rien n'est rendu, l'appelant ne peut pas confondre un fichier tronqué et complet
+    if (erreur) {
+        for (int i = 0; i < nombre; i++) {
+            free(motifs[i].sequence);
+            liberer_distribution_motif(motifs[i].distribution);
+        }
+        free(motifs);
+        return NULL;
+    }
+    *nombre_motifs = nombre;
+    return motifs;
+}
@@ -0,0 +1,196 @@
+// filtre_consensus.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "projet.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define FILTRE_AVX2_DISPONIBLE 1
+#include <immintrin.h>
+#endif
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define LONGUEUR_MAX_BOITE_FILTRE 127 // Au-delà, les correspondances ne tiennent plus dans un octet signé
+
+// Masque des positions [0, 32) de `sequence` où la boîte a au plus un mésappariement
+// (lit les 32 + longueur - 1 premières bases)
+typedef uint32_t (*FonctionMasqueBoite)(const char *sequence, const char *boite, int longueur);
+
+static FiltreConsensus filtre_choisi = FILTRE_CONSENSUS_AUTO;
+
+static uint32_t masque_boite_scalaire(const char *sequence, const char *boite, int longueur) {
+    uint32_t masque = 0;
+    for (int j = 0; j < 32; j++) {
+        if (comparer_avec_marge_erreur(sequence + j, boite, longueur)) masque |= (uint32_t)1 << j;
+    }
+    return masque;
+}
+
+#ifdef __SSE2__
+static uint32_t masque_boite_sse2(const char *sequence, const char *boite, int longueur) {
+    // Une comparaison d'octets par base de la boîte : chaque voie compte les correspondances de sa position
+    __m128i bas = _mm_setzero_si128(), haut = _mm_setzero_si128();
+    for (int k = 0; k < longueur; k++) {
+        __m128i base = _mm_set1_epi8(boite[k]);
+        bas = _mm_sub_epi8(bas, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(sequence + k)), base));
+        haut = _mm_sub_epi8(haut, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(sequence + k + 16)), base));
+    }
+    __m128i seuil = _mm_set1_epi8((char)(longueur - 2));
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpgt_epi8(bas, seuil)) |
+           (uint32_t)_mm_movemask_epi8(_mm_cmpgt_epi8(haut, seuil)) << 16;
+}
+#endif
+
+#ifdef FILTRE_AVX2_DISPONIBLE
+__attribute__((target("avx2")))
+static uint32_t masque_boite_avx2(const char *sequence, const char *boite, int longueur) {
+    __m256i correspondances = _mm256_setzero_si256();
+    for (int k = 0; k < longueur; k++) {
+        __m256i bases = _mm256_loadu_si256((const __m256i*)(sequence + k));
+        correspondances = _mm256_sub_epi8(correspondances, _mm256_cmpeq_epi8(bases, _mm256_set1_epi8(boite[k])));
+    }
+    return (uint32_t)_mm256_movemask_epi8(_mm256_cmpgt_epi8(correspondances, _mm256_set1_epi8((char)(longueur - 2))));
+}
+#endif
+
+static bool filtre_disponible(FiltreConsensus filtre) {
+    switch (filtre) {
+        case FILTRE_CONSENSUS_AUTO:
+        case FILTRE_CONSENSUS_REFERENCE:
+        case FILTRE_CONSENSUS_SCALAIRE:
+            return true;
+        case FILTRE_CONSENSUS_SSE2:
+#ifdef __SSE2__
+            return true;
+#else
+            return false;
+#endif
+        case FILTRE_CONSENSUS_AVX2:
+#ifdef FILTRE_AVX2_DISPONIBLE
+            return __builtin_cpu_supports("avx2");
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+int choisir_filtre_consensus(FiltreConsensus filtre) {
+    if (!filtre_disponible(filtre)) return -1;
+    filtre_choisi = filtre;
+    return 0;
+}
+
+FiltreConsensus filtre_consensus_actif(void) {
+    if (filtre_choisi != FILTRE_CONSENSUS_AUTO) return filtre_choisi;
+    if (filtre_disponible(FILTRE_CONSENSUS_AVX2)) return FILTRE_CONSENSUS_AVX2;
+    if (filtre_disponible(FILTRE_CONSENSUS_SSE2)) return FILTRE_CONSENSUS_SSE2;
+    // Sans instructions vectorielles, remplir les masques coûte plus que le parcours direct
+    return FILTRE_CONSENSUS_REFERENCE;
+}
+
+static FonctionMasqueBoite fonction_masque(FiltreConsensus filtre) {
+#ifdef FILTRE_AVX2_DISPONIBLE
+    if (filtre == FILTRE_CONSENSUS_AVX2) return masque_boite_avx2;
+#endif
+#ifdef __SSE2__
+    if (filtre == FILTRE_CONSENSUS_SSE2) return masque_boite_sse2;
+#endif
+    return masque_boite_scalaire;
+}
+
+// Parcours position par position : la définition des paires, que le filtre doit reproduire
+static int64_t parcourir_paires_reference(const char *sequence, int64_t debut, int64_t fin, int64_t limite,
+                                          const char *boite_35, int longueur_35, const char *boite_10,
+                                          int longueur_10, FonctionPaireConsensus fonction, void *contexte) {
+    int64_t compteur = 0;
+    for (int64_t i = debut; i < fin && i <= limite - longueur_35; i++) {
+        if (!comparer_avec_marge_erreur(sequence + i, boite_35, longueur_35)) continue;
+        for (int distance = ESPACEMENT_MIN_CONSENSUS; distance <= ESPACEMENT_MAX_CONSENSUS; distance++) {
+            int64_t position_boite_10 = i + longueur_35 + distance;
+            if (position_boite_10 + longueur_10 > limite) continue;
+            if (!comparer_avec_marge_erreur(sequence + position_boite_10, boite_10, longueur_10)) continue;
+            if (fonction != NULL) fonction(i, position_boite_10, contexte);
+            compteur++;
+        }
+    }
+    return compteur;
+}
+
+// Bit j de `bits` : la boîte commence en `debut + j` avec au plus un mésappariement et finit avant `limite`
+static void remplir_bits_boite(const char *sequence, int64_t debut, int64_t fin, int64_t limite, const char *boite,
+                               int longueur, FonctionMasqueBoite masque, uint64_t *bits) {
+    if (fin > limite - longueur + 1) fin = limite - longueur + 1;
+    int64_t p = debut;
+    // Par 32 positions tant que les lectures restent dans la séquence ; `p - debut` reste multiple de 32
+    for (; p + 32 <= fin && p + 32 + longueur - 1 <= limite; p += 32) {
+        int64_t j = p - debut;
+        bits[j >> 6] |= (uint64_t)masque(sequence + p, boite, longueur) << (j & 63);
+    }
+    for (; p < fin; p++) {
+        if (comparer_avec_marge_erreur(sequence + p, boite, longueur)) {
+            bits[(p - debut) >> 6] |= (uint64_t)1 << ((p - debut) & 63);
+        }
+    }
+}
+
+// 64 bits de `bits` à partir du bit `indice`
+static inline uint64_t extraire_bits(const uint64_t *bits, int64_t indice) {
+    int decalage = indice & 63;
+    uint64_t mot = bits[indice >> 6] >> decalage;
+    return decalage == 0 ? mot : mot | bits[(indice >> 6) + 1] << (64 - decalage);
+}
+
+int64_t parcourir_paires_consensus(const char *sequence, int64_t debut, int64_t fin, int64_t limite,
+                                   const char *boite_35, const char *boite_10, FonctionPaireConsensus fonction,
+                                   void *contexte) {
+    int longueur_35 = strlen(boite_35);
+    int longueur_10 = strlen(boite_10);
+    if (fin > limite - longueur_35 + 1) fin = limite - longueur_35 + 1;
+    if (fin <= debut) return 0;
+
+    FiltreConsensus filtre = filtre_consensus_actif();
+    int64_t mots_35 = (fin - debut + 63) / 64;
+    // Les boîtes -10 d'un mot de -35 s'étendent jusqu'à longueur_35 + ESPACEMENT_MAX_CONSENSUS bits plus loin,
+    // et extraire_bits lit un mot de plus
+    int64_t mots_10 = mots_35 + (longueur_35 + ESPACEMENT_MAX_CONSENSUS) / 64 + 2;
+    uint64_t *bits_35 = filtre != FILTRE_CONSENSUS_REFERENCE ? calloc(mots_35, sizeof(uint64_t)) : NULL;
+    uint64_t *bits_10 = bits_35 != NULL ? calloc(mots_10, sizeof(uint64_t)) : NULL;
+    if (bits_10 == NULL || longueur_35 > LONGUEUR_MAX_BOITE_FILTRE || longueur_10 > LONGUEUR_MAX_BOITE_FILTRE) {
+        free(bits_35);
+        free(bits_10);
+        return parcourir_paires_reference(sequence, debut, fin, limite, boite_35, longueur_35, boite_10, longueur_10,
+                                          fonction, contexte);
+    }
+
+    FonctionMasqueBoite masque = fonction_masque(filtre);
+    remplir_bits_boite(sequence, debut, fin, limite, boite_35, longueur_35, masque, bits_35);
+    remplir_bits_boite(sequence, debut, debut + 64 * (mots_10 - 1), limite, boite_10, longueur_10, masque, bits_10);
+
+    int64_t compteur = 0;
+    for (int64_t m = 0; m < mots_35; m++) {
+        if (bits_35[m] == 0) continue;
+        // Boîte -10 à l'un des cinq espacements : cinq masques décalés, combinés mot à mot
+        uint64_t boites_10 = 0;
+        for (int distance = ESPACEMENT_MIN_CONSENSUS; distance <= ESPACEMENT_MAX_CONSENSUS; distance++) {
+            boites_10 |= extraire_bits(bits_10, 64 * m + longueur_35 + distance);
+        }
+        // Seules les positions retenues par les deux masques sont examinées une à une
+        uint64_t survivants = bits_35[m] & boites_10;
+        while (survivants != 0) {
+            int64_t j = 64 * m + __builtin_ctzll(survivants);
+            survivants &= survivants - 1;
+            for (int distance = ESPACEMENT_MIN_CONSENSUS; distance <= ESPACEMENT_MAX_CONSENSUS; distance++) {
+                int64_t indice_10 = j + longueur_35 + distance;
+                if ((bits_10[indice_10 >> 6] >> (indice_10 & 63) & 1) == 0) continue;
+                if (fonction != NULL) fonction(debut + j, debut + indice_10, contexte);
+                compteur++;
+            }
+        }
+    }
+    free(bits_35);
+    free(bits_10);
+    return compteur;
+}
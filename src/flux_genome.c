@@ -0,0 +1,313 @@
+// flux_genome.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "projet.h"
+
+#define TAILLE_TAMPON_BRUT (1 << 20)  // Taille des lectures dans le fichier FASTA
+
+struct LecteurFlux {
+    SourceSequence *source;      ///< Fichier texte, gzip ou BGZF
+    char *brut;                  ///< Dernier bloc lu (décompressé) dans le fichier
+    size_t taille_brut;
+    size_t position_brut;
+    int debut_ligne;             ///< Le prochain octet brut est en début de ligne
+    int dans_entete;             ///< On est dans une ligne d'en-tête FASTA
+    int fin_fichier;
+    int bases_enregistrement;    ///< Des bases de l'enregistrement courant ont déjà été lues
+    int nouvel_enregistrement;   ///< Un en-tête '>' a été franchi depuis les dernières bases lues
+};
+
+// Remplit le tampon brut si nécessaire ; retourne 0 à la fin du fichier
+static int remplir_brut(LecteurFlux *lecteur) {
+    if (lecteur->position_brut < lecteur->taille_brut) return 1;
+    if (lecteur->fin_fichier) return 0;
+    lecteur->taille_brut = lire_source(lecteur->source, lecteur->brut, TAILLE_TAMPON_BRUT);
+    lecteur->position_brut = 0;
+    if (lecteur->taille_brut == 0) {
+        lecteur->fin_fichier = 1;
+        return 0;
+    }
+    return 1;
+}
+
+static int est_nucleotide(char c) {
+    return c == 'A' || c == 'C' || c == 'G' || c == 'T';
+}
+
+// Avance jusqu'au prochain nucléotide (sans le consommer) ; retourne 0 s'il n'y en a plus
+static int avancer_jusqua_base(LecteurFlux *lecteur) {
+    while (remplir_brut(lecteur)) {
+        char c = lecteur->brut[lecteur->position_brut];
+        if (lecteur->debut_ligne && c == '>') {
+            lecteur->dans_entete = 1;
+            if (lecteur->bases_enregistrement) lecteur->nouvel_enregistrement = 1;
+            lecteur->bases_enregistrement = 0;
+        }
+        if (c == '\n') {
+            lecteur->debut_ligne = 1;
+            lecteur->dans_entete = 0;
+            lecteur->position_brut++;
+            continue;
+        }
+        lecteur->debut_ligne = 0;
+        if (!lecteur->dans_entete && est_nucleotide(toupper(c))) return 1;
+        lecteur->position_brut++;
+    }
+    return 0;
+}
+
+// Avec `par_enregistrement`, la lecture s'arrête au premier en-tête franchi après des bases déjà lues
+static int64_t lire_bases(LecteurFlux *lecteur, char *destination, int64_t maximum, int par_enregistrement) {
+    int64_t copiees = 0;
+    while (copiees < maximum && avancer_jusqua_base(lecteur)) {
+        if (par_enregistrement && lecteur->nouvel_enregistrement) break;
+        lecteur->bases_enregistrement = 1;
+        // Copie d'une traite de la fin de la ligne courante
+        while (copiees < maximum && lecteur->position_brut < lecteur->taille_brut) {
+            char c = toupper(lecteur->brut[lecteur->position_brut]);
+            if (c == '\n') break;
+            if (est_nucleotide(c)) destination[copiees++] = c;
+            lecteur->position_brut++;
+        }
+    }
+    return copiees;
+}
+
+int64_t lire_bases_flux(LecteurFlux *lecteur, char *destination, int64_t maximum) {
+    return lire_bases(lecteur, destination, maximum, 0);
+}
+
+LecteurFlux* ouvrir_lecteur_flux(const char *chemin_fichier) {
+    LecteurFlux *lecteur = calloc(1, sizeof(LecteurFlux));
+    if (lecteur == NULL) return NULL;
+    lecteur->source = ouvrir_source(chemin_fichier);
+    lecteur->brut = lecteur->source != NULL ? malloc(TAILLE_TAMPON_BRUT) : NULL;
+    if (lecteur->source == NULL || lecteur->brut == NULL) {
+        fermer_lecteur_flux(lecteur);
+        return NULL;
+    }
+    lecteur->debut_ligne = 1;
+    return lecteur;
+}
+
+int erreur_lecteur_flux(LecteurFlux *lecteur) {
+    return erreur_source(lecteur->source);
+}
+
+void fermer_lecteur_flux(LecteurFlux *lecteur) {
+    if (lecteur == NULL) return;
+    fermer_source(lecteur->source);
+    free(lecteur->brut);
+    free(lecteur);
+}
+
+int initialiser_fenetre_flux(FenetreFlux *fenetre, const char *chemin_fichier, int64_t taille_fenetre,
+                             int64_t chevauchement) {
+    memset(fenetre, 0, sizeof(*fenetre));
+    if (taille_fenetre > INT32_MAX) {
+        printf("Erreur : la fenêtre ne peut pas dépasser %d bases\n", INT32_MAX);
+        return -1;
+    }
+    if (taille_fenetre <= chevauchement) {
+        printf("Erreur : la fenêtre (%lld bases) doit dépasser le plus long objet recherché (%lld bases)\n",
+               (long long)taille_fenetre, (long long)chevauchement);
+        return -1;
+    }
+    fenetre->lecteur = ouvrir_lecteur_flux(chemin_fichier);
+    if (fenetre->lecteur == NULL) {
+        perror("Erreur lors de l'ouverture du fichier");
+        return -1;
+    }
+    fenetre->sequence = malloc(taille_fenetre + 1);
+    if (fenetre->sequence == NULL) {
+        liberer_fenetre_flux(fenetre);
+        return -1;
+    }
+    fenetre->taille_fenetre = taille_fenetre;
+    fenetre->chevauchement = chevauchement;
+    return 0;
+}
+
+int fenetre_suivante(FenetreFlux *fenetre) {
+    if (fenetre->derniere) return 0;
+
+    // Les `chevauchement` dernières bases de la fenêtre précédente sont reprises en tête, sauf si elle terminait
+    // un enregistrement : aucun objet ne chevauche deux enregistrements d'un FASTA multiple
+    int64_t reprises = 0;
+    if (fenetre->numero > 0) {
+        if (!fenetre->lecteur->nouvel_enregistrement) reprises = fenetre->chevauchement;
+        memmove(fenetre->sequence, fenetre->sequence + fenetre->longueur - reprises, reprises);
+        fenetre->debut += fenetre->longueur - reprises;
+        fenetre->lecteur->nouvel_enregistrement = 0;
+    }
+
+    int64_t lues = lire_bases(fenetre->lecteur, fenetre->sequence + reprises, fenetre->taille_fenetre - reprises, 1);
+    if (erreur_lecteur_flux(fenetre->lecteur)) return -1;
+    if (lues == 0 && fenetre->numero > 0) return 0;
+
+    fenetre->longueur = reprises + lues;
+    fenetre->sequence[fenetre->longueur] = '\0';
+    fenetre->derniere = !avancer_jusqua_base(fenetre->lecteur);
+    // Fin de fichier due à une erreur de décompression : la fenêtre n'est pas la dernière du génome
+    if (fenetre->derniere && erreur_lecteur_flux(fenetre->lecteur)) return -1;
+    int fin_enregistrement = fenetre->derniere || fenetre->lecteur->nouvel_enregistrement;
+    fenetre->fin_propre = fin_enregistrement ? fenetre->debut + fenetre->longueur
+                                             : fenetre->debut + fenetre->longueur - fenetre->chevauchement;
+    fenetre->numero++;
+    return 1;
+}
+
+void liberer_fenetre_flux(FenetreFlux *fenetre) {
+    fermer_lecteur_flux(fenetre->lecteur);
+    free(fenetre->sequence);
+    memset(fenetre, 0, sizeof(*fenetre));
+}
+
+static int ajouter_position_gene(ResultatsFlux *resultats, int64_t position) {
+    if (resultats->nombre_genes == resultats->capacite_genes) {
+        int capacite = resultats->capacite_genes == 0 ? 8 : resultats->capacite_genes * 2;
+        int64_t *p = realloc(resultats->positions_genes, capacite * sizeof(int64_t));
+        if (p == NULL) return -1;
+        resultats->positions_genes = p;
+        resultats->capacite_genes = capacite;
+    }
+    resultats->positions_genes[resultats->nombre_genes++] = position;
+    return 0;
+}
+
+// Recherche du gène dans une fenêtre : seuls les alignements qui commencent dans la partie propre comptent
+static int analyser_gene_fenetre(const FenetreFlux *fenetre, const char *sequence_gene, double identite_min,
+                                 ResultatsFlux *resultats) {
+    IndexKmers *index = construire_index_kmers(fenetre->sequence, (int)fenetre->longueur, LONGUEUR_GRAINE_GENE);
+    if (index == NULL) return -1;
+
+    AlignementGene alignements[NOMBRE_MAX_GENES_FENETRE];
+    int nombre = rechercher_gene_graines(index, fenetre->sequence, sequence_gene, identite_min,
+                                         alignements, NOMBRE_MAX_GENES_FENETRE);
+    liberer_index_kmers(index);
+    if (nombre < 0) return -1;
+
+    int statut = 0;
+    for (int a = 0; a < nombre && a < NOMBRE_MAX_GENES_FENETRE; a++) {
+        int64_t position = fenetre->debut + alignements[a].debut;
+        if (position < fenetre->fin_propre && statut == 0) {
+            statut = ajouter_position_gene(resultats, position);
+        }
+        liberer_alignement_gene(&alignements[a]);
+    }
+    return statut;
+}
+
+// Paires de boîtes -35/-10 dont la boîte -35 commence dans la partie propre de la fenêtre
+static int64_t compter_consensus_fenetre(const FenetreFlux *fenetre, const char *boite_35, const char *boite_10) {
+    return parcourir_paires_consensus(fenetre->sequence, 0, fenetre->fin_propre - fenetre->debut, fenetre->longueur,
+                                      boite_35, boite_10, NULL, NULL);
+}
+
+// k-mers commençant dans la partie propre de la fenêtre (code 2 bits glissant)
+static void compter_kmers_fenetre(const FenetreFlux *fenetre, int k, uint64_t *comptes) {
+    uint32_t masque = (uint32_t)(((uint64_t)1 << (2 * k)) - 1);
+    int64_t fin_propre = fenetre->fin_propre - fenetre->debut;
+    uint32_t code = 0;
+    int valides = 0;
+    for (int64_t i = 0; i < fenetre->longueur; i++) {
+        int c;
+        switch (fenetre->sequence[i]) {
+            case 'A': c = 0; break;
+            case 'C': c = 1; break;
+            case 'G': c = 2; break;
+            default: c = 3; break;
+        }
+        code = ((code << 2) | (uint32_t)c) & masque;
+        if (++valides >= k) {
+            int64_t debut_kmer = i - k + 1;
+            if (debut_kmer >= fin_propre) break;
+            comptes[code]++;
+        }
+    }
+}
+
+int analyser_genome_flux(const char *chemin_genome, const char *sequence_gene, int longueur_kmer,
+                         int64_t taille_fenetre, ResultatsFlux *resultats) {
+    memset(resultats, 0, sizeof(*resultats));
+    if (longueur_kmer < 1 || longueur_kmer > LONGUEUR_MAX_KMER_FLUX) {
+        printf("Erreur : longueur de k-mer %d non supportée en mode flux (1 à %d)\n", longueur_kmer, LONGUEUR_MAX_KMER_FLUX);
+        return -1;
+    }
+    resultats->longueur_kmer = longueur_kmer;
+    resultats->comptes_kmers = calloc((size_t)1 << (2 * longueur_kmer), sizeof(uint64_t));
+    if (resultats->comptes_kmers == NULL) return -1;
+
+    // Le chevauchement doit contenir entièrement le plus long objet recherché
+    int64_t longueur_gene = sequence_gene != NULL ? (int64_t)strlen(sequence_gene) : 0;
+    int64_t longueur_consensus = strlen(BOITE_35) + ESPACEMENT_MAX_CONSENSUS + strlen(BOITE_10);
+    int64_t chevauchement = 2 * longueur_gene;
+    if (longueur_consensus > chevauchement) chevauchement = longueur_consensus;
+    if (longueur_kmer > chevauchement) chevauchement = longueur_kmer;
+
+    FenetreFlux fenetre;
+    if (initialiser_fenetre_flux(&fenetre, chemin_genome, taille_fenetre, chevauchement) != 0) {
+        liberer_resultats_flux(resultats);
+        return -1;
+    }
+
+    int statut = 0;
+    int lecture = 0;
+    while (statut == 0 && (lecture = fenetre_suivante(&fenetre)) == 1) {
+        resultats->longueur_genome = fenetre.debut + fenetre.longueur;
+        resultats->nombre_fenetres++;
+
+        if (longueur_gene > 0) {
+            statut = analyser_gene_fenetre(&fenetre, sequence_gene, IDENTITE_MIN, resultats);
+        }
+        resultats->nombre_consensus += compter_consensus_fenetre(&fenetre, BOITE_35, BOITE_10);
+        compter_kmers_fenetre(&fenetre, longueur_kmer, resultats->comptes_kmers);
+    }
+
+    liberer_fenetre_flux(&fenetre);
+    if (statut == 0 && lecture < 0) {
+        printf("Erreur : lecture de %s interrompue, analyse en flux abandonnée\n", chemin_genome);
+        liberer_resultats_flux(resultats);
+        return -1;
+    }
+    if (statut != 0) {
+        printf("Erreur d'allocation mémoire lors de l'analyse en flux\n");
+        liberer_resultats_flux(resultats);
+        return -1;
+    }
+    return 0;
+}
+
+void liberer_resultats_flux(ResultatsFlux *resultats) {
+    free(resultats->positions_genes);
+    free(resultats->comptes_kmers);
+    memset(resultats, 0, sizeof(*resultats));
+}
+
+void decoder_kmer(uint64_t code, int k, char *kmer) {
+    static const char bases[4] = {'A', 'C', 'G', 'T'};
+    for (int i = k - 1; i >= 0; i--) {
+        kmer[i] = bases[code & 3];
+        code >>= 2;
+    }
+    kmer[k] = '\0';
+}
+
+int ecrire_comptes_kmers_flux(const ResultatsFlux *resultats, const char *chemin_fichier) {
+    FILE *fichier = fopen(chemin_fichier, "w");
+    if (fichier == NULL) {
+        perror("Erreur lors de l'ouverture du fichier des k-mers");
+        return -1;
+    }
+    char kmer[LONGUEUR_MAX_KMER_FLUX + 1];
+    uint64_t nombre_codes = (uint64_t)1 << (2 * resultats->longueur_kmer);
+    for (uint64_t code = 0; code < nombre_codes; code++) {
+        if (resultats->comptes_kmers[code] == 0) continue;
+        decoder_kmer(code, resultats->longueur_kmer, kmer);
+        fprintf(fichier, "%s\t%llu\n", kmer, (unsigned long long)resultats->comptes_kmers[code]);
+    }
+    fclose(fichier);
+    return 0;
+}
@@ -0,0 +1,627 @@
+// index_suffixes.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "projet.h"
+
+#define LONGUEUR_RANG_INITIAL 12  // Les suffixes sont d'abord triés sur leurs 12 premières bases
+#define LONGUEUR_MIN_SEGMENT 5     // Longueur minimale des segments exacts du principe des tiroirs
+#define DEMI_CODE_INITIAL 15625    // 5^6 : le code initial (base 5) est trié en deux passes de 6 bases
+
+static int rang_base(char nucleotide) {
+    switch (nucleotide) {
+        case 'A': return 1;
+        case 'C': return 2;
+        case 'G': return 3;
+        case 'T': return 4;
+        default: return 0;  // Fin de séquence ou caractère inattendu
+    }
+}
+
+// Tri par comptage stable de `source` vers `destination` selon une moitié du code initial
+static void trier_demi_code(const int32_t *source, int32_t *destination, int n, const int32_t *code,
+                            int poids_fort, int32_t *comptes) {
+    memset(comptes, 0, (DEMI_CODE_INITIAL + 1) * sizeof(int32_t));
+    for (int i = 0; i < n; i++) {
+        int c = poids_fort ? code[source[i]] / DEMI_CODE_INITIAL : code[source[i]] % DEMI_CODE_INITIAL;
+        comptes[c + 1]++;
+    }
+    for (int c = 0; c < DEMI_CODE_INITIAL; c++) comptes[c + 1] += comptes[c];
+    for (int i = 0; i < n; i++) {
+        int c = poids_fort ? code[source[i]] / DEMI_CODE_INITIAL : code[source[i]] % DEMI_CODE_INITIAL;
+        destination[comptes[c]++] = source[i];
+    }
+}
+
+typedef struct {
+    int32_t cle;
+    int32_t suffixe;
+} PaireSuffixe;
+
+static int comparer_paires(const void *a, const void *b) {
+    const PaireSuffixe *x = a, *y = b;
+    return (x->cle > y->cle) - (x->cle < y->cle);
+}
+
+IndexSuffixes* construire_index_suffixes(const char *sequence_genome, int longueur_genome) {
+    if (longueur_genome < 1) return NULL;
+    IndexSuffixes *index = calloc(1, sizeof(IndexSuffixes));
+    if (index == NULL) return NULL;
+    index->genome = sequence_genome;
+    index->longueur_genome = longueur_genome;
+    int n = longueur_genome;
+    index->suffixes = malloc(n * sizeof(int32_t));
+    int32_t *rang = malloc(n * sizeof(int32_t));
+    int32_t *nouveau_rang = malloc(n * sizeof(int32_t));
+    int32_t *tampon = malloc(n * sizeof(int32_t));
+    int32_t *comptes = malloc((DEMI_CODE_INITIAL + 1) * sizeof(int32_t));
+    PaireSuffixe *paires = malloc(n * sizeof(PaireSuffixe));
+    if (index->suffixes == NULL || rang == NULL || nouveau_rang == NULL || tampon == NULL || comptes == NULL ||
+        paires == NULL) {
+        free(rang);
+        free(nouveau_rang);
+        free(tampon);
+        free(comptes);
+        free(paires);
+        liberer_index_suffixes(index);
+        return NULL;
+    }
+    int32_t *suffixes = index->suffixes;
+
+    // Code initial : les LONGUEUR_RANG_INITIAL premières bases en base 5 (0 au-delà de la fin),
+    // trié par deux tris par comptage (poids faibles puis poids forts)
+    int puissance = DEMI_CODE_INITIAL * DEMI_CODE_INITIAL / 5;
+    int code = 0;
+    for (int j = 0; j < LONGUEUR_RANG_INITIAL; j++) code = code * 5 + (j < n ? rang_base(sequence_genome[j]) : 0);
+    for (int i = 0; i < n; i++) {
+        nouveau_rang[i] = code;
+        int suivante = i + LONGUEUR_RANG_INITIAL < n ? rang_base(sequence_genome[i + LONGUEUR_RANG_INITIAL]) : 0;
+        code = (code - rang_base(sequence_genome[i]) * puissance) * 5 + suivante;
+        suffixes[i] = i;
+    }
+    trier_demi_code(suffixes, tampon, n, nouveau_rang, 0, comptes);
+    trier_demi_code(tampon, suffixes, n, nouveau_rang, 1, comptes);
+
+    // Rang d'un suffixe : indice, dans la table, du premier suffixe de son groupe (même préfixe de h bases)
+    int groupes_non_resolus = 0;
+    for (int j = 0; j < n; j++) {
+        if (j > 0 && nouveau_rang[suffixes[j]] == nouveau_rang[suffixes[j - 1]]) {
+            rang[suffixes[j]] = rang[suffixes[j - 1]];
+            groupes_non_resolus = 1;
+        } else {
+            rang[suffixes[j]] = j;
+        }
+    }
+
+    // Doublement des préfixes : seuls les groupes de plusieurs suffixes sont triés, selon le rang de s + h
+    // (les suffixes qui se terminent avant s + h viennent en premier)
+    for (int h = LONGUEUR_RANG_INITIAL; groupes_non_resolus; h *= 2) {
+        groupes_non_resolus = 0;
+        memcpy(nouveau_rang, rang, n * sizeof(int32_t));
+        for (int debut = 0; debut < n;) {
+            int fin = debut + 1;
+            while (fin < n && rang[suffixes[fin]] == debut) fin++;
+            if (fin - debut > 1) {
+                for (int j = debut; j < fin; j++) {
+                    int s = suffixes[j];
+                    paires[j].cle = s + h < n ? rang[s + h] : -1;
+                    paires[j].suffixe = s;
+                }
+                qsort(paires + debut, fin - debut, sizeof(PaireSuffixe), comparer_paires);
+                for (int j = debut; j < fin; j++) {
+                    suffixes[j] = paires[j].suffixe;
+                    if (j > debut && paires[j].cle == paires[j - 1].cle) {
+                        nouveau_rang[suffixes[j]] = nouveau_rang[suffixes[j - 1]];
+                        groupes_non_resolus = 1;
+                    } else {
+                        nouveau_rang[suffixes[j]] = j;
+                    }
+                }
+            }
+            debut = fin;
+        }
+        int32_t *echange = rang;
+        rang = nouveau_rang;
+        nouveau_rang = echange;
+    }
+
+    free(rang);
+    free(nouveau_rang);
+    free(tampon);
+    free(comptes);
+    free(paires);
+    return index;
+}
+
+void liberer_index_suffixes(IndexSuffixes *index) {
+    if (index == NULL) return;
+    free(index->suffixes);
+    free(index);
+}
+
+int32_t* calculer_lcp(const IndexSuffixes *index) {
+    int n = index->longueur_genome;
+    int32_t *lcp = malloc(n * sizeof(int32_t));
+    int32_t *rang = malloc(n * sizeof(int32_t));
+    if (lcp == NULL || rang == NULL) {
+        printf("Erreur d'allocation mémoire pour la table LCP\n");
+        free(lcp);
+        free(rang);
+        return NULL;
+    }
+    for (int r = 0; r < n; r++) rang[index->suffixes[r]] = r;
+
+    // Kasai : en passant du suffixe p au suffixe p + 1, le préfixe commun perd au plus une base
+    const char *genome = index->genome;
+    int h = 0;
+    lcp[0] = 0;
+    for (int p = 0; p < n; p++) {
+        int r = rang[p];
+        if (r == 0) {
+            h = 0;
+            continue;
+        }
+        int q = index->suffixes[r - 1];
+        while (p + h < n && q + h < n && genome[p + h] == genome[q + h]) h++;
+        lcp[r] = h;
+        if (h > 0) h--;
+    }
+    free(rang);
+    return lcp;
+}
+
+// Compare le motif au préfixe du suffixe commençant en `position`
+static int comparer_prefixe(const IndexSuffixes *index, int position, const char *motif, int longueur_motif) {
+    int disponibles = index->longueur_genome - position;
+    int n = disponibles < longueur_motif ? disponibles : longueur_motif;
+    int comparaison = memcmp(index->genome + position, motif, n);
+    if (comparaison != 0) return comparaison;
+    return n < longueur_motif ? -1 : 0;  // Suffixe plus court que le motif : il le précède
+}
+
+int intervalle_suffixes(const IndexSuffixes *index, const char *motif, int longueur_motif, int *debut, int *fin) {
+    int bas = 0, haut = index->longueur_genome;
+    while (bas < haut) {
+        int milieu = bas + (haut - bas) / 2;
+        if (comparer_prefixe(index, index->suffixes[milieu], motif, longueur_motif) < 0) bas = milieu + 1;
+        else haut = milieu;
+    }
+    *debut = bas;
+    haut = index->longueur_genome;
+    while (bas < haut) {
+        int milieu = bas + (haut - bas) / 2;
+        if (comparer_prefixe(index, index->suffixes[milieu], motif, longueur_motif) <= 0) bas = milieu + 1;
+        else haut = milieu;
+    }
+    *fin = bas;
+    return *fin - *debut;
+}
+
+// Une occurrence est ignorée si elle commence dans la fenêtre exclue ou à une position masquée
+static bool occurrence_exclue(int position, int start_exclusion, int longueur_exclusion, const MasqueExclusion *masque) {
+    if (longueur_exclusion > 0 && position >= start_exclusion && position < start_exclusion + longueur_exclusion) {
+        return true;
+    }
+    return masque != NULL && position_masquee(masque, position);
+}
+
+int compter_occurrences_index(const IndexSuffixes *index, const char *motif, int longueur_motif,
+                              int start_exclusion, int longueur_exclusion, const MasqueExclusion *masque) {
+    int debut, fin;
+    int occurrences = intervalle_suffixes(index, motif, longueur_motif, &debut, &fin);
+    if (longueur_exclusion <= 0 && (masque == NULL || masque->nombre_intervalles == 0)) return occurrences;
+    for (int j = debut; j < fin; j++) {
+        if (occurrence_exclue(index->suffixes[j], start_exclusion, longueur_exclusion, masque)) occurrences--;
+    }
+    return occurrences;
+}
+
+static int comparer_entiers(const void *a, const void *b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+int* positions_occurrences(const IndexSuffixes *index, const char *motif, int longueur_motif,
+                           const MasqueExclusion *masque, int *nombre) {
+    int debut, fin;
+    intervalle_suffixes(index, motif, longueur_motif, &debut, &fin);
+    int *positions = malloc((fin - debut > 0 ? fin - debut : 1) * sizeof(int));
+    *nombre = 0;
+    if (positions == NULL) return NULL;
+    for (int j = debut; j < fin; j++) {
+        if (!occurrence_exclue(index->suffixes[j], 0, 0, masque)) positions[(*nombre)++] = index->suffixes[j];
+    }
+    qsort(positions, *nombre, sizeof(int), comparer_entiers);
+    return positions;
+}
+
+// ==================== Occurrences avec mésappariements ====================
+
+typedef struct {
+    const IndexSuffixes *index;
+    const char *motif;
+    int longueur_motif;
+    int mismatches_max;
+    int start_exclusion;
+    int longueur_exclusion;
+    const MasqueExclusion *masque;
+    int occurrences;
+    int *positions;               // NULL : comptage seul
+    int capacite_positions;
+    int erreur;
+} RechercheApprochee;
+
+static char base_suffixe(const IndexSuffixes *index, int position, int decalage) {
+    return position + decalage < index->longueur_genome ? index->genome[position + decalage] : '\0';
+}
+
+// Restreint [debut, fin), dont les suffixes partagent leurs `profondeur` premières bases,
+// à ceux dont la base suivante vaut `base`
+static void restreindre_intervalle(const IndexSuffixes *index, int *debut, int *fin, int profondeur, char base) {
+    int bas = *debut, haut = *fin;
+    while (bas < haut) {
+        int milieu = bas + (haut - bas) / 2;
+        if (base_suffixe(index, index->suffixes[milieu], profondeur) < base) bas = milieu + 1;
+        else haut = milieu;
+    }
+    int nouveau_debut = bas;
+    haut = *fin;
+    while (bas < haut) {
+        int milieu = bas + (haut - bas) / 2;
+        if (base_suffixe(index, index->suffixes[milieu], profondeur) <= base) bas = milieu + 1;
+        else haut = milieu;
+    }
+    *debut = nouveau_debut;
+    *fin = bas;
+}
+
+// Compare la fin du motif (à partir de `profondeur`) au suffixe commençant en `position`
+static int comparer_fin_motif(const IndexSuffixes *index, int position, const char *motif, int longueur_motif,
+                              int profondeur) {
+    return comparer_prefixe(index, position + profondeur, motif + profondeur, longueur_motif - profondeur);
+}
+
+static void relever_position(RechercheApprochee *recherche, int p) {
+    if (occurrence_exclue(p, recherche->start_exclusion, recherche->longueur_exclusion, recherche->masque)) return;
+    if (recherche->positions != NULL) {
+        if (recherche->occurrences == recherche->capacite_positions) {
+            int capacite = recherche->capacite_positions * 2;
+            int *nouvelles = realloc(recherche->positions, capacite * sizeof(int));
+            if (nouvelles == NULL) {
+                recherche->erreur = 1;
+                return;
+            }
+            recherche->positions = nouvelles;
+            recherche->capacite_positions = capacite;
+        }
+        recherche->positions[recherche->occurrences] = p;
+    }
+    recherche->occurrences++;
+}
+
+static void relever_intervalle(RechercheApprochee *recherche, int debut, int fin) {
+    for (int j = debut; j < fin && !recherche->erreur; j++) relever_position(recherche, recherche->index->suffixes[j]);
+}
+
+// Descente dans la table des suffixes : à chaque profondeur, les quatre bases sont essayées tant que
+// le budget de mésappariements le permet ; une fois le budget épuisé, la fin du motif est cherchée à l'identique
+static void descendre_approche(RechercheApprochee *recherche, int debut, int fin, int profondeur, int erreurs) {
+    const IndexSuffixes *index = recherche->index;
+    if (debut >= fin || recherche->erreur) return;
+    if (profondeur == recherche->longueur_motif) {
+        relever_intervalle(recherche, debut, fin);
+        return;
+    }
+    if (erreurs == recherche->mismatches_max) {
+        int bas = debut, haut = fin;
+        while (bas < haut) {
+            int milieu = bas + (haut - bas) / 2;
+            if (comparer_fin_motif(index, index->suffixes[milieu], recherche->motif, recherche->longueur_motif,
+                                   profondeur) < 0) bas = milieu + 1;
+            else haut = milieu;
+        }
+        int premier = bas;
+        haut = fin;
+        while (bas < haut) {
+            int milieu = bas + (haut - bas) / 2;
+            if (comparer_fin_motif(index, index->suffixes[milieu], recherche->motif, recherche->longueur_motif,
+                                   profondeur) <= 0) bas = milieu + 1;
+            else haut = milieu;
+        }
+        relever_intervalle(recherche, premier, bas);
+        return;
+    }
+    for (int b = 0; b < 4; b++) {
+        char base = "ACGT"[b];
+        int sous_debut = debut, sous_fin = fin;
+        restreindre_intervalle(index, &sous_debut, &sous_fin, profondeur, base);
+        descendre_approche(recherche, sous_debut, sous_fin, profondeur + 1,
+                           erreurs + (base != recherche->motif[profondeur]));
+    }
+}
+
+// Principe des tiroirs : avec d mésappariements, l'un des d + 1 segments du motif apparaît à l'identique.
+// Chaque segment est cherché exactement, puis les candidats sont vérifiés ; un candidat n'est relevé que
+// pour le premier segment qu'il contient exactement (pas de doublon)
+static void chercher_par_segments(RechercheApprochee *recherche) {
+    const IndexSuffixes *index = recherche->index;
+    int m = recherche->longueur_motif;
+    int nombre_segments = recherche->mismatches_max + 1;
+    for (int s = 0; s < nombre_segments && !recherche->erreur; s++) {
+        int debut_segment = s * m / nombre_segments;
+        int fin_segment = (s + 1) * m / nombre_segments;
+        int debut, fin;
+        intervalle_suffixes(index, recherche->motif + debut_segment, fin_segment - debut_segment, &debut, &fin);
+        for (int j = debut; j < fin; j++) {
+            int candidat = index->suffixes[j] - debut_segment;
+            if (candidat < 0 || candidat + m > index->longueur_genome) continue;
+            const char *fenetre = index->genome + candidat;
+
+            // Un segment précédent exact : le candidat a déjà été relevé
+            int deja_vu = 0;
+            for (int t = 0; t < s && !deja_vu; t++) {
+                int a = t * m / nombre_segments, b = (t + 1) * m / nombre_segments;
+                deja_vu = memcmp(fenetre + a, recherche->motif + a, b - a) == 0;
+            }
+            if (deja_vu) continue;
+
+            int erreurs = 0;
+            for (int k = 0; k < m && erreurs <= recherche->mismatches_max; k++) {
+                if (fenetre[k] != recherche->motif[k]) erreurs++;
+            }
+            if (erreurs > recherche->mismatches_max) continue;
+
+            relever_position(recherche, candidat);
+        }
+    }
+}
+
+static void chercher_approche(RechercheApprochee *recherche) {
+    if (recherche->mismatches_max > 0 &&
+        recherche->longueur_motif / (recherche->mismatches_max + 1) >= LONGUEUR_MIN_SEGMENT) {
+        chercher_par_segments(recherche);
+    } else {
+        descendre_approche(recherche, 0, recherche->index->longueur_genome, 0, 0);
+    }
+}
+
+int compter_occurrences_approchees(const IndexSuffixes *index, const char *motif, int longueur_motif,
+                                   int mismatches_max, int start_exclusion, int longueur_exclusion,
+                                   const MasqueExclusion *masque) {
+    RechercheApprochee recherche = {index, motif, longueur_motif, mismatches_max, start_exclusion,
+                                    longueur_exclusion, masque, 0, NULL, 0, 0};
+    chercher_approche(&recherche);
+    return recherche.occurrences;
+}
+
+int* positions_occurrences_approchees(const IndexSuffixes *index, const char *motif, int longueur_motif,
+                                      int mismatches_max, const MasqueExclusion *masque, int *nombre) {
+    RechercheApprochee recherche = {index, motif, longueur_motif, mismatches_max, 0, 0, masque, 0, NULL, 64, 0};
+    recherche.positions = malloc(recherche.capacite_positions * sizeof(int));
+    if (recherche.positions != NULL) chercher_approche(&recherche);
+    if (recherche.positions == NULL || recherche.erreur) {
+        free(recherche.positions);
+        *nombre = 0;
+        return NULL;
+    }
+    // Chaque position n'est relevée qu'une fois (intervalles disjoints ou premier segment exact)
+    qsort(recherche.positions, recherche.occurrences, sizeof(int), comparer_entiers);
+    *nombre = recherche.occurrences;
+    return recherche.positions;
+}
+
+// ==================== Annotation des gènes ====================
+
+static int comparer_genes(const void *a, const void *b) {
+    const GeneAnnote *x = a, *y = b;
+    if (x->debut != y->debut) return (x->debut > y->debut) - (x->debut < y->debut);
+    return (x->fin > y->fin) - (x->fin < y->fin);
+}
+
+// Extrait la valeur d'un attribut GFF3 (`cle=valeur;...`)
+static char* attribut_gff(const char *attributs, const char *cle) {
+    size_t longueur_cle = strlen(cle);
+    for (const char *p = attributs; *p != '\0';) {
+        if (strncmp(p, cle, longueur_cle) == 0 && p[longueur_cle] == '=') {
+            const char *valeur = p + longueur_cle + 1;
+            return strndup(valeur, strcspn(valeur, ";\t\r\n"));
+        }
+        const char *suivant = strchr(p, ';');
+        if (suivant == NULL) break;
+        p = suivant + 1;
+    }
+    return NULL;
+}
+
+AnnotationGenes* charger_annotation_genes(const char *chemin_fichier) {
+    FILE *fichier = fopen(chemin_fichier, "r");
+    if (fichier == NULL) {
+        perror("Erreur lors de l'ouverture du fichier d'annotation");
+        return NULL;
+    }
+    AnnotationGenes *annotation = calloc(1, sizeof(AnnotationGenes));
+    if (annotation == NULL) {
+        fclose(fichier);
+        return NULL;
+    }
+
+    int capacite = 0;
+    char *ligne = NULL;
+    size_t taille_ligne = 0;
+    while (getline(&ligne, &taille_ligne, fichier) != -1) {
+        if (ligne[0] == '#' || ligne[0] == '\n' || ligne[0] == '\r') continue;
+
+        // Découpage en colonnes séparées par des tabulations
+        char *colonnes[9];
+        int nombre_colonnes = 0;
+        for (char *p = ligne; nombre_colonnes < 9;) {
+            colonnes[nombre_colonnes++] = p;
+            p = strchr(p, '\t');
+            if (p == NULL) break;
+            *p++ = '\0';
+        }
+
+        GeneAnnote gene = {0, 0, '+', NULL};
+        if (nombre_colonnes >= 9) {
+            // GFF3 : seqid, source, type, début, fin (1-indexés, inclus), score, brin, phase, attributs
+            if (strcmp(colonnes[2], "gene") != 0) continue;
+            gene.debut = atoi(colonnes[3]) - 1;
+            gene.fin = atoi(colonnes[4]);
+            gene.brin = colonnes[6][0];
+            gene.nom = attribut_gff(colonnes[8], "Name");
+            if (gene.nom == NULL) gene.nom = attribut_gff(colonnes[8], "ID");
+        } else if (nombre_colonnes >= 3) {
+            // TSV : nom, début, fin (1-indexés, inclus) et brin facultatif
+            if (!isdigit((unsigned char)colonnes[1][0])) continue;  // Ligne d'en-tête
+            gene.nom = strndup(colonnes[0], strcspn(colonnes[0], "\r\n"));
+            gene.debut = atoi(colonnes[1]) - 1;
+            gene.fin = atoi(colonnes[2]);
+            if (nombre_colonnes >= 4 && (colonnes[3][0] == '+' || colonnes[3][0] == '-')) gene.brin = colonnes[3][0];
+        } else {
+            continue;
+        }
+        if (gene.fin <= gene.debut) {
+            free(gene.nom);
+            continue;
+        }
+
+        if (annotation->nombre == capacite) {
+            capacite = capacite == 0 ? 256 : capacite * 2;
+            GeneAnnote *p = realloc(annotation->genes, capacite * sizeof(GeneAnnote));
+            if (p == NULL) {
+                printf("Erreur d'allocation mémoire\n");
+                free(gene.nom);
+                break;
+            }
+            annotation->genes = p;
+        }
+        annotation->genes[annotation->nombre++] = gene;
+    }
+    free(ligne);
+    fclose(fichier);
+
+    // Tri par début, puis plus grande fin parmi les gènes qui commencent avant (gènes chevauchants)
+    qsort(annotation->genes, annotation->nombre, sizeof(GeneAnnote), comparer_genes);
+    annotation->fin_max = malloc((annotation->nombre > 0 ? annotation->nombre : 1) * sizeof(int));
+    if (annotation->fin_max == NULL) {
+        liberer_annotation_genes(annotation);
+        return NULL;
+    }
+    for (int g = 0; g < annotation->nombre; g++) {
+        int fin = annotation->genes[g].fin;
+        annotation->fin_max[g] = g > 0 && annotation->fin_max[g - 1] > fin ? annotation->fin_max[g - 1] : fin;
+    }
+    return annotation;
+}
+
+void liberer_annotation_genes(AnnotationGenes *annotation) {
+    if (annotation == NULL) return;
+    for (int g = 0; g < annotation->nombre; g++) free(annotation->genes[g].nom);
+    free(annotation->genes);
+    free(annotation->fin_max);
+    free(annotation);
+}
+
+int distance_gene_annote(const AnnotationGenes *annotation, int debut, int fin) {
+    if (annotation->nombre == 0) return -1;
+
+    // Dernier gène commençant avant la fin de l'occurrence
+    int bas = 0, haut = annotation->nombre;
+    while (bas < haut) {
+        int milieu = bas + (haut - bas) / 2;
+        if (annotation->genes[milieu].debut < fin) bas = milieu + 1;
+        else haut = milieu;
+    }
+    int g = bas - 1;
+
+    int distance = -1;
+    if (g >= 0) {
+        if (annotation->fin_max[g] > debut) return 0;  // Chevauche un gène
+        distance = debut - annotation->fin_max[g];
+    }
+    if (g + 1 < annotation->nombre) {
+        int droite = annotation->genes[g + 1].debut - fin;
+        if (distance < 0 || droite < distance) distance = droite;
+    }
+    return distance;
+}
+
+// ==================== Distribution des occurrences ====================
+
+DistributionMotif* calculer_distribution_motif(const IndexSuffixes *index, const char *motif, int longueur_motif,
+                                               const MasqueExclusion *masque, const AnnotationGenes *annotation,
+                                               int taille_fenetre) {
+    DistributionMotif *distribution = calloc(1, sizeof(DistributionMotif));
+    if (distribution == NULL) return NULL;
+    distribution->positions = positions_occurrences(index, motif, longueur_motif, masque,
+                                                    &distribution->nombre_occurrences);
+    if (distribution->positions == NULL) {
+        free(distribution);
+        return NULL;
+    }
+    int n = distribution->nombre_occurrences;
+    distribution->ecart_min = distribution->ecart_median = distribution->ecart_max = -1;
+    distribution->distance_min_gene = -1;
+    distribution->distance_moyenne_gene = -1.0;
+
+    // Écarts entre copies consécutives
+    if (n >= 2) {
+        int *ecarts = malloc((n - 1) * sizeof(int));
+        if (ecarts != NULL) {
+            for (int i = 1; i < n; i++) ecarts[i - 1] = distribution->positions[i] - distribution->positions[i - 1];
+            qsort(ecarts, n - 1, sizeof(int), comparer_entiers);
+            distribution->ecart_min = ecarts[0];
+            distribution->ecart_median = ecarts[(n - 1) / 2];
+            distribution->ecart_max = ecarts[n - 2];
+            distribution->ecart_moyen = (double)(distribution->positions[n - 1] - distribution->positions[0]) / (n - 1);
+            free(ecarts);
+        }
+    }
+
+    // Densité : nombre de copies par fenêtre de `taille_fenetre` bases
+    if (taille_fenetre > 0) {
+        distribution->taille_fenetre = taille_fenetre;
+        distribution->nombre_fenetres = (index->longueur_genome + taille_fenetre - 1) / taille_fenetre;
+        distribution->densites = calloc(distribution->nombre_fenetres > 0 ? distribution->nombre_fenetres : 1, sizeof(int));
+        if (distribution->densites != NULL) {
+            for (int i = 0; i < n; i++) {
+                int f = distribution->positions[i] / taille_fenetre;
+                if (++distribution->densites[f] > distribution->densite_max) {
+                    distribution->densite_max = distribution->densites[f];
+                    distribution->fenetre_densite_max = f;
+                }
+            }
+        }
+    }
+
+    // Distance au gène annoté le plus proche (0 si l'occurrence chevauche un gène)
+    if (annotation != NULL && annotation->nombre > 0 && n > 0) {
+        distribution->distances_genes = malloc(n * sizeof(int));
+        if (distribution->distances_genes != NULL) {
+            double somme = 0.0;
+            int intergeniques = 0;
+            for (int i = 0; i < n; i++) {
+                int p = distribution->positions[i];
+                int d = distance_gene_annote(annotation, p, p + longueur_motif);
+                distribution->distances_genes[i] = d;
+                somme += d;
+                if (d > 0) intergeniques++;
+                if (distribution->distance_min_gene < 0 || d < distribution->distance_min_gene) {
+                    distribution->distance_min_gene = d;
+                }
+            }
+            distribution->distance_moyenne_gene = somme / n;
+            distribution->fraction_intergenique = (double)intergeniques / n;
+        }
+    }
+    return distribution;
+}
+
+void liberer_distribution_motif(DistributionMotif *distribution) {
+    if (distribution == NULL) return;
+    free(distribution->positions);
+    free(distribution->densites);
+    free(distribution->distances_genes);
+    free(distribution);
+}
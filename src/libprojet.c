@@ -0,0 +1,250 @@
+// libprojet.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "projet.h"
+#include "libprojet.h"
+
+struct GenomeProjet {
+    char *sequence;
+    int longueur;
+    IndexSuffixes *index;          // COUNT, positions et extension
+    IndexKmers *index_kmers;       // Graines de la recherche de gène
+};
+
+// Les requêtes qui se servent du pool tiennent ce verrou en lecture : le pool n'est remplacé, et l'ancien
+// détruit, que lorsqu'aucune n'est en cours
+static pthread_rwlock_t verrou_pool = PTHREAD_RWLOCK_INITIALIZER;
+static PoolThreads *pool_bibliotheque = NULL;  // Pool créé par projet_definir_threads
+
+int projet_definir_threads(int nombre_threads) {
+    if (nombre_threads < 1 || pthread_rwlock_trywrlock(&verrou_pool) != 0) return -1;
+    PoolThreads *pool = nombre_threads > 1 ? creer_pool_threads(nombre_threads) : NULL;
+    int erreur = nombre_threads > 1 && pool == NULL;
+    if (!erreur) {
+        definir_pool_global(pool);
+        detruire_pool_threads(pool_bibliotheque);
+        pool_bibliotheque = pool;
+    }
+    pthread_rwlock_unlock(&verrou_pool);
+    return erreur ? -1 : 0;
+}
+
+// Prend possession de la séquence ; elle est libérée en cas d'erreur
+static GenomeProjet* indexer_genome(char *sequence, int longueur) {
+    GenomeProjet *genome = calloc(1, sizeof(GenomeProjet));
+    if (genome == NULL) {
+        free(sequence);
+        return NULL;
+    }
+    genome->sequence = sequence;
+    genome->longueur = longueur;
+    genome->index = construire_index_suffixes(sequence, longueur);
+    genome->index_kmers = construire_index_kmers(sequence, longueur, LONGUEUR_GRAINE_GENE);
+    if (genome->index == NULL || genome->index_kmers == NULL) {
+        projet_fermer_genome(genome);
+        return NULL;
+    }
+    return genome;
+}
+
+// Lecture du génome (le pool décompresse les fichiers BGZF), verrou du pool tenu en lecture
+static GenomeProjet* lire_genome(const char *chemin_fasta) {
+    LecteurFlux *lecteur = ouvrir_lecteur_flux(chemin_fasta);
+    if (lecteur == NULL) return NULL;
+    int64_t capacite = 1 << 20, longueur = 0, lues;
+    char *sequence = malloc(capacite);
+    while (sequence != NULL && (lues = lire_bases_flux(lecteur, sequence + longueur, capacite - 1 - longueur)) > 0) {
+        longueur += lues;
+        if (longueur == capacite - 1) {
+            char *agrandie = capacite < INT32_MAX ? realloc(sequence, capacite * 2) : NULL;
+            if (agrandie == NULL) free(sequence);
+            sequence = agrandie;
+            capacite *= 2;
+        }
+    }
+    int erreur = erreur_lecteur_flux(lecteur);
+    fermer_lecteur_flux(lecteur);
+    if (sequence == NULL || erreur || longueur == 0 || longueur >= INT32_MAX) {
+        free(sequence);
+        return NULL;
+    }
+    sequence[longueur] = '\0';
+    return indexer_genome(sequence, (int)longueur);
+}
+
+GenomeProjet* projet_ouvrir_genome(const char *chemin_fasta) {
+    pthread_rwlock_rdlock(&verrou_pool);
+    GenomeProjet *genome = lire_genome(chemin_fasta);
+    pthread_rwlock_unlock(&verrou_pool);
+    return genome;
+}
+
+GenomeProjet* projet_creer_genome(const char *sequence, int longueur) {
+    if (sequence == NULL || longueur < 1) return NULL;
+    char *copie = malloc((size_t)longueur + 1);
+    if (copie == NULL) return NULL;
+    memcpy(copie, sequence, longueur);
+    copie[longueur] = '\0';
+    return indexer_genome(copie, longueur);
+}
+
+void projet_fermer_genome(GenomeProjet *genome) {
+    if (genome == NULL) return;
+    liberer_index_suffixes(genome->index);
+    liberer_index_kmers(genome->index_kmers);
+    free(genome->sequence);
+    free(genome);
+}
+
+int projet_longueur_genome(const GenomeProjet *genome) {
+    return genome->longueur;
+}
+
+const char* projet_sequence_genome(const GenomeProjet *genome) {
+    return genome->sequence;
+}
+
+// Gène plus court qu'une graine : copies sans indels des deux brins, par le balayage parallèle
+static int rechercher_gene_court(const GenomeProjet *genome, const char *gene, double identite_min,
+                                 ProjetGene *resultats, int nombre_max) {
+    int longueur = strlen(gene);
+    char *inverse = malloc(longueur + 1);
+    int *positions = malloc((nombre_max > 0 ? nombre_max : 1) * sizeof(int));
+    float *identites = malloc((nombre_max > 0 ? nombre_max : 1) * sizeof(float));
+    int nombre = inverse != NULL && positions != NULL && identites != NULL ? 0 : -1;
+    if (nombre == 0) {
+        ecrire_complement_inverse(gene, longueur, inverse);
+        inverse[longueur] = '\0';
+    }
+    for (int b = 0; b < 2 && nombre >= 0; b++) {
+        int places = nombre < nombre_max ? nombre_max - nombre : 0;
+        int copies = lister_copies_gene_parallele(genome->sequence, b == 0 ? gene : inverse, identite_min,
+                                                  positions, identites, places);
+        if (copies < 0) {
+            projet_liberer_genes(resultats, nombre < nombre_max ? nombre : nombre_max);
+            nombre = -1;
+            break;
+        }
+        for (int c = 0; c < copies && c < places; c++) {
+            // Identités et mésappariements déduits de l'identité : score +2/-3 comme l'alignement en bande
+            int identiques = (int)(identites[c] * longueur + 0.5f);
+            char cigar[16];
+            snprintf(cigar, sizeof(cigar), "%dM", longueur);
+            ProjetGene resultat = {positions[c], positions[c] + longueur, 2 * identiques - 3 * (longueur - identiques),
+                                   identites[c], strdup(cigar), b == 0 ? '+' : '-'};
+            resultats[nombre + c] = resultat;
+            if (resultat.cigar == NULL) {
+                projet_liberer_genes(resultats, nombre + c + 1);
+                copies = -1;
+                break;
+            }
+        }
+        nombre = copies < 0 ? -1 : nombre + copies;
+    }
+    free(inverse);
+    free(positions);
+    free(identites);
+    return nombre;
+}
+
+int projet_rechercher_gene(const GenomeProjet *genome, const char *gene, double identite_min, ProjetGene *resultats,
+                           int nombre_max) {
+    if (gene == NULL || nombre_max < 0) return -1;
+    if ((int)strlen(gene) < LONGUEUR_GRAINE_GENE) {
+        pthread_rwlock_rdlock(&verrou_pool);
+        int nombre = rechercher_gene_court(genome, gene, identite_min, resultats, nombre_max);
+        pthread_rwlock_unlock(&verrou_pool);
+        return nombre;
+    }
+    AlignementGene *alignements = nombre_max > 0 ? malloc(nombre_max * sizeof(AlignementGene)) : NULL;
+    if (nombre_max > 0 && alignements == NULL) return -1;
+    int nombre = rechercher_gene_graines(genome->index_kmers, genome->sequence, gene, identite_min, alignements,
+                                         nombre_max);
+    for (int r = 0; r < nombre && r < nombre_max; r++) {
+        ProjetGene resultat = {alignements[r].debut, alignements[r].fin, alignements[r].score,
+                               alignements[r].identite, alignements[r].cigar, alignements[r].brin};
+        resultats[r] = resultat;  // Le CIGAR passe à l'appelant
+    }
+    free(alignements);
+    return nombre;
+}
+
+void projet_liberer_genes(ProjetGene *resultats, int nombre) {
+    for (int r = 0; r < nombre; r++) {
+        free(resultats[r].cigar);
+        resultats[r].cigar = NULL;
+    }
+}
+
+int projet_rechercher_consensus(const GenomeProjet *genome, int debut, int fin, const char *boite_35,
+                                const char *boite_10, ProjetPaireConsensus *paires, int nombre_max) {
+    if (debut < 0 || fin > genome->longueur || debut > fin || nombre_max < 0) return -1;
+    int *positions = malloc((nombre_max > 0 ? 2 * (size_t)nombre_max : 1) * sizeof(int));
+    if (positions == NULL) return -1;
+    int nombre = lister_paires_consensus(genome->sequence, debut, fin, boite_35 != NULL ? boite_35 : BOITE_35,
+                                         boite_10 != NULL ? boite_10 : BOITE_10, positions, nombre_max);
+    // Positions deux à deux : copiées champ par champ, sans supposer la disposition de ProjetPaireConsensus
+    for (int p = 0; p < nombre && p < nombre_max; p++) {
+        paires[p].position_35 = positions[2 * p];
+        paires[p].position_10 = positions[2 * p + 1];
+    }
+    free(positions);
+    return nombre;
+}
+
+static bool motif_valide(const char *motif, int longueur, int mismatches) {
+    if (motif == NULL || longueur < 1 || mismatches < 0 || mismatches > 3) return false;
+    for (int i = 0; i < longueur; i++) {
+        if (code_nucleotide(motif[i]) < 0) return false;
+    }
+    return true;
+}
+
+int projet_compter_motif(const GenomeProjet *genome, const char *motif, int longueur, int mismatches) {
+    if (!motif_valide(motif, longueur, mismatches)) return -1;
+    if (mismatches == 0) return compter_occurrences_index(genome->index, motif, longueur, 0, 0, NULL);
+    return compter_occurrences_approchees(genome->index, motif, longueur, mismatches, 0, 0, NULL);
+}
+
+int* projet_positions_motif(const GenomeProjet *genome, const char *motif, int longueur, int mismatches,
+                            int *nombre) {
+    *nombre = 0;
+    if (!motif_valide(motif, longueur, mismatches)) return NULL;
+    int *positions = mismatches == 0
+                   ? positions_occurrences(genome->index, motif, longueur, NULL, nombre)
+                   : positions_occurrences_approchees(genome->index, motif, longueur, mismatches, NULL, nombre);
+    // Aucune occurrence : tableau vide plutôt que NULL, réservé aux erreurs
+    if (positions == NULL && *nombre == 0) positions = malloc(sizeof(int));
+    return positions;
+}
+
+int projet_etendre_motif(const GenomeProjet *genome, int position, int longueur, int copies_min,
+                         ProjetMotif *resultat) {
+    if (position < 0 || longueur < 1 || position + longueur > genome->longueur) return -1;
+    const char *sequence = genome->sequence;
+    int occurrences = compter_occurrences_index(genome->index, sequence + position, longueur, position, longueur,
+                                                NULL);
+    int longueur_initiale = longueur;
+    // Une base à gauche si possible, sinon à droite ; les copies commençant dans le motif lui-même ne comptent pas
+    for (;;) {
+        int gauche = position > 0 ? compter_occurrences_index(genome->index, sequence + position - 1, longueur + 1,
+                                                              position - 1, longueur + 1, NULL) : -1;
+        if (gauche >= copies_min) {
+            position--;
+            longueur++;
+            occurrences = gauche;
+            continue;
+        }
+        int droite = position + longueur < genome->longueur
+                   ? compter_occurrences_index(genome->index, sequence + position, longueur + 1, position,
+                                               longueur + 1, NULL) : -1;
+        if (droite < copies_min) break;
+        longueur++;
+        occurrences = droite;
+    }
+    ProjetMotif motif = {position, longueur, occurrences};
+    *resultat = motif;
+    return longueur - longueur_initiale;
+}
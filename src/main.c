@@ -5,141 +5,236 @@
 #include <unistd.h>
 #include <limits.h>
 #include <string.h>
+#include <stdarg.h>
+#include <errno.h>
+
+// Affiche les options reconnues par le programme
+static void afficher_usage(const char *nom_programme) {
+    printf("Usage : %s [options]\n", nom_programme);
+    printf("  --blast <fichier>   Charge un résultat BLAST tabulaire et affiche son résumé\n");
+    printf("  --aligner <liste>   Aligne les motifs retenus sur les génomes listés (un chemin par ligne)\n");
+    printf("  --conservation <liste> Compare les motifs retenus entre les souches listées (copies, amont du gène, identité)\n");
+    printf("  --flux <fichier>    Analyse un génome fenêtre par fenêtre (mémoire bornée, positions 64 bits)\n");
+    printf("  --fenetre <bases>   Nombre de bases par fenêtre en mode flux (défaut : %d)\n", TAILLE_FENETRE_FLUX);
+    printf("  --serveur <socket>  Garde le génome indexé en mémoire et répond aux requêtes reçues sur une socket Unix\n");
+    printf("  --sortie <fichier>  Fichier recevant tous les motifs retenus (défaut : data/motifs.tsv)\n");
+    printf("  --format <format>   Format de ce fichier : tsv, jsonl ou bin (défaut : tsv)\n");
+    printf("  --mismatches <d>    Compte aussi les copies à au plus d mésappariements (1 à 3)\n");
+    printf("  --moteur <m>        Découverte des motifs : repetitions (répétitions maximales, défaut) ou glouton\n");
+    printf("  --dust              Ignore les graines situées dans des régions de faible complexité\n");
+    printf("  --copies-max <n>    Ignore les graines chevauchant un k-mer présent plus de n fois dans le génome\n");
+    printf("  --spectre <k>       Compte tous les k-mers du génome (k de 1 à %d) : spectre et k-mers surreprésentés\n",
+           LONGUEUR_MAX_KMER_SPECTRE);
+    printf("  --top <n>           Nombre de k-mers surreprésentés écrits (défaut : %d)\n", NOMBRE_KMERS_SURREPRESENTES);
+    printf("  --fold-change-min <x> Fold change au-delà duquel un motif est retenu (défaut : %.1f)\n", FOLD_CHANGE_MIN);
+    printf("  --cache <dossier>   Réutilise les résultats intermédiaires (gène, motifs candidats) d'une exécution précédente\n");
+    printf("  --graine <n>        Graine du génome aléatoire (défaut : l'heure), pour des exécutions reproductibles\n");
+    printf("  --contextes <f>     Écrit en FASTA chaque occurrence des motifs retenus, avec ses coordonnées\n");
+    printf("  --flanc <bases>     Bases ajoutées de chaque côté d'une occurrence dans ce fichier (défaut : 0)\n");
+    printf("  --brin <b>          Brins des occurrences écrites : plus, moins ou deux (défaut : deux)\n");
+    printf("  --verifier <taux>   Recompte une part (0 à 1) des motifs retenus avec les fonctions de référence\n");
+    printf("  --verifier-moteurs <n> Compare les moteurs rapides aux fonctions de référence sur n génomes, puis s'arrête\n");
+    printf("  --threads <n>       Nombre de threads de calcul (défaut : nombre de cœurs)\n");
+    printf("  --silencieux        N'affiche pas chaque motif retenu dans la console\n");
+    printf("  --progression <m>   Progression des traitements longs : barre, lignes ou aucune (défaut : barre sur un terminal)\n");
+    printf("  --annotation <f>    Gènes annotés (GFF3 ou TSV) pour la distance des copies de chaque motif\n");
+    printf("  --masque <f>        Régions (BED ou \"début fin\", 0-indexées) dont les occurrences sont ignorées\n");
+    printf("  --masquer-region    Ignore aussi les occurrences dans toute la région étudiée en amont du gène\n");
+    printf("  --tests             Lance les tests des fonctions, puis s'arrête (make test)\n");
+    printf("  --aide              Affiche cette aide\n");
+}
 
-int main() {
-    // ==================== TEST DES FONCTIONS ====================
-    printf("\n========================================================================================\n");
-    printf("         Test des fonctions avant lancement du programme\n");
-    printf("========================================================================================\n\n");
-
-    // Tests des fonctions de recherche de séquences consensus
-    test_seq_consensus_distance_15();
-    test_seq_consensus_distance_19();
-    test_seq_consensus_chevauchante();
-    test_seq_consensus_critique_seq();
-    test_rechercher_seq_consensus_en_amont();
-    test_rechercher_seq_consensus_en_amont_critique();
-
-    // Tests des fonctions de recherche de gènes
-    test_presence_gene();
-    test_presence_multiple_gene();
-    test_abscence_gene();
-    test_abscence_gene_critique();
-
-    // Tests des fonctions de recherche de motifs
-    test_rechercher_motif_rapide();
-    test_calculer_fold_change();
-    
-    // ATTENTION, ces tests arriveront dans la prochaine version du programme.
-    
-    // Tests des fonctions d'extention  et de traitement des k-uplets
-    //test_etendre_et_traiter_k_uplets();
-
-    // Message final indiquant que tous les tests sont réussis
-    printf("\n========================================================================================\n");
-    printf("   Tous les tests ont été passés avec succès\n");
-    printf("========================================================================================\n\n");
-
-    // ==================== PROGRAMME PRINCIPAL ====================
-    char cwd[PATH_MAX];
-    if (getcwd(cwd, sizeof(cwd)) == NULL) {
-        perror("Erreur lors de l'obtention du répertoire de travail");
-        return 1;
+// Construit le chemin "<cwd>/../data/<nom>" dans un tampon de PATH_MAX octets ; -1 si le chemin serait tronqué
+__attribute__((format(printf, 3, 4)))
+static int chemin_donnees(char *chemin, const char *cwd, const char *format_nom, ...) {
+    int longueur = snprintf(chemin, PATH_MAX, "%s/../data/", cwd);
+    if (longueur < 0 || longueur >= PATH_MAX) {
+        printf("Erreur : chemin trop long dans %s\n", cwd);
+        return -1;
     }
+    va_list arguments;
+    va_start(arguments, format_nom);
+    int longueur_nom = vsnprintf(chemin + longueur, PATH_MAX - longueur, format_nom, arguments);
+    va_end(arguments);
+    if (longueur_nom < 0 || longueur_nom >= PATH_MAX - longueur) {
+        printf("Erreur : chemin trop long dans %s\n", cwd);
+        return -1;
+    }
+    return 0;
+}
 
-    // Chemins des fichiers
-    char chemin_sequence_reelle[PATH_MAX];
-    char chemin_sequence_aleatoire[PATH_MAX];
-    char chemin_gene[PATH_MAX];
-
-    snprintf(chemin_sequence_reelle, PATH_MAX, "%s/../data/sequence_reelle.fna", cwd);
-    snprintf(chemin_sequence_aleatoire, PATH_MAX, "%s/../data/sequence_aleatoire.fna", cwd);
-    snprintf(chemin_gene, PATH_MAX, "%s/../data/gene.fna", cwd);
-
-    // Initialisation de la graine aléatoire
-    srand(time(NULL));
-
-    // Génération de la séquence aléatoire
-    // Lecture du génome complet étudié
-    char* sequence_reelle = lire_fichier(chemin_sequence_reelle);
-    if (!sequence_reelle) {
+// Données partagées par les étapes de l'analyse principale (chaque champ est écrit par une seule étape)
+typedef struct {
+    const char *chemin_sequence_reelle;
+    const char *chemin_sequence_aleatoire;
+    const char *chemin_gene;
+    const char *chemin_annotation;
+    const char *chemin_masque;
+    const char *cwd;
+    uint64_t graine;
+    bool graine_du_genome;         // Graine tirée du génome réel à sa lecture (cache sans --graine)
+    int longueur_spectre;
+    int nombre_surrepresentes;
+    ParametresSortie *sortie;
+
+    char *sequence_reelle;
+    int longueur_sequence_reelle;
+    char *sequence_alea;
+    char *sequence_gene;
+    int position_gene;
+    AnnotationGenes *annotation;
+    MasqueExclusion *masque;
+    char *entete_genome;
+    IndexSuffixes *index_reel;
+    IndexSuffixes *index_aleatoire;
+    SpectreKmers *spectre;
+} AnalysePrincipale;
+
+// Lecture du génome complet étudié
+static int etape_lecture_genome(void *contexte) {
+    AnalysePrincipale *analyse = contexte;
+    analyse->sequence_reelle = lire_fichier(analyse->chemin_sequence_reelle);
+    if (!analyse->sequence_reelle) {
         printf("Erreur lors de la lecture de la séquence réelle.\n");
         return 1;
     }
-    int longueur_sequence_aleatoire = strlen(sequence_reelle);
-    char *sequence = generer_sequence(longueur_sequence_aleatoire);
-    if (sequence == NULL) {
-        free(sequence_reelle);
+    analyse->longueur_sequence_reelle = strlen(analyse->sequence_reelle);
+    return 0;
+}
+
+// Lecture du gène d'intérêt
+static int etape_lecture_gene(void *contexte) {
+    AnalysePrincipale *analyse = contexte;
+    analyse->sequence_gene = lire_fichier(analyse->chemin_gene);
+    if (!analyse->sequence_gene) {
+        printf("Erreur lors de la lecture des fichiers de séquence.\n");
         return 1;
     }
+    return 0;
+}
 
-    ecrire_fichier_sequence(sequence, chemin_sequence_aleatoire);
-    free(sequence);
-
-    // Lecture des séquences aléatoire et du gène d'intérêt
-    char* sequence_alea = lire_fichier(chemin_sequence_aleatoire);
-    char* sequence_gene = lire_fichier(chemin_gene);
-
-    if (!sequence_alea || !sequence_gene) {
+// Génération de la séquence aléatoire, de la longueur du génome réel
+static int etape_generation_aleatoire(void *contexte) {
+    AnalysePrincipale *analyse = contexte;
+    if (analyse->graine_du_genome) {
+        analyse->graine = graine_depuis_genome(analyse->sequence_reelle, analyse->longueur_sequence_reelle);
+    }
+    analyse->sequence_alea = generer_sequence_parallele(analyse->longueur_sequence_reelle, analyse->graine);
+    if (!analyse->sequence_alea) {
         printf("Erreur lors de la lecture des fichiers de séquence.\n");
-        free(sequence_reelle);
-        free(sequence_alea);
-        free(sequence_gene);
         return 1;
     }
+    return 0;
+}
 
-    // Séparateur
+// Enregistrement de la séquence aléatoire, pendant la suite de l'analyse
+static int etape_ecriture_aleatoire(void *contexte) {
+    AnalysePrincipale *analyse = contexte;
+    ecrire_fichier_sequence(analyse->sequence_alea, analyse->chemin_sequence_aleatoire);
+    return 0;
+}
+
+// Recherche du gène dans la séquence réelle et enregistrement de sa position
+static int etape_recherche_gene(void *contexte) {
+    AnalysePrincipale *analyse = contexte;
     printf("\n========================================================================================\n");
     printf("   Recherche du gène dans la séquence réelle d'E. coli\n");
     printf("========================================================================================\n\n");
 
-    // Paramètres pour la recherche du gène
-    double identite_minimale = IDENTITE_MIN;  // Pourcentage d'identité minimale
-
-    // Recherche du gène dans la séquence réelle et enregistrement de sa position
-    int position_gene = rechercher_gene(sequence_reelle, sequence_gene, identite_minimale);
-
-    // Vérifier que la position du gène est valide
-    int longueur_sequence_reelle = strlen(sequence_reelle);
-    if (position_gene < 0 || position_gene > longueur_sequence_reelle) {
+    // Graines et alignement en bande : une copie portant des indels reste détectée ; avec --cache, la position
+    // est relue tant que le génome, le gène et l'identité minimale n'ont pas changé
+    char brin = '.';
+    analyse->position_gene = rechercher_gene_cache(analyse->sortie->dossier_cache, analyse->sequence_reelle,
+                                                   analyse->sequence_gene, IDENTITE_MIN, &brin);
+    if (analyse->position_gene < 0 || analyse->position_gene > analyse->longueur_sequence_reelle) {
         printf("Erreur : position du gène invalide.\n");
-        free(sequence_reelle);
-        free(sequence_alea);
-        free(sequence_gene);
         return 1;
     }
+    if (brin == '-') {
+        // La région en amont d'un gène du brin - suit sa fin : les étapes suivantes n'étudient que le brin +
+        printf("Erreur : le gène est sur le brin -, l'analyse de la région en amont ne porte que sur le brin +.\n");
+        return 1;
+    }
+    return 0;
+}
 
-    // === Recherche de séquences consensus avant l'analyse des motifs ===
+// Recherche de séquences consensus avant l'analyse des motifs
+static int etape_consensus(void *contexte) {
+    AnalysePrincipale *analyse = contexte;
     printf("\n========================================================================================\n");
     printf("   Recherche de la présence de boîtes consensus en amont du gène\n");
     printf("========================================================================================\n\n");
 
-    // Paramètres pour la recherche de séquences consensus
-    int bases_amont_consensus = LONGEUR_SEQUENCE_ETUDIE_CONSENSUS;  // Nombre de bases en amont pour la recherche
-    char* boite_35 = BOITE_35;  // Séquence de la boîte -35
-    char* boite_10 = BOITE_10;  // Séquence de la boîte -10
-
-    // Appel à la fonction rechercher_seq_consensus
-    int nombre_sequences = rechercher_seq_consensus(sequence_reelle, boite_35, boite_10, position_gene, bases_amont_consensus);
-
+    int nombre_sequences = rechercher_seq_consensus_parallele(analyse->sequence_reelle, BOITE_35, BOITE_10,
+                                                              analyse->position_gene,
+                                                              LONGEUR_SEQUENCE_ETUDIE_CONSENSUS);
     if (nombre_sequences == -1) {
         printf("Aucune séquence consensus trouvée en amont du gène.\n");
     } else {
         printf("Nombre total de séquences consensus trouvées : %d\n", nombre_sequences);
     }
+    return 0;
+}
+
+// Gènes annotés, pour situer les copies des motifs retenus
+static int etape_annotation(void *contexte) {
+    AnalysePrincipale *analyse = contexte;
+    if (analyse->chemin_annotation == NULL) return 0;
+    analyse->annotation = charger_annotation_genes(analyse->chemin_annotation);
+    if (analyse->annotation == NULL) {
+        printf("Annotation ignorée : %s\n", analyse->chemin_annotation);
+    }
+    return 0;
+}
 
-    // Séparateur pour l'analyse des motifs
+// Régions du génome réel dont les occurrences ne sont pas comptées
+static int etape_masque(void *contexte) {
+    AnalysePrincipale *analyse = contexte;
+    if (analyse->chemin_masque == NULL) return 0;
+    analyse->masque = creer_masque_exclusion(analyse->longueur_sequence_reelle);
+    if (analyse->masque != NULL && charger_masque_exclusion(analyse->masque, analyse->chemin_masque) < 0) {
+        printf("Masque ignoré : %s\n", analyse->chemin_masque);
+        liberer_masque_exclusion(analyse->masque);
+        analyse->masque = NULL;
+    }
+    return 0;
+}
+
+// En-têtes des contextes des occurrences : identifiant et description du génome réel, comme dans BLAST
+static int etape_entete_genome(void *contexte) {
+    AnalysePrincipale *analyse = contexte;
+    if (analyse->sortie->chemin_contextes != NULL) {
+        analyse->entete_genome = lire_entete_fasta(analyse->chemin_sequence_reelle);
+    }
+    return 0;
+}
+
+// Tables des suffixes des deux génomes, construites pendant la recherche du gène (NULL : reconstruites au besoin)
+static int etape_index_reel(void *contexte) {
+    AnalysePrincipale *analyse = contexte;
+    analyse->index_reel = construire_index_suffixes(analyse->sequence_reelle, analyse->longueur_sequence_reelle);
+    return 0;
+}
+
+static int etape_index_aleatoire(void *contexte) {
+    AnalysePrincipale *analyse = contexte;
+    analyse->index_aleatoire = construire_index_suffixes(analyse->sequence_alea,
+                                                         analyse->longueur_sequence_reelle);
+    return 0;
+}
+
+// Analyse des motifs dans la région en amont du gène
+static int etape_motifs(void *contexte) {
+    AnalysePrincipale *analyse = contexte;
+    ParametresSortie *sortie = analyse->sortie;
     printf("\n========================================================================================\n");
     printf("   Analyse des motifs dans la région promotrice\n");
     printf("========================================================================================\n\n");
 
     // Vérifier que la région en amont ne dépasse pas les limites de la séquence
     int taille_region = LONGEUR_REGION_ETUIE_MOTIFS;  // Taille de la région en amont à analyser
-    if (position_gene - taille_region < 0) {
+    if (analyse->position_gene - taille_region < 0) {
         printf("Erreur : la région en amont dépasse les limites de la séquence\n");
-        free(sequence_reelle);
-        free(sequence_alea);
-        free(sequence_gene);
         return 1;
     }
 
@@ -147,35 +242,536 @@ int main() {
     char* sous_sequence = (char*)malloc((taille_region + 1) * sizeof(char));
     if (sous_sequence == NULL) {
         printf("Erreur d'allocation mémoire pour la sous-séquence\n");
-        free(sequence_reelle);
-        free(sequence_alea);
-        free(sequence_gene);
         return 1;
     }
-
-    strncpy(sous_sequence, &sequence_reelle[position_gene - taille_region], taille_region);
+    strncpy(sous_sequence, &analyse->sequence_reelle[analyse->position_gene - taille_region], taille_region);
     sous_sequence[taille_region] = '\0';
 
-    // Paramètres pour l'analyse des k-uplets
-    int longueur_k_uplet = LONGUEUR_K_UPLET;     // Longueur des k-uplets à rechercher
-    int longueur_min_motif = LONGUEUR_MIN_MOTIF; // Longueur minimale d'un motif pour le test statistique
+    sortie->annotation = analyse->annotation;
+    sortie->masque = analyse->masque;
+    sortie->index_reel = analyse->index_reel;
+    sortie->index_aleatoire = analyse->index_aleatoire;
+    if (sortie->chemin_contextes != NULL) {
+        sortie->contextes.identifiant = "sequence_reelle";
+        char *entete_genome = analyse->entete_genome;
+        if (entete_genome != NULL && entete_genome[0] != '\0') {
+            char *espace = strchr(entete_genome, ' ');
+            if (espace != NULL) {
+                *espace = '\0';
+                sortie->contextes.description = espace + 1;
+            }
+            sortie->contextes.identifiant = entete_genome;
+        }
+    }
 
     // Appeler la fonction pour traiter les k-uplets en excluant la région spécifique
-    traiter_k_uplets(sous_sequence, taille_region, sequence_reelle,
-                     longueur_sequence_reelle, longueur_k_uplet, longueur_min_motif,
-                     sequence_alea, position_gene);
-
-    // Libérer la mémoire
+    traiter_k_uplets(sous_sequence, taille_region, analyse->sequence_reelle, analyse->longueur_sequence_reelle,
+                     LONGUEUR_K_UPLET, LONGUEUR_MIN_MOTIF, analyse->sequence_alea, analyse->position_gene, sortie);
     free(sous_sequence);
+    return 0;
+}
 
-    // === Fin de l'intégration du module analyse_motifs ===
+// Spectre des k-mers du génome réel, calculé pendant la recherche du gène et l'analyse des motifs
+static int etape_spectre(void *contexte) {
+    AnalysePrincipale *analyse = contexte;
+    analyse->spectre = calculer_spectre_kmers(analyse->sequence_reelle, analyse->longueur_sequence_reelle,
+                                              analyse->longueur_spectre);
+    return 0;
+}
 
-    printf("\nProgramme terminé avec succès.\n");
+// Écriture du spectre et des k-mers surreprésentés par rapport au modèle de fond
+static int etape_rapport_spectre(void *contexte) {
+    AnalysePrincipale *analyse = contexte;
+    SpectreKmers *spectre = analyse->spectre;
+    int longueur_spectre = analyse->longueur_spectre;
+    if (spectre == NULL) {
+        // Erreur du calcul, affichée ici pour rester après les résultats des motifs
+        printf("Erreur lors du calcul du spectre des %d-mers\n", longueur_spectre);
+        return 0;
+    }
+    char chemin_spectre[PATH_MAX];
+    char chemin_surrepresentes[PATH_MAX];
+    if (chemin_donnees(chemin_spectre, analyse->cwd, "spectre_k%d.tsv", longueur_spectre) != 0 ||
+        chemin_donnees(chemin_surrepresentes, analyse->cwd, "kmers_surrepresentes_k%d.tsv", longueur_spectre) != 0) {
+        return -1;
+    }
+    printf("\nSpectre des %d-mers : %lld k-mers, %lld distincts\n", longueur_spectre,
+           (long long)spectre->nombre_total, (long long)spectre->nombre_distincts);
+    ecrire_spectre_kmers(spectre, chemin_spectre);
+
+    int nombre_kmers = 0;
+    KmerSurrepresente *kmers = kmers_surrepresentes(spectre, analyse->sequence_reelle,
+                                                    analyse->longueur_sequence_reelle, ORDRE_MODELE_FOND,
+                                                    analyse->nombre_surrepresentes, &nombre_kmers);
+    if (kmers != NULL) {
+        ecrire_kmers_surrepresentes(kmers, nombre_kmers, longueur_spectre, chemin_surrepresentes);
+        printf("%d k-mers surreprésentés écrits dans %s\n", nombre_kmers, chemin_surrepresentes);
+        free(kmers);
+    }
+    return 0;
+}
 
-    // Libération de la mémoire
-    free(sequence_reelle);
-    free(sequence_alea);
-    free(sequence_gene);
+// Ajout d'une étape ; un échec d'allocation est retenu dans `*echec`, vérifié une fois le graphe construit
+static int ajouter_etape(GrapheTaches *graphe, const char *nom, FonctionTache fonction, void *contexte, bool *echec) {
+    int tache = ajouter_tache(graphe, nom, fonction, contexte);
+    if (tache < 0) *echec = true;
+    return tache;
+}
 
-    return 0;
+// `etape` attend `prerequis` ; un échec (allocation, ou étape dont l'ajout a échoué) est retenu dans `*echec`
+static void relier_etapes(GrapheTaches *graphe, int etape, int prerequis, bool *echec) {
+    if (ajouter_dependance(graphe, etape, prerequis) != 0) *echec = true;
+}
+
+int main(int argc, char *argv[]) {
+    // ==================== LECTURE DES OPTIONS ====================
+    const char *chemin_blast = NULL;
+    const char *chemin_liste_genomes = NULL;
+    const char *chemin_flux = NULL;
+    const char *chemin_liste_souches = NULL;
+    const char *chemin_socket = NULL;
+    int64_t taille_fenetre = TAILLE_FENETRE_FLUX;
+    ParametresSortie sortie = parametres_sortie_defaut();
+    const char *chemin_annotation = NULL;
+    const char *chemin_masque = NULL;
+    int nombre_threads = nombre_coeurs_disponibles();
+    int longueur_spectre = 0;
+    int nombre_surrepresentes = NOMBRE_KMERS_SURREPRESENTES;
+    const char *texte_graine = NULL;
+    uint64_t graine_fixee = 0;
+    BilanVerification bilan_verification = {0, 0};
+    int genomes_verification = 0;
+    ModeProgression mode_progression = PROGRESSION_AUTO;
+    bool lancer_tests = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--blast") == 0 && i + 1 < argc) {
+            chemin_blast = argv[++i];
+        } else if (strcmp(argv[i], "--aligner") == 0 && i + 1 < argc) {
+            chemin_liste_genomes = argv[++i];
+        } else if (strcmp(argv[i], "--conservation") == 0 && i + 1 < argc) {
+            chemin_liste_souches = argv[++i];
+        } else if (strcmp(argv[i], "--flux") == 0 && i + 1 < argc) {
+            chemin_flux = argv[++i];
+        } else if (strcmp(argv[i], "--serveur") == 0 && i + 1 < argc) {
+            chemin_socket = argv[++i];
+        } else if (strcmp(argv[i], "--fenetre") == 0 && i + 1 < argc) {
+            char *fin_nombre = NULL;
+            taille_fenetre = strtoll(argv[++i], &fin_nombre, 10);
+            if (fin_nombre == argv[i] || *fin_nombre != '\0' || taille_fenetre <= 0) {
+                printf("La taille de fenêtre doit être un nombre de bases positif : %s\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--sortie") == 0 && i + 1 < argc) {
+            sortie.chemin_resultats = argv[++i];
+        } else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            if (format_resultats_depuis_nom(argv[++i], &sortie.format) != 0) {
+                printf("Format inconnu : %s\n", argv[i]);
+                afficher_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--annotation") == 0 && i + 1 < argc) {
+            chemin_annotation = argv[++i];
+        } else if (strcmp(argv[i], "--mismatches") == 0 && i + 1 < argc) {
+            sortie.mismatches_max = atoi(argv[++i]);
+            if (sortie.mismatches_max < 0 || sortie.mismatches_max > 3) {
+                printf("Le nombre de mésappariements doit être compris entre 0 et 3\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--masque") == 0 && i + 1 < argc) {
+            chemin_masque = argv[++i];
+        } else if (strcmp(argv[i], "--masquer-region") == 0) {
+            sortie.masquer_region = 1;
+        } else if (strcmp(argv[i], "--moteur") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "repetitions") == 0) {
+                sortie.moteur = MOTEUR_REPETITIONS;
+            } else if (strcmp(argv[i], "glouton") == 0) {
+                sortie.moteur = MOTEUR_GLOUTON;
+            } else {
+                printf("Moteur inconnu : %s\n", argv[i]);
+                afficher_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--dust") == 0) {
+            sortie.masquer_faible_complexite = 1;
+        } else if (strcmp(argv[i], "--copies-max") == 0 && i + 1 < argc) {
+            char *fin_nombre = NULL;
+            long copies_max = strtol(argv[++i], &fin_nombre, 10);
+            if (fin_nombre == argv[i] || *fin_nombre != '\0' || copies_max < 1 || copies_max > INT_MAX) {
+                printf("Le nombre maximal de copies doit être un entier positif : %s\n", argv[i]);
+                return 1;
+            }
+            sortie.copies_max_graine = (int)copies_max;
+        } else if (strcmp(argv[i], "--spectre") == 0 && i + 1 < argc) {
+            longueur_spectre = atoi(argv[++i]);
+            if (longueur_spectre < 1 || longueur_spectre > LONGUEUR_MAX_KMER_SPECTRE) {
+                printf("La longueur des k-mers du spectre doit être comprise entre 1 et %d\n", LONGUEUR_MAX_KMER_SPECTRE);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--top") == 0 && i + 1 < argc) {
+            nombre_surrepresentes = atoi(argv[++i]);
+            if (nombre_surrepresentes < 1) {
+                printf("Le nombre de k-mers surreprésentés doit être positif\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--fold-change-min") == 0 && i + 1 < argc) {
+            char *fin_nombre = NULL;
+            sortie.fold_change_min = strtod(argv[++i], &fin_nombre);
+            if (fin_nombre == argv[i] || *fin_nombre != '\0' || !(sortie.fold_change_min > 0)) {
+                printf("Le fold change minimal doit être un nombre positif : %s\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--cache") == 0 && i + 1 < argc) {
+            sortie.dossier_cache = argv[++i];
+        } else if (strcmp(argv[i], "--graine") == 0 && i + 1 < argc) {
+            texte_graine = argv[++i];
+            // Une graine mal saisie donnerait silencieusement la graine 0 et des clés de cache d'apparence valide
+            char *fin_nombre = NULL;
+            errno = 0;
+            graine_fixee = strtoull(texte_graine, &fin_nombre, 10);
+            if (fin_nombre == texte_graine || *fin_nombre != '\0' || errno == ERANGE ||
+                strchr(texte_graine, '-') != NULL) {
+                printf("La graine doit être un entier positif ou nul : %s\n", texte_graine);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--contextes") == 0 && i + 1 < argc) {
+            sortie.chemin_contextes = argv[++i];
+        } else if (strcmp(argv[i], "--flanc") == 0 && i + 1 < argc) {
+            sortie.contextes.flanc = atoi(argv[++i]);
+            if (sortie.contextes.flanc < 0) {
+                printf("Le flanc doit être positif ou nul\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--brin") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "plus") == 0) {
+                sortie.contextes.brin = BRIN_PLUS;
+            } else if (strcmp(argv[i], "moins") == 0) {
+                sortie.contextes.brin = BRIN_MOINS;
+            } else if (strcmp(argv[i], "deux") == 0) {
+                sortie.contextes.brin = BRIN_DEUX;
+            } else {
+                printf("Brin inconnu : %s\n", argv[i]);
+                afficher_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--verifier") == 0 && i + 1 < argc) {
+            char *fin_nombre = NULL;
+            sortie.taux_verification = strtod(argv[++i], &fin_nombre);
+            if (fin_nombre == argv[i] || *fin_nombre != '\0' || !(sortie.taux_verification > 0) ||
+                sortie.taux_verification > 1) {
+                printf("Le taux de vérification doit être un nombre compris entre 0 (exclu) et 1 : %s\n", argv[i]);
+                return 1;
+            }
+            sortie.verification = &bilan_verification;
+        } else if (strcmp(argv[i], "--verifier-moteurs") == 0 && i + 1 < argc) {
+            genomes_verification = atoi(argv[++i]);
+            if (genomes_verification < 1) {
+                printf("Le nombre de génomes vérifiés doit être au moins 1\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            nombre_threads = atoi(argv[++i]);
+            if (nombre_threads < 1) {
+                printf("Le nombre de threads doit être au moins 1\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--silencieux") == 0) {
+            sortie.affichage_console = 0;
+        } else if (strcmp(argv[i], "--progression") == 0 && i + 1 < argc) {
+            if (mode_progression_depuis_nom(argv[++i], &mode_progression) != 0) {
+                printf("Mode de progression inconnu : %s\n", argv[i]);
+                afficher_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--tests") == 0) {
+            lancer_tests = true;
+        } else if (strcmp(argv[i], "--aide") == 0) {
+            afficher_usage(argv[0]);
+            return 0;
+        } else {
+            printf("Option inconnue : %s\n", argv[i]);
+            afficher_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    // Pool de threads partagé par toutes les étapes (les threads s'arrêtent avec le processus)
+    PoolThreads *pool = creer_pool_threads(nombre_threads);
+    definir_pool_global(pool);
+
+    // Tests des fonctions (make test) : rien d'autre n'est lancé
+    if (lancer_tests) {
+        executer_tests_projet();
+        detruire_pool_threads(pool);
+        return 0;
+    }
+
+    // Les traitements longs avancent des compteurs ; un thread les affiche à intervalle fixe jusqu'à la sortie
+    if (demarrer_rapporteur_progression(mode_progression) == 0) atexit(arreter_rapporteur_progression);
+
+    // ==================== VÉRIFICATION DES MOTEURS RAPIDES ====================
+    if (genomes_verification > 0) {
+        printf("\n========================================================================================\n");
+        printf("   Vérification des moteurs rapides sur %d génomes\n", genomes_verification);
+        printf("========================================================================================\n\n");
+
+        int resultat = verifier_moteurs(GRAINE_VERIFICATION, genomes_verification, &bilan_verification);
+        printf("%lld résultats comparés aux fonctions de référence, %lld divergence(s)\n",
+               (long long)bilan_verification.comparaisons, (long long)bilan_verification.divergences);
+        return resultat == 0 ? 0 : 1;
+    }
+
+    // ==================== RÉSUMÉ D'UN RÉSULTAT BLAST ====================
+    if (chemin_blast != NULL) {
+        printf("\n========================================================================================\n");
+        printf("   Résumé des hits BLAST : %s\n", chemin_blast);
+        printf("========================================================================================\n\n");
+
+        TableBlast *table = charger_table_blast(chemin_blast);
+        if (table == NULL) {
+            return 1;
+        }
+        afficher_resume_blast(table, DISTANCE_GROUPE_BLAST);
+        liberer_table_blast(table);
+        return 0;
+    }
+
+    // ==================== PROGRAMME PRINCIPAL ====================
+    char cwd[PATH_MAX];
+    if (getcwd(cwd, sizeof(cwd)) == NULL) {
+        perror("Erreur lors de l'obtention du répertoire de travail");
+        return 1;
+    }
+
+    // Chemins des fichiers
+    char chemin_sequence_reelle[PATH_MAX];
+    char chemin_sequence_aleatoire[PATH_MAX];
+    char chemin_gene[PATH_MAX];
+
+    if (chemin_donnees(chemin_sequence_reelle, cwd, "sequence_reelle.fna") != 0 ||
+        chemin_donnees(chemin_sequence_aleatoire, cwd, "sequence_aleatoire.fna") != 0 ||
+        chemin_donnees(chemin_gene, cwd, "gene.fna") != 0) {
+        return 1;
+    }
+
+    // Fichiers de résultats des motifs
+    char chemin_motifs_retenus[PATH_MAX];
+    char chemin_resultats[PATH_MAX];
+    if (chemin_donnees(chemin_motifs_retenus, cwd, "motif_retenu.txt") != 0) {
+        return 1;
+    }
+    sortie.chemin_motifs_retenus = chemin_motifs_retenus;
+    if (sortie.chemin_resultats == NULL) {
+        // Par défaut, l'extension suit le format choisi
+        const char *extensions[] = {"tsv", "jsonl", "bin"};
+        if (chemin_donnees(chemin_resultats, cwd, "motifs.%s", extensions[sortie.format]) != 0) {
+            return 1;
+        }
+        sortie.chemin_resultats = chemin_resultats;
+    }
+
+    // ==================== ALIGNEMENT LOCAL DES MOTIFS RETENUS ====================
+    if (chemin_liste_genomes != NULL) {
+        char chemin_alignement[PATH_MAX];
+        if (chemin_donnees(chemin_alignement, cwd, "alignement_local.txt") != 0) {
+            return 1;
+        }
+
+        printf("\n========================================================================================\n");
+        printf("   Alignement local des motifs retenus sur les génomes de %s\n", chemin_liste_genomes);
+        printf("========================================================================================\n\n");
+
+        ParametresAlignement parametres = parametres_alignement_defaut();
+        return aligner_motifs_genomes(chemin_motifs_retenus, chemin_liste_genomes, chemin_alignement, &parametres) < 0 ? 1 : 0;
+    }
+
+    // ==================== CONSERVATION DES MOTIFS ENTRE SOUCHES ====================
+    if (chemin_liste_souches != NULL) {
+        char chemin_conservation[PATH_MAX];
+        if (chemin_donnees(chemin_conservation, cwd, "conservation.tsv") != 0) {
+            return 1;
+        }
+
+        printf("\n========================================================================================\n");
+        printf("   Conservation des motifs retenus dans les souches de %s\n", chemin_liste_souches);
+        printf("========================================================================================\n\n");
+
+        char* sequence_gene = lire_fichier(chemin_gene);
+        int nombre_souches = comparer_souches(chemin_motifs_retenus, chemin_liste_souches, sequence_gene,
+                                              chemin_conservation);
+        free(sequence_gene);
+        return nombre_souches < 0 ? 1 : 0;
+    }
+
+    // ==================== ANALYSE EN FLUX ====================
+    if (chemin_flux != NULL) {
+        char chemin_kmers[PATH_MAX];
+        if (chemin_donnees(chemin_kmers, cwd, "kmers_flux.tsv") != 0) {
+            return 1;
+        }
+
+        printf("\n========================================================================================\n");
+        printf("   Analyse en flux de %s (fenêtres de %lld bases)\n", chemin_flux, (long long)taille_fenetre);
+        printf("========================================================================================\n\n");
+
+        char* sequence_gene = lire_fichier(chemin_gene);
+        ResultatsFlux resultats;
+        if (analyser_genome_flux(chemin_flux, sequence_gene, LONGUEUR_K_UPLET, taille_fenetre, &resultats) != 0) {
+            free(sequence_gene);
+            return 1;
+        }
+        free(sequence_gene);
+
+        printf("Bases lues : %lld en %d fenêtre(s)\n", (long long)resultats.longueur_genome, resultats.nombre_fenetres);
+        for (int g = 0; g < resultats.nombre_genes; g++) {
+            printf("Gène trouvé à la position %lld\n", (long long)resultats.positions_genes[g] + 1);
+        }
+        if (resultats.nombre_genes == 0) printf("Gène non trouvé\n");
+        printf("Nombre de paires de boîtes consensus dans le génome : %lld\n", (long long)resultats.nombre_consensus);
+        if (ecrire_comptes_kmers_flux(&resultats, chemin_kmers) == 0) {
+            printf("Comptes des %d-mers écrits dans %s\n", resultats.longueur_kmer, chemin_kmers);
+        }
+        liberer_resultats_flux(&resultats);
+        return 0;
+    }
+
+    // ==================== SERVEUR DE REQUÊTES ====================
+    if (chemin_socket != NULL) {
+        printf("\n========================================================================================\n");
+        printf("   Serveur de requêtes sur %s\n", chemin_socket);
+        printf("========================================================================================\n\n");
+
+        char* sequence_reelle = lire_fichier(chemin_sequence_reelle);
+        if (!sequence_reelle) {
+            printf("Erreur lors de la lecture de la séquence réelle.\n");
+            return 1;
+        }
+        int longueur_sequence_reelle = strlen(sequence_reelle);
+        AnnotationGenes *annotation = chemin_annotation != NULL ? charger_annotation_genes(chemin_annotation) : NULL;
+        MasqueExclusion *masque = NULL;
+        if (chemin_masque != NULL) {
+            masque = creer_masque_exclusion(longueur_sequence_reelle);
+            if (masque != NULL && charger_masque_exclusion(masque, chemin_masque) < 0) {
+                printf("Masque ignoré : %s\n", chemin_masque);
+                liberer_masque_exclusion(masque);
+                masque = NULL;
+            }
+        }
+
+        // Le génome est indexé une seule fois ; chaque requête n'interroge plus que les index
+        int code_retour = 1;
+        ServeurGenome *serveur = creer_serveur_genome(sequence_reelle, longueur_sequence_reelle, annotation, masque);
+        if (serveur == NULL) printf("Erreur d'allocation mémoire pour les index du génome\n");
+        int socket_ecoute = serveur != NULL ? ouvrir_socket_serveur(chemin_socket) : -1;
+        if (socket_ecoute >= 0) {
+            printf("Génome de %d bases indexé, en attente des requêtes\n", longueur_sequence_reelle);
+            fflush(stdout);
+            code_retour = servir_requetes(serveur, socket_ecoute) == 0 ? 0 : 1;
+            close(socket_ecoute);
+            unlink(chemin_socket);
+        }
+        liberer_serveur_genome(serveur);
+        liberer_masque_exclusion(masque);
+        liberer_annotation_genes(annotation);
+        free(sequence_reelle);
+        return code_retour;
+    }
+
+    // Initialisation de la graine aléatoire
+    srand(time(NULL));
+
+    // La séquence aléatoire est générée par blocs en parallèle, à partir d'une seule graine
+    uint64_t graine = ((uint64_t)rand() << 32) ^ (uint64_t)rand();
+    if (texte_graine != NULL) {
+        // Graine fixée : même génome aléatoire d'une exécution à l'autre, donc motifs candidats réutilisables
+        graine = graine_fixee;
+    }
+    // Le génome aléatoire fait partie de la clé des candidats : avec le cache mais sans graine fixée, une graine
+    // tirée de l'heure ne laisserait jamais relire une entrée, et chaque exécution en écrirait une nouvelle
+    bool graine_du_genome = texte_graine == NULL && sortie.dossier_cache != NULL;
+    if (graine_du_genome) printf("Cache sans --graine : graine du génome aléatoire tirée du génome réel\n");
+
+    AnalysePrincipale analyse = {chemin_sequence_reelle, chemin_sequence_aleatoire, chemin_gene, chemin_annotation,
+                                 chemin_masque, cwd, graine, graine_du_genome, longueur_spectre, nombre_surrepresentes,
+                                 &sortie,
+                                 NULL, 0, NULL, NULL, -1, NULL, NULL, NULL, NULL, NULL, NULL};
+
+    // Chaque étape attend les données qu'elle lit : tables des suffixes et spectre avancent pendant la recherche
+    // du gène et l'analyse des motifs. Les étapes qui peuvent afficher restent enchaînées, dans l'ordre des
+    // sections de la console ; celles qui avancent en parallèle n'affichent rien.
+    GrapheTaches *graphe = creer_graphe_taches();
+    if (graphe == NULL) {
+        printf("Erreur d'allocation mémoire pour le graphe des étapes\n");
+        return 1;
+    }
+    bool echec = false;
+    int lecture_genome = ajouter_etape(graphe, "lecture du génome", etape_lecture_genome, &analyse, &echec);
+    int lecture_gene = ajouter_etape(graphe, "lecture du gène", etape_lecture_gene, &analyse, &echec);
+    int generation = ajouter_etape(graphe, "génome aléatoire", etape_generation_aleatoire, &analyse, &echec);
+    int ecriture = ajouter_etape(graphe, "écriture aléatoire", etape_ecriture_aleatoire, &analyse, &echec);
+    int recherche_gene = ajouter_etape(graphe, "recherche du gène", etape_recherche_gene, &analyse, &echec);
+    int consensus = ajouter_etape(graphe, "boîtes consensus", etape_consensus, &analyse, &echec);
+    int annotation = ajouter_etape(graphe, "annotation", etape_annotation, &analyse, &echec);
+    int masque = ajouter_etape(graphe, "masque", etape_masque, &analyse, &echec);
+    int entete = ajouter_etape(graphe, "en-tête du génome", etape_entete_genome, &analyse, &echec);
+    int motifs = ajouter_etape(graphe, "analyse des motifs", etape_motifs, &analyse, &echec);
+    relier_etapes(graphe, generation, lecture_genome, &echec);
+    relier_etapes(graphe, ecriture, generation, &echec);
+    relier_etapes(graphe, recherche_gene, lecture_genome, &echec);
+    relier_etapes(graphe, recherche_gene, lecture_gene, &echec);
+    // Étapes qui peuvent afficher (écriture du génome aléatoire, annotation, masque, en-tête) : terminées avant la
+    // section de la recherche du gène, pour ne pas s'y intercaler
+    relier_etapes(graphe, recherche_gene, ecriture, &echec);
+    relier_etapes(graphe, recherche_gene, annotation, &echec);
+    relier_etapes(graphe, recherche_gene, masque, &echec);
+    relier_etapes(graphe, recherche_gene, entete, &echec);
+    relier_etapes(graphe, consensus, recherche_gene, &echec);
+    relier_etapes(graphe, masque, lecture_genome, &echec);
+    relier_etapes(graphe, motifs, consensus, &echec);
+    relier_etapes(graphe, motifs, generation, &echec);
+    if (sortie.dossier_cache == NULL) {
+        // Sans cache, les deux tables des suffixes servent toujours : construites dès que leur génome est prêt
+        int index_reel = ajouter_etape(graphe, "index du génome", etape_index_reel, &analyse, &echec);
+        int index_aleatoire = ajouter_etape(graphe, "index aléatoire", etape_index_aleatoire, &analyse, &echec);
+        relier_etapes(graphe, index_reel, lecture_genome, &echec);
+        relier_etapes(graphe, index_aleatoire, generation, &echec);
+        relier_etapes(graphe, motifs, index_reel, &echec);
+        relier_etapes(graphe, motifs, index_aleatoire, &echec);
+    }
+    if (longueur_spectre > 0) {
+        int calcul_spectre = ajouter_etape(graphe, "spectre des k-mers", etape_spectre, &analyse, &echec);
+        int rapport_spectre = ajouter_etape(graphe, "k-mers surreprésentés", etape_rapport_spectre, &analyse, &echec);
+        relier_etapes(graphe, calcul_spectre, lecture_genome, &echec);
+        relier_etapes(graphe, rapport_spectre, calcul_spectre, &echec);
+        relier_etapes(graphe, rapport_spectre, motifs, &echec);
+    }
+
+    // Avec --threads 1, les étapes s'exécutent l'une après l'autre, dans l'ordre de leur ajout
+    int resultat = -1;
+    if (echec) printf("Erreur d'allocation mémoire pour le graphe des étapes\n");
+    else resultat = executer_graphe_taches(graphe, nombre_threads > 1 ? TACHES_SIMULTANEES : 1);
+    if (resultat == 0) {
+        printf("\n");
+        afficher_bilan_taches(graphe);
+        printf("\nProgramme terminé avec succès.\n");
+    }
+
+    // Libération de la mémoire
+    liberer_graphe_taches(graphe);
+    liberer_spectre_kmers(analyse.spectre);
+    liberer_index_suffixes(analyse.index_reel);
+    liberer_index_suffixes(analyse.index_aleatoire);
+    free(analyse.entete_genome);
+    liberer_annotation_genes(analyse.annotation);
+    liberer_masque_exclusion(analyse.masque);
+    free(analyse.sequence_reelle);
+    free(analyse.sequence_alea);
+    free(analyse.sequence_gene);
+    detruire_pool_threads(pool);
+    if (resultat != 0) return 1;
+
+    // Une divergence relevée par --verifier fait échouer l'exécution
+    return bilan_verification.divergences > 0 ? 1 : 0;
 }
@@ -0,0 +1,247 @@
+// masque_exclusion.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "projet.h"
+
+MasqueExclusion* creer_masque_exclusion(int longueur_genome) {
+    MasqueExclusion *masque = calloc(1, sizeof(MasqueExclusion));
+    if (masque == NULL) return NULL;
+    masque->longueur_genome = longueur_genome;
+    masque->bits = calloc((size_t)longueur_genome / 64 + 1, sizeof(uint64_t));
+    if (masque->bits == NULL) {
+        free(masque);
+        return NULL;
+    }
+    return masque;
+}
+
+void liberer_masque_exclusion(MasqueExclusion *masque) {
+    if (masque == NULL) return;
+    free(masque->bits);
+    free(masque->debuts);
+    free(masque->fins);
+    free(masque);
+}
+
+// Met à 1 les bits de [debut, fin) mot par mot
+static void marquer_bits(uint64_t *bits, int debut, int fin) {
+    while (debut < fin) {
+        int mot = debut >> 6;
+        int decalage = debut & 63;
+        int nombre = 64 - decalage < fin - debut ? 64 - decalage : fin - debut;
+        uint64_t plage = nombre == 64 ? ~(uint64_t)0 : (((uint64_t)1 << nombre) - 1) << decalage;
+        bits[mot] |= plage;
+        debut += nombre;
+    }
+}
+
+int ajouter_intervalle_masque(MasqueExclusion *masque, int debut, int fin) {
+    if (debut < 0) debut = 0;
+    if (fin > masque->longueur_genome) fin = masque->longueur_genome;
+    if (debut >= fin) return 0;
+
+    marquer_bits(masque->bits, debut, fin);
+
+    // Insertion dans la liste triée des intervalles, fusionnés avec ceux qu'ils chevauchent ou touchent
+    int bas = 0, haut = masque->nombre_intervalles;
+    while (bas < haut) {
+        int milieu = bas + (haut - bas) / 2;
+        if (masque->fins[milieu] < debut) bas = milieu + 1;
+        else haut = milieu;
+    }
+    int premier = bas;  // Premier intervalle se terminant à partir de `debut`
+    int dernier = premier;
+    while (dernier < masque->nombre_intervalles && masque->debuts[dernier] <= fin) {
+        if (masque->debuts[dernier] < debut) debut = masque->debuts[dernier];
+        if (masque->fins[dernier] > fin) fin = masque->fins[dernier];
+        dernier++;
+    }
+
+    int fusionnes = dernier - premier;
+    if (fusionnes == 0 && masque->nombre_intervalles == masque->capacite) {
+        int capacite = masque->capacite == 0 ? 16 : masque->capacite * 2;
+        int *debuts = realloc(masque->debuts, capacite * sizeof(int));
+        if (debuts == NULL) return -1;
+        masque->debuts = debuts;
+        int *fins = realloc(masque->fins, capacite * sizeof(int));
+        if (fins == NULL) return -1;
+        masque->fins = fins;
+        masque->capacite = capacite;
+    }
+    // Remplace les `fusionnes` intervalles [premier, dernier) par un seul
+    int restants = masque->nombre_intervalles - dernier;
+    int decalage = 1 - fusionnes;
+    memmove(masque->debuts + dernier + decalage, masque->debuts + dernier, restants * sizeof(int));
+    memmove(masque->fins + dernier + decalage, masque->fins + dernier, restants * sizeof(int));
+    masque->debuts[premier] = debut;
+    masque->fins[premier] = fin;
+    masque->nombre_intervalles += decalage;
+    return 0;
+}
+
+bool position_masquee(const MasqueExclusion *masque, int position) {
+    if (masque == NULL || position < 0 || position >= masque->longueur_genome) return false;
+    return (masque->bits[position >> 6] >> (position & 63)) & 1;
+}
+
+int fin_intervalle_masque(const MasqueExclusion *masque, int position) {
+    int bas = 0, haut = masque->nombre_intervalles;
+    while (bas < haut) {
+        int milieu = bas + (haut - bas) / 2;
+        if (masque->fins[milieu] <= position) bas = milieu + 1;
+        else haut = milieu;
+    }
+    if (bas < masque->nombre_intervalles && masque->debuts[bas] <= position) return masque->fins[bas];
+    return position;
+}
+
+int charger_masque_exclusion(MasqueExclusion *masque, const char *chemin_fichier) {
+    FILE *fichier = fopen(chemin_fichier, "r");
+    if (fichier == NULL) {
+        perror("Erreur lors de l'ouverture du fichier de masque");
+        return -1;
+    }
+    char *ligne = NULL;
+    size_t taille_ligne = 0;
+    int nombre = 0;
+    while (getline(&ligne, &taille_ligne, fichier) != -1) {
+        if (ligne[0] == '#' || strncmp(ligne, "track", 5) == 0 || strncmp(ligne, "browser", 7) == 0) continue;
+
+        // BED (chromosome, début, fin, ...) ou simplement (début, fin) : positions 0-indexées, fin exclue
+        char *champs[3];
+        int nombre_champs = 0;
+        for (char *p = strtok(ligne, " \t\r\n"); p != NULL && nombre_champs < 3; p = strtok(NULL, " \t\r\n")) {
+            champs[nombre_champs++] = p;
+        }
+        if (nombre_champs < 2) continue;
+        int premier = isdigit((unsigned char)champs[0][0]) ? 0 : 1;
+        if (premier + 1 >= nombre_champs || !isdigit((unsigned char)champs[premier][0])) continue;
+
+        if (ajouter_intervalle_masque(masque, atoi(champs[premier]), atoi(champs[premier + 1])) != 0) {
+            printf("Erreur d'allocation mémoire\n");
+            break;
+        }
+        nombre++;
+    }
+    free(ligne);
+    fclose(fichier);
+    return nombre;
+}
+
+int64_t bases_masquees(const MasqueExclusion *masque) {
+    int64_t total = 0;
+    for (int i = 0; i < masque->nombre_intervalles; i++) total += masque->fins[i] - masque->debuts[i];
+    return total;
+}
+
+bool chevauche_masque(const MasqueExclusion *masque, int debut, int fin) {
+    if (masque == NULL || masque->nombre_intervalles == 0) return false;
+    // Premier intervalle se terminant après `debut` : le seul candidat au chevauchement
+    int bas = 0, haut = masque->nombre_intervalles;
+    while (bas < haut) {
+        int milieu = bas + (haut - bas) / 2;
+        if (masque->fins[milieu] <= debut) bas = milieu + 1;
+        else haut = milieu;
+    }
+    return bas < masque->nombre_intervalles && masque->debuts[bas] < fin;
+}
+
+// Ajoute au masque chaque plage de bits à 1 d'un bitset, dans l'ordre croissant (insertions en fin de liste)
+static int ajouter_plages_bits(MasqueExclusion *masque, const uint64_t *bits) {
+    int nombre_mots = masque->longueur_genome / 64 + 1;
+    int debut = -1;
+    for (int mot = 0; mot < nombre_mots; mot++) {
+        if (bits[mot] == 0 && debut < 0) continue;
+        if (bits[mot] == ~(uint64_t)0 && debut >= 0) continue;
+        for (int b = 0; b < 64; b++) {
+            int position = mot * 64 + b;
+            bool masquee = (bits[mot] >> b) & 1;
+            if (masquee && debut < 0) {
+                debut = position;
+            } else if (!masquee && debut >= 0) {
+                if (ajouter_intervalle_masque(masque, debut, position) != 0) return -1;
+                debut = -1;
+            }
+        }
+    }
+    if (debut >= 0 && ajouter_intervalle_masque(masque, debut, masque->longueur_genome) != 0) return -1;
+    return 0;
+}
+
+static int code_base(char nucleotide) {
+    switch (nucleotide) {
+        case 'C': return 1;
+        case 'G': return 2;
+        case 'T': return 3;
+        default: return 0;
+    }
+}
+
+int masquer_faible_complexite(MasqueExclusion *masque, const char *sequence, int longueur, int fenetre, int seuil) {
+    if (fenetre < 4 || longueur < fenetre) return 0;
+    if (longueur > masque->longueur_genome) longueur = masque->longueur_genome;
+
+    // Score DUST d'une fenêtre : somme des c(c-1)/2 sur ses triplets, divisée par (triplets - 1) ;
+    // la somme est tenue à jour à chaque glissement (un triplet sort, un autre entre)
+    int triplets = fenetre - 2;
+    int64_t seuil_somme = (int64_t)seuil * (triplets - 1);
+    int comptes[64] = {0};
+    int64_t somme = 0;
+    int code = 0;
+    int debut_plage = -1, fin_plage = -1;
+    for (int i = 0; i < longueur; i++) {
+        code = ((code << 2) | code_base(sequence[i])) & 63;
+        if (i < 2) continue;
+        somme += comptes[code]++;  // Le triplet finissant en i entre dans la fenêtre
+        int debut = i - fenetre + 1;
+        if (debut < 0) continue;
+        if (somme > seuil_somme) {
+            // Fenêtres masquées consécutives ou chevauchantes : une seule plage
+            if (debut_plage >= 0 && debut <= fin_plage) {
+                fin_plage = debut + fenetre;
+            } else {
+                if (debut_plage >= 0 && ajouter_intervalle_masque(masque, debut_plage, fin_plage) != 0) return -1;
+                debut_plage = debut;
+                fin_plage = debut + fenetre;
+            }
+        }
+        // Le premier triplet de la fenêtre en sort avant le prochain glissement
+        int sortant = (code_base(sequence[debut]) << 4) | (code_base(sequence[debut + 1]) << 2) |
+                      code_base(sequence[debut + 2]);
+        somme -= --comptes[sortant];
+    }
+    if (debut_plage >= 0 && ajouter_intervalle_masque(masque, debut_plage, fin_plage) != 0) return -1;
+    return 0;
+}
+
+int masquer_kmers_frequents(MasqueExclusion *masque, const IndexSuffixes *index, int longueur_kmer, int copies_max) {
+    int n = index->longueur_genome < masque->longueur_genome ? index->longueur_genome : masque->longueur_genome;
+    uint64_t *bits = calloc((size_t)masque->longueur_genome / 64 + 1, sizeof(uint64_t));
+    if (bits == NULL) return -1;
+
+    // Les copies d'un même k-mer sont contiguës dans la table des suffixes
+    int debut = 0;
+    while (debut < index->longueur_genome) {
+        int p = index->suffixes[debut];
+        int fin = debut + 1;
+        if (p + longueur_kmer <= index->longueur_genome) {
+            while (fin < index->longueur_genome && index->suffixes[fin] + longueur_kmer <= index->longueur_genome &&
+                   memcmp(index->genome + p, index->genome + index->suffixes[fin], longueur_kmer) == 0) {
+                fin++;
+            }
+            if (fin - debut > copies_max) {
+                for (int j = debut; j < fin; j++) {
+                    int q = index->suffixes[j];
+                    marquer_bits(bits, q, q + longueur_kmer < n ? q + longueur_kmer : n);
+                }
+            }
+        }
+        debut = fin;
+    }
+
+    int resultat = ajouter_plages_bits(masque, bits);
+    free(bits);
+    return resultat;
+}
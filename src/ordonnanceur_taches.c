@@ -0,0 +1,244 @@
+// ordonnanceur_taches.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "projet.h"
+
+typedef struct {
+    const char *nom;
+    FonctionTache fonction;
+    void *contexte;
+    int *successeurs;
+    int nombre_successeurs;
+    int capacite_successeurs;
+    int nombre_prerequis;
+    int prerequis_restants;        // Prérequis pas encore terminés pendant l'exécution
+    EtatTache etat;
+    double debut;                  // Secondes depuis le lancement du graphe
+    double fin;
+} Tache;
+
+struct GrapheTaches {
+    Tache *taches;
+    int nombre;
+    int capacite;
+    int terminees;                 // Tâches réussies, échouées ou annulées
+    pthread_mutex_t verrou;
+    pthread_cond_t condition;
+    struct timespec lancement;
+};
+
+static double secondes_depuis(const struct timespec *origine) {
+    struct timespec maintenant;
+    clock_gettime(CLOCK_MONOTONIC, &maintenant);
+    return (double)(maintenant.tv_sec - origine->tv_sec) + (maintenant.tv_nsec - origine->tv_nsec) / 1e9;
+}
+
+GrapheTaches* creer_graphe_taches(void) {
+    GrapheTaches *graphe = calloc(1, sizeof(GrapheTaches));
+    if (graphe == NULL) return NULL;
+    pthread_mutex_init(&graphe->verrou, NULL);
+    pthread_cond_init(&graphe->condition, NULL);
+    return graphe;
+}
+
+void liberer_graphe_taches(GrapheTaches *graphe) {
+    if (graphe == NULL) return;
+    for (int t = 0; t < graphe->nombre; t++) free(graphe->taches[t].successeurs);
+    free(graphe->taches);
+    pthread_mutex_destroy(&graphe->verrou);
+    pthread_cond_destroy(&graphe->condition);
+    free(graphe);
+}
+
+int ajouter_tache(GrapheTaches *graphe, const char *nom, FonctionTache fonction, void *contexte) {
+    if (graphe->nombre == graphe->capacite) {
+        int capacite = graphe->capacite == 0 ? 16 : graphe->capacite * 2;
+        Tache *taches = realloc(graphe->taches, capacite * sizeof(Tache));
+        if (taches == NULL) return -1;
+        graphe->taches = taches;
+        graphe->capacite = capacite;
+    }
+    Tache tache = {nom, fonction, contexte, NULL, 0, 0, 0, 0, TACHE_EN_ATTENTE, 0, 0};
+    graphe->taches[graphe->nombre] = tache;
+    return graphe->nombre++;
+}
+
+int ajouter_dependance(GrapheTaches *graphe, int tache, int prerequis) {
+    if (tache < 0 || tache >= graphe->nombre || prerequis < 0 || prerequis >= graphe->nombre) return -1;
+    Tache *amont = &graphe->taches[prerequis];
+    if (amont->nombre_successeurs == amont->capacite_successeurs) {
+        int capacite = amont->capacite_successeurs == 0 ? 4 : amont->capacite_successeurs * 2;
+        int *successeurs = realloc(amont->successeurs, capacite * sizeof(int));
+        if (successeurs == NULL) return -1;
+        amont->successeurs = successeurs;
+        amont->capacite_successeurs = capacite;
+    }
+    amont->successeurs[amont->nombre_successeurs++] = tache;
+    graphe->taches[tache].nombre_prerequis++;
+    return 0;
+}
+
+// Parcours de Kahn : le graphe est exécutable si toutes les tâches finissent par être prêtes
+static bool graphe_acyclique(const GrapheTaches *graphe) {
+    int *restants = malloc((graphe->nombre > 0 ? graphe->nombre : 1) * sizeof(int));
+    int *pile = malloc((graphe->nombre > 0 ? graphe->nombre : 1) * sizeof(int));
+    if (restants == NULL || pile == NULL) {
+        free(restants);
+        free(pile);
+        return false;
+    }
+    int sommet = 0, vues = 0;
+    for (int t = 0; t < graphe->nombre; t++) {
+        restants[t] = graphe->taches[t].nombre_prerequis;
+        if (restants[t] == 0) pile[sommet++] = t;
+    }
+    while (sommet > 0) {
+        const Tache *tache = &graphe->taches[pile[--sommet]];
+        vues++;
+        for (int s = 0; s < tache->nombre_successeurs; s++) {
+            if (--restants[tache->successeurs[s]] == 0) pile[sommet++] = tache->successeurs[s];
+        }
+    }
+    free(restants);
+    free(pile);
+    return vues == graphe->nombre;
+}
+
+// Annule une tâche en attente et, par transitivité, tout ce qui en dépend (verrou tenu)
+static void annuler_tache(GrapheTaches *graphe, int indice) {
+    Tache *tache = &graphe->taches[indice];
+    if (tache->etat != TACHE_EN_ATTENTE) return;
+    tache->etat = TACHE_ANNULEE;
+    graphe->terminees++;
+    for (int s = 0; s < tache->nombre_successeurs; s++) annuler_tache(graphe, tache->successeurs[s]);
+}
+
+static void* executer_taches(void *argument) {
+    GrapheTaches *graphe = argument;
+    pthread_mutex_lock(&graphe->verrou);
+    for (;;) {
+        // Tâche prête de plus petit indice : avec un seul thread, l'ordre est celui de la déclaration
+        int indice = -1;
+        for (int t = 0; t < graphe->nombre && indice < 0; t++) {
+            if (graphe->taches[t].etat == TACHE_EN_ATTENTE && graphe->taches[t].prerequis_restants == 0) indice = t;
+        }
+        if (indice < 0) {
+            if (graphe->terminees == graphe->nombre) break;
+            pthread_cond_wait(&graphe->condition, &graphe->verrou);
+            continue;
+        }
+        Tache *tache = &graphe->taches[indice];
+        tache->etat = TACHE_EN_COURS;
+        tache->debut = secondes_depuis(&graphe->lancement);
+        pthread_mutex_unlock(&graphe->verrou);
+
+        int resultat = tache->fonction(tache->contexte);
+
+        pthread_mutex_lock(&graphe->verrou);
+        tache->fin = secondes_depuis(&graphe->lancement);
+        tache->etat = resultat == 0 ? TACHE_REUSSIE : TACHE_ECHOUEE;
+        graphe->terminees++;
+        for (int s = 0; s < tache->nombre_successeurs; s++) {
+            if (resultat == 0) graphe->taches[tache->successeurs[s]].prerequis_restants--;
+            else annuler_tache(graphe, tache->successeurs[s]);
+        }
+        pthread_cond_broadcast(&graphe->condition);
+    }
+    pthread_mutex_unlock(&graphe->verrou);
+    return NULL;
+}
+
+int executer_graphe_taches(GrapheTaches *graphe, int nombre_threads) {
+    if (!graphe_acyclique(graphe)) {
+        printf("Erreur : les dépendances entre étapes forment un cycle\n");
+        return -1;
+    }
+    for (int t = 0; t < graphe->nombre; t++) {
+        graphe->taches[t].etat = TACHE_EN_ATTENTE;
+        graphe->taches[t].prerequis_restants = graphe->taches[t].nombre_prerequis;
+    }
+    graphe->terminees = 0;
+    clock_gettime(CLOCK_MONOTONIC, &graphe->lancement);
+
+    // Le thread appelant exécute lui aussi des tâches
+    if (nombre_threads < 1) nombre_threads = 1;
+    if (nombre_threads > graphe->nombre) nombre_threads = graphe->nombre > 0 ? graphe->nombre : 1;
+    pthread_t *threads = malloc((nombre_threads - 1 > 0 ? nombre_threads - 1 : 1) * sizeof(pthread_t));
+    int lances = 0;
+    while (threads != NULL && lances < nombre_threads - 1 &&
+           pthread_create(&threads[lances], NULL, executer_taches, graphe) == 0) {
+        lances++;
+    }
+    executer_taches(graphe);
+    for (int i = 0; i < lances; i++) pthread_join(threads[i], NULL);
+    free(threads);
+
+    for (int t = 0; t < graphe->nombre; t++) {
+        if (graphe->taches[t].etat != TACHE_REUSSIE) return -1;
+    }
+    return 0;
+}
+
+EtatTache etat_tache(const GrapheTaches *graphe, int tache) {
+    return graphe->taches[tache].etat;
+}
+
+double duree_tache(const GrapheTaches *graphe, int tache) {
+    const Tache *t = &graphe->taches[tache];
+    return t->etat == TACHE_REUSSIE || t->etat == TACHE_ECHOUEE ? t->fin - t->debut : 0;
+}
+
+double duree_chemin_critique(const GrapheTaches *graphe) {
+    // Les indices ne suivent pas forcément l'ordre topologique : relaxation jusqu'à stabilité (graphe acyclique)
+    double *fin_au_plus_tot = calloc(graphe->nombre > 0 ? graphe->nombre : 1, sizeof(double));
+    if (fin_au_plus_tot == NULL) return 0;
+    for (int t = 0; t < graphe->nombre; t++) fin_au_plus_tot[t] = duree_tache(graphe, t);
+    bool modifie = true;
+    for (int passe = 0; passe < graphe->nombre && modifie; passe++) {
+        modifie = false;
+        for (int t = 0; t < graphe->nombre; t++) {
+            const Tache *tache = &graphe->taches[t];
+            for (int s = 0; s < tache->nombre_successeurs; s++) {
+                int suivante = tache->successeurs[s];
+                double fin = fin_au_plus_tot[t] + duree_tache(graphe, suivante);
+                if (fin > fin_au_plus_tot[suivante]) {
+                    fin_au_plus_tot[suivante] = fin;
+                    modifie = true;
+                }
+            }
+        }
+    }
+    double critique = 0;
+    for (int t = 0; t < graphe->nombre; t++) {
+        if (fin_au_plus_tot[t] > critique) critique = fin_au_plus_tot[t];
+    }
+    free(fin_au_plus_tot);
+    return critique;
+}
+
+// Nombre de caractères affichés d'une chaîne UTF-8 (octets de continuation exclus), pour aligner les colonnes
+static int largeur_affichee(const char *texte) {
+    int largeur = 0;
+    for (const unsigned char *c = (const unsigned char*)texte; *c != '\0'; c++) largeur += (*c & 0xC0) != 0x80;
+    return largeur;
+}
+
+void afficher_bilan_taches(const GrapheTaches *graphe) {
+    double somme = 0, fin = 0;
+    for (int t = 0; t < graphe->nombre; t++) {
+        somme += duree_tache(graphe, t);
+        if (graphe->taches[t].fin > fin) fin = graphe->taches[t].fin;
+    }
+    printf("%d étapes en %.2f s (%.2f s cumulées, plus longue chaîne de dépendances : %.2f s)\n", graphe->nombre, fin,
+           somme, duree_chemin_critique(graphe));
+    for (int t = 0; t < graphe->nombre; t++) {
+        const Tache *tache = &graphe->taches[t];
+        const char *etats[] = {"en attente", "en cours", "réussie", "échouée", "annulée"};
+        int marge_nom = 24 - largeur_affichee(tache->nom), marge_etat = 12 - largeur_affichee(etats[tache->etat]);
+        printf("  %s%*s%s%*s%6.2f s -> %6.2f s\n", tache->nom, marge_nom > 1 ? marge_nom : 1, "", etats[tache->etat],
+               marge_etat > 1 ? marge_etat : 1, "", tache->debut, tache->etat == TACHE_ANNULEE ? tache->debut : tache->fin);
+    }
+}
@@ -0,0 +1,163 @@
+// pool_threads.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "projet.h"
+
+struct PoolThreads {
+    int nombre_threads;            // Threads participant aux calculs, dont celui qui soumet la tâche
+    pthread_t *travailleurs;       // nombre_threads - 1 threads permanents
+    pthread_mutex_t soumission;    // Une seule boucle parallèle à la fois
+    pthread_mutex_t verrou;
+    pthread_cond_t travail_disponible;
+    pthread_cond_t travail_termine;
+    int arret;
+
+    // Boucle en cours
+    FonctionBloc fonction;
+    void *contexte;
+    int64_t debut, fin, taille_bloc, chevauchement;
+    int64_t nombre_blocs;
+    int64_t prochain_bloc;         // Prochain bloc à distribuer
+    int64_t blocs_termines;
+};
+
+static PoolThreads *pool_courant = NULL;
+static _Thread_local int dans_tache = 0;  // Une boucle lancée depuis un bloc s'exécute dans le thread courant
+
+int64_t nombre_blocs_parallele(int64_t debut, int64_t fin, int64_t taille_bloc) {
+    if (fin <= debut || taille_bloc < 1) return 0;
+    return (fin - debut + taille_bloc - 1) / taille_bloc;
+}
+
+static void executer_bloc(FonctionBloc fonction, void *contexte, int64_t debut, int64_t fin, int64_t taille_bloc,
+                          int64_t chevauchement, int64_t indice) {
+    BlocParallele bloc;
+    bloc.indice = indice;
+    bloc.debut = debut + indice * taille_bloc;
+    bloc.fin = bloc.debut + taille_bloc < fin ? bloc.debut + taille_bloc : fin;
+    bloc.fin_lecture = bloc.fin + chevauchement;
+    dans_tache = 1;
+    fonction(&bloc, contexte);
+    dans_tache = 0;
+}
+
+// Prend et exécute des blocs de la boucle en cours tant qu'il en reste ; appelé verrou pris
+static void traiter_blocs(PoolThreads *pool) {
+    while (pool->prochain_bloc < pool->nombre_blocs) {
+        int64_t indice = pool->prochain_bloc++;
+        pthread_mutex_unlock(&pool->verrou);
+        executer_bloc(pool->fonction, pool->contexte, pool->debut, pool->fin, pool->taille_bloc,
+                      pool->chevauchement, indice);
+        pthread_mutex_lock(&pool->verrou);
+        if (++pool->blocs_termines == pool->nombre_blocs) pthread_cond_broadcast(&pool->travail_termine);
+    }
+}
+
+static void* boucle_travailleur(void *argument) {
+    PoolThreads *pool = argument;
+    pthread_mutex_lock(&pool->verrou);
+    while (!pool->arret) {
+        if (pool->prochain_bloc < pool->nombre_blocs) traiter_blocs(pool);
+        else pthread_cond_wait(&pool->travail_disponible, &pool->verrou);
+    }
+    pthread_mutex_unlock(&pool->verrou);
+    return NULL;
+}
+
+PoolThreads* creer_pool_threads(int nombre_threads) {
+    PoolThreads *pool = calloc(1, sizeof(PoolThreads));
+    if (pool == NULL) return NULL;
+    pool->nombre_threads = nombre_threads < 1 ? 1 : nombre_threads;
+    pthread_mutex_init(&pool->soumission, NULL);
+    pthread_mutex_init(&pool->verrou, NULL);
+    pthread_cond_init(&pool->travail_disponible, NULL);
+    pthread_cond_init(&pool->travail_termine, NULL);
+
+    pool->travailleurs = malloc(pool->nombre_threads * sizeof(pthread_t));
+    if (pool->travailleurs == NULL) {
+        detruire_pool_threads(pool);
+        return NULL;
+    }
+    int lances = 1;
+    while (lances < pool->nombre_threads &&
+           pthread_create(&pool->travailleurs[lances - 1], NULL, boucle_travailleur, pool) == 0) {
+        lances++;
+    }
+    // Faute de pouvoir lancer tous les threads, le pool travaille avec ceux qui l'ont été
+    pool->nombre_threads = lances;
+    return pool;
+}
+
+void detruire_pool_threads(PoolThreads *pool) {
+    if (pool == NULL) return;
+    pthread_mutex_lock(&pool->verrou);
+    pool->arret = 1;
+    pthread_cond_broadcast(&pool->travail_disponible);
+    pthread_mutex_unlock(&pool->verrou);
+    for (int t = 0; pool->travailleurs != NULL && t < pool->nombre_threads - 1; t++) {
+        pthread_join(pool->travailleurs[t], NULL);
+    }
+    if (pool_courant == pool) pool_courant = NULL;
+    free(pool->travailleurs);
+    pthread_mutex_destroy(&pool->soumission);
+    pthread_mutex_destroy(&pool->verrou);
+    pthread_cond_destroy(&pool->travail_disponible);
+    pthread_cond_destroy(&pool->travail_termine);
+    free(pool);
+}
+
+int nombre_threads_pool(const PoolThreads *pool) {
+    return pool == NULL ? 1 : pool->nombre_threads;
+}
+
+void pool_parallel_for(PoolThreads *pool, int64_t debut, int64_t fin, int64_t taille_bloc, int64_t chevauchement,
+                       FonctionBloc fonction, void *contexte) {
+    int64_t nombre_blocs = nombre_blocs_parallele(debut, fin, taille_bloc);
+    if (nombre_blocs == 0) return;
+
+    // Sans thread supplémentaire, ou depuis un bloc en cours : exécution dans l'ordre, dans le thread courant
+    if (pool == NULL || pool->nombre_threads == 1 || nombre_blocs == 1 || dans_tache) {
+        int imbrique = dans_tache;
+        for (int64_t b = 0; b < nombre_blocs; b++) {
+            executer_bloc(fonction, contexte, debut, fin, taille_bloc, chevauchement, b);
+        }
+        dans_tache = imbrique;
+        return;
+    }
+
+    pthread_mutex_lock(&pool->soumission);
+    pthread_mutex_lock(&pool->verrou);
+    pool->fonction = fonction;
+    pool->contexte = contexte;
+    pool->debut = debut;
+    pool->fin = fin;
+    pool->taille_bloc = taille_bloc;
+    pool->chevauchement = chevauchement;
+    pool->nombre_blocs = nombre_blocs;
+    pool->prochain_bloc = 0;
+    pool->blocs_termines = 0;
+    pthread_cond_broadcast(&pool->travail_disponible);
+
+    // Le thread appelant travaille aussi, puis attend les blocs encore en cours
+    traiter_blocs(pool);
+    while (pool->blocs_termines < pool->nombre_blocs) pthread_cond_wait(&pool->travail_termine, &pool->verrou);
+    pool->nombre_blocs = 0;
+    pool->prochain_bloc = 0;
+    pthread_mutex_unlock(&pool->verrou);
+    pthread_mutex_unlock(&pool->soumission);
+}
+
+void definir_pool_global(PoolThreads *pool) {
+    pool_courant = pool;
+}
+
+PoolThreads* pool_global(void) {
+    return pool_courant;
+}
+
+int nombre_coeurs_disponibles(void) {
+    long coeurs = sysconf(_SC_NPROCESSORS_ONLN);
+    return coeurs < 1 ? 1 : (int)coeurs;
+}
@@ -0,0 +1,203 @@
+// progression.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "projet.h"
+
+#define LARGEUR_BARRE_PROGRESSION 30 // Caractères de la barre de chaque compteur
+
+// Les threads de calcul n'écrivent que `fait`, sans verrou ; ouverture, fermeture et lecture passent par le verrou
+struct CompteurProgression {
+    bool actif;
+    char nom[LONGUEUR_NOM_PROGRESSION];
+    int64_t total;
+    _Atomic int64_t fait;
+    struct timespec ouverture;
+};
+
+static CompteurProgression compteurs[COMPTEURS_PROGRESSION_MAX];
+static pthread_mutex_t verrou_compteurs = PTHREAD_MUTEX_INITIALIZER;
+
+// Rapporteur : un thread qui affiche les compteurs à intervalle fixe
+static struct {
+    pthread_mutex_t verrou;
+    pthread_cond_t condition;
+    pthread_t thread;
+    bool lance;
+    bool arret;
+    ModeProgression mode;
+    int periode_ms;
+    bool ligne_ouverte;            // Barre affichée sans retour à la ligne
+} rapporteur = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, 0, false, false, PROGRESSION_AUCUNE, 0, false};
+
+static double secondes_depuis(const struct timespec *origine) {
+    struct timespec maintenant;
+    clock_gettime(CLOCK_MONOTONIC, &maintenant);
+    return (double)(maintenant.tv_sec - origine->tv_sec) + (maintenant.tv_nsec - origine->tv_nsec) / 1e9;
+}
+
+CompteurProgression* ouvrir_compteur_progression(const char *nom, int64_t total) {
+    CompteurProgression *compteur = NULL;
+    pthread_mutex_lock(&verrou_compteurs);
+    for (int c = 0; c < COMPTEURS_PROGRESSION_MAX && compteur == NULL; c++) {
+        if (!compteurs[c].actif) compteur = &compteurs[c];
+    }
+    if (compteur != NULL) {
+        snprintf(compteur->nom, LONGUEUR_NOM_PROGRESSION, "%s", nom);
+        compteur->total = total > 0 ? total : 0;
+        atomic_store_explicit(&compteur->fait, 0, memory_order_relaxed);
+        clock_gettime(CLOCK_MONOTONIC, &compteur->ouverture);
+        compteur->actif = true;
+    }
+    pthread_mutex_unlock(&verrou_compteurs);
+    return compteur;
+}
+
+void avancer_progression(CompteurProgression *compteur, int64_t increment) {
+    // Sans compteur (tous les emplacements pris), la progression n'est simplement pas suivie
+    if (compteur != NULL) atomic_fetch_add_explicit(&compteur->fait, increment, memory_order_relaxed);
+}
+
+static EtatProgression etat_compteur(CompteurProgression *compteur) {
+    EtatProgression etat;
+    memcpy(etat.nom, compteur->nom, LONGUEUR_NOM_PROGRESSION);
+    etat.fait = atomic_load_explicit(&compteur->fait, memory_order_relaxed);
+    etat.total = compteur->total;
+    etat.duree = secondes_depuis(&compteur->ouverture);
+    return etat;
+}
+
+int lire_progression(EtatProgression *etats, int nombre_max) {
+    int nombre = 0;
+    pthread_mutex_lock(&verrou_compteurs);
+    for (int c = 0; c < COMPTEURS_PROGRESSION_MAX && nombre < nombre_max; c++) {
+        if (compteurs[c].actif) etats[nombre++] = etat_compteur(&compteurs[c]);
+    }
+    pthread_mutex_unlock(&verrou_compteurs);
+    return nombre;
+}
+
+int formater_progression(const EtatProgression *etats, int nombre, ModeProgression mode, char *destination,
+                         size_t taille) {
+    size_t ecrits = 0;
+    destination[0] = '\0';
+    for (int e = 0; e < nombre && ecrits < taille; e++) {
+        const EtatProgression *etat = &etats[e];
+        int pourcentage = etat->total > 0 ? (int)(100 * (etat->fait < etat->total ? etat->fait : etat->total) /
+                                                  etat->total) : 0;
+        if (mode == PROGRESSION_BARRE) {
+            char barre[LARGEUR_BARRE_PROGRESSION + 1];
+            int pleins = pourcentage * LARGEUR_BARRE_PROGRESSION / 100;
+            memset(barre, '=', pleins);
+            memset(barre + pleins, ' ', LARGEUR_BARRE_PROGRESSION - pleins);
+            barre[LARGEUR_BARRE_PROGRESSION] = '\0';
+            ecrits += snprintf(destination + ecrits, taille - ecrits, "%s%s [%s] %3d%%", e > 0 ? "  " : "",
+                               etat->nom, barre, pourcentage);
+        } else {
+            ecrits += snprintf(destination + ecrits, taille - ecrits, "%s%s : %lld/%lld (%d%%, %.1f s)",
+                               e > 0 ? " ; " : "", etat->nom, (long long)etat->fait, (long long)etat->total,
+                               pourcentage, etat->duree);
+        }
+    }
+    return ecrits < taille ? (int)ecrits : (int)taille - 1;
+}
+
+// Affiche une ligne pour les compteurs donnés (verrou du rapporteur tenu)
+static void afficher_etats(const EtatProgression *etats, int nombre, bool derniere) {
+    char ligne[512];
+    formater_progression(etats, nombre, rapporteur.mode, ligne, sizeof(ligne));
+    if (rapporteur.mode == PROGRESSION_BARRE) {
+        // Une seule écriture par rafraîchissement, qui efface la fin de la barre précédente
+        printf("\r%s\033[K%s", ligne, derniere ? "\n" : "");
+        rapporteur.ligne_ouverte = !derniere;
+    } else {
+        printf("Progression : %s\n", ligne);
+    }
+    fflush(stdout);
+}
+
+void fermer_compteur_progression(CompteurProgression *compteur) {
+    if (compteur == NULL) return;
+    pthread_mutex_lock(&rapporteur.verrou);
+    pthread_mutex_lock(&verrou_compteurs);
+    EtatProgression etat = etat_compteur(compteur);
+    compteur->actif = false;
+    pthread_mutex_unlock(&verrou_compteurs);
+    // La barre est terminée à 100 % et suivie d'un retour à la ligne : l'affichage suivant commence sur une ligne propre
+    if (rapporteur.lance && rapporteur.mode == PROGRESSION_BARRE && rapporteur.ligne_ouverte) {
+        afficher_etats(&etat, 1, true);
+    }
+    pthread_mutex_unlock(&rapporteur.verrou);
+}
+
+static void* executer_rapporteur(void *argument) {
+    (void)argument;
+    pthread_mutex_lock(&rapporteur.verrou);
+    while (!rapporteur.arret) {
+        struct timespec echeance;
+        clock_gettime(CLOCK_REALTIME, &echeance);
+        echeance.tv_sec += rapporteur.periode_ms / 1000;
+        echeance.tv_nsec += (long)(rapporteur.periode_ms % 1000) * 1000000;
+        if (echeance.tv_nsec >= 1000000000) {
+            echeance.tv_sec++;
+            echeance.tv_nsec -= 1000000000;
+        }
+        while (!rapporteur.arret && pthread_cond_timedwait(&rapporteur.condition, &rapporteur.verrou, &echeance) == 0) {
+        }
+        if (rapporteur.arret) break;
+        EtatProgression etats[COMPTEURS_PROGRESSION_MAX];
+        int nombre = lire_progression(etats, COMPTEURS_PROGRESSION_MAX);
+        if (nombre > 0) afficher_etats(etats, nombre, false);
+    }
+    pthread_mutex_unlock(&rapporteur.verrou);
+    return NULL;
+}
+
+int demarrer_rapporteur_progression(ModeProgression mode) {
+    if (mode == PROGRESSION_AUTO) mode = isatty(STDOUT_FILENO) ? PROGRESSION_BARRE : PROGRESSION_LIGNES;
+    int resultat = 0;
+    pthread_mutex_lock(&rapporteur.verrou);
+    if (!rapporteur.lance && mode != PROGRESSION_AUCUNE) {
+        rapporteur.mode = mode;
+        rapporteur.periode_ms = mode == PROGRESSION_BARRE ? PERIODE_BARRE_PROGRESSION_MS
+                                                          : PERIODE_LIGNES_PROGRESSION_MS;
+        rapporteur.arret = false;
+        rapporteur.ligne_ouverte = false;
+        // Le thread attend le verrou, relâché une fois `lance` à jour
+        rapporteur.lance = pthread_create(&rapporteur.thread, NULL, executer_rapporteur, NULL) == 0;
+        resultat = rapporteur.lance ? 0 : -1;
+    }
+    pthread_mutex_unlock(&rapporteur.verrou);
+    return resultat;
+}
+
+void arreter_rapporteur_progression(void) {
+    pthread_mutex_lock(&rapporteur.verrou);
+    if (!rapporteur.lance) {
+        pthread_mutex_unlock(&rapporteur.verrou);
+        return;
+    }
+    rapporteur.arret = true;
+    pthread_cond_signal(&rapporteur.condition);
+    pthread_mutex_unlock(&rapporteur.verrou);
+    pthread_join(rapporteur.thread, NULL);
+    pthread_mutex_lock(&rapporteur.verrou);
+    rapporteur.lance = false;
+    if (rapporteur.ligne_ouverte) {
+        printf("\n");
+        rapporteur.ligne_ouverte = false;
+    }
+    pthread_mutex_unlock(&rapporteur.verrou);
+}
+
+int mode_progression_depuis_nom(const char *nom, ModeProgression *mode) {
+    if (strcmp(nom, "barre") == 0) *mode = PROGRESSION_BARRE;
+    else if (strcmp(nom, "lignes") == 0) *mode = PROGRESSION_LIGNES;
+    else if (strcmp(nom, "aucune") == 0) *mode = PROGRESSION_AUCUNE;
+    else return -1;
+    return 0;
+}
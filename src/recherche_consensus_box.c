@@ -18,14 +18,17 @@ bool comparer_avec_marge_erreur(const char* sous_sequence, const char* sequence_
     return true;  // La séquence correspond avec au plus une erreur
 }
 
+// Affiche une paire trouvée, relative au génome complet
+static void afficher_paire_consensus(int64_t position_boite_35, int64_t position_boite_10, void *contexte) {
+    const char *sequence_genome = contexte;
+    printf("Boîte -35 trouvée à la position %d : %.6s\n", (int)position_boite_35, sequence_genome + position_boite_35);
+    printf("Boîte -10 trouvée à la position %d : %.6s\n", (int)position_boite_10, sequence_genome + position_boite_10);
+}
+
 // Fonction pour rechercher des boîtes consensus dans tout le génome ou en amont d'un gène
 // Si base_amont == 0 la recherche est faite sur tout le génome
 int rechercher_seq_consensus(const char* sequence_genome, const char* boite_35, const char* boite_10, int position_gene, int bases_amont) {
     int longueur_genome = strlen(sequence_genome);
-    int longueur_boite_35 = strlen(boite_35);
-    int longueur_boite_10 = strlen(boite_10);
-    bool sequence_trouvee = false;
-    int compteur = 0;  // Initialisation du compteur
 
     // Limiter la recherche à une région en amont si `bases_amont` > 0
     int debut_recherche = 0;
@@ -36,48 +39,136 @@ int rechercher_seq_consensus(const char* sequence_genome, const char* boite_35,
         fin_recherche = position_gene;
     }
 
-    // Parcours de la séquence pour chercher les occurrences de la boîte -35
-    for (int i = debut_recherche; i <= fin_recherche - longueur_boite_35; i++) {
-        const char* sous_sequence_35 = sequence_genome + i;
+    // Boîtes -35 dans toute la région, puis boîte -10 à 15 à 19 nucléotides, sans dépasser la région
+    // (tolérance de 1 erreur par boîte) ; chaque paire est affichée dès qu'elle est trouvée
+    int compteur = (int)parcourir_paires_consensus(sequence_genome, debut_recherche, fin_recherche, fin_recherche,
+                                                   boite_35, boite_10, afficher_paire_consensus,
+                                                   (void*)sequence_genome);
+
+    // Si aucune séquence consensus n'a été trouvée, retourne -1
+    if (compteur == 0) {
+        printf("Séquence consensus non trouvée\n");
+        return -1;
+    }
 
-        // Si une boîte -35 est trouvée (tolérance de 1 erreur)
-        if (comparer_avec_marge_erreur(sous_sequence_35, boite_35, longueur_boite_35)) {
+    // Si une ou plusieurs séquences ont été trouvées, retourne le nombre de séquences consensus trouvées
+    printf("Nombre de séquences consensus trouvées : %d\n", compteur);
+    return compteur;
+}
 
-            // Recherche de la boîte -10 avec une distance de 15 à 19 nucléotides
-            for (int distance = 15; distance <= 19; distance++) {
-                int position_boite_10 = i + longueur_boite_35 + distance;
+typedef struct {
+    int *positions;
+    int nombre;
+    int nombre_max;
+} ListePairesConsensus;
 
-                // Vérifie que la boîte -10 ne dépasse pas la longueur du génome
-                if (position_boite_10 + longueur_boite_10 > fin_recherche) {
-                    continue;  // Ignore cette itération si la boîte -10 est hors limites
-                }
+static void ranger_paire_consensus(int64_t position_boite_35, int64_t position_boite_10, void *contexte) {
+    ListePairesConsensus *liste = contexte;
+    if (liste->nombre < liste->nombre_max) {
+        liste->positions[2 * liste->nombre] = (int)position_boite_35;
+        liste->positions[2 * liste->nombre + 1] = (int)position_boite_10;
+    }
+    liste->nombre++;
+}
 
-                const char* sous_sequence_10 = sequence_genome + position_boite_10;
+int lister_paires_consensus(const char* sequence_genome, int debut, int fin, const char* boite_35,
+                            const char* boite_10, int *positions, int nombre_max) {
+    // Mêmes règles que rechercher_seq_consensus : boîte -10 de 15 à 19 bases après la -35, dans [debut, fin)
+    ListePairesConsensus liste = {positions, 0, nombre_max};
+    parcourir_paires_consensus(sequence_genome, debut, fin, fin, boite_35, boite_10, ranger_paire_consensus, &liste);
+    return liste.nombre;
+}
 
-                // Si une boîte -10 est trouvée (tolérance de 1 erreur)
-                if (comparer_avec_marge_erreur(sous_sequence_10, boite_10, longueur_boite_10)) {
-                    sequence_trouvee = true;  // Une séquence valide a été trouvée
-                    compteur++;  // Incrémenter le compteur pour chaque correspondance trouvée
+// Paires de boîtes (-35, -10) trouvées dans un bloc, dans l'ordre du parcours séquentiel
+typedef struct {
+    int *positions;                // Positions des boîtes -35 et -10, deux à deux
+    int nombre;
+    int capacite;
+    int erreur;
+} PairesBoitesBloc;
 
-                    // Ajuster les positions pour les rendre relatives au génome complet
-                    int position_boite_35_absolue = i;
-                    int position_boite_10_absolue = position_boite_10;
+typedef struct {
+    const char *sequence_genome;
+    const char *boite_35;
+    const char *boite_10;
+    int fin_recherche;
+    PairesBoitesBloc *blocs;
+} RechercheConsensusParallele;
 
-                    // Afficher les séquences et les positions trouvées
-                    printf("Boîte -35 trouvée à la position %d : %.6s\n", position_boite_35_absolue, sous_sequence_35);
-                    printf("Boîte -10 trouvée à la position %d : %.6s\n", position_boite_10_absolue, sous_sequence_10);
-                }
-            }
+static void ajouter_paire_bloc(int64_t position_boite_35, int64_t position_boite_10, void *contexte) {
+    PairesBoitesBloc *paires = contexte;
+    if (paires->erreur) return;
+    if (paires->nombre == paires->capacite) {
+        int capacite = paires->capacite == 0 ? 16 : paires->capacite * 2;
+        int *p = realloc(paires->positions, 2 * capacite * sizeof(int));
+        if (p == NULL) {
+            paires->erreur = 1;
+            return;
         }
+        paires->positions = p;
+        paires->capacite = capacite;
     }
+    paires->positions[2 * paires->nombre] = (int)position_boite_35;
+    paires->positions[2 * paires->nombre + 1] = (int)position_boite_10;
+    paires->nombre++;
+}
 
-    // Si aucune séquence consensus n'a été trouvée, retourne -1
-    if (!sequence_trouvee) {
-        printf("Séquence consensus non trouvée\n");
+static void rechercher_consensus_bloc(const BlocParallele *bloc, void *contexte) {
+    RechercheConsensusParallele *recherche = contexte;
+    // Seules les boîtes -35 commencent dans le bloc ; les boîtes -10 peuvent le déborder
+    parcourir_paires_consensus(recherche->sequence_genome, bloc->debut, bloc->fin, recherche->fin_recherche,
+                               recherche->boite_35, recherche->boite_10, ajouter_paire_bloc,
+                               &recherche->blocs[bloc->indice]);
+}
+
+int rechercher_seq_consensus_parallele(const char* sequence_genome, const char* boite_35, const char* boite_10,
+                                       int position_gene, int bases_amont) {
+    int longueur_genome = strlen(sequence_genome);
+    int longueur_boite_35 = strlen(boite_35);
+
+    // Mêmes bornes que rechercher_seq_consensus
+    int debut_recherche = 0;
+    int fin_recherche = longueur_genome;
+    if (bases_amont > 0) {
+        debut_recherche = (position_gene > bases_amont) ? position_gene - bases_amont : 0;
+        fin_recherche = position_gene;
+    }
+
+    int64_t fin_boucle = fin_recherche - longueur_boite_35 + 1;
+    int64_t nombre_blocs = nombre_blocs_parallele(debut_recherche, fin_boucle, TAILLE_BLOC_PARALLELE);
+    PairesBoitesBloc *blocs = calloc(nombre_blocs > 0 ? nombre_blocs : 1, sizeof(PairesBoitesBloc));
+    if (blocs == NULL) {
+        printf("Erreur d'allocation mémoire\n");
         return -1;
     }
+    RechercheConsensusParallele recherche = {sequence_genome, boite_35, boite_10, fin_recherche, blocs};
+    pool_parallel_for(pool_global(), debut_recherche, fin_boucle, TAILLE_BLOC_PARALLELE,
+                      longueur_boite_35 + ESPACEMENT_MAX_CONSENSUS + strlen(boite_10), rechercher_consensus_bloc, &recherche);
 
-    // Si une ou plusieurs séquences ont été trouvées, retourne le nombre de séquences consensus trouvées
+    // Fusion dans l'ordre des blocs, avec les messages du parcours séquentiel
+    int compteur = 0;
+    int erreur = 0;
+    for (int64_t b = 0; b < nombre_blocs; b++) {
+        erreur |= blocs[b].erreur;
+        for (int p = 0; p < blocs[b].nombre; p++) {
+            int position_boite_35 = blocs[b].positions[2 * p];
+            int position_boite_10 = blocs[b].positions[2 * p + 1];
+            printf("Boîte -35 trouvée à la position %d : %.6s\n", position_boite_35, sequence_genome + position_boite_35);
+            printf("Boîte -10 trouvée à la position %d : %.6s\n", position_boite_10, sequence_genome + position_boite_10);
+            compteur++;
+        }
+        free(blocs[b].positions);
+    }
+    free(blocs);
+    if (erreur) {
+        printf("Erreur d'allocation mémoire\n");
+        return -1;
+    }
+
+    if (compteur == 0) {
+        printf("Séquence consensus non trouvée\n");
+        return -1;
+    }
     printf("Nombre de séquences consensus trouvées : %d\n", compteur);
     return compteur;
-}
\ No newline at end of file
+}
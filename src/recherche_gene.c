@@ -43,3 +43,96 @@ int rechercher_gene(const char* sequence_genome, const char* sequence_gene, doub
 
     return position_premiere_occurence;
 }
+
+// Copies du gène d'un bloc : toutes sont comptées, les `nombre_max` premières sont gardées
+typedef struct {
+    int nombre;
+    int *positions;
+    float *identites;
+} CopiesGeneBloc;
+
+typedef struct {
+    const char *sequence_genome;
+    const char *sequence_gene;
+    int longueur_gene;
+    double identite_min;
+    int nombre_max;
+    CopiesGeneBloc *blocs;
+    _Atomic int erreur;
+} RechercheGeneParallele;
+
+static void rechercher_gene_bloc(const BlocParallele *bloc, void *contexte) {
+    RechercheGeneParallele *recherche = contexte;
+    CopiesGeneBloc *copies = &recherche->blocs[bloc->indice];
+    for (int64_t i = bloc->debut; i < bloc->fin; i++) {
+        float identite = calculer_identite(recherche->sequence_genome + i, recherche->sequence_gene,
+                                           recherche->longueur_gene);
+        if (identite < recherche->identite_min) continue;
+        if (copies->nombre < recherche->nombre_max) {
+            // Tableaux alloués à la première copie : la plupart des blocs n'en ont aucune
+            if (copies->positions == NULL) {
+                copies->positions = malloc(recherche->nombre_max * sizeof(int));
+                copies->identites = malloc(recherche->nombre_max * sizeof(float));
+                if (copies->positions == NULL || copies->identites == NULL) {
+                    recherche->erreur = 1;
+                    return;
+                }
+            }
+            copies->positions[copies->nombre] = (int)i;
+            copies->identites[copies->nombre] = identite;
+        }
+        copies->nombre++;
+    }
+}
+
+int lister_copies_gene_parallele(const char* sequence_genome, const char* sequence_gene, double identite_min,
+                                 int *positions, float *identites, int nombre_max) {
+    int longueur_genome = strlen(sequence_genome);
+    int longueur_gene = strlen(sequence_gene);
+    if (longueur_gene == 0 || nombre_max < 0) return longueur_gene == 0 ? 0 : -1;
+    int64_t nombre_blocs = nombre_blocs_parallele(0, longueur_genome - longueur_gene + 1, TAILLE_BLOC_PARALLELE);
+    CopiesGeneBloc *blocs = calloc(nombre_blocs > 0 ? nombre_blocs : 1, sizeof(CopiesGeneBloc));
+    if (blocs == NULL) return -1;
+    RechercheGeneParallele recherche = {sequence_genome, sequence_gene, longueur_gene, identite_min, nombre_max,
+                                        blocs, 0};
+    pool_parallel_for(pool_global(), 0, longueur_genome - longueur_gene + 1, TAILLE_BLOC_PARALLELE,
+                      longueur_gene - 1, rechercher_gene_bloc, &recherche);
+
+    // Fusion dans l'ordre des blocs : les copies sortent par position croissante
+    int nombre = 0;
+    for (int64_t b = 0; b < nombre_blocs; b++) {
+        for (int c = 0; c < blocs[b].nombre; c++, nombre++) {
+            if (nombre >= nombre_max || c >= nombre_max) continue;
+            positions[nombre] = blocs[b].positions[c];
+            identites[nombre] = blocs[b].identites[c];
+        }
+        free(blocs[b].positions);
+        free(blocs[b].identites);
+    }
+    free(blocs);
+    return recherche.erreur ? -1 : nombre;
+}
+
+int rechercher_gene_parallele(const char* sequence_genome, const char* sequence_gene, double identite_min) {
+    int positions[2];
+    float identites[2];
+    int nombre = lister_copies_gene_parallele(sequence_genome, sequence_gene, identite_min, positions, identites, 2);
+    if (nombre < 0) {
+        printf("Erreur d'allocation mémoire\n");
+        return -1;
+    }
+
+    // Mêmes messages que rechercher_gene, qui s'arrête à la deuxième copie
+    for (int c = 0; c < nombre && c < 2; c++) {
+        printf("Gène trouvé à la position %d avec une identité de %.2f%%\n", positions[c] + 1, identites[c] * 100);
+    }
+    if (nombre > 1) {
+        printf("Gène trouvé à plusieurs reprises dans le génome !\n");
+        return -1;
+    }
+    if (nombre == 0) {
+        printf("Gène non trouvé\n");
+        return -1;
+    }
+    return positions[0] + 1;
+}
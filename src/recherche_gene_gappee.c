@@ -0,0 +1,443 @@
+// recherche_gene_gappee.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "projet.h"
+
+// Barème de l'alignement en bande (identique à celui de blastn)
+#define SCORE_IDENTITE 2
+#define PENALITE_MESAPPARIEMENT 3
+#define OUVERTURE_GAP 7        // Coût de la première base d'un gap (ouverture + extension)
+#define EXTENSION_GAP 2
+#define INFINI_NEGATIF -1000000000
+
+#define NOMBRE_MAX_GROUPES 32  // Nombre maximal de groupes de graines alignés par requête
+
+static int coder_base(char nucleotide) {
+    switch (nucleotide) {
+        case 'A': return 0;
+        case 'C': return 1;
+        case 'G': return 2;
+        case 'T': return 3;
+        default: return -1;
+    }
+}
+
+IndexKmers* construire_index_kmers(const char *sequence_genome, int longueur_genome, int k) {
+    if (k < 1 || k > 15) return NULL;
+
+    IndexKmers *index = calloc(1, sizeof(IndexKmers));
+    if (index == NULL) return NULL;
+    index->k = k;
+    index->longueur_genome = longueur_genome;
+
+    size_t nombre_codes = (size_t)1 << (2 * k);
+    uint32_t masque = (uint32_t)(nombre_codes - 1);
+    index->debut = calloc(nombre_codes + 1, sizeof(uint32_t));
+    int nombre_positions = longueur_genome - k + 1 > 0 ? longueur_genome - k + 1 : 1;
+    index->positions = malloc(nombre_positions * sizeof(uint32_t));
+    if (index->debut == NULL || index->positions == NULL) {
+        liberer_index_kmers(index);
+        return NULL;
+    }
+
+    // Premier passage : nombre d'occurrences de chaque k-mer (code 2 bits glissant)
+    uint32_t code = 0;
+    int valides = 0;
+    for (int i = 0; i < longueur_genome; i++) {
+        int c = coder_base(sequence_genome[i]);
+        if (c < 0) {
+            valides = 0;
+            continue;
+        }
+        code = ((code << 2) | (uint32_t)c) & masque;
+        if (++valides >= k) index->debut[code + 1]++;
+    }
+    for (size_t c = 0; c < nombre_codes; c++) index->debut[c + 1] += index->debut[c];
+
+    // Second passage : rangement des positions (tri par comptage, positions croissantes par k-mer)
+    uint32_t *curseur = malloc(nombre_codes * sizeof(uint32_t));
+    if (curseur == NULL) {
+        liberer_index_kmers(index);
+        return NULL;
+    }
+    memcpy(curseur, index->debut, nombre_codes * sizeof(uint32_t));
+    code = 0;
+    valides = 0;
+    for (int i = 0; i < longueur_genome; i++) {
+        int c = coder_base(sequence_genome[i]);
+        if (c < 0) {
+            valides = 0;
+            continue;
+        }
+        code = ((code << 2) | (uint32_t)c) & masque;
+        if (++valides >= k) index->positions[curseur[code]++] = (uint32_t)(i - k + 1);
+    }
+    free(curseur);
+    return index;
+}
+
+void liberer_index_kmers(IndexKmers *index) {
+    if (index == NULL) return;
+    free(index->debut);
+    free(index->positions);
+    free(index);
+}
+
+void liberer_alignement_gene(AlignementGene *alignement) {
+    free(alignement->cigar);
+    alignement->cigar = NULL;
+}
+
+typedef struct {
+    int diagonale;   ///< Position génomique - position dans la requête
+    int position_requete;
+} Graine;
+
+typedef struct {
+    int diagonale_min;
+    int diagonale_max;
+    int nombre_graines;
+} GroupeGraines;
+
+static int comparer_graines(const void *a, const void *b) {
+    const Graine *x = a;
+    const Graine *y = b;
+    if (x->diagonale != y->diagonale) return (x->diagonale > y->diagonale) - (x->diagonale < y->diagonale);
+    return x->position_requete - y->position_requete;
+}
+
+static int comparer_groupes(const void *a, const void *b) {
+    const GroupeGraines *x = a;
+    const GroupeGraines *y = b;
+    if (x->nombre_graines != y->nombre_graines) return y->nombre_graines - x->nombre_graines;
+    return x->diagonale_min - y->diagonale_min;
+}
+
+static int score_bases(char a, char b) {
+    return (a == b) ? SCORE_IDENTITE : -PENALITE_MESAPPARIEMENT;
+}
+
+// Ajoute une opération au CIGAR construit à l'envers pendant le retour sur trace
+static void empiler_operation(char *operations, int *nombre, char operation) {
+    operations[(*nombre)++] = operation;
+}
+
+static char* construire_cigar(const char *operations_inverses, int nombre) {
+    // Au plus 11 caractères par opération (longueur + lettre)
+    char *cigar = malloc((size_t)nombre * 12 + 1);
+    if (cigar == NULL) return NULL;
+    int longueur = 0;
+    int i = nombre - 1;
+    while (i >= 0) {
+        char operation = operations_inverses[i];
+        int repetitions = 0;
+        while (i >= 0 && operations_inverses[i] == operation) {
+            repetitions++;
+            i--;
+        }
+        longueur += sprintf(cigar + longueur, "%d%c", repetitions, operation);
+    }
+    cigar[longueur] = '\0';
+    return cigar;
+}
+
+/**
+ * Alignement global sur la requête, local sur le génome, restreint à la bande de diagonales
+ * [diagonale_basse, diagonale_haute] (diagonale = position génomique - position dans la requête).
+ */
+static int aligner_en_bande(const char *genome, int longueur_genome, const char *requete, int m,
+                            int diagonale_basse, int diagonale_haute, AlignementGene *resultat) {
+    int largeur = diagonale_haute - diagonale_basse + 1;
+    size_t cellules = (size_t)(m + 1) * largeur;
+    int *H = malloc(cellules * sizeof(int));
+    int *E = malloc(cellules * sizeof(int));
+    int *F = malloc(cellules * sizeof(int));
+    if (H == NULL || E == NULL || F == NULL) {
+        free(H); free(E); free(F);
+        return -1;
+    }
+
+    // Cellule (i, c) : préfixe de i bases de la requête, se terminant avant la base j = i + diagonale_basse + c
+    for (int i = 0; i <= m; i++) {
+        for (int c = 0; c < largeur; c++) {
+            size_t k = (size_t)i * largeur + c;
+            int j = i + diagonale_basse + c;
+            if (j < 0 || j > longueur_genome) {
+                H[k] = E[k] = F[k] = INFINI_NEGATIF;
+                continue;
+            }
+            if (i == 0) {
+                H[k] = 0;  // Début libre dans le génome
+                E[k] = F[k] = INFINI_NEGATIF;
+                continue;
+            }
+
+            int e = INFINI_NEGATIF;
+            if (c > 0 && H[k - 1] > INFINI_NEGATIF) {
+                e = E[k - 1] - EXTENSION_GAP;
+                if (H[k - 1] - OUVERTURE_GAP > e) e = H[k - 1] - OUVERTURE_GAP;
+            }
+            int f = INFINI_NEGATIF;
+            if (c + 1 < largeur && H[k - largeur + 1] > INFINI_NEGATIF) {
+                f = F[k - largeur + 1] - EXTENSION_GAP;
+                if (H[k - largeur + 1] - OUVERTURE_GAP > f) f = H[k - largeur + 1] - OUVERTURE_GAP;
+            }
+            int h = INFINI_NEGATIF;
+            if (j >= 1 && H[k - largeur] > INFINI_NEGATIF) {
+                h = H[k - largeur] + score_bases(requete[i - 1], genome[j - 1]);
+            }
+            if (e > h) h = e;
+            if (f > h) h = f;
+            H[k] = h;
+            E[k] = e;
+            F[k] = f;
+        }
+    }
+
+    // Fin libre dans le génome : meilleure cellule de la dernière ligne
+    int c_fin = -1;
+    for (int c = 0; c < largeur; c++) {
+        size_t k = (size_t)m * largeur + c;
+        if (H[k] > INFINI_NEGATIF && (c_fin < 0 || H[k] > H[(size_t)m * largeur + c_fin])) c_fin = c;
+    }
+    if (c_fin < 0) {
+        free(H); free(E); free(F);
+        return 1;
+    }
+
+    char *operations = malloc((size_t)(m + largeur) * 2 + 1);
+    if (operations == NULL) {
+        free(H); free(E); free(F);
+        return -1;
+    }
+    int nombre_operations = 0;
+    int identiques = 0;
+    int i = m;
+    int c = c_fin;
+    int etat = 0;  // 0 = H, 1 = E (délétion : base du génome absente de la requête), 2 = F (insertion)
+    resultat->score = H[(size_t)m * largeur + c_fin];
+    resultat->fin = m + diagonale_basse + c_fin;  // Position (exclue) de fin dans le génome
+
+    while (i > 0) {
+        size_t k = (size_t)i * largeur + c;
+        int j = i + diagonale_basse + c;
+        if (etat == 0) {
+            if (j >= 1 && H[k - largeur] > INFINI_NEGATIF &&
+                H[k] == H[k - largeur] + score_bases(requete[i - 1], genome[j - 1])) {
+                if (requete[i - 1] == genome[j - 1]) identiques++;
+                empiler_operation(operations, &nombre_operations, 'M');
+                i--;
+            } else if (H[k] == E[k]) {
+                etat = 1;
+            } else {
+                etat = 2;
+            }
+        } else if (etat == 1) {
+            empiler_operation(operations, &nombre_operations, 'D');
+            if (E[k] == H[k - 1] - OUVERTURE_GAP) etat = 0;
+            c--;
+        } else {
+            empiler_operation(operations, &nombre_operations, 'I');
+            if (F[k] == H[k - largeur + 1] - OUVERTURE_GAP) etat = 0;
+            i--;
+            c++;
+        }
+    }
+
+    resultat->debut = i + diagonale_basse + c;
+    resultat->longueur_alignement = nombre_operations;
+    resultat->identite = nombre_operations > 0 ? (double)identiques / nombre_operations : 0.0;
+    resultat->cigar = construire_cigar(operations, nombre_operations);
+
+    free(operations);
+    free(H); free(E); free(F);
+    return resultat->cigar == NULL ? -1 : 0;
+}
+
+static char complementer_base(char nucleotide) {
+    switch (nucleotide) {
+        case 'A': return 'T';
+        case 'C': return 'G';
+        case 'G': return 'C';
+        case 'T': return 'A';
+        default: return 'N';
+    }
+}
+
+/**
+ * Aligne une orientation du gène (`requete`, brin `brin`) autour de ses groupes de graines et ajoute les
+ * alignements retenus à `resultats` ; renvoie le nouveau nombre de résultats, ou -1 en cas d'erreur.
+ */
+static int rechercher_gene_brin(const IndexKmers *index, const char *sequence_genome, const char *sequence_gene,
+                                char brin, double identite_min, AlignementGene *resultats, int nombre_max_resultats,
+                                int nombre_resultats) {
+    int k = index->k;
+    int m = strlen(sequence_gene);
+
+    // Graines : chaque k-mer du gène est cherché dans l'index (les k-mers trop fréquents sont ignorés)
+    int capacite = 1024;
+    int nombre_graines = 0;
+    Graine *graines = malloc(capacite * sizeof(Graine));
+    if (graines == NULL) return -1;
+
+    uint32_t masque = (uint32_t)(((size_t)1 << (2 * k)) - 1);
+    uint32_t code = 0;
+    int valides = 0;
+    for (int q = 0; q < m; q++) {
+        int c = coder_base(sequence_gene[q]);
+        if (c < 0) {
+            valides = 0;
+            continue;
+        }
+        code = ((code << 2) | (uint32_t)c) & masque;
+        if (++valides < k) continue;
+
+        uint32_t debut = index->debut[code];
+        uint32_t fin = index->debut[code + 1];
+        if (fin - debut > OCCURRENCES_MAX_GRAINE) continue;
+        for (uint32_t e = debut; e < fin; e++) {
+            if (nombre_graines == capacite) {
+                capacite *= 2;
+                Graine *p = realloc(graines, capacite * sizeof(Graine));
+                if (p == NULL) {
+                    free(graines);
+                    return -1;
+                }
+                graines = p;
+            }
+            graines[nombre_graines].diagonale = (int)index->positions[e] - (q - k + 1);
+            graines[nombre_graines].position_requete = q - k + 1;
+            nombre_graines++;
+        }
+    }
+
+    // Regroupement des graines dont les diagonales sont proches (les indels décalent la diagonale)
+    int bande = m / 20 > LARGEUR_MIN_BANDE ? m / 20 : LARGEUR_MIN_BANDE;
+    qsort(graines, nombre_graines, sizeof(Graine), comparer_graines);
+    GroupeGraines *groupes = malloc((nombre_graines > 0 ? nombre_graines : 1) * sizeof(GroupeGraines));
+    if (groupes == NULL) {
+        free(graines);
+        return -1;
+    }
+    int nombre_groupes = 0;
+    for (int g = 0; g < nombre_graines; g++) {
+        if (nombre_groupes == 0 || graines[g].diagonale - groupes[nombre_groupes - 1].diagonale_max > bande) {
+            groupes[nombre_groupes].diagonale_min = graines[g].diagonale;
+            groupes[nombre_groupes].nombre_graines = 0;
+            nombre_groupes++;
+        }
+        groupes[nombre_groupes - 1].diagonale_max = graines[g].diagonale;
+        groupes[nombre_groupes - 1].nombre_graines++;
+    }
+    free(graines);
+
+    // Les groupes les plus fournis sont alignés en premier
+    qsort(groupes, nombre_groupes, sizeof(GroupeGraines), comparer_groupes);
+
+    for (int g = 0; g < nombre_groupes && g < NOMBRE_MAX_GROUPES; g++) {
+        if (groupes[g].nombre_graines < NOMBRE_MIN_GRAINES) break;
+
+        AlignementGene alignement = {0};
+        int statut = aligner_en_bande(sequence_genome, index->longueur_genome, sequence_gene, m,
+                                      groupes[g].diagonale_min - bande, groupes[g].diagonale_max + bande, &alignement);
+        if (statut < 0) {
+            free(groupes);
+            return -1;
+        }
+        if (statut > 0 || alignement.identite < identite_min) {
+            liberer_alignement_gene(&alignement);
+            continue;
+        }
+
+        alignement.brin = brin;
+
+        // Deux groupes voisins (ou les deux brins d'un gène palindromique) peuvent produire le même alignement
+        int doublon = 0;
+        for (int r = 0; r < nombre_resultats && r < nombre_max_resultats; r++) {
+            if (resultats[r].debut < alignement.fin && alignement.debut < resultats[r].fin) doublon = 1;
+        }
+        if (doublon) {
+            liberer_alignement_gene(&alignement);
+            continue;
+        }
+
+        if (nombre_resultats < nombre_max_resultats) {
+            resultats[nombre_resultats] = alignement;
+        } else {
+            liberer_alignement_gene(&alignement);
+        }
+        nombre_resultats++;
+    }
+
+    free(groupes);
+    return nombre_resultats;
+}
+
+int rechercher_gene_graines(const IndexKmers *index, const char *sequence_genome, const char *sequence_gene,
+                            double identite_min, AlignementGene *resultats, int nombre_max_resultats) {
+    int m = strlen(sequence_gene);
+    if (m < index->k) return 0;
+    char *inverse = malloc(m + 1);
+    if (inverse == NULL) return -1;
+    for (int i = 0; i < m; i++) inverse[i] = complementer_base(sequence_gene[m - 1 - i]);
+    inverse[m] = '\0';
+
+    // Brin + puis brin - : le complément inverse du gène est aligné sur le même index, en coordonnées du brin +
+    int nombre = rechercher_gene_brin(index, sequence_genome, sequence_gene, '+', identite_min, resultats,
+                                      nombre_max_resultats, 0);
+    if (nombre >= 0) {
+        int nombre_plus = nombre;
+        nombre = rechercher_gene_brin(index, sequence_genome, inverse, '-', identite_min, resultats,
+                                      nombre_max_resultats, nombre_plus);
+        for (int r = 0; nombre < 0 && r < nombre_plus && r < nombre_max_resultats; r++) {
+            liberer_alignement_gene(&resultats[r]);
+        }
+    }
+    free(inverse);
+    return nombre;
+}
+
+int rechercher_gene_index(const IndexKmers *index, const char *sequence_genome, const char *sequence_gene,
+                          double identite_min, char *brin) {
+    // Gène plus court qu'une graine : sans graine à placer, balayage direct sans indels (brin +)
+    if ((int)strlen(sequence_gene) < index->k) {
+        int position = rechercher_gene_parallele(sequence_genome, sequence_gene, identite_min);
+        if (brin != NULL) *brin = position > 0 ? '+' : '.';
+        return position;
+    }
+    AlignementGene resultats[2];
+    int nombre = rechercher_gene_graines(index, sequence_genome, sequence_gene, identite_min, resultats, 2);
+    if (nombre < 0) {
+        printf("Erreur d'allocation mémoire lors de la recherche du gène\n");
+        return -1;
+    }
+    for (int r = 0; r < nombre && r < 2; r++) {
+        printf("Gène trouvé à la position %d (brin %c) avec une identité de %.2f%% (alignement %d-%d, CIGAR %s)\n",
+               resultats[r].debut + 1, resultats[r].brin, resultats[r].identite * 100, resultats[r].debut + 1,
+               resultats[r].fin, resultats[r].cigar);
+    }
+
+    int position = nombre == 1 ? resultats[0].debut + 1 : -1;
+    if (brin != NULL) *brin = nombre == 1 ? resultats[0].brin : '.';
+    for (int r = 0; r < nombre && r < 2; r++) liberer_alignement_gene(&resultats[r]);
+
+    if (nombre == 0) {
+        printf("Gène non trouvé\n");
+    } else if (nombre > 1) {
+        printf("Gène trouvé à plusieurs reprises dans le génome !\n");
+    }
+    return position;
+}
+
+// Même contrat que rechercher_gene : position 1-indexée du gène, -1 si absent ou présent plusieurs fois
+int rechercher_gene_gappee(const char* sequence_genome, const char *sequence_gene, double identite_min) {
+    IndexKmers *index = construire_index_kmers(sequence_genome, strlen(sequence_genome), LONGUEUR_GRAINE_GENE);
+    if (index == NULL) {
+        printf("Erreur d'allocation mémoire pour l'index des k-mers\n");
+        return -1;
+    }
+    int position = rechercher_gene_index(index, sequence_genome, sequence_gene, identite_min, NULL);
+    liberer_index_kmers(index);
+    return position;
+}
@@ -3,8 +3,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
 #include <time.h>
 #include <ctype.h>
+#include <sys/stat.h>
 
 #include "projet.h"
 
@@ -12,42 +14,147 @@
 
 // Fonction pour lire un fichier FASTA ou texte et en extraire la séquence d'ADN
 char* lire_fichier(const char* chemin_fichier) {
-    FILE *fichier = fopen(chemin_fichier, "r");
-    if (fichier == NULL) {
+    struct stat infos;
+    if (stat(chemin_fichier, &infos) != 0) {
+        perror("Erreur lors de l'ouverture du fichier");
+        return NULL;
+    }
+    LecteurFlux *lecteur = ouvrir_lecteur_flux(chemin_fichier);
+    if (lecteur == NULL) {
         perror("Erreur lors de l'ouverture du fichier");
         return NULL;
     }
 
-    fseek(fichier, 0, SEEK_END);
-    long taille_fichier = ftell(fichier);
-    rewind(fichier);
-
-    char *sequence = (char*)malloc((taille_fichier + 1) * sizeof(char));
+    // La taille du fichier borne la séquence d'un fichier texte ; un fichier compressé est agrandi au besoin
+    int64_t capacite = (int64_t)infos.st_size + 1;
+    char *sequence = (char*)malloc(capacite * sizeof(char));
     if (sequence == NULL) {
         printf("Erreur d'allocation mémoire\n");
-        fclose(fichier);
+        fermer_lecteur_flux(lecteur);
         return NULL;
     }
 
-    char ligne[256];
-    int index = 0;
-    while (fgets(ligne, sizeof(ligne), fichier)) {
-        if (ligne[0] == '>') continue;  // Ignorer les lignes de description (FASTA)
-        for (int i = 0; ligne[i] != '\0'; i++) {
-            if (ligne[i] != '\n' && ligne[i] != ' ') {
-                char nucleotide = toupper(ligne[i]);
-                if (nucleotide == 'A' || nucleotide == 'C' || nucleotide == 'G' || nucleotide == 'T') {
-                    sequence[index++] = nucleotide;
-                }
+    int64_t index = 0;
+    int64_t lues;
+    while ((lues = lire_bases_flux(lecteur, sequence + index, capacite - 1 - index)) > 0) {
+        index += lues;
+        if (index == capacite - 1) {
+            char *p = realloc(sequence, capacite * 2);
+            if (p == NULL) {
+                printf("Erreur d'allocation mémoire\n");
+                free(sequence);
+                fermer_lecteur_flux(lecteur);
+                return NULL;
             }
+            sequence = p;
+            capacite *= 2;
         }
     }
 
+    // Un fichier compressé tronqué ou corrompu ne doit pas passer pour un génome plus court
+    if (erreur_lecteur_flux(lecteur)) {
+        printf("Erreur lors de la lecture de %s\n", chemin_fichier);
+        free(sequence);
+        fermer_lecteur_flux(lecteur);
+        return NULL;
+    }
     sequence[index] = '\0';
-    fclose(fichier);
+    fermer_lecteur_flux(lecteur);
     return sequence;
 }
 
+// Fonction pour lire un fichier FASTA contenant plusieurs enregistrements (un par séquence)
+SequenceFasta* lire_fichier_multi_fasta(const char* chemin_fichier, int *nombre_sequences) {
+    SourceSequence *source = ouvrir_source(chemin_fichier);
+    if (source == NULL) {
+        perror("Erreur lors de l'ouverture du fichier");
+        return NULL;
+    }
+
+    SequenceFasta *sequences = NULL;
+    int nombre = 0;
+    int capacite = 0;
+    int capacite_courante = 0;  // Capacité allouée pour la séquence de l'enregistrement courant
+
+    char *ligne = NULL;
+    size_t taille_ligne = 0;
+    int64_t lus;
+    int erreur = 0;
+    while (!erreur && (lus = lire_ligne_source(source, &ligne, &taille_ligne)) != -1) {
+        if (ligne[0] == '>') {
+            // Nouvel enregistrement : l'identifiant est le premier mot de l'en-tête
+            if (nombre == capacite) {
+                capacite = capacite == 0 ? 8 : capacite * 2;
+                SequenceFasta *p = realloc(sequences, capacite * sizeof(SequenceFasta));
+                if (p == NULL) {
+                    printf("Erreur d'allocation mémoire\n");
+                    erreur = 1;
+                    break;
+                }
+                sequences = p;
+            }
+            int longueur_nom = strcspn(ligne + 1, " \t\r\n");
+            sequences[nombre].nom = strndup(ligne + 1, longueur_nom);
+            sequences[nombre].sequence = malloc(1024);
+            if (sequences[nombre].nom == NULL || sequences[nombre].sequence == NULL) {
+                printf("Erreur d'allocation mémoire\n");
+                free(sequences[nombre].nom);
+                free(sequences[nombre].sequence);
+                erreur = 1;
+                break;
+            }
+            sequences[nombre].sequence[0] = '\0';
+            sequences[nombre].longueur = 0;
+            capacite_courante = 1024;
+            nombre++;
+            continue;
+        }
+        if (nombre == 0) continue;  // Séquence sans en-tête : ignorée
+
+        SequenceFasta *courante = &sequences[nombre - 1];
+        if (courante->longueur + lus + 1 > capacite_courante) {
+            while (courante->longueur + lus + 1 > capacite_courante) capacite_courante *= 2;
+            char *p = realloc(courante->sequence, capacite_courante);
+            if (p == NULL) {
+                printf("Erreur d'allocation mémoire\n");
+                erreur = 1;
+                break;
+            }
+            courante->sequence = p;
+        }
+        for (int64_t i = 0; i < lus; i++) {
+            char nucleotide = toupper(ligne[i]);
+            if (nucleotide == 'A' || nucleotide == 'C' || nucleotide == 'G' || nucleotide == 'T') {
+                courante->sequence[courante->longueur++] = nucleotide;
+            }
+        }
+        courante->sequence[courante->longueur] = '\0';
+    }
+
+    free(ligne);
+    if (!erreur && erreur_source(source)) {
+        printf("Erreur lors de la lecture de %s\n", chemin_fichier);
+        erreur = 1;
+    }
+    fermer_source(source);
+    if (erreur) {
+        liberer_sequences_fasta(sequences, nombre);
+        *nombre_sequences = 0;
+        return NULL;
+    }
+    *nombre_sequences = nombre;
+    return sequences;
+}
+
+void liberer_sequences_fasta(SequenceFasta *sequences, int nombre_sequences) {
+    if (sequences == NULL) return;
+    for (int i = 0; i < nombre_sequences; i++) {
+        free(sequences[i].nom);
+        free(sequences[i].sequence);
+    }
+    free(sequences);
+}
+
 // Fonction modifiée pour rechercher un motif dans une séquence en excluant une partie du génome (k-uplets)
 int rechercher_motif_rapide(char *motif, char *sequence_complete, int start_sous_seq, int longueur_sous_sequence) {
     int occurrences = 0;
@@ -72,14 +179,100 @@ int rechercher_motif_rapide(char *motif, char *sequence_complete, int start_sous
     return occurrences;
 }
 
+// Variante de rechercher_motif_rapide respectant un masque : une occurrence trouvée dans une région masquée
+// fait reprendre la recherche à la fin de cette région, toutes les positions intermédiaires étant masquées
+int rechercher_motif_masque(const char *motif, const char *sequence_complete, int start_sous_seq,
+                            int longueur_sous_sequence, const MasqueExclusion *masque) {
+    int occurrences = 0;
+    const char *position = sequence_complete;
+
+    while ((position = strstr(position, motif)) != NULL) {
+        int position_index = position - sequence_complete;
+        if (position_masquee(masque, position_index)) {
+            position = sequence_complete + fin_intervalle_masque(masque, position_index);
+            continue;
+        }
+        if (position_index < start_sous_seq || position_index >= start_sous_seq + longueur_sous_sequence) {
+            occurrences++;
+        }
+        position++;
+    }
+
+    return occurrences;
+}
+
+// Compte les occurrences d'un motif à au plus `mismatches_max` mésappariements, par parcours du génome
+// (même tolérance que comparer_avec_marge_erreur, généralisée ; sert de référence à l'index des suffixes)
+int rechercher_motif_approche(const char *motif, const char *sequence_complete, int mismatches_max,
+                              int start_sous_seq, int longueur_sous_sequence) {
+    int longueur_motif = strlen(motif);
+    int longueur_sequence = strlen(sequence_complete);
+    int occurrences = 0;
+    for (int i = 0; i + longueur_motif <= longueur_sequence; i++) {
+        if (i >= start_sous_seq && i < start_sous_seq + longueur_sous_sequence) continue;
+        int erreurs = 0;
+        for (int j = 0; j < longueur_motif && erreurs <= mismatches_max; j++) {
+            if (sequence_complete[i + j] != motif[j]) erreurs++;
+        }
+        if (erreurs <= mismatches_max) occurrences++;
+    }
+    return occurrences;
+}
+
 // Fonction pour calculer le fold change
 double calculer_fold_change(int occurrences_reelles, int occurrences_aleatoires) {
     double epsilon = 1e-6;
     return (double)occurrences_reelles / (occurrences_aleatoires + epsilon); // epsilon pour evité la division par 0
 }
 
+// Génome dans lequel les motifs sont comptés : par son index des suffixes s'il existe, par parcours sinon
+typedef struct {
+    const char *sequence;
+    const IndexSuffixes *index;
+    const MasqueExclusion *masque;
+} SourceComptage;
+
+static int compter_motif(const SourceComptage *source, const char *motif, int longueur_motif,
+                         int start_exclusion, int longueur_exclusion) {
+    if (source->index != NULL) {
+        return compter_occurrences_index(source->index, motif, longueur_motif, start_exclusion,
+                                         longueur_exclusion, source->masque);
+    }
+    // Le parcours par strstr demande un motif terminé par '\0'
+    char *copie = strndup(motif, longueur_motif);
+    if (copie == NULL) return 0;
+    int occurrences = rechercher_motif_masque(copie, source->sequence, start_exclusion, longueur_exclusion,
+                                              source->masque);
+    free(copie);
+    return occurrences;
+}
+
+// Fait entrer une base dans le code 2 bits glissant ; renvoie true si les k dernières bases forment un k-mer codé
+static bool glisser_code(uint64_t *code, int *bases_valides, char nucleotide, int longueur_kmer) {
+    int base = code_nucleotide(nucleotide);
+    if (base < 0) {
+        *bases_valides = 0;
+        return false;
+    }
+    *code = ((*code << 2) | (uint64_t)base) & masque_code_kmer(longueur_kmer);
+    return ++*bases_valides >= longueur_kmer;
+}
+
+// Occurrences non masquées d'un k-mer commençant dans [debut, debut + k) : celles que le comptage d'un
+// k-uplet exclut (lui-même et ses chevauchements), à retirer du compte de la table
+static int occurrences_dans_exclusion(const char *genome, int longueur_genome, const char *kmer, int longueur_kmer,
+                                      int debut, const MasqueExclusion *masque) {
+    int occurrences = 0;
+    for (int j = debut; j < debut + longueur_kmer && j + longueur_kmer <= longueur_genome; j++) {
+        if (!position_masquee(masque, j) && memcmp(genome + j, kmer, longueur_kmer) == 0) occurrences++;
+    }
+    return occurrences;
+}
+
 // Fonction pour essayer d'étendre un k-uplet à gauche et à droite
-int etendre_k_uplet(char *sequence_complete, int longueur_total_genome, Motif *motif, int *occurrences_reelles) {
+static int etendre_avec_source(const SourceComptage *source, int longueur_total_genome, Motif *motif,
+                               int *occurrences_reelles) {
+    const char *sequence_complete = source->sequence;
     int left = motif->start_pos;         // Position pour étendre à gauche
     int right = motif->start_pos + motif->length;  // Position pour étendre à droite
     int extended = 0;  // Flag pour savoir si une extension a été faite
@@ -101,7 +294,7 @@ int etendre_k_uplet(char *sequence_complete, int longueur_total_genome, Motif *m
         sequence_temp[new_length] = '\0';
 
         // Rechercher dans la séquence complète
-        new_occurrences = rechercher_motif_rapide(sequence_temp, sequence_complete, motif->start_pos, motif->length);
+        new_occurrences = compter_motif(source, sequence_temp, new_length, motif->start_pos, motif->length);
 
         if (new_occurrences >= X_HIT_AVANT_ENTRE) {
             free(motif->sequence);
@@ -130,7 +323,7 @@ int etendre_k_uplet(char *sequence_complete, int longueur_total_genome, Motif *m
         sequence_temp[new_length] = '\0';
 
         // Rechercher dans la séquence complète
-        new_occurrences = rechercher_motif_rapide(sequence_temp, sequence_complete, motif->start_pos, motif->length);
+        new_occurrences = compter_motif(source, sequence_temp, new_length, motif->start_pos, motif->length);
 
         if (new_occurrences >= X_HIT_AVANT_ENTRE) {
             free(motif->sequence);
@@ -146,6 +339,42 @@ int etendre_k_uplet(char *sequence_complete, int longueur_total_genome, Motif *m
     return extended;
 }
 
+int etendre_k_uplet(char *sequence_complete, int longueur_total_genome, Motif *motif, int *occurrences_reelles) {
+    SourceComptage source = {sequence_complete, NULL, NULL};
+    return etendre_avec_source(&source, longueur_total_genome, motif, occurrences_reelles);
+}
+
+int etendre_k_uplet_index(const IndexSuffixes *index, Motif *motif, int *occurrences_reelles) {
+    SourceComptage source = {index->genome, index, NULL};
+    return etendre_avec_source(&source, index->longueur_genome, motif, occurrences_reelles);
+}
+
+// Même extension pour un motif égal au génome sur [*position, *position + *longueur) : chaque candidat
+// est lui aussi une sous-chaîne du génome, compté sans être recopié
+static int etendre_dans_genome(const SourceComptage *source, int longueur_total_genome, int *position,
+                               int *longueur, int *occurrences_reelles) {
+    const char *genome = source->sequence;
+    int occurrences;
+    if (*position > 0) {
+        occurrences = compter_motif(source, genome + *position - 1, *longueur + 1, *position, *longueur);
+        if (occurrences >= X_HIT_AVANT_ENTRE) {
+            (*position)--;
+            (*longueur)++;
+            *occurrences_reelles = occurrences;
+            return 1;
+        }
+    }
+    if (*position + *longueur < longueur_total_genome) {
+        occurrences = compter_motif(source, genome + *position, *longueur + 1, *position, *longueur);
+        if (occurrences >= X_HIT_AVANT_ENTRE) {
+            (*longueur)++;
+            *occurrences_reelles = occurrences;
+            return 1;
+        }
+    }
+    return 0;
+}
+
 
 // Fonction de comparaison pour le tri des motifs par position
 int comparer_motifs(const void *a, const void *b) {
@@ -154,242 +383,495 @@ int comparer_motifs(const void *a, const void *b) {
     return motifA->start_pos - motifB->start_pos;
 }
 
-// Fonction pour afficher la barre de progression
-void afficher_progression(int current, int total) {
-    int largeur_barre = 50; // Largeur de la barre de progression
-    float progression = (float)current / total;
-    int position = (int)(progression * largeur_barre);
-
-    printf("\r["); // Retour au début de la ligne
-    for (int i = 0; i < largeur_barre; i++) {
-        if (i < position) {
-            printf("=");  // Simple '=' pour la barre
-        } else {
-            printf(" ");  // Espaces pour combler la barre
-        }
-    }
-    printf("] %d%%", (int)(progression * 100));
-    fflush(stdout);
+// Affiche un motif du stock sous un titre encadré de '======'
+static void afficher_motif_retenu(const StockMotifs *stock, int i, const char *titre) {
+    printf("====== %s ======\n", titre);
+    printf("Motif : %.*s\n", stock->longueurs[i], sequence_motif_stock(stock, i));
+    printf("Position : %d\n", stock->positions[i]);
+    printf("Longueur : %d\n", stock->longueurs[i]);
+    printf("Fold Change : %.2f\n", stock->fold_changes[i]);
+    printf("\n");
 }
 
 // Fonction pour afficher l'interface graphique des résultats
-void afficher_interface_graphique(Motif* motifs_potentiels, int nombre_motifs, int position_gene) {
-    if (nombre_motifs == 0) {
+void afficher_interface_graphique(const StockMotifs *stock, int position_gene) {
+    if (stock == NULL || stock->nombre == 0) {
         printf("Aucun motif potentiel trouvé.\n");
         return;
     }
 
-    // Trouver le motif avec le fold change le plus élevé
-    Motif* meilleur_fold_change = &motifs_potentiels[0];
-    Motif* motif_plus_proche_gene = &motifs_potentiels[0];
-    Motif* motif_le_plus_long = &motifs_potentiels[0];
+    // Meilleur motif selon chaque critère (à égalité, le premier du stock)
+    int meilleur_fold_change, motif_plus_proche_gene, motif_le_plus_long;
+    meilleurs_motifs_stock(stock, CRITERE_FOLD_CHANGE, position_gene, 1, &meilleur_fold_change);
+    meilleurs_motifs_stock(stock, CRITERE_DISTANCE_GENE, position_gene, 1, &motif_plus_proche_gene);
+    meilleurs_motifs_stock(stock, CRITERE_LONGUEUR, position_gene, 1, &motif_le_plus_long);
 
-    for (int i = 1; i < nombre_motifs; i++) {
-        if (motifs_potentiels[i].fold_change > meilleur_fold_change->fold_change) {
-            meilleur_fold_change = &motifs_potentiels[i];
-        }
-        // Calculer la distance au gène
-        int distance_courante = abs(motifs_potentiels[i].start_pos - position_gene);
-        int distance_minimale = abs(motif_plus_proche_gene->start_pos - position_gene);
-        if (distance_courante < distance_minimale) {
-            motif_plus_proche_gene = &motifs_potentiels[i];
+    // Affichage graphique final avec doubles lignes '======'
+    printf("\n");
+    afficher_motif_retenu(stock, meilleur_fold_change, "Motif avec le taux de fold change le plus élevé");
+    afficher_motif_retenu(stock, motif_plus_proche_gene, "Motif le plus proche du gène");
+    afficher_motif_retenu(stock, motif_le_plus_long, "Motif ayant la longueur la plus élevée");
+}
+
+// Motifs de la région trouvés par le moteur des répétitions maximales : chacune est comptée comme un motif
+// étendu (sa propre occurrence exclue) et devient un candidat. Retourne -1 en cas d'erreur.
+static int ajouter_repetitions_maximales(StockMotifs *motifs, const SourceComptage *source_reelle,
+                                         const SourceComptage *source_aleatoire, int debut_region, int fin_region,
+                                         int longueur_min_motif, const MasqueExclusion *masque_graines,
+                                         int *ignorees) {
+    int32_t *lcp = calculer_lcp(source_reelle->index);
+    if (lcp == NULL) return -1;
+    int nombre = 0;
+    // La copie retenue n'étant pas comptée, il en faut une de plus que X_HIT_AVANT_ENTRE
+    RepetitionMaximale *repetitions = rechercher_repetitions_maximales(source_reelle->index, lcp, debut_region,
+                                                                       fin_region, longueur_min_motif,
+                                                                       X_HIT_AVANT_ENTRE + 1, &nombre);
+    free(lcp);
+    if (repetitions == NULL) return -1;
+    printf("%d répétitions maximales chevauchant la région\n", nombre);
+
+    for (int r = 0; r < nombre; r++) {
+        int position = repetitions[r].position;
+        int longueur = repetitions[r].longueur;
+        if (chevauche_masque(masque_graines, position, position + longueur)) {
+            (*ignorees)++;
+            continue;
         }
-        if (motifs_potentiels[i].length > motif_le_plus_long->length) {
-            motif_le_plus_long = &motifs_potentiels[i];
+        const char *sequence_motif = source_reelle->sequence + position;
+        int occurrences_reelles = compter_motif(source_reelle, sequence_motif, longueur, position, longueur);
+        if (occurrences_reelles < X_HIT_AVANT_ENTRE) continue;
+        int occurrences_aleatoires = compter_motif(source_aleatoire, sequence_motif, longueur, 0, 0);
+        double fold_change = calculer_fold_change(occurrences_reelles, occurrences_aleatoires);
+        if (ajouter_motif_stock(motifs, NULL, position, longueur, fold_change, occurrences_reelles,
+                                occurrences_aleatoires) < 0) {
+            free(repetitions);
+            return -1;
         }
     }
+    free(repetitions);
+    return nombre;
+}
 
-    // Affichage graphique final avec doubles lignes '======'
-    printf("\n====== Motif avec le taux de fold change le plus élevé ======\n");
-    printf("Motif : %s\n", meilleur_fold_change->sequence);
-    printf("Position : %d\n", meilleur_fold_change->start_pos);
-    printf("Longueur : %d\n", meilleur_fold_change->length);
-    printf("Fold Change : %.2f\n", meilleur_fold_change->fold_change);
-    printf("\n");
-
-    printf("====== Motif le plus proche du gène ======\n");
-    printf("Motif : %s\n", motif_plus_proche_gene->sequence);
-    printf("Position : %d\n", motif_plus_proche_gene->start_pos);
-    printf("Longueur : %d\n", motif_plus_proche_gene->length);
-    printf("Fold Change : %.2f\n", motif_plus_proche_gene->fold_change);
-    printf("\n");
+// Construction des tables des suffixes des génomes réel et aléatoire, une par bloc (sauf si déjà fournie)
+typedef struct {
+    const char *genomes[2];
+    int longueurs[2];
+    IndexSuffixes *index[2];
+} ConstructionIndex;
+
+static void construire_index_bloc(const BlocParallele *bloc, void *contexte) {
+    ConstructionIndex *construction = contexte;
+    if (construction->index[bloc->indice] != NULL) return;
+    construction->index[bloc->indice] = construire_index_suffixes(construction->genomes[bloc->indice],
+                                                                  construction->longueurs[bloc->indice]);
+    if (construction->index[bloc->indice] == NULL && construction->longueurs[bloc->indice] > 0) {
+        printf("Erreur d'allocation mémoire pour l'index des suffixes\n");
+    }
+}
 
-    printf("====== Motif ayant la longueur la plus élevée ======\n");
-    printf("Motif : %s\n", motif_le_plus_long->sequence);
-    printf("Position : %d\n", motif_le_plus_long->start_pos);
-    printf("Longueur : %d\n", motif_le_plus_long->length);
-    printf("Fold Change : %.2f\n", motif_le_plus_long->fold_change);
-    printf("\n");
+// Clé du cache des candidats : contenu des deux génomes et tous les paramètres de la découverte
+static uint64_t cle_motifs_candidats(const char *sequence_complete, int longueur_total_genome,
+                                     const char *sequence_aleatoire, int longueur_aleatoire, int start_sous_seq,
+                                     int longueur_sous_sequence, int longueur_k_uplet, int longueur_min_motif,
+                                     const MasqueExclusion *masque, const ParametresSortie *sortie) {
+    uint64_t cle = empreinte_donnees("motifs", 6, EMPREINTE_INITIALE);
+    cle = empreinte_entier(longueur_total_genome, cle);
+    cle = empreinte_donnees(sequence_complete, longueur_total_genome, cle);
+    cle = empreinte_entier(longueur_aleatoire, cle);
+    cle = empreinte_donnees(sequence_aleatoire, longueur_aleatoire, cle);
+    int64_t parametres[] = {start_sous_seq, longueur_sous_sequence, longueur_k_uplet, longueur_min_motif,
+                            X_HIT_AVANT_ENTRE, sortie->moteur, sortie->masquer_faible_complexite, FENETRE_DUST,
+                            SEUIL_DUST, sortie->copies_max_graine};
+    for (size_t i = 0; i < sizeof(parametres) / sizeof(parametres[0]); i++) cle = empreinte_entier(parametres[i], cle);
+    cle = empreinte_entier(masque != NULL ? masque->nombre_intervalles : 0, cle);
+    for (int i = 0; masque != NULL && i < masque->nombre_intervalles; i++) {
+        cle = empreinte_entier(masque->debuts[i], cle);
+        cle = empreinte_entier(masque->fins[i], cle);
+    }
+    return cle;
 }
 
-// Fonction pour traiter les k-uplets dans une région de la séquence
-void traiter_k_uplets(char* sous_sequence, int longueur_sous_sequence, char* sequence_complete,
-                      int longueur_total_genome, int longueur_k_uplet, int longueur_min_motif,
-                      char* sequence_aleatoire, int position_gene) {
-    // Calculer le début de la sous-séquence dans la séquence complète
-    int start_sous_seq = (position_gene >= LONGEUR_REGION_ETUIE_MOTIFS) ? (position_gene - LONGEUR_REGION_ETUIE_MOTIFS) : 0;
+// Découverte des motifs candidats de la région : motifs étendus d'au moins `longueur_min_motif` bases, avec
+// leurs comptes, avant le seuil de fold change. Retourne -1 si un candidat n'a pas pu être rangé.
+static int decouvrir_motifs_candidats(StockMotifs *candidats, const char *sous_sequence, int longueur_sous_sequence,
+                                      int start_sous_seq, int longueur_total_genome, int longueur_k_uplet,
+                                      int longueur_min_motif, const SourceComptage *source_reelle,
+                                      const SourceComptage *source_aleatoire, int longueur_aleatoire,
+                                      const ParametresSortie *sortie) {
+    const char *sequence_complete = source_reelle->sequence;
+    const MasqueExclusion *masque = source_reelle->masque;
+    int total_k_uplets = longueur_sous_sequence - longueur_k_uplet + 1;
+
+    // Pré-passe de masquage des graines : faible complexité et k-mers très répétés, dont l'extension est coûteuse
+    MasqueExclusion *masque_graines = NULL;
+    int graines_ignorees = 0;
+    if (sortie->masquer_faible_complexite || sortie->copies_max_graine > 0) {
+        masque_graines = creer_masque_exclusion(longueur_total_genome);
+        int erreur = masque_graines == NULL;
+        if (!erreur && sortie->masquer_faible_complexite) {
+            erreur = masquer_faible_complexite(masque_graines, sequence_complete, longueur_total_genome,
+                                               FENETRE_DUST, SEUIL_DUST) != 0;
+        }
+        if (!erreur && sortie->copies_max_graine > 0 && source_reelle->index != NULL) {
+            erreur = masquer_kmers_frequents(masque_graines, source_reelle->index, longueur_k_uplet,
+                                             sortie->copies_max_graine) != 0;
+        }
+        if (erreur) {
+            printf("Erreur d'allocation mémoire pour le masquage des graines : aucune graine masquée\n");
+            liberer_masque_exclusion(masque_graines);
+            masque_graines = NULL;
+        } else {
+            printf("%lld bases masquées pour les graines\n", (long long)bases_masquees(masque_graines));
+        }
+    }
 
-    // Tableau dynamique pour stocker les motifs potentiels
-    Motif *motifs_potentiels = NULL;
-    int nombre_motifs = 0;
-    int capacite_motifs = 0;
+    // Moteur des répétitions maximales : tous les motifs de la région en un parcours de la table LCP,
+    // indépendamment de l'ordre des graines. Sans index (faute de mémoire), extension gloutonne des graines.
+    bool moteur_glouton = sortie->moteur == MOTEUR_GLOUTON || source_reelle->index == NULL;
+    int repetitions_ignorees = 0;
+    if (!moteur_glouton) {
+        printf("Recherche des répétitions maximales\n");
+        int avant = candidats->nombre;
+        if (ajouter_repetitions_maximales(candidats, source_reelle, source_aleatoire, start_sous_seq,
+                                          start_sous_seq + longueur_sous_sequence, longueur_min_motif,
+                                          masque_graines, &repetitions_ignorees) < 0) {
+            printf("Erreur d'allocation mémoire pour les répétitions maximales : extension des graines\n");
+            candidats->nombre = avant;
+            moteur_glouton = true;
+        }
+    }
 
-    int total_k_uplets = longueur_sous_sequence - longueur_k_uplet + 1;
+    // Comptage des graines : les k-mers de la région sont insérés dans deux tables, remplies chacune en un
+    // parcours du génome ; la boucle des graines n'a plus qu'un décalage et une recherche par base.
+    // Au-delà de LONGUEUR_MAX_KMER_CODE, chaque graine est comptée dans l'index des suffixes.
+    TableKmers *table_reelle = NULL, *table_aleatoire = NULL;
+    if (moteur_glouton && longueur_k_uplet <= LONGUEUR_MAX_KMER_CODE && total_k_uplets > 0) {
+        table_reelle = creer_table_kmers(longueur_k_uplet, total_k_uplets);
+        table_aleatoire = creer_table_kmers(longueur_k_uplet, total_k_uplets);
+        uint64_t code = 0;
+        int bases_valides = 0;
+        for (int i = 0; i < longueur_sous_sequence && table_reelle != NULL && table_aleatoire != NULL; i++) {
+            if (glisser_code(&code, &bases_valides, sous_sequence[i], longueur_k_uplet)) {
+                inserer_kmer(table_reelle, code);
+                inserer_kmer(table_aleatoire, code);
+            }
+        }
+        if (table_reelle != NULL && table_aleatoire != NULL) {
+            compter_kmers_genome_parallele(table_reelle, sequence_complete, longueur_total_genome, masque);
+            compter_kmers_genome_parallele(table_aleatoire, source_aleatoire->sequence, longueur_aleatoire, NULL);
+        } else {
+            liberer_table_kmers(table_reelle);
+            liberer_table_kmers(table_aleatoire);
+            table_reelle = table_aleatoire = NULL;
+        }
+    }
+
+    int erreur_stock = 0;
 
     // Afficher un séparateur avant le début de l'analyse
-    printf("Début de l'analyse des k-uplets\n");
+    if (moteur_glouton) printf("Début de l'analyse des k-uplets\n");
 
-    // Traiter les k-uplets dans la région de la séquence
-    for (int i = 0; i <= longueur_sous_sequence - longueur_k_uplet; i++) {
-        // Afficher la progression
-        afficher_progression(i + 1, total_k_uplets);
+    // Code glissant de la graine courante, amorcé avec ses k - 1 premières bases
+    uint64_t code_graine = 0;
+    int bases_valides = 0;
+    for (int i = 0; i < longueur_k_uplet - 1 && i < longueur_sous_sequence; i++) {
+        glisser_code(&code_graine, &bases_valides, sous_sequence[i], longueur_k_uplet);
+    }
+
+    // Traiter les k-uplets dans la région de la séquence (la progression est affichée par le rapporteur)
+    CompteurProgression *progression = moteur_glouton ? ouvrir_compteur_progression("graines", total_k_uplets) : NULL;
+    for (int i = 0; moteur_glouton && i <= longueur_sous_sequence - longueur_k_uplet; i++) {
+        avancer_progression(progression, 1);
 
-        // Extraction du k-uplet
-        char k_uplet[longueur_k_uplet + 1];
-        strncpy(k_uplet, &sous_sequence[i], longueur_k_uplet);
-        k_uplet[longueur_k_uplet] = '\0';
+        // Une seule base entre dans le code à chaque pas
+        bool code_valide = glisser_code(&code_graine, &bases_valides, sous_sequence[i + longueur_k_uplet - 1],
+                                        longueur_k_uplet);
+
+        // Les graines chevauchant une région masquée ne sont ni comptées ni étendues
+        if (chevauche_masque(masque_graines, start_sous_seq + i, start_sous_seq + i + longueur_k_uplet)) {
+            graines_ignorees++;
+            continue;
+        }
 
         // Définir les paramètres pour exclure cette région lors de la recherche
         int start_pos_exclusion = start_sous_seq + i;  // Position exacte du k-uplet dans la séquence complète
         int longueur_exclusion = longueur_k_uplet;
 
-        // Rechercher ce k-uplet dans la séquence complète
-        int occurrences_reelles = rechercher_motif_rapide(k_uplet, sequence_complete, start_pos_exclusion, longueur_exclusion);
-
-        // Rechercher dans la séquence aléatoire
-        int occurrences_aleatoires = rechercher_motif_rapide(k_uplet, sequence_aleatoire, 0, 0);
+        int occurrences_reelles, occurrences_aleatoires;
+        if (table_reelle != NULL) {
+            // Graine contenant autre chose que A, C, G ou T : aucune occurrence
+            if (!code_valide) continue;
+            occurrences_reelles = *trouver_kmer(table_reelle, code_graine) -
+                occurrences_dans_exclusion(sequence_complete, longueur_total_genome, &sous_sequence[i],
+                                           longueur_k_uplet, start_pos_exclusion, masque);
+            occurrences_aleatoires = *trouver_kmer(table_aleatoire, code_graine);
+        } else {
+            occurrences_reelles = compter_motif(source_reelle, &sous_sequence[i], longueur_k_uplet,
+                                                start_pos_exclusion, longueur_exclusion);
+            occurrences_aleatoires = compter_motif(source_aleatoire, &sous_sequence[i], longueur_k_uplet, 0, 0);
+        }
 
         // Si le motif est trouvé plusieurs fois dans la séquence réelle, étendre et tester
         if (occurrences_reelles >= X_HIT_AVANT_ENTRE) {
             // Calculer la position de départ dans le génome complet
             int start_pos_in_genome = start_sous_seq + i;
 
-            // Créer un motif initial à partir du k-uplet
-            Motif motif = {strdup(k_uplet), start_pos_in_genome, longueur_k_uplet, 0.0, occurrences_reelles, occurrences_aleatoires};
-
-            int extension_possible = 1;
+            // Le motif est la sous-chaîne [position, position + longueur) du génome réel
+            int position = start_pos_in_genome;
+            int longueur = longueur_k_uplet;
 
             // Essayer d'étendre le k-uplet à gauche et à droite jusqu'à ce qu'on ne puisse plus l'étendre
-            while (extension_possible) {
-                extension_possible = etendre_k_uplet(sequence_complete, longueur_total_genome, &motif, &occurrences_reelles);
-                if (extension_possible == -1) {
-                    // Erreur lors de l'extension
-                    break;
-                }
+            while (etendre_dans_genome(source_reelle, longueur_total_genome, &position, &longueur,
+                                       &occurrences_reelles)) {
             }
 
             // Vérifier si le motif atteint la longueur minimale avant de faire le test statistique
-            if (motif.length >= longueur_min_motif) {
-                // Recalculer les occurrences réelles pour le motif étendu
-                occurrences_reelles = rechercher_motif_rapide(motif.sequence, sequence_complete,  motif.start_pos, motif.length);
-                motif.occurrences_reelles = occurrences_reelles;
+            if (longueur >= longueur_min_motif) {
+                const char *sequence_motif = sequence_complete + position;
 
-                occurrences_aleatoires = rechercher_motif_rapide(motif.sequence, sequence_aleatoire, 0, 0);
-                motif.occurrences_aleatoires = occurrences_aleatoires;
+                // Recalculer les occurrences réelles pour le motif étendu
+                occurrences_reelles = compter_motif(source_reelle, sequence_motif, longueur, position, longueur);
+                occurrences_aleatoires = compter_motif(source_aleatoire, sequence_motif, longueur, 0, 0);
 
                 double fold_change = calculer_fold_change(occurrences_reelles, occurrences_aleatoires);
 
-                if (fold_change > FOLD_CHANGE_MIN) {
-                    // Stocker le motif dans le tableau
-                    if (nombre_motifs == capacite_motifs) {
-                        // Augmenter la capacité du tableau
-                        capacite_motifs = capacite_motifs == 0 ? 10 : capacite_motifs * 2;
-                        motifs_potentiels = realloc(motifs_potentiels, capacite_motifs * sizeof(Motif));
-                        if (motifs_potentiels == NULL) {
-                            printf("Erreur d'allocation mémoire pour le tableau de motifs\n");
-                            free(motif.sequence);
-                            break;
-                        }
-                    }
-
-                    // Ajouter le motif au tableau
-                    motif.fold_change = fold_change;
-                    motifs_potentiels[nombre_motifs++] = motif;
-                } else {
-                    // Libérer la mémoire si le motif n'est pas retenu
-                    free(motif.sequence);
+                // Stocker le candidat : une ligne de plus dans chaque colonne, sans allocation par motif
+                if (ajouter_motif_stock(candidats, NULL, position, longueur, fold_change, occurrences_reelles,
+                                        occurrences_aleatoires) < 0) {
+                    printf("Erreur d'allocation mémoire pour le tableau de motifs\n");
+                    erreur_stock = 1;
+                    break;
                 }
-            } else {
-                free(motif.sequence);
             }
         }
     }
 
-    // Ajouter une nouvelle ligne après la barre de progression
-    printf("\n");
+    fermer_compteur_progression(progression);
+    if (masque_graines != NULL && moteur_glouton) {
+        printf("%d graines masquées ignorées sur %d\n", graines_ignorees, total_k_uplets);
+    } else if (masque_graines != NULL) {
+        printf("%d répétitions masquées ignorées\n", repetitions_ignorees);
+    }
 
-    // Afficher le résumé des motifs après tri par position
-    if (nombre_motifs > 0) {
-        printf("\n====== Analyse terminée ======\n");
-        // Trier les motifs par position
-        qsort(motifs_potentiels, nombre_motifs, sizeof(Motif), comparer_motifs);
+    liberer_masque_exclusion(masque_graines);
+    liberer_table_kmers(table_reelle);
+    liberer_table_kmers(table_aleatoire);
+    return erreur_stock ? -1 : 0;
+}
 
-        printf("Résumé des motifs potentiels retenus :\n");
+// Fonction pour traiter les k-uplets dans une région de la séquence
+void traiter_k_uplets(char* sous_sequence, int longueur_sous_sequence, char* sequence_complete,
+                      int longueur_total_genome, int longueur_k_uplet, int longueur_min_motif,
+                      char* sequence_aleatoire, int position_gene, const ParametresSortie *sortie) {
+    ParametresSortie sortie_defaut = parametres_sortie_defaut();
+    if (sortie == NULL) sortie = &sortie_defaut;
 
-        // Enregistrement des 3 meilleurs motifs dans motif_retenu.txt au forma FASTA
-        FILE* fichier_motifs = fopen("../data/motif_retenu.txt", "w");  // AJOUT : Ouverture du fichier
-        if (fichier_motifs == NULL) {
-            perror("Impossible de créer ou d'ouvrir le fichier data/motif_retenu.txt");
-        }
+    // Calculer le début de la sous-séquence dans la séquence complète
+    int start_sous_seq = (position_gene >= LONGEUR_REGION_ETUIE_MOTIFS) ? (position_gene - LONGEUR_REGION_ETUIE_MOTIFS) : 0;
+
+    // Motifs potentiels, rangés en colonnes ; leurs séquences sont lues dans le génome réel
+    StockMotifs *motifs = creer_stock_motifs(sequence_complete, 0);
+    if (motifs == NULL) {
+        printf("Erreur d'allocation mémoire pour le tableau de motifs\n");
+        return;
+    }
 
-        // Affichage CONSOLE de tous les motifs 
-        for (int i = 0; i < nombre_motifs; i++) {
-            printf("Motif : %s\n", motifs_potentiels[i].sequence);
-            printf("Position : %d\n", motifs_potentiels[i].start_pos);
-            printf("Longueur : %d\n", motifs_potentiels[i].length);
-            printf("Fold Change : %.2f\n", motifs_potentiels[i].fold_change);
-            printf("Occurrences réelles : %d\n", motifs_potentiels[i].occurrences_reelles);
-            printf("Occurrences aléatoires : %d\n", motifs_potentiels[i].occurrences_aleatoires);
-            printf("-----------------------------\n");
+    // Masque du génome réel : celui fourni, plus la région étudiée si demandé
+    MasqueExclusion *masque_region = NULL;
+    const MasqueExclusion *masque = sortie->masque;
+    if (sortie->masquer_region) {
+        masque_region = creer_masque_exclusion(longueur_total_genome);
+        if (masque_region == NULL) {
+            printf("Erreur d'allocation mémoire pour le masque\n");
+            liberer_stock_motifs(motifs);
+            return;
         }
+        for (int i = 0; masque != NULL && i < masque->nombre_intervalles; i++) {
+            ajouter_intervalle_masque(masque_region, masque->debuts[i], masque->fins[i]);
+        }
+        ajouter_intervalle_masque(masque_region, start_sous_seq, start_sous_seq + longueur_sous_sequence);
+        masque = masque_region;
+    }
+    if (masque != NULL) {
+        printf("%lld bases masquées dans le génome réel\n", (long long)bases_masquees(masque));
+    }
 
-        // Recherche des 3 motifs « meilleurs » (mêmes calculs que dans afficher_interface_graphique)
-        Motif* meilleur_fold_change = &motifs_potentiels[0];
-        Motif* motif_plus_proche_gene = &motifs_potentiels[0];
-        Motif* motif_le_plus_long = &motifs_potentiels[0];
+    // Candidats (motifs étendus, avant le seuil de fold change), lus dans le cache si les deux génomes et les
+    // paramètres de la découverte n'ont pas changé
+    int longueur_aleatoire = strlen(sequence_aleatoire);
+    uint64_t cle_cache = 0;
+    bool candidats_en_cache = false;
+    if (sortie->dossier_cache != NULL) {
+        cle_cache = cle_motifs_candidats(sequence_complete, longueur_total_genome, sequence_aleatoire,
+                                         longueur_aleatoire, start_sous_seq, longueur_sous_sequence,
+                                         longueur_k_uplet, longueur_min_motif, masque, sortie);
+        int nombre_candidats = lire_motifs_cache(sortie->dossier_cache, cle_cache, motifs);
+        candidats_en_cache = nombre_candidats >= 0;
+        if (candidats_en_cache) printf("%d motifs candidats lus dans le cache\n", nombre_candidats);
+    }
 
-        for (int i = 1; i < nombre_motifs; i++) {
-            if (motifs_potentiels[i].fold_change > meilleur_fold_change->fold_change) {
-                meilleur_fold_change = &motifs_potentiels[i];
-            }
-            int distance_courante = abs(motifs_potentiels[i].start_pos - position_gene);
-            int distance_minimale = abs(motif_plus_proche_gene->start_pos - position_gene);
-            if (distance_courante < distance_minimale) {
-                motif_plus_proche_gene = &motifs_potentiels[i];
+    // Tous les comptages passent par les tables des suffixes des deux génomes, construites une seule fois
+    // (sans index, par exemple faute de mémoire, le génome est parcouru à chaque comptage). Avec les candidats
+    // du cache, seules la répartition des copies, les occurrences approchées et les contextes en ont encore besoin.
+    bool besoin_index = !candidats_en_cache || sortie->calcul_distribution || sortie->mismatches_max > 0 ||
+                        sortie->chemin_contextes != NULL || sortie->verification != NULL;
+    bool besoin_index_aleatoire = !candidats_en_cache || sortie->mismatches_max > 0 || sortie->verification != NULL;
+    ConstructionIndex construction = {{sequence_complete, sequence_aleatoire},
+                                      {longueur_total_genome, longueur_aleatoire},
+                                      {sortie->index_reel, sortie->index_aleatoire}};
+    pool_parallel_for(pool_global(), 0, besoin_index_aleatoire ? 2 : besoin_index ? 1 : 0, 1, 0,
+                      construire_index_bloc, &construction);
+    IndexSuffixes *index = construction.index[0];
+    IndexSuffixes *index_aleatoire = construction.index[1];
+    SourceComptage source_reelle = {sequence_complete, index, masque};
+    SourceComptage source_aleatoire = {sequence_aleatoire, index_aleatoire, NULL};
+
+    if (!candidats_en_cache &&
+        decouvrir_motifs_candidats(motifs, sous_sequence, longueur_sous_sequence, start_sous_seq,
+                                   longueur_total_genome, longueur_k_uplet, longueur_min_motif, &source_reelle,
+                                   &source_aleatoire, longueur_aleatoire, sortie) == 0 &&
+        sortie->dossier_cache != NULL) {
+        ecrire_motifs_cache(sortie->dossier_cache, cle_cache, motifs);
+    }
+
+    // Seuil de fold change appliqué après la découverte : le changer réutilise les candidats du cache
+    // (strictement supérieur au seuil, d'où le double suivant)
+    filtrer_stock_motifs(motifs, nextafter(sortie->fold_change_min, INFINITY), 0, 0);
+
+    // Afficher le résumé des motifs après tri par position
+    int nombre_motifs = motifs->nombre;
+    if (nombre_motifs > 0) {
+        printf("\n====== Analyse terminée ======\n");
+        // Trier les motifs par position
+        trier_stock_motifs(motifs, CRITERE_POSITION, position_gene);
+
+        // Répartition des copies et occurrences approchées de chaque motif, lues dans les tables des suffixes
+        for (int i = 0; i < nombre_motifs && index != NULL; i++) {
+            const char *sequence_motif = sequence_motif_stock(motifs, i);
+            int longueur = motifs->longueurs[i];
+            if (sortie->calcul_distribution) {
+                motifs->distributions[i] = calculer_distribution_motif(index, sequence_motif, longueur, masque,
+                                                                       sortie->annotation,
+                                                                       sortie->taille_fenetre_densite);
             }
-            if (motifs_potentiels[i].length > motif_le_plus_long->length) {
-                motif_le_plus_long = &motifs_potentiels[i];
+            if (sortie->mismatches_max > 0 && index_aleatoire != NULL) {
+                motifs->approchees_reelles[i] = compter_occurrences_approchees(index, sequence_motif, longueur,
+                    sortie->mismatches_max, motifs->positions[i], longueur, masque);
+                motifs->approchees_aleatoires[i] = compter_occurrences_approchees(index_aleatoire, sequence_motif,
+                    longueur, sortie->mismatches_max, 0, 0, NULL);
             }
         }
 
+        // Comptes d'un échantillon des motifs retenus comparés à ceux des parcours de référence
+        if (sortie->verification != NULL && index != NULL && index_aleatoire != NULL) {
+            BilanVerification *bilan = sortie->verification;
+            int64_t comparaisons = bilan->comparaisons, divergences = bilan->divergences;
+            for (int i = 0; i < nombre_motifs; i++) {
+                // Échantillon reproductible : il ne dépend que de la position et de la longueur du motif
+                uint64_t cle = empreinte_entier(motifs->positions[i], EMPREINTE_INITIALE);
+                cle = empreinte_entier(motifs->longueurs[i], cle);
+                if (!echantillon_retenu(cle, sortie->taux_verification)) continue;
+                const char *sequence_motif = sequence_motif_stock(motifs, i);
+                int longueur = motifs->longueurs[i];
+                verifier_comptage_motif(bilan, index, sequence_motif, longueur, motifs->positions[i], longueur,
+                                        masque, sortie->mismatches_max);
+                verifier_comptage_motif(bilan, index_aleatoire, sequence_motif, longueur, 0, 0, NULL,
+                                        sortie->mismatches_max);
+            }
+            printf("Vérification : %lld comptes comparés aux références, %lld divergence(s)\n",
+                   (long long)(bilan->comparaisons - comparaisons), (long long)(bilan->divergences - divergences));
+        }
 
-        if (fichier_motifs != NULL) {
-            // Motif avec le plus fort fold change
-            fprintf(fichier_motifs, ">Motif avec le taux de fold change le plus élevé\n");
-            fprintf(fichier_motifs, "%s\n\n", meilleur_fold_change->sequence);
+        // Enregistrement de tous les motifs, avec tous leurs champs, dans le fichier de résultats
+        if (sortie->chemin_resultats != NULL) {
+            EcrivainResultats *ecrivain = ouvrir_ecrivain_resultats(sortie->chemin_resultats, sortie->format);
+            if (ecrivain != NULL) {
+                for (int i = 0; i < nombre_motifs; i++) {
+                    Motif motif = vue_motif_stock(motifs, i);
+                    if (ecrire_motif_resultat(ecrivain, &motif) != 0) break;
+                }
+                if (fermer_ecrivain_resultats(ecrivain) == 0) {
+                    printf("%d motifs écrits dans %s\n", nombre_motifs, sortie->chemin_resultats);
+                }
+            }
+        }
 
-            // Motif le plus proche du gène
-            fprintf(fichier_motifs, ">Motif le plus proche du gène\n");
-            fprintf(fichier_motifs, "%s\n\n", motif_plus_proche_gene->sequence);
+        // Contexte de chaque occurrence des motifs retenus, en FASTA
+        if (sortie->chemin_contextes != NULL && index != NULL) {
+            int64_t nombre_contextes = ecrire_contextes_occurrences(index, motifs, masque, &sortie->contextes,
+                                                                    sortie->chemin_contextes);
+            if (nombre_contextes >= 0) {
+                printf("%lld occurrences écrites dans %s\n", (long long)nombre_contextes, sortie->chemin_contextes);
+            }
+        }
 
-            // Motif ayant la longueur la plus élevée
-            fprintf(fichier_motifs, ">Motif ayant la longueur la plus élevée\n");
-            fprintf(fichier_motifs, "%s\n\n", motif_le_plus_long->sequence);
+        // Affichage CONSOLE de tous les motifs (facultatif : coûteux quand les motifs sont nombreux)
+        if (sortie->affichage_console) {
+            printf("Résumé des motifs potentiels retenus :\n");
+            for (int i = 0; i < nombre_motifs; i++) {
+                printf("Motif : %.*s\n", motifs->longueurs[i], sequence_motif_stock(motifs, i));
+                printf("Position : %d\n", motifs->positions[i]);
+                printf("Longueur : %d\n", motifs->longueurs[i]);
+                printf("Fold Change : %.2f\n", motifs->fold_changes[i]);
+                printf("Occurrences réelles : %d\n", motifs->occurrences_reelles[i]);
+                printf("Occurrences aléatoires : %d\n", motifs->occurrences_aleatoires[i]);
+                if (motifs->approchees_reelles[i] >= 0) {
+                    printf("Occurrences à %d mésappariement(s) près : %d réelles, %d aléatoires\n", sortie->mismatches_max,
+                           motifs->approchees_reelles[i], motifs->approchees_aleatoires[i]);
+                }
+                const DistributionMotif *distribution = motifs->distributions[i];
+                if (distribution != NULL && distribution->nombre_occurrences >= 2) {
+                    printf("Écart entre copies : min %d, médian %d, max %d\n", distribution->ecart_min,
+                           distribution->ecart_median, distribution->ecart_max);
+                    printf("Densité maximale : %d copies entre %lld et %lld\n", distribution->densite_max,
+                           (long long)distribution->fenetre_densite_max * distribution->taille_fenetre,
+                           (long long)(distribution->fenetre_densite_max + 1) * distribution->taille_fenetre);
+                }
+                if (distribution != NULL && distribution->distances_genes != NULL) {
+                    printf("Distance au gène annoté le plus proche : min %d, moyenne %.0f (%.0f%% des copies intergéniques)\n",
+                           distribution->distance_min_gene, distribution->distance_moyenne_gene,
+                           distribution->fraction_intergenique * 100);
+                }
+                printf("-----------------------------\n");
+            }
+        }
 
-            fclose(fichier_motifs);  // AJOUT : Fermeture du fichier
+        // Les 3 motifs « meilleurs » (mêmes critères que dans afficher_interface_graphique)
+        int meilleurs[3];
+        meilleurs_motifs_stock(motifs, CRITERE_FOLD_CHANGE, position_gene, 1, &meilleurs[0]);
+        meilleurs_motifs_stock(motifs, CRITERE_DISTANCE_GENE, position_gene, 1, &meilleurs[1]);
+        meilleurs_motifs_stock(motifs, CRITERE_LONGUEUR, position_gene, 1, &meilleurs[2]);
+
+        // Enregistrement des 3 meilleurs motifs au format FASTA
+        FILE* fichier_motifs = NULL;
+        if (sortie->chemin_motifs_retenus != NULL) {
+            fichier_motifs = fopen(sortie->chemin_motifs_retenus, "w");
+            if (fichier_motifs == NULL) {
+                perror("Impossible de créer ou d'ouvrir le fichier des motifs retenus");
+            }
+        }
+        if (fichier_motifs != NULL) {
+            const char *titres[3] = {"Motif avec le taux de fold change le plus élevé", "Motif le plus proche du gène",
+                                     "Motif ayant la longueur la plus élevée"};
+            for (int m = 0; m < 3; m++) {
+                fprintf(fichier_motifs, ">%s\n", titres[m]);
+                fprintf(fichier_motifs, "%.*s\n\n", motifs->longueurs[meilleurs[m]],
+                        sequence_motif_stock(motifs, meilleurs[m]));
+            }
+            fclose(fichier_motifs);
         }
 
 
         // Afficher l'interface graphique finale
-        afficher_interface_graphique(motifs_potentiels, nombre_motifs, position_gene);
-
-        // Libérer la mémoire des motifs
-        for (int i = 0; i < nombre_motifs; i++) {
-            free(motifs_potentiels[i].sequence);
-        }
-        free(motifs_potentiels);
+        afficher_interface_graphique(motifs, position_gene);
     } else {
         printf("\n====== Analyse terminée ======\n");
         printf("Aucun motif potentiel retenu.\n");
     }
+
+    liberer_stock_motifs(motifs);
+    // Les tables fournies par l'appelant restent à sa charge
+    if (index != sortie->index_reel) liberer_index_suffixes(index);
+    if (index_aleatoire != sortie->index_aleatoire) liberer_index_suffixes(index_aleatoire);
+    liberer_masque_exclusion(masque_region);
 }
@@ -0,0 +1,108 @@
+// repetitions_maximales.c
+#include <stdio.h>
+#include <stdlib.h>
+#include "projet.h"
+
+#define GAUCHE_VIDE -1   // Aucun suffixe rattaché à l'intervalle pour l'instant
+#define GAUCHE_DIVERS 4  // Bases précédentes différentes (ou suffixe en début de génome) : maximal à gauche
+
+// Intervalle LCP en cours : suffixes de rangs [debut, ...) partageant un préfixe de `lcp` bases
+typedef struct {
+    int lcp;
+    int debut;
+    int gauche;         // Base précédant toutes ses occurrences, GAUCHE_DIVERS si elles diffèrent
+    int position;       // Plus grande occurrence commençant avant la fin de la région (-1 : aucune)
+} IntervalleLcp;
+
+static void fusionner_intervalle(IntervalleLcp *dans, int gauche, int position) {
+    if (dans->gauche == GAUCHE_VIDE) dans->gauche = gauche;
+    else if (dans->gauche != gauche) dans->gauche = GAUCHE_DIVERS;
+    if (position > dans->position) dans->position = position;
+}
+
+// Ajoute un intervalle terminé aux résultats s'il est une répétition maximale retenue
+static int relever_intervalle(const IntervalleLcp *intervalle, int fin, int debut_region, int longueur_min,
+                              int copies_min, RepetitionMaximale **repetitions, int *nombre, int *capacite) {
+    int copies = fin - intervalle->debut;
+    // Maximale à droite par construction (les suffixes divergent après `lcp` bases), à gauche si les bases
+    // précédentes diffèrent ; elle doit chevaucher la région
+    if (intervalle->lcp < longueur_min || copies < copies_min || intervalle->gauche != GAUCHE_DIVERS ||
+        intervalle->position < 0 || intervalle->position + intervalle->lcp <= debut_region) {
+        return 0;
+    }
+    if (*nombre == *capacite) {
+        int nouvelle_capacite = *capacite == 0 ? 64 : 2 * *capacite;
+        RepetitionMaximale *agrandi = realloc(*repetitions, nouvelle_capacite * sizeof(RepetitionMaximale));
+        if (agrandi == NULL) return -1;
+        *repetitions = agrandi;
+        *capacite = nouvelle_capacite;
+    }
+    RepetitionMaximale repetition = {intervalle->position, intervalle->lcp, copies};
+    (*repetitions)[(*nombre)++] = repetition;
+    return 0;
+}
+
+RepetitionMaximale* rechercher_repetitions_maximales(const IndexSuffixes *index, const int32_t *lcp,
+                                                     int debut_region, int fin_region, int longueur_min,
+                                                     int copies_min, int *nombre) {
+    *nombre = 0;
+    int n = index->longueur_genome;
+    int capacite_pile = 256, hauteur = 0;
+    IntervalleLcp *pile = malloc(capacite_pile * sizeof(IntervalleLcp));
+    RepetitionMaximale *repetitions = NULL;
+    int capacite = 0;
+    if (pile == NULL) return NULL;
+    IntervalleLcp racine = {0, 0, GAUCHE_VIDE, -1};
+    pile[hauteur++] = racine;
+
+    // Parcours ascendant des intervalles LCP (Abouelhoda et al.) : chaque suffixe est rattaché à l'intervalle
+    // le plus profond qui le contient, et un intervalle transmet ses informations à son parent en se fermant
+    for (int i = 1; i <= n; i++) {
+        int l = i < n ? lcp[i] : 0;
+        int p = index->suffixes[i - 1];
+        int gauche = p == 0 ? GAUCHE_DIVERS : code_nucleotide(index->genome[p - 1]);
+        if (gauche < 0) gauche = GAUCHE_DIVERS;
+        int position = p < fin_region ? p : -1;
+
+        IntervalleLcp ouvert = {l, i - 1, gauche, position};
+        if (l <= pile[hauteur - 1].lcp) {
+            fusionner_intervalle(&pile[hauteur - 1], gauche, position);
+            ouvert.debut = -1;
+        }
+        while (l < pile[hauteur - 1].lcp) {
+            IntervalleLcp ferme = pile[--hauteur];
+            if (relever_intervalle(&ferme, i, debut_region, longueur_min, copies_min, &repetitions, nombre,
+                                   &capacite) != 0) {
+                free(pile);
+                free(repetitions);
+                *nombre = 0;
+                return NULL;
+            }
+            if (l <= pile[hauteur - 1].lcp) {
+                fusionner_intervalle(&pile[hauteur - 1], ferme.gauche, ferme.position);
+            } else {
+                // L'intervalle fermé est le premier enfant d'un intervalle de profondeur l, ouvert ici
+                ouvert.debut = ferme.debut;
+                ouvert.gauche = ferme.gauche;
+                ouvert.position = ferme.position;
+            }
+        }
+        if (l > pile[hauteur - 1].lcp) {
+            if (hauteur == capacite_pile) {
+                capacite_pile *= 2;
+                IntervalleLcp *agrandie = realloc(pile, capacite_pile * sizeof(IntervalleLcp));
+                if (agrandie == NULL) {
+                    free(pile);
+                    free(repetitions);
+                    *nombre = 0;
+                    return NULL;
+                }
+                pile = agrandie;
+            }
+            pile[hauteur++] = ouvert;
+        }
+    }
+    free(pile);
+    if (repetitions == NULL) repetitions = malloc(sizeof(RepetitionMaximale));
+    return repetitions;
+}
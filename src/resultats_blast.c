@@ -0,0 +1,465 @@
+// resultats_blast.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "projet.h"
+
+#define CAPACITE_INITIALE_HITS 1024
+#define TAILLE_INITIALE_DICTIONNAIRE 256
+
+// Hachage FNV-1a d'un identifiant (requête ou sujet)
+static uint32_t hacher_nom(const char *nom, int longueur) {
+    uint32_t h = 2166136261u;
+    for (int i = 0; i < longueur; i++) {
+        h ^= (unsigned char)nom[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static void initialiser_dictionnaire(DictionnaireNoms *dico) {
+    memset(dico, 0, sizeof(*dico));
+}
+
+static void liberer_dictionnaire(DictionnaireNoms *dico) {
+    for (int i = 0; i < dico->nombre; i++) {
+        free(dico->noms[i]);
+    }
+    free(dico->noms);
+    free(dico->table);
+    memset(dico, 0, sizeof(*dico));
+}
+
+static int redimensionner_dictionnaire(DictionnaireNoms *dico, int nouvelle_taille) {
+    int *table = malloc(nouvelle_taille * sizeof(int));
+    if (table == NULL) return -1;
+    for (int i = 0; i < nouvelle_taille; i++) table[i] = -1;
+
+    // Réinsertion des noms déjà connus
+    for (int i = 0; i < dico->nombre; i++) {
+        uint32_t h = hacher_nom(dico->noms[i], strlen(dico->noms[i])) & (nouvelle_taille - 1);
+        while (table[h] != -1) h = (h + 1) & (nouvelle_taille - 1);
+        table[h] = i;
+    }
+    free(dico->table);
+    dico->table = table;
+    dico->taille_table = nouvelle_taille;
+    return 0;
+}
+
+// Retourne l'indice du nom dans le dictionnaire, en l'ajoutant si nécessaire (-1 en cas d'erreur)
+static int indexer_nom(DictionnaireNoms *dico, const char *nom, int longueur) {
+    // Les sorties BLAST sont groupées par sujet : on teste d'abord le dernier nom vu
+    if (dico->dernier >= 0 && dico->dernier < dico->nombre) {
+        const char *dernier = dico->noms[dico->dernier];
+        if ((int)strlen(dernier) == longueur && memcmp(dernier, nom, longueur) == 0) {
+            return dico->dernier;
+        }
+    }
+
+    if (dico->table == NULL || 2 * (dico->nombre + 1) > dico->taille_table) {
+        int nouvelle_taille = dico->taille_table == 0 ? TAILLE_INITIALE_DICTIONNAIRE : dico->taille_table * 2;
+        if (redimensionner_dictionnaire(dico, nouvelle_taille) != 0) return -1;
+    }
+
+    uint32_t h = hacher_nom(nom, longueur) & (dico->taille_table - 1);
+    while (dico->table[h] != -1) {
+        const char *candidat = dico->noms[dico->table[h]];
+        if ((int)strlen(candidat) == longueur && memcmp(candidat, nom, longueur) == 0) {
+            dico->dernier = dico->table[h];
+            return dico->table[h];
+        }
+        h = (h + 1) & (dico->taille_table - 1);
+    }
+
+    if (dico->nombre == dico->capacite) {
+        int capacite = dico->capacite == 0 ? 16 : dico->capacite * 2;
+        char **noms = realloc(dico->noms, capacite * sizeof(char*));
+        if (noms == NULL) return -1;
+        dico->noms = noms;
+        dico->capacite = capacite;
+    }
+
+    char *copie = malloc(longueur + 1);
+    if (copie == NULL) return -1;
+    memcpy(copie, nom, longueur);
+    copie[longueur] = '\0';
+
+    dico->noms[dico->nombre] = copie;
+    dico->table[h] = dico->nombre;
+    dico->dernier = dico->nombre;
+    return dico->nombre++;
+}
+
+// Agrandit toutes les colonnes de la table d'un coup
+static int agrandir_table_blast(TableBlast *table) {
+    int capacite = table->capacite == 0 ? CAPACITE_INITIALE_HITS : table->capacite * 2;
+
+#define AGRANDIR_COLONNE(colonne) do { \
+        void *p = realloc(table->colonne, capacite * sizeof(*table->colonne)); \
+        if (p == NULL) return -1; \
+        table->colonne = p; \
+    } while (0)
+
+    AGRANDIR_COLONNE(indice_requete);
+    AGRANDIR_COLONNE(indice_sujet);
+    AGRANDIR_COLONNE(identite);
+    AGRANDIR_COLONNE(longueur_alignement);
+    AGRANDIR_COLONNE(mesappariements);
+    AGRANDIR_COLONNE(ouvertures_gap);
+    AGRANDIR_COLONNE(debut_requete);
+    AGRANDIR_COLONNE(fin_requete);
+    AGRANDIR_COLONNE(debut_sujet);
+    AGRANDIR_COLONNE(fin_sujet);
+    AGRANDIR_COLONNE(evalue);
+    AGRANDIR_COLONNE(score_bits);
+
+#undef AGRANDIR_COLONNE
+
+    table->capacite = capacite;
+    return 0;
+}
+
+// Lecture d'un entier décimal sans passer par strtol (le champ est délimité par une tabulation)
+static const char* lire_entier_champ(const char *p, const char *fin, int64_t *valeur) {
+    int64_t v = 0;
+    int negatif = 0;
+    if (p < fin && *p == '-') {
+        negatif = 1;
+        p++;
+    }
+    while (p < fin && *p >= '0' && *p <= '9') {
+        v = v * 10 + (*p - '0');
+        p++;
+    }
+    *valeur = negatif ? -v : v;
+    return p;
+}
+
+// Avance jusqu'au champ suivant ; retourne NULL si la ligne se termine avant
+static const char* champ_suivant(const char *p, const char *fin_ligne) {
+    while (p < fin_ligne && *p != '\t') p++;
+    return p < fin_ligne ? p + 1 : NULL;
+}
+
+// Analyse une ligne de hit (12 colonnes du format tabulaire BLAST) et l'ajoute à la table
+static int analyser_ligne_blast(TableBlast *table, const char *ligne, const char *fin_ligne) {
+    const char *champs[12];
+    const char *p = ligne;
+    for (int c = 0; c < 12; c++) {
+        if (p == NULL) return 1;  // Ligne incomplète : ignorée
+        champs[c] = p;
+        p = champ_suivant(p, fin_ligne);
+    }
+
+    if (table->nombre_hits == table->capacite && agrandir_table_blast(table) != 0) {
+        return -1;
+    }
+
+    int n = table->nombre_hits;
+    const char *fin_requete = champs[1] - 1;
+    const char *fin_sujet = champs[2] - 1;
+
+    table->indice_requete[n] = indexer_nom(&table->requetes, champs[0], fin_requete - champs[0]);
+    table->indice_sujet[n] = indexer_nom(&table->sujets, champs[1], fin_sujet - champs[1]);
+    if (table->indice_requete[n] < 0 || table->indice_sujet[n] < 0) return -1;
+
+    int64_t v;
+    table->identite[n] = strtof(champs[2], NULL);
+    lire_entier_champ(champs[3], fin_ligne, &v); table->longueur_alignement[n] = (int)v;
+    lire_entier_champ(champs[4], fin_ligne, &v); table->mesappariements[n] = (int)v;
+    lire_entier_champ(champs[5], fin_ligne, &v); table->ouvertures_gap[n] = (int)v;
+    lire_entier_champ(champs[6], fin_ligne, &v); table->debut_requete[n] = (int)v;
+    lire_entier_champ(champs[7], fin_ligne, &v); table->fin_requete[n] = (int)v;
+    lire_entier_champ(champs[8], fin_ligne, &table->debut_sujet[n]);
+    lire_entier_champ(champs[9], fin_ligne, &table->fin_sujet[n]);
+    table->evalue[n] = strtod(champs[10], NULL);
+    table->score_bits[n] = strtof(champs[11], NULL);
+
+    table->nombre_hits++;
+    return 0;
+}
+
+TableBlast* charger_table_blast(const char *chemin_fichier) {
+    FILE *fichier = fopen(chemin_fichier, "rb");
+    if (fichier == NULL) {
+        perror("Erreur lors de l'ouverture du fichier BLAST");
+        return NULL;
+    }
+
+    long taille_fichier = fseek(fichier, 0, SEEK_END) == 0 ? ftell(fichier) : -1;
+    if (taille_fichier < 0) {
+        perror("Erreur lors de la lecture du fichier BLAST");
+        fclose(fichier);
+        return NULL;
+    }
+    rewind(fichier);
+
+    // Le fichier est lu en un seul bloc puis découpé en place
+    char *contenu = malloc(taille_fichier + 1);
+    if (contenu == NULL) {
+        printf("Erreur d'allocation mémoire\n");
+        fclose(fichier);
+        return NULL;
+    }
+    size_t lus = fread(contenu, 1, taille_fichier, fichier);
+    fclose(fichier);
+    contenu[lus] = '\0';
+
+    TableBlast *table = calloc(1, sizeof(TableBlast));
+    if (table == NULL) {
+        free(contenu);
+        return NULL;
+    }
+    initialiser_dictionnaire(&table->requetes);
+    initialiser_dictionnaire(&table->sujets);
+    table->requetes.dernier = -1;
+    table->sujets.dernier = -1;
+
+    const char *p = contenu;
+    const char *fin = contenu + lus;
+    while (p < fin) {
+        const char *fin_ligne = memchr(p, '\n', fin - p);
+        if (fin_ligne == NULL) fin_ligne = fin;
+
+        // Les lignes de commentaire (# Fields, # hits found...) et les lignes vides sont ignorées
+        if (fin_ligne > p && *p != '#' && *p != '\r' && *p != '\n') {
+            const char *fin_utile = fin_ligne;
+            if (fin_utile > p && fin_utile[-1] == '\r') fin_utile--;
+            if (analyser_ligne_blast(table, p, fin_utile) < 0) {
+                printf("Erreur d'allocation mémoire lors du chargement de %s\n", chemin_fichier);
+                liberer_table_blast(table);
+                free(contenu);
+                return NULL;
+            }
+        }
+        p = fin_ligne + 1;
+    }
+
+    free(contenu);
+    return table;
+}
+
+void liberer_table_blast(TableBlast *table) {
+    if (table == NULL) return;
+    free(table->indice_requete);
+    free(table->indice_sujet);
+    free(table->identite);
+    free(table->longueur_alignement);
+    free(table->mesappariements);
+    free(table->ouvertures_gap);
+    free(table->debut_requete);
+    free(table->fin_requete);
+    free(table->debut_sujet);
+    free(table->fin_sujet);
+    free(table->evalue);
+    free(table->score_bits);
+    liberer_dictionnaire(&table->requetes);
+    liberer_dictionnaire(&table->sujets);
+    free(table);
+}
+
+int* blast_hits_par_sujet(const TableBlast *table, int indice_requete) {
+    int *compte = calloc(table->sujets.nombre > 0 ? table->sujets.nombre : 1, sizeof(int));
+    if (compte == NULL) return NULL;
+
+    for (int i = 0; i < table->nombre_hits; i++) {
+        if (indice_requete >= 0 && table->indice_requete[i] != indice_requete) continue;
+        compte[table->indice_sujet[i]]++;
+    }
+    return compte;
+}
+
+int* blast_distribution_copies(const TableBlast *table, int indice_requete, int *copies_max) {
+    int *compte = blast_hits_par_sujet(table, indice_requete);
+    if (compte == NULL) return NULL;
+
+    int maximum = 0;
+    for (int s = 0; s < table->sujets.nombre; s++) {
+        if (compte[s] > maximum) maximum = compte[s];
+    }
+
+    int *histogramme = calloc(maximum + 1, sizeof(int));
+    if (histogramme == NULL) {
+        free(compte);
+        return NULL;
+    }
+    for (int s = 0; s < table->sujets.nombre; s++) {
+        histogramme[compte[s]]++;
+    }
+
+    free(compte);
+    *copies_max = maximum;
+    return histogramme;
+}
+
+static int comparer_int64(const void *a, const void *b) {
+    int64_t x = *(const int64_t*)a;
+    int64_t y = *(const int64_t*)b;
+    return (x > y) - (x < y);
+}
+
+// Extrait, trie et groupe par sujet les positions (coordonnée la plus basse) des hits d'une requête.
+// Le tableau `debut_par_sujet` (nombre_sujets + 1 cases) donne les bornes de chaque sujet dans `positions`.
+static int64_t* positions_triees_par_sujet(const TableBlast *table, int indice_requete, int **debut_par_sujet) {
+    int nombre_sujets = table->sujets.nombre;
+    int *debut = calloc(nombre_sujets + 1, sizeof(int));
+    int64_t *positions = malloc((table->nombre_hits > 0 ? table->nombre_hits : 1) * sizeof(int64_t));
+    if (debut == NULL || positions == NULL) {
+        free(debut);
+        free(positions);
+        return NULL;
+    }
+
+    // Tri par comptage sur l'indice de sujet, puis tri des positions à l'intérieur de chaque sujet
+    for (int i = 0; i < table->nombre_hits; i++) {
+        if (indice_requete >= 0 && table->indice_requete[i] != indice_requete) continue;
+        debut[table->indice_sujet[i] + 1]++;
+    }
+    for (int s = 0; s < nombre_sujets; s++) debut[s + 1] += debut[s];
+
+    int *curseur = malloc((nombre_sujets > 0 ? nombre_sujets : 1) * sizeof(int));
+    if (curseur == NULL) {
+        free(debut);
+        free(positions);
+        return NULL;
+    }
+    memcpy(curseur, debut, nombre_sujets * sizeof(int));
+    for (int i = 0; i < table->nombre_hits; i++) {
+        if (indice_requete >= 0 && table->indice_requete[i] != indice_requete) continue;
+        int64_t a = table->debut_sujet[i];
+        int64_t b = table->fin_sujet[i];
+        positions[curseur[table->indice_sujet[i]]++] = a < b ? a : b;
+    }
+    free(curseur);
+
+    for (int s = 0; s < nombre_sujets; s++) {
+        qsort(positions + debut[s], debut[s + 1] - debut[s], sizeof(int64_t), comparer_int64);
+    }
+
+    *debut_par_sujet = debut;
+    return positions;
+}
+
+GroupeHitsBlast* blast_regrouper_positions(const TableBlast *table, int indice_requete, int64_t distance_max,
+                                           int *nombre_groupes) {
+    int *debut = NULL;
+    int64_t *positions = positions_triees_par_sujet(table, indice_requete, &debut);
+    if (positions == NULL) return NULL;
+
+    // Allocation non vide même sans groupe : NULL signale seulement une erreur
+    int capacite = 1;
+    int nombre = 0;
+    GroupeHitsBlast *groupes = malloc(sizeof(GroupeHitsBlast));
+    if (groupes == NULL) {
+        free(positions);
+        free(debut);
+        return NULL;
+    }
+
+    for (int s = 0; s < table->sujets.nombre; s++) {
+        for (int i = debut[s]; i < debut[s + 1]; i++) {
+            // Nouveau groupe si l'écart avec le hit précédent dépasse la distance autorisée
+            if (i == debut[s] || positions[i] - positions[i - 1] > distance_max) {
+                if (nombre == capacite) {
+                    capacite = capacite < 64 ? 64 : capacite * 2;
+                    GroupeHitsBlast *p = realloc(groupes, capacite * sizeof(GroupeHitsBlast));
+                    if (p == NULL) {
+                        free(groupes);
+                        free(positions);
+                        free(debut);
+                        return NULL;
+                    }
+                    groupes = p;
+                }
+                groupes[nombre].indice_sujet = s;
+                groupes[nombre].debut = positions[i];
+                groupes[nombre].nombre_hits = 0;
+                nombre++;
+            }
+            groupes[nombre - 1].fin = positions[i];
+            groupes[nombre - 1].nombre_hits++;
+        }
+    }
+
+    free(positions);
+    free(debut);
+    *nombre_groupes = nombre;
+    return groupes;
+}
+
+EcartMotifsBlast* blast_ecart_motifs(const TableBlast *table, int requete_a, int requete_b) {
+    int *debut_a = NULL;
+    int *debut_b = NULL;
+    int64_t *positions_a = positions_triees_par_sujet(table, requete_a, &debut_a);
+    int64_t *positions_b = positions_triees_par_sujet(table, requete_b, &debut_b);
+    EcartMotifsBlast *ecarts = calloc(table->sujets.nombre > 0 ? table->sujets.nombre : 1, sizeof(EcartMotifsBlast));
+    if (positions_a == NULL || positions_b == NULL || ecarts == NULL) {
+        free(positions_a); free(debut_a);
+        free(positions_b); free(debut_b);
+        free(ecarts);
+        return NULL;
+    }
+
+    for (int s = 0; s < table->sujets.nombre; s++) {
+        EcartMotifsBlast *e = &ecarts[s];
+        e->ecart_min = -1;
+        e->ecart_max = -1;
+        if (debut_a[s] == debut_a[s + 1] || debut_b[s] == debut_b[s + 1]) continue;
+
+        // Fusion des deux listes triées : pour chaque hit de A, distance au hit de B le plus proche
+        int j = debut_b[s];
+        double somme = 0.0;
+        for (int i = debut_a[s]; i < debut_a[s + 1]; i++) {
+            while (j + 1 < debut_b[s + 1] && positions_b[j + 1] <= positions_a[i]) j++;
+            int64_t ecart = llabs(positions_a[i] - positions_b[j]);
+            if (j + 1 < debut_b[s + 1]) {
+                int64_t ecart_suivant = llabs(positions_b[j + 1] - positions_a[i]);
+                if (ecart_suivant < ecart) ecart = ecart_suivant;
+            }
+            if (e->ecart_min < 0 || ecart < e->ecart_min) e->ecart_min = ecart;
+            if (ecart > e->ecart_max) e->ecart_max = ecart;
+            somme += (double)ecart;
+            e->nombre_paires++;
+        }
+        e->ecart_moyen = somme / e->nombre_paires;
+    }
+
+    free(positions_a); free(debut_a);
+    free(positions_b); free(debut_b);
+    return ecarts;
+}
+
+void afficher_resume_blast(const TableBlast *table, int64_t distance_groupe) {
+    printf("Hits chargés : %d (%d requête(s), %d sujet(s))\n",
+           table->nombre_hits, table->requetes.nombre, table->sujets.nombre);
+
+    for (int q = 0; q < table->requetes.nombre; q++) {
+        printf("\n====== Requête %s ======\n", table->requetes.noms[q]);
+
+        int copies_max = 0;
+        int *histogramme = blast_distribution_copies(table, q, &copies_max);
+        if (histogramme != NULL) {
+            printf("Distribution du nombre de copies (copies : sujets) :\n");
+            for (int c = 1; c <= copies_max; c++) {
+                if (histogramme[c] > 0) printf("  %d : %d\n", c, histogramme[c]);
+            }
+            free(histogramme);
+        }
+
+        int nombre_groupes = 0;
+        GroupeHitsBlast *groupes = blast_regrouper_positions(table, q, distance_groupe, &nombre_groupes);
+        if (groupes != NULL) {
+            int groupes_multiples = 0;
+            for (int g = 0; g < nombre_groupes; g++) {
+                if (groupes[g].nombre_hits > 1) groupes_multiples++;
+            }
+            printf("Groupes de hits (distance <= %lld) : %d, dont %d avec plusieurs copies\n",
+                   (long long)distance_groupe, nombre_groupes, groupes_multiples);
+            free(groupes);
+        } else {
+            printf("Erreur d'allocation mémoire\n");
+        }
+    }
+}
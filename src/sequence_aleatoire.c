@@ -39,3 +39,41 @@ void ecrire_fichier_sequence(const char *sequence, const char *chemin_fichier) {
     fclose(fichier);
     printf("Séquence écrite dans %s\n", chemin_fichier);
 }
+
+// Générateur splitmix64 : chaque bloc a le sien, initialisé à partir de la graine et de son indice
+static uint64_t suivant_splitmix64(uint64_t *etat) {
+    uint64_t z = (*etat += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+typedef struct {
+    char *sequence;
+    uint64_t graine;
+} GenerationParallele;
+
+static void generer_bloc(const BlocParallele *bloc, void *contexte) {
+    GenerationParallele *generation = contexte;
+    uint64_t etat = generation->graine ^ ((uint64_t)bloc->indice * 0xD1B54A32D192ED03ULL);
+    for (int64_t i = bloc->debut; i < bloc->fin; i++) {
+        // Mêmes fréquences que generer_nucleotide
+        double tirage = (double)(suivant_splitmix64(&etat) >> 11) / (double)(1ULL << 53);
+        if (tirage < 0.246) generation->sequence[i] = 'A';
+        else if (tirage < 0.490) generation->sequence[i] = 'T';
+        else if (tirage < 0.745) generation->sequence[i] = 'C';
+        else generation->sequence[i] = 'G';
+    }
+}
+
+char* generer_sequence_parallele(int longueur_seq, uint64_t graine) {
+    char *sequence = malloc((longueur_seq + 1) * sizeof(char));
+    if (sequence == NULL) {
+        printf("Erreur : Allocation mémoire échouée\n");
+        return NULL;
+    }
+    GenerationParallele generation = {sequence, graine};
+    pool_parallel_for(pool_global(), 0, longueur_seq, TAILLE_BLOC_PARALLELE, 0, generer_bloc, &generation);
+    sequence[longueur_seq] = '\0';
+    return sequence;
+}
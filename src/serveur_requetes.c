@@ -0,0 +1,481 @@
+// serveur_requetes.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <time.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "projet.h"
+
+#define POSITIONS_MAX_REPONSE 1000  // Positions listées au plus par une réponse POS (le total est toujours donné)
+#define PAIRES_MAX_REPONSE 1000     // Paires de boîtes listées au plus par une réponse PROMOTEUR
+#define RESULTATS_MAX_GENE 8        // Alignements listés au plus par une réponse GENE
+
+ServeurGenome* creer_serveur_genome(const char *genome, int longueur_genome, const AnnotationGenes *annotation,
+                                    const MasqueExclusion *masque) {
+    ServeurGenome *serveur = calloc(1, sizeof(ServeurGenome));
+    if (serveur == NULL) return NULL;
+    serveur->genome = genome;
+    serveur->longueur_genome = longueur_genome;
+    serveur->annotation = annotation;
+    serveur->masque = masque;
+    serveur->index = construire_index_suffixes(genome, longueur_genome);
+    serveur->index_kmers = construire_index_kmers(genome, longueur_genome, LONGUEUR_GRAINE_GENE);
+    if (serveur->index == NULL || serveur->index_kmers == NULL) {
+        liberer_serveur_genome(serveur);
+        return NULL;
+    }
+    return serveur;
+}
+
+void liberer_serveur_genome(ServeurGenome *serveur) {
+    if (serveur == NULL) return;
+    liberer_index_suffixes(serveur->index);
+    liberer_index_kmers(serveur->index_kmers);
+    free(serveur);
+}
+
+// Réponse en cours de construction, agrandie au besoin
+typedef struct {
+    char *texte;
+    size_t longueur;
+    size_t capacite;
+    int erreur;
+} Reponse;
+
+static void ajouter_reponse(Reponse *reponse, const char *format, ...) {
+    if (reponse->erreur) return;
+    for (;;) {
+        va_list arguments;
+        va_start(arguments, format);
+        size_t disponible = reponse->capacite - reponse->longueur;
+        int ecrits = vsnprintf(reponse->texte == NULL ? NULL : reponse->texte + reponse->longueur, disponible,
+                               format, arguments);
+        va_end(arguments);
+        if (ecrits < 0) {
+            reponse->erreur = 1;
+            return;
+        }
+        if ((size_t)ecrits < disponible) {
+            reponse->longueur += ecrits;
+            return;
+        }
+        size_t capacite = reponse->capacite == 0 ? 128 : reponse->capacite;
+        while (capacite - reponse->longueur <= (size_t)ecrits) capacite *= 2;
+        char *texte = realloc(reponse->texte, capacite);
+        if (texte == NULL) {
+            reponse->erreur = 1;
+            return;
+        }
+        reponse->texte = texte;
+        reponse->capacite = capacite;
+    }
+}
+
+// Un motif de requête ne contient que A, C, G et T
+static bool motif_valide(const char *motif) {
+    if (*motif == '\0') return false;
+    for (const char *c = motif; *c; c++) {
+        if (code_nucleotide(*c) < 0) return false;
+    }
+    return true;
+}
+
+static void repondre_count(const ServeurGenome *serveur, char *arguments, Reponse *reponse) {
+    char *reste = NULL;
+    char *motif = strtok_r(arguments, " \t\r", &reste);
+    char *texte_mismatches = strtok_r(NULL, " \t\r", &reste);
+    int mismatches = texte_mismatches != NULL ? atoi(texte_mismatches) : 0;
+    if (motif == NULL || !motif_valide(motif)) {
+        ajouter_reponse(reponse, "ERR motif invalide");
+    } else if (mismatches < 0 || mismatches > 3) {
+        ajouter_reponse(reponse, "ERR mésappariements entre 0 et 3");
+    } else if (mismatches == 0) {
+        ajouter_reponse(reponse, "OK %d", compter_occurrences_index(serveur->index, motif, strlen(motif), 0, 0,
+                                                                    serveur->masque));
+    } else {
+        ajouter_reponse(reponse, "OK %d", compter_occurrences_approchees(serveur->index, motif, strlen(motif),
+                                                                         mismatches, 0, 0, serveur->masque));
+    }
+}
+
+static void repondre_pos(const ServeurGenome *serveur, char *arguments, Reponse *reponse) {
+    char *reste = NULL;
+    char *motif = strtok_r(arguments, " \t\r", &reste);
+    char *texte_max = strtok_r(NULL, " \t\r", &reste);
+    int nombre_max = texte_max != NULL ? atoi(texte_max) : POSITIONS_MAX_REPONSE;
+    if (motif == NULL || !motif_valide(motif)) {
+        ajouter_reponse(reponse, "ERR motif invalide");
+        return;
+    }
+    int nombre = 0;
+    int *positions = positions_occurrences(serveur->index, motif, strlen(motif), serveur->masque, &nombre);
+    if (positions == NULL && nombre > 0) {
+        ajouter_reponse(reponse, "ERR mémoire");
+        return;
+    }
+    ajouter_reponse(reponse, "OK %d", nombre);
+    for (int i = 0; i < nombre && i < nombre_max; i++) ajouter_reponse(reponse, " %d", positions[i]);
+    free(positions);
+}
+
+static void repondre_gene(const ServeurGenome *serveur, char *arguments, Reponse *reponse) {
+    char *reste = NULL;
+    char *requete = strtok_r(arguments, " \t\r", &reste);
+    char *texte_identite = strtok_r(NULL, " \t\r", &reste);
+    if (requete == NULL) {
+        ajouter_reponse(reponse, "ERR gène manquant");
+        return;
+    }
+
+    // Une séquence est alignée sur le génome (graines de l'index des k-mers) ; un nom est cherché dans l'annotation
+    if (motif_valide(requete) && (int)strlen(requete) >= LONGUEUR_GRAINE_GENE) {
+        double identite = texte_identite != NULL ? atof(texte_identite) : IDENTITE_MIN;
+        AlignementGene resultats[RESULTATS_MAX_GENE];
+        int nombre = rechercher_gene_graines(serveur->index_kmers, serveur->genome, requete, identite, resultats,
+                                             RESULTATS_MAX_GENE);
+        if (nombre < 0) {
+            ajouter_reponse(reponse, "ERR mémoire");
+            return;
+        }
+        ajouter_reponse(reponse, "OK %d", nombre);
+        for (int r = 0; r < nombre && r < RESULTATS_MAX_GENE; r++) {
+            ajouter_reponse(reponse, " %d:%d:%c:%.4f:%s", resultats[r].debut, resultats[r].fin, resultats[r].brin,
+                            resultats[r].identite, resultats[r].cigar);
+            liberer_alignement_gene(&resultats[r]);
+        }
+        return;
+    }
+    if (serveur->annotation == NULL) {
+        ajouter_reponse(reponse, "ERR aucune annotation chargée");
+        return;
+    }
+    int nombre = 0;
+    for (int g = 0; g < serveur->annotation->nombre; g++) {
+        if (strcmp(serveur->annotation->genes[g].nom, requete) == 0) nombre++;
+    }
+    ajouter_reponse(reponse, "OK %d", nombre);
+    for (int g = 0; g < serveur->annotation->nombre; g++) {
+        const GeneAnnote *gene = &serveur->annotation->genes[g];
+        if (strcmp(gene->nom, requete) == 0) ajouter_reponse(reponse, " %d:%d:%c", gene->debut, gene->fin, gene->brin);
+    }
+}
+
+static void repondre_promoteur(const ServeurGenome *serveur, char *arguments, Reponse *reponse) {
+    char *reste = NULL;
+    char *texte_position = strtok_r(arguments, " \t\r", &reste);
+    char *texte_amont = strtok_r(NULL, " \t\r", &reste);
+    int bases_amont = texte_amont != NULL ? atoi(texte_amont) : LONGEUR_SEQUENCE_ETUDIE_CONSENSUS;
+    if (texte_position == NULL || bases_amont < 1) {
+        ajouter_reponse(reponse, "ERR position manquante");
+        return;
+    }
+    int position = atoi(texte_position);
+    if (position < 0 || position > serveur->longueur_genome) {
+        ajouter_reponse(reponse, "ERR position hors du génome");
+        return;
+    }
+    int debut = position > bases_amont ? position - bases_amont : 0;
+    int paires[2 * PAIRES_MAX_REPONSE];
+    int nombre = lister_paires_consensus(serveur->genome, debut, position, BOITE_35, BOITE_10, paires,
+                                         PAIRES_MAX_REPONSE);
+    ajouter_reponse(reponse, "OK %d", nombre);
+    for (int p = 0; p < nombre && p < PAIRES_MAX_REPONSE; p++) {
+        ajouter_reponse(reponse, " %d:%d", paires[2 * p], paires[2 * p + 1]);
+    }
+}
+
+ActionServeur repondre_requete(const ServeurGenome *serveur, const char *ligne, char **texte_reponse) {
+    Reponse reponse = {NULL, 0, 0, 0};
+    ActionServeur action = ACTION_CONTINUER;
+    char *copie = strdup(ligne);
+    char *reste = NULL;
+    char *commande = copie != NULL ? strtok_r(copie, " \t\r", &reste) : NULL;
+    char *arguments = reste != NULL ? reste : "";
+    if (copie == NULL) {
+        reponse.erreur = 1;
+    } else if (commande == NULL) {
+        ajouter_reponse(&reponse, "ERR requête vide");
+    } else if (strcmp(commande, "COUNT") == 0) {
+        repondre_count(serveur, arguments, &reponse);
+    } else if (strcmp(commande, "POS") == 0) {
+        repondre_pos(serveur, arguments, &reponse);
+    } else if (strcmp(commande, "GENE") == 0) {
+        repondre_gene(serveur, arguments, &reponse);
+    } else if (strcmp(commande, "PROMOTEUR") == 0) {
+        repondre_promoteur(serveur, arguments, &reponse);
+    } else if (strcmp(commande, "STATS") == 0) {
+        ajouter_reponse(&reponse, "OK requetes=%lld latence_moyenne_us=%.1f latence_max_us=%.1f",
+                        (long long)serveur->requetes,
+                        serveur->requetes > 0 ? serveur->latence_totale_us / serveur->requetes : 0.0,
+                        serveur->latence_max_us);
+    } else if (strcmp(commande, "QUIT") == 0) {
+        ajouter_reponse(&reponse, "OK");
+        action = ACTION_FERMER;
+    } else if (strcmp(commande, "ARRET") == 0) {
+        ajouter_reponse(&reponse, "OK");
+        action = ACTION_ARRETER;
+    } else {
+        ajouter_reponse(&reponse, "ERR commande inconnue : %s", commande);
+    }
+    free(copie);
+    if (reponse.erreur) {
+        free(reponse.texte);
+        *texte_reponse = NULL;
+        return action;
+    }
+    *texte_reponse = reponse.texte;
+    return action;
+}
+
+int ouvrir_socket_serveur(const char *chemin_socket) {
+    struct sockaddr_un adresse;
+    memset(&adresse, 0, sizeof(adresse));
+    adresse.sun_family = AF_UNIX;
+    if (strlen(chemin_socket) >= sizeof(adresse.sun_path)) {
+        printf("Chemin de socket trop long : %s\n", chemin_socket);
+        return -1;
+    }
+    strcpy(adresse.sun_path, chemin_socket);
+
+    int socket_ecoute = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (socket_ecoute < 0) {
+        perror("Erreur lors de la création de la socket");
+        return -1;
+    }
+    unlink(chemin_socket);  // Socket laissée par un serveur précédent
+    if (bind(socket_ecoute, (struct sockaddr*)&adresse, sizeof(adresse)) != 0 ||
+        listen(socket_ecoute, CLIENTS_MAX_SERVEUR) != 0) {
+        perror("Erreur lors de l'ouverture de la socket");
+        close(socket_ecoute);
+        return -1;
+    }
+    return socket_ecoute;
+}
+
+// Client connecté : octets reçus dont la ligne n'est pas encore complète, réponses pas encore envoyées
+// (les sockets sont non bloquantes : un client qui ne lit pas ses réponses ne bloque pas les autres)
+typedef struct {
+    int descripteur;
+    char *tampon;
+    size_t longueur;
+    char *sortie;
+    size_t longueur_sortie;
+    size_t capacite_sortie;
+    int fermer;                    // Déconnecter une fois les réponses en attente envoyées
+} ClientServeur;
+
+// Requête d'un lot : reçue d'un client, traitée par un bloc du pool
+typedef struct {
+    int client;
+    char *ligne;
+    char *reponse;
+    ActionServeur action;
+    struct timespec reception;
+    double latence_us;
+} RequeteLot;
+
+typedef struct {
+    const ServeurGenome *serveur;
+    RequeteLot *requetes;
+} LotRequetes;
+
+static double microsecondes_depuis(const struct timespec *debut) {
+    struct timespec maintenant;
+    clock_gettime(CLOCK_MONOTONIC, &maintenant);
+    return (maintenant.tv_sec - debut->tv_sec) * 1e6 + (maintenant.tv_nsec - debut->tv_nsec) / 1e3;
+}
+
+static void traiter_requete_bloc(const BlocParallele *bloc, void *contexte) {
+    LotRequetes *lot = contexte;
+    RequeteLot *requete = &lot->requetes[bloc->indice];
+    requete->action = repondre_requete(lot->serveur, requete->ligne, &requete->reponse);
+    requete->latence_us = microsecondes_depuis(&requete->reception);
+}
+
+// Met des octets en attente d'envoi ; retourne -1 si le client laisse plus de TAILLE_MAX_SORTIE_CLIENT octets non lus
+static int ajouter_sortie(ClientServeur *client, const char *donnees, size_t longueur) {
+    if (client->longueur_sortie + longueur > TAILLE_MAX_SORTIE_CLIENT) return -1;
+    if (client->longueur_sortie + longueur > client->capacite_sortie) {
+        size_t capacite = client->capacite_sortie == 0 ? 4096 : client->capacite_sortie;
+        while (capacite < client->longueur_sortie + longueur) capacite *= 2;
+        char *sortie = realloc(client->sortie, capacite);
+        if (sortie == NULL) return -1;
+        client->sortie = sortie;
+        client->capacite_sortie = capacite;
+    }
+    memcpy(client->sortie + client->longueur_sortie, donnees, longueur);
+    client->longueur_sortie += longueur;
+    return 0;
+}
+
+// Envoie ce que la socket accepte sans attendre ; retourne -1 si la connexion est rompue
+static int envoyer_sortie(ClientServeur *client) {
+    size_t envoyes = 0;
+    int resultat = 0;
+    while (envoyes < client->longueur_sortie) {
+        ssize_t n = send(client->descripteur, client->sortie + envoyes, client->longueur_sortie - envoyes,
+                         MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) resultat = -1;
+            break;
+        }
+        envoyes += n;
+    }
+    memmove(client->sortie, client->sortie + envoyes, client->longueur_sortie - envoyes);
+    client->longueur_sortie -= envoyes;
+    return resultat;
+}
+
+// Déconnexion sans attendre l'envoi des réponses (connexion rompue ou client qui ne lit pas)
+static void abandonner_client(ClientServeur *client) {
+    client->longueur_sortie = 0;
+    client->fermer = 1;
+}
+
+// Lit ce qu'un client a envoyé et ajoute ses lignes complètes au lot ; retourne -1 s'il faut le déconnecter
+static int lire_client(ClientServeur *client, int indice_client, RequeteLot **lot, int *nombre, int *capacite,
+                       const struct timespec *reception) {
+    char tampon[65536];
+    ssize_t lus = recv(client->descripteur, tampon, sizeof(tampon), 0);
+    if (lus < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) return 0;
+    if (lus <= 0) return -1;
+    char *agrandi = realloc(client->tampon, client->longueur + lus + 1);
+    if (agrandi == NULL) return -1;
+    client->tampon = agrandi;
+    memcpy(client->tampon + client->longueur, tampon, lus);
+    client->longueur += lus;
+
+    size_t debut = 0;
+    for (size_t i = 0; i < client->longueur; i++) {
+        if (client->tampon[i] != '\n') continue;
+        client->tampon[i] = '\0';
+        if (*nombre == *capacite) {
+            int nouvelle_capacite = *capacite == 0 ? 64 : 2 * *capacite;
+            RequeteLot *nouveau = realloc(*lot, nouvelle_capacite * sizeof(RequeteLot));
+            if (nouveau == NULL) return -1;
+            *lot = nouveau;
+            *capacite = nouvelle_capacite;
+        }
+        RequeteLot requete = {indice_client, strdup(client->tampon + debut), NULL, ACTION_CONTINUER, *reception, 0};
+        if (requete.ligne == NULL) return -1;
+        (*lot)[(*nombre)++] = requete;
+        debut = i + 1;
+    }
+    memmove(client->tampon, client->tampon + debut, client->longueur - debut);
+    client->longueur -= debut;
+    return client->longueur > TAILLE_MAX_REQUETE ? -1 : 0;
+}
+
+static void deconnecter_client(ClientServeur *clients, int *nombre_clients, int indice) {
+    close(clients[indice].descripteur);
+    free(clients[indice].tampon);
+    free(clients[indice].sortie);
+    clients[indice] = clients[--*nombre_clients];
+}
+
+int servir_requetes(ServeurGenome *serveur, int socket_ecoute) {
+    ClientServeur clients[CLIENTS_MAX_SERVEUR];
+    struct pollfd descripteurs[CLIENTS_MAX_SERVEUR + 1];
+    int nombre_clients = 0;
+    RequeteLot *lot = NULL;
+    int capacite_lot = 0;
+    int arret = 0;
+
+    while (!arret) {
+        descripteurs[0].fd = socket_ecoute;
+        descripteurs[0].events = POLLIN;
+        for (int c = 0; c < nombre_clients; c++) {
+            descripteurs[c + 1].fd = clients[c].descripteur;
+            descripteurs[c + 1].events = (clients[c].fermer ? 0 : POLLIN) | (clients[c].longueur_sortie > 0 ? POLLOUT : 0);
+        }
+        if (poll(descripteurs, nombre_clients + 1, -1) < 0) {
+            if (errno == EINTR) continue;
+            perror("Erreur d'attente des requêtes");
+            break;
+        }
+        struct timespec reception;
+        clock_gettime(CLOCK_MONOTONIC, &reception);
+
+        // Toutes les lignes complètes reçues depuis le dernier réveil forment un lot
+        int nombre_requetes = 0;
+        int clients_sondes = nombre_clients;
+        for (int c = 0; c < clients_sondes; c++) {
+            if (clients[c].fermer || (descripteurs[c + 1].revents & (POLLIN | POLLHUP | POLLERR)) == 0) continue;
+            // Fin de connexion côté client : les réponses déjà dues sont encore envoyées
+            if (lire_client(&clients[c], c, &lot, &nombre_requetes, &capacite_lot, &reception) != 0) {
+                clients[c].fermer = 1;
+            }
+        }
+
+        // Le lot est réparti sur les threads du pool, une requête par bloc
+        if (nombre_requetes > 0) {
+            LotRequetes contexte = {serveur, lot};
+            pool_parallel_for(pool_global(), 0, nombre_requetes, 1, 0, traiter_requete_bloc, &contexte);
+        }
+
+        // Réponses dans l'ordre de réception, suivies de la latence de chaque requête, mises en attente d'envoi
+        for (int r = 0; r < nombre_requetes; r++) {
+            RequeteLot *requete = &lot[r];
+            ClientServeur *client = &clients[requete->client];
+            serveur->requetes++;
+            serveur->latence_totale_us += requete->latence_us;
+            if (requete->latence_us > serveur->latence_max_us) serveur->latence_max_us = requete->latence_us;
+            if (!client->fermer) {
+                char latence[64];
+                snprintf(latence, sizeof(latence), "\tlatence_us=%.1f\n", requete->latence_us);
+                const char *texte = requete->reponse != NULL ? requete->reponse : "ERR mémoire";
+                if (ajouter_sortie(client, texte, strlen(texte)) != 0 ||
+                    ajouter_sortie(client, latence, strlen(latence)) != 0) {
+                    printf("Client déconnecté : plus de %d octets de réponses non lus\n", TAILLE_MAX_SORTIE_CLIENT);
+                    abandonner_client(client);
+                }
+            }
+            if (requete->action == ACTION_FERMER) client->fermer = 1;
+            if (requete->action == ACTION_ARRETER) arret = 1;
+            free(requete->ligne);
+            free(requete->reponse);
+        }
+
+        // Envois sans attente : ce que la socket n'accepte pas encore attend le prochain POLLOUT
+        for (int c = 0; c < clients_sondes; c++) {
+            if (clients[c].longueur_sortie > 0 && envoyer_sortie(&clients[c]) != 0) abandonner_client(&clients[c]);
+        }
+
+        // Déconnexions, de la fin vers le début (un client déconnecté est remplacé par le dernier)
+        for (int c = clients_sondes - 1; c >= 0; c--) {
+            if (clients[c].fermer && clients[c].longueur_sortie == 0) deconnecter_client(clients, &nombre_clients, c);
+        }
+
+        // Nouvelle connexion
+        if (descripteurs[0].revents & POLLIN) {
+            int descripteur = accept(socket_ecoute, NULL, NULL);
+            if (descripteur >= 0 && fcntl(descripteur, F_SETFL, fcntl(descripteur, F_GETFL) | O_NONBLOCK) != 0) {
+                close(descripteur);
+            } else if (descripteur >= 0 && nombre_clients == CLIENTS_MAX_SERVEUR) {
+                // Socket neuve : le message tient dans son tampon d'envoi
+                send(descripteur, "ERR trop de clients\n", 20, MSG_NOSIGNAL);
+                close(descripteur);
+            } else if (descripteur >= 0) {
+                ClientServeur client = {descripteur, NULL, 0, NULL, 0, 0, 0};
+                clients[nombre_clients++] = client;
+            }
+        }
+    }
+
+    // À l'arrêt, les réponses en attente sont envoyées si la socket les accepte encore
+    while (nombre_clients > 0) {
+        envoyer_sortie(&clients[nombre_clients - 1]);
+        deconnecter_client(clients, &nombre_clients, nombre_clients - 1);
+    }
+    free(lot);
+    printf("%lld requêtes traitées, latence moyenne %.1f µs, maximale %.1f µs\n", (long long)serveur->requetes,
+           serveur->requetes > 0 ? serveur->latence_totale_us / serveur->requetes : 0.0, serveur->latence_max_us);
+    return 0;
+}
@@ -0,0 +1,287 @@
+// spectre_kmers.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "projet.h"
+
+// Les k-mers sont répartis selon leurs premières bases : chaque partition couvre un intervalle de codes,
+// triée séparément, et leur concaténation dans l'ordre est triée
+#define BASES_PARTITION 3
+
+typedef struct {
+    const char *sequence;
+    int longueur_kmer;
+    int decalage_partition;        // Décalage amenant les premières bases du code en poids faible
+    int nombre_partitions;
+    int64_t *tailles;              // tailles[bloc * nombre_partitions + partition]
+    uint64_t *codes;               // Codes rangés par partition, puis par bloc
+    int pass_ecriture;
+} RepartitionKmers;
+
+// Parcourt les k-mers commençant dans le bloc : premier passage, compte par partition ; second, rangement
+static void repartir_kmers_bloc(const BlocParallele *bloc, void *contexte) {
+    RepartitionKmers *repartition = contexte;
+    int k = repartition->longueur_kmer;
+    uint64_t masque_code = masque_code_kmer(k);
+    int64_t *tailles = repartition->tailles + bloc->indice * repartition->nombre_partitions;
+    uint64_t code = 0;
+    int bases_valides = 0;
+    for (int64_t i = bloc->debut; i < bloc->fin_lecture; i++) {
+        int base = code_nucleotide(repartition->sequence[i]);
+        if (base < 0) {
+            bases_valides = 0;
+            continue;
+        }
+        code = ((code << 2) | (uint64_t)base) & masque_code;
+        if (++bases_valides < k) continue;
+        int partition = (int)(code >> repartition->decalage_partition);
+        if (repartition->pass_ecriture) repartition->codes[tailles[partition]++] = code;
+        else tailles[partition]++;
+    }
+}
+
+static int comparer_codes(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+typedef struct {
+    uint64_t *codes;
+    int64_t *debuts;               // Début de chaque partition dans `codes` (nombre_partitions + 1 valeurs)
+    int64_t *distincts;            // Nombre de k-mers distincts de chaque partition
+    int32_t *comptes;              // Compte de chaque k-mer distinct, au début de sa partition
+} ComptageSpectre;
+
+// Trie une partition et la réduit à ses k-mers distincts, rangés en tête de partition
+static void compter_partition(const BlocParallele *bloc, void *contexte) {
+    ComptageSpectre *comptage = contexte;
+    int64_t debut = comptage->debuts[bloc->indice], fin = comptage->debuts[bloc->indice + 1];
+    uint64_t *codes = comptage->codes;
+    qsort(codes + debut, fin - debut, sizeof(uint64_t), comparer_codes);
+    int64_t distincts = 0;
+    for (int64_t i = debut; i < fin;) {
+        int64_t j = i + 1;
+        while (j < fin && codes[j] == codes[i]) j++;
+        codes[debut + distincts] = codes[i];
+        comptage->comptes[debut + distincts] = (int32_t)(j - i);
+        distincts++;
+        i = j;
+    }
+    comptage->distincts[bloc->indice] = distincts;
+}
+
+SpectreKmers* calculer_spectre_kmers(const char *sequence, int longueur, int longueur_kmer) {
+    if (longueur_kmer < 1 || longueur_kmer > LONGUEUR_MAX_KMER_SPECTRE || longueur < longueur_kmer) return NULL;
+    int bases_partition = longueur_kmer < BASES_PARTITION ? longueur_kmer : BASES_PARTITION;
+    int nombre_partitions = 1 << (2 * bases_partition);
+    int64_t fin_debuts = (int64_t)longueur - longueur_kmer + 1;
+    int64_t nombre_blocs = nombre_blocs_parallele(0, fin_debuts, TAILLE_BLOC_PARALLELE);
+
+    SpectreKmers *spectre = calloc(1, sizeof(SpectreKmers));
+    int64_t *tailles = calloc(nombre_blocs * nombre_partitions, sizeof(int64_t));
+    int64_t *debuts = calloc(nombre_partitions + 1, sizeof(int64_t));
+    int64_t *distincts = calloc(nombre_partitions, sizeof(int64_t));
+    uint64_t *codes = malloc(fin_debuts * sizeof(uint64_t));
+    int32_t *comptes = malloc(fin_debuts * sizeof(int32_t));
+    if (spectre == NULL || tailles == NULL || debuts == NULL || distincts == NULL || codes == NULL || comptes == NULL) {
+        printf("Erreur d'allocation mémoire pour le spectre des k-mers\n");
+        free(spectre);
+        free(tailles);
+        free(debuts);
+        free(distincts);
+        free(codes);
+        free(comptes);
+        return NULL;
+    }
+    spectre->longueur_kmer = longueur_kmer;
+
+    // Premier passage : nombre de k-mers de chaque partition dans chaque bloc
+    RepartitionKmers repartition = {sequence, longueur_kmer, 2 * (longueur_kmer - bases_partition),
+                                    nombre_partitions, tailles, codes, 0};
+    pool_parallel_for(pool_global(), 0, fin_debuts, TAILLE_BLOC_PARALLELE, longueur_kmer - 1,
+                      repartir_kmers_bloc, &repartition);
+
+    // Positions d'écriture : partition par partition, puis bloc par bloc (ordre indépendant des threads)
+    int64_t position = 0;
+    for (int p = 0; p < nombre_partitions; p++) {
+        debuts[p] = position;
+        for (int64_t b = 0; b < nombre_blocs; b++) {
+            int64_t taille = tailles[b * nombre_partitions + p];
+            tailles[b * nombre_partitions + p] = position;
+            position += taille;
+        }
+    }
+    debuts[nombre_partitions] = position;
+    spectre->nombre_total = position;
+
+    // Second passage : rangement des codes, puis tri et comptage de chaque partition
+    repartition.pass_ecriture = 1;
+    pool_parallel_for(pool_global(), 0, fin_debuts, TAILLE_BLOC_PARALLELE, longueur_kmer - 1,
+                      repartir_kmers_bloc, &repartition);
+    ComptageSpectre comptage = {codes, debuts, distincts, comptes};
+    pool_parallel_for(pool_global(), 0, nombre_partitions, 1, 0, compter_partition, &comptage);
+    free(tailles);
+
+    // Concaténation des partitions : les k-mers distincts sont triés par code
+    int64_t nombre_distincts = 0;
+    for (int p = 0; p < nombre_partitions; p++) {
+        memmove(codes + nombre_distincts, codes + debuts[p], distincts[p] * sizeof(uint64_t));
+        memmove(comptes + nombre_distincts, comptes + debuts[p], distincts[p] * sizeof(int32_t));
+        nombre_distincts += distincts[p];
+    }
+    free(debuts);
+    free(distincts);
+    spectre->nombre_distincts = nombre_distincts;
+    spectre->codes = codes;
+    spectre->comptes = comptes;
+
+    // Spectre : nombre de k-mers distincts par nombre d'occurrences
+    for (int64_t i = 0; i < nombre_distincts; i++) {
+        if (comptes[i] > spectre->occurrences_max) spectre->occurrences_max = comptes[i];
+    }
+    spectre->spectre = calloc(spectre->occurrences_max + 1, sizeof(int64_t));
+    if (spectre->spectre == NULL) {
+        liberer_spectre_kmers(spectre);
+        return NULL;
+    }
+    for (int64_t i = 0; i < nombre_distincts; i++) spectre->spectre[comptes[i]]++;
+    return spectre;
+}
+
+void liberer_spectre_kmers(SpectreKmers *spectre) {
+    if (spectre == NULL) return;
+    free(spectre->codes);
+    free(spectre->comptes);
+    free(spectre->spectre);
+    free(spectre);
+}
+
+int occurrences_kmer_spectre(const SpectreKmers *spectre, uint64_t code) {
+    int64_t bas = 0, haut = spectre->nombre_distincts;
+    while (bas < haut) {
+        int64_t milieu = bas + (haut - bas) / 2;
+        if (spectre->codes[milieu] < code) bas = milieu + 1;
+        else haut = milieu;
+    }
+    return bas < spectre->nombre_distincts && spectre->codes[bas] == code ? spectre->comptes[bas] : 0;
+}
+
+// Comptes des m-mers et (m+1)-mers du génome, pour le modèle de Markov d'ordre m
+static int compter_mots_courts(const char *sequence, int longueur, int longueur_mot, int64_t *comptes) {
+    uint64_t masque_code = masque_code_kmer(longueur_mot);
+    uint64_t code = 0;
+    int bases_valides = 0;
+    int64_t total = 0;
+    for (int i = 0; i < longueur; i++) {
+        int base = code_nucleotide(sequence[i]);
+        if (base < 0) {
+            bases_valides = 0;
+            continue;
+        }
+        code = ((code << 2) | (uint64_t)base) & masque_code;
+        if (++bases_valides >= longueur_mot) {
+            comptes[code]++;
+            total++;
+        }
+    }
+    return total > 0 ? 0 : -1;
+}
+
+double occurrences_attendues_kmer(uint64_t code, int longueur_kmer, int ordre, const int64_t *comptes_ordre,
+                                  const int64_t *comptes_ordre_plus_un, int64_t nombre_positions) {
+    // E(w) = N(w[0..m]) N(w[1..m+1]) ... N(w[k-m-1..k-1]) / (N(w[1..m]) ... N(w[k-m-1..k-2])),
+    // avec N(mot vide) = nombre de positions pour l'ordre 0
+    uint64_t masque_plus_un = masque_code_kmer(ordre + 1);
+    uint64_t masque_ordre = ordre == 0 ? 0 : masque_code_kmer(ordre);
+    double attendu = 1.0;
+    for (int i = 0; i + ordre + 1 <= longueur_kmer; i++) {
+        int decalage = 2 * (longueur_kmer - i - ordre - 1);
+        attendu *= (double)comptes_ordre_plus_un[(code >> decalage) & masque_plus_un];
+        if (i > 0) {
+            double diviseur = ordre == 0 ? (double)nombre_positions
+                                         : (double)comptes_ordre[(code >> (decalage + 2)) & masque_ordre];
+            if (diviseur == 0) return 0;
+            attendu /= diviseur;
+        }
+    }
+    return attendu;
+}
+
+KmerSurrepresente* kmers_surrepresentes(const SpectreKmers *spectre, const char *sequence, int longueur,
+                                        int ordre, int nombre_max, int *nombre) {
+    *nombre = 0;
+    int k = spectre->longueur_kmer;
+    if (ordre > k - 2) ordre = k - 2;
+    if (ordre < 0 || ordre > ORDRE_MAX_MODELE_FOND || nombre_max < 1) return NULL;
+
+    int64_t *comptes_ordre = calloc((size_t)1 << (2 * ordre), sizeof(int64_t));
+    int64_t *comptes_ordre_plus_un = calloc((size_t)1 << (2 * (ordre + 1)), sizeof(int64_t));
+    KmerSurrepresente *meilleurs = malloc(nombre_max * sizeof(KmerSurrepresente));
+    if (comptes_ordre == NULL || comptes_ordre_plus_un == NULL || meilleurs == NULL) {
+        free(comptes_ordre);
+        free(comptes_ordre_plus_un);
+        free(meilleurs);
+        return NULL;
+    }
+    if ((ordre > 0 && compter_mots_courts(sequence, longueur, ordre, comptes_ordre) != 0) ||
+        compter_mots_courts(sequence, longueur, ordre + 1, comptes_ordre_plus_un) != 0) {
+        free(comptes_ordre);
+        free(comptes_ordre_plus_un);
+        free(meilleurs);
+        return NULL;
+    }
+    int64_t positions = 0;
+    for (int c = 0; c < 4; c++) positions += ordre == 0 ? comptes_ordre_plus_un[c] : 0;
+
+    // Les `nombre_max` meilleurs scores (obs - att) / sqrt(att), triés par insertion (décroissants)
+    for (int64_t i = 0; i < spectre->nombre_distincts; i++) {
+        double attendu = occurrences_attendues_kmer(spectre->codes[i], k, ordre, comptes_ordre,
+                                                    comptes_ordre_plus_un, positions);
+        if (attendu <= 0) continue;
+        double score = (spectre->comptes[i] - attendu) / sqrt(attendu);
+        if (*nombre == nombre_max && score <= meilleurs[nombre_max - 1].score) continue;
+        int j = *nombre < nombre_max ? (*nombre)++ : nombre_max - 1;
+        while (j > 0 && meilleurs[j - 1].score < score) {
+            meilleurs[j] = meilleurs[j - 1];
+            j--;
+        }
+        meilleurs[j].code = spectre->codes[i];
+        meilleurs[j].occurrences = spectre->comptes[i];
+        meilleurs[j].attendues = attendu;
+        meilleurs[j].score = score;
+    }
+    free(comptes_ordre);
+    free(comptes_ordre_plus_un);
+    return meilleurs;
+}
+
+int ecrire_spectre_kmers(const SpectreKmers *spectre, const char *chemin_fichier) {
+    FILE *fichier = fopen(chemin_fichier, "w");
+    if (fichier == NULL) {
+        perror("Erreur lors de l'ouverture du fichier du spectre");
+        return -1;
+    }
+    fprintf(fichier, "occurrences\tkmers_distincts\n");
+    for (int c = 1; c <= spectre->occurrences_max; c++) {
+        if (spectre->spectre[c] > 0) fprintf(fichier, "%d\t%lld\n", c, (long long)spectre->spectre[c]);
+    }
+    return fclose(fichier) == 0 ? 0 : -1;
+}
+
+int ecrire_kmers_surrepresentes(const KmerSurrepresente *kmers, int nombre, int longueur_kmer,
+                                const char *chemin_fichier) {
+    FILE *fichier = fopen(chemin_fichier, "w");
+    if (fichier == NULL) {
+        perror("Erreur lors de l'ouverture du fichier des k-mers surreprésentés");
+        return -1;
+    }
+    char kmer[LONGUEUR_MAX_KMER_CODE + 1];
+    fprintf(fichier, "kmer\toccurrences\toccurrences_attendues\trapport\tscore\n");
+    for (int i = 0; i < nombre; i++) {
+        decoder_kmer(kmers[i].code, longueur_kmer, kmer);
+        fprintf(fichier, "%s\t%d\t%.2f\t%.3f\t%.2f\n", kmer, kmers[i].occurrences, kmers[i].attendues,
+                kmers[i].occurrences / kmers[i].attendues, kmers[i].score);
+    }
+    return fclose(fichier) == 0 ? 0 : -1;
+}
@@ -0,0 +1,209 @@
+// stock_motifs.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "projet.h"
+
+StockMotifs* creer_stock_motifs(const char *genome, int capacite_initiale) {
+    StockMotifs *stock = calloc(1, sizeof(StockMotifs));
+    if (stock == NULL) return NULL;
+    stock->genome = genome;
+    if (capacite_initiale > 0 && reserver_stock_motifs(stock, capacite_initiale) != 0) {
+        liberer_stock_motifs(stock);
+        return NULL;
+    }
+    return stock;
+}
+
+void liberer_stock_motifs(StockMotifs *stock) {
+    if (stock == NULL) return;
+    for (int i = 0; stock->distributions != NULL && i < stock->nombre; i++) {
+        liberer_distribution_motif(stock->distributions[i]);
+    }
+    free(stock->positions);
+    free(stock->longueurs);
+    free(stock->fold_changes);
+    free(stock->occurrences_reelles);
+    free(stock->occurrences_aleatoires);
+    free(stock->approchees_reelles);
+    free(stock->approchees_aleatoires);
+    free(stock->distributions);
+    free(stock->decalages);
+    free(stock->reserve);
+    free(stock);
+}
+
+// Agrandit une colonne ; en cas d'échec, la colonne d'origine reste valide
+static int agrandir_colonne(void **colonne, int capacite, size_t taille_element) {
+    void *nouvelle = realloc(*colonne, (size_t)capacite * taille_element);
+    if (nouvelle == NULL) return -1;
+    *colonne = nouvelle;
+    return 0;
+}
+
+int reserver_stock_motifs(StockMotifs *stock, int capacite) {
+    if (capacite <= stock->capacite) return 0;
+    if (agrandir_colonne((void**)&stock->positions, capacite, sizeof(int32_t)) != 0 ||
+        agrandir_colonne((void**)&stock->longueurs, capacite, sizeof(int32_t)) != 0 ||
+        agrandir_colonne((void**)&stock->fold_changes, capacite, sizeof(double)) != 0 ||
+        agrandir_colonne((void**)&stock->occurrences_reelles, capacite, sizeof(int32_t)) != 0 ||
+        agrandir_colonne((void**)&stock->occurrences_aleatoires, capacite, sizeof(int32_t)) != 0 ||
+        agrandir_colonne((void**)&stock->approchees_reelles, capacite, sizeof(int32_t)) != 0 ||
+        agrandir_colonne((void**)&stock->approchees_aleatoires, capacite, sizeof(int32_t)) != 0 ||
+        agrandir_colonne((void**)&stock->distributions, capacite, sizeof(DistributionMotif*)) != 0 ||
+        (stock->genome == NULL && agrandir_colonne((void**)&stock->decalages, capacite, sizeof(int64_t)) != 0)) {
+        return -1;
+    }
+    stock->capacite = capacite;
+    return 0;
+}
+
+int ajouter_motif_stock(StockMotifs *stock, const char *sequence, int position, int longueur, double fold_change,
+                        int occurrences_reelles, int occurrences_aleatoires) {
+    if (stock->nombre == stock->capacite &&
+        reserver_stock_motifs(stock, stock->capacite == 0 ? 64 : 2 * stock->capacite) != 0) {
+        return -1;
+    }
+    // Sans génome, les séquences sont copiées bout à bout dans une seule réserve
+    if (stock->genome == NULL) {
+        if (sequence == NULL) return -1;
+        if (stock->taille_reserve + longueur > stock->capacite_reserve) {
+            int64_t capacite = stock->capacite_reserve == 0 ? 4096 : stock->capacite_reserve;
+            while (capacite < stock->taille_reserve + longueur) capacite *= 2;
+            char *reserve = realloc(stock->reserve, capacite);
+            if (reserve == NULL) return -1;
+            stock->reserve = reserve;
+            stock->capacite_reserve = capacite;
+        }
+        memcpy(stock->reserve + stock->taille_reserve, sequence, longueur);
+        stock->decalages[stock->nombre] = stock->taille_reserve;
+        stock->taille_reserve += longueur;
+    }
+    int i = stock->nombre++;
+    stock->positions[i] = position;
+    stock->longueurs[i] = longueur;
+    stock->fold_changes[i] = fold_change;
+    stock->occurrences_reelles[i] = occurrences_reelles;
+    stock->occurrences_aleatoires[i] = occurrences_aleatoires;
+    stock->approchees_reelles[i] = -1;
+    stock->approchees_aleatoires[i] = -1;
+    stock->distributions[i] = NULL;
+    return i;
+}
+
+const char* sequence_motif_stock(const StockMotifs *stock, int i) {
+    return stock->genome != NULL ? stock->genome + stock->positions[i] : stock->reserve + stock->decalages[i];
+}
+
+Motif vue_motif_stock(const StockMotifs *stock, int i) {
+    Motif motif = {(char*)sequence_motif_stock(stock, i), stock->positions[i], stock->longueurs[i],
+                   stock->fold_changes[i], stock->occurrences_reelles[i], stock->occurrences_aleatoires[i],
+                   stock->distributions[i], stock->approchees_reelles[i], stock->approchees_aleatoires[i]};
+    return motif;
+}
+
+// Clé de tri d'un motif : les meilleurs motifs ont les plus petites clés
+static double cle_motif(const StockMotifs *stock, int i, CritereMotifs critere, int position_reference) {
+    switch (critere) {
+        case CRITERE_FOLD_CHANGE: return -stock->fold_changes[i];
+        case CRITERE_LONGUEUR: return -stock->longueurs[i];
+        case CRITERE_DISTANCE_GENE: return abs(stock->positions[i] - position_reference);
+        case CRITERE_POSITION:
+        default: return stock->positions[i];
+    }
+}
+
+typedef struct {
+    double cle;
+    int32_t indice;
+} CleMotif;
+
+// À clés égales, l'ordre d'insertion est conservé (tri stable)
+static int comparer_cles_motifs(const void *a, const void *b) {
+    const CleMotif *x = a, *y = b;
+    if (x->cle != y->cle) return x->cle < y->cle ? -1 : 1;
+    return (x->indice > y->indice) - (x->indice < y->indice);
+}
+
+// Réordonne une colonne selon les indices triés, en passant par un tampon
+static void permuter_colonne(void *colonne, size_t taille_element, const CleMotif *ordre, int nombre, void *tampon) {
+    char *source = colonne, *destination = tampon;
+    for (int i = 0; i < nombre; i++) {
+        memcpy(destination + (size_t)i * taille_element, source + (size_t)ordre[i].indice * taille_element,
+               taille_element);
+    }
+    memcpy(colonne, tampon, (size_t)nombre * taille_element);
+}
+
+int trier_stock_motifs(StockMotifs *stock, CritereMotifs critere, int position_reference) {
+    int n = stock->nombre;
+    if (n < 2) return 0;
+    CleMotif *ordre = malloc(n * sizeof(CleMotif));
+    void *tampon = malloc((size_t)n * sizeof(double));  // Assez grand pour chaque colonne
+    if (ordre == NULL || tampon == NULL) {
+        free(ordre);
+        free(tampon);
+        return -1;
+    }
+    for (int i = 0; i < n; i++) {
+        ordre[i].cle = cle_motif(stock, i, critere, position_reference);
+        ordre[i].indice = i;
+    }
+    qsort(ordre, n, sizeof(CleMotif), comparer_cles_motifs);
+
+    permuter_colonne(stock->positions, sizeof(int32_t), ordre, n, tampon);
+    permuter_colonne(stock->longueurs, sizeof(int32_t), ordre, n, tampon);
+    permuter_colonne(stock->fold_changes, sizeof(double), ordre, n, tampon);
+    permuter_colonne(stock->occurrences_reelles, sizeof(int32_t), ordre, n, tampon);
+    permuter_colonne(stock->occurrences_aleatoires, sizeof(int32_t), ordre, n, tampon);
+    permuter_colonne(stock->approchees_reelles, sizeof(int32_t), ordre, n, tampon);
+    permuter_colonne(stock->approchees_aleatoires, sizeof(int32_t), ordre, n, tampon);
+    permuter_colonne(stock->distributions, sizeof(DistributionMotif*), ordre, n, tampon);
+    if (stock->genome == NULL) permuter_colonne(stock->decalages, sizeof(int64_t), ordre, n, tampon);
+    free(ordre);
+    free(tampon);
+    return 0;
+}
+
+int meilleurs_motifs_stock(const StockMotifs *stock, CritereMotifs critere, int position_reference, int nombre_max,
+                           int *indices) {
+    // Sélection par insertion dans les `nombre_max` meilleurs : un seul parcours des colonnes
+    int nombre = 0;
+    for (int i = 0; i < stock->nombre && nombre_max > 0; i++) {
+        double cle = cle_motif(stock, i, critere, position_reference);
+        if (nombre == nombre_max && cle >= cle_motif(stock, indices[nombre - 1], critere, position_reference)) {
+            continue;
+        }
+        int j = nombre < nombre_max ? nombre++ : nombre_max - 1;
+        while (j > 0 && cle_motif(stock, indices[j - 1], critere, position_reference) > cle) {
+            indices[j] = indices[j - 1];
+            j--;
+        }
+        indices[j] = i;
+    }
+    return nombre;
+}
+
+int filtrer_stock_motifs(StockMotifs *stock, double fold_change_min, int longueur_min, int occurrences_min) {
+    int conserves = 0;
+    for (int i = 0; i < stock->nombre; i++) {
+        if (stock->fold_changes[i] < fold_change_min || stock->longueurs[i] < longueur_min ||
+            stock->occurrences_reelles[i] < occurrences_min) {
+            liberer_distribution_motif(stock->distributions[i]);
+            continue;
+        }
+        // Compactage en place, dans l'ordre ; la réserve n'est pas réécrite (les décalages restent valides)
+        stock->positions[conserves] = stock->positions[i];
+        stock->longueurs[conserves] = stock->longueurs[i];
+        stock->fold_changes[conserves] = stock->fold_changes[i];
+        stock->occurrences_reelles[conserves] = stock->occurrences_reelles[i];
+        stock->occurrences_aleatoires[conserves] = stock->occurrences_aleatoires[i];
+        stock->approchees_reelles[conserves] = stock->approchees_reelles[i];
+        stock->approchees_aleatoires[conserves] = stock->approchees_aleatoires[i];
+        stock->distributions[conserves] = stock->distributions[i];
+        if (stock->genome == NULL) stock->decalages[conserves] = stock->decalages[i];
+        conserves++;
+    }
+    stock->nombre = conserves;
+    return conserves;
+}
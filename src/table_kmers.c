@@ -0,0 +1,133 @@
+// table_kmers.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "projet.h"
+
+int code_nucleotide(char nucleotide) {
+    switch (nucleotide) {
+        case 'A': return 0;
+        case 'C': return 1;
+        case 'G': return 2;
+        case 'T': return 3;
+        default: return -1;
+    }
+}
+
+uint64_t masque_code_kmer(int longueur_kmer) {
+    return longueur_kmer >= 32 ? UINT64_MAX : ((uint64_t)1 << (2 * longueur_kmer)) - 1;
+}
+
+int coder_kmer(const char *kmer, int longueur_kmer, uint64_t *code) {
+    uint64_t valeur = 0;
+    for (int i = 0; i < longueur_kmer; i++) {
+        int base = code_nucleotide(kmer[i]);
+        if (base < 0) return -1;
+        valeur = (valeur << 2) | (uint64_t)base;
+    }
+    *code = valeur;
+    return 0;
+}
+
+TableKmers* creer_table_kmers(int longueur_kmer, int nombre_max) {
+    if (longueur_kmer < 1 || longueur_kmer > LONGUEUR_MAX_KMER_CODE || nombre_max < 0) return NULL;
+    TableKmers *table = calloc(1, sizeof(TableKmers));
+    if (table == NULL) return NULL;
+    table->longueur_kmer = longueur_kmer;
+
+    // Taux de remplissage d'au plus 1/2 : les sondages linéaires restent courts
+    int capacite = 16;
+    while (capacite < 2 * (int64_t)nombre_max) capacite *= 2;
+    table->capacite = capacite;
+    table->codes = malloc(capacite * sizeof(uint64_t));
+    table->comptes = malloc(capacite * sizeof(int32_t));
+    if (table->codes == NULL || table->comptes == NULL) {
+        liberer_table_kmers(table);
+        return NULL;
+    }
+    // Tous les codes sont possibles (poly-T pour k = 32 vaut 2^64 - 1) : une case vide a un compte de -1
+    for (int i = 0; i < capacite; i++) table->comptes[i] = -1;
+    return table;
+}
+
+void liberer_table_kmers(TableKmers *table) {
+    if (table == NULL) return;
+    free(table->codes);
+    free(table->comptes);
+    free(table);
+}
+
+// Case du code dans la table : la sienne s'il est présent, la première case vide de sa séquence de sondage sinon
+static int case_kmer(const TableKmers *table, uint64_t code) {
+    int masque = table->capacite - 1;
+    int i = (int)(((code * 0x9E3779B97F4A7C15ULL) >> 32) & (uint64_t)masque);
+    while (table->comptes[i] >= 0 && table->codes[i] != code) i = (i + 1) & masque;
+    return i;
+}
+
+int inserer_kmer(TableKmers *table, uint64_t code) {
+    int i = case_kmer(table, code);
+    if (table->comptes[i] < 0) {
+        if (2 * (table->nombre + 1) > table->capacite) return -1;
+        table->codes[i] = code;
+        table->comptes[i] = 0;
+        table->nombre++;
+    }
+    return 0;
+}
+
+int32_t* trouver_kmer(const TableKmers *table, uint64_t code) {
+    int i = case_kmer(table, code);
+    return table->comptes[i] >= 0 ? &table->comptes[i] : NULL;
+}
+
+// Compte les k-mers de la table commençant dans [debut, fin) ; les incréments sont atomiques si plusieurs
+// blocs remplissent la table en même temps (l'addition étant commutative, les comptes restent déterministes)
+static void compter_kmers_intervalle(TableKmers *table, const char *sequence, int64_t debut, int64_t fin,
+                                     const MasqueExclusion *masque, bool atomique) {
+    int k = table->longueur_kmer;
+    uint64_t masque_code = masque_code_kmer(k);
+    uint64_t code = 0;
+    int bases_valides = 0;  // Bases ACGT consécutives se terminant à la position courante
+
+    // Code 2 bits glissant : un décalage et un ajout par base
+    for (int64_t i = debut; i < fin + k - 1; i++) {
+        int base = code_nucleotide(sequence[i]);
+        if (base < 0) {
+            bases_valides = 0;
+            continue;
+        }
+        code = ((code << 2) | (uint64_t)base) & masque_code;
+        if (++bases_valides < k) continue;
+        int debut_kmer = (int)(i - k + 1);
+        if (masque != NULL && position_masquee(masque, debut_kmer)) continue;
+        int32_t *compte = trouver_kmer(table, code);
+        if (compte == NULL) continue;
+        if (atomique) __atomic_fetch_add(compte, 1, __ATOMIC_RELAXED);
+        else (*compte)++;
+    }
+}
+
+void compter_kmers_genome(TableKmers *table, const char *sequence, int longueur, const MasqueExclusion *masque) {
+    if (longueur < table->longueur_kmer) return;
+    compter_kmers_intervalle(table, sequence, 0, longueur - table->longueur_kmer + 1, masque, false);
+}
+
+typedef struct {
+    TableKmers *table;
+    const char *sequence;
+    const MasqueExclusion *masque;
+} ComptageKmersParallele;
+
+static void compter_kmers_bloc(const BlocParallele *bloc, void *contexte) {
+    ComptageKmersParallele *comptage = contexte;
+    compter_kmers_intervalle(comptage->table, comptage->sequence, bloc->debut, bloc->fin, comptage->masque, true);
+}
+
+void compter_kmers_genome_parallele(TableKmers *table, const char *sequence, int longueur,
+                                    const MasqueExclusion *masque) {
+    if (longueur < table->longueur_kmer) return;
+    ComptageKmersParallele comptage = {table, sequence, masque};
+    pool_parallel_for(pool_global(), 0, longueur - table->longueur_kmer + 1, TAILLE_BLOC_PARALLELE,
+                      table->longueur_kmer - 1, compter_kmers_bloc, &comptage);
+}
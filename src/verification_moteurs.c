@@ -0,0 +1,432 @@
+// verification_moteurs.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "projet.h"
+
+#define REQUETES_PAR_GENOME 30        // Motifs comptés par génome vérifié
+#define GRAINES_PAR_GENOME 6          // Graines étendues par génome vérifié
+#define ETAPES_EXTENSION_MAX 400      // Extensions successives comparées par graine
+#define KMERS_PAR_GENOME 40           // k-mers comptés par génome vérifié
+#define REPETITIONS_MAX_VERIFIEES 200 // Répétitions maximales recomptées par génome vérifié
+#define PROMOTEURS_PAR_GENOME 25      // Paires de boîtes consensus plantées par génome vérifié
+#define REGIONS_CONSENSUS 4           // Régions parcourues par chaque implémentation du pré-filtre
+
+// Générateur splitmix64 (mêmes constantes que generer_sequence_parallele)
+static uint64_t tirer(uint64_t *etat) {
+    uint64_t z = (*etat += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+bool echantillon_retenu(uint64_t cle, double taux) {
+    if (taux <= 0) return false;
+    if (taux >= 1) return true;
+    uint64_t etat = cle;
+    return (double)(tirer(&etat) >> 11) / (double)(1ULL << 53) < taux;
+}
+
+static int comparer_resultat(BilanVerification *bilan, const char *quoi, const char *motif, int longueur_motif,
+                             int64_t rapide, int64_t reference) {
+    bilan->comparaisons++;
+    if (rapide == reference) return 0;
+    bilan->divergences++;
+    printf("Divergence (%s) pour %.*s%s : %lld au lieu de %lld\n", quoi, longueur_motif > 40 ? 40 : longueur_motif,
+           motif, longueur_motif > 40 ? "..." : "", (long long)rapide, (long long)reference);
+    return 1;
+}
+
+// Positions de référence : parcours de toutes les positions, à au plus `mismatches_max` mésappariements
+static int* positions_reference(const char *genome, int longueur_genome, const char *motif, int longueur_motif,
+                                int mismatches_max, const MasqueExclusion *masque, int *nombre) {
+    *nombre = 0;
+    int *positions = malloc((longueur_genome > 0 ? longueur_genome : 1) * sizeof(int));
+    if (positions == NULL) return NULL;
+    for (int i = 0; i + longueur_motif <= longueur_genome; i++) {
+        if (position_masquee(masque, i)) continue;
+        int erreurs = 0;
+        for (int j = 0; j < longueur_motif && erreurs <= mismatches_max; j++) {
+            if (genome[i + j] != motif[j]) erreurs++;
+        }
+        if (erreurs <= mismatches_max) positions[(*nombre)++] = i;
+    }
+    return positions;
+}
+
+static int comparer_positions(BilanVerification *bilan, const char *quoi, const char *motif, int longueur_motif,
+                              const int *rapides, int nombre_rapides, const int *references, int nombre_references) {
+    if (comparer_resultat(bilan, quoi, motif, longueur_motif, nombre_rapides, nombre_references) != 0) return 1;
+    for (int i = 0; i < nombre_references; i++) {
+        if (rapides[i] != references[i]) {
+            return comparer_resultat(bilan, quoi, motif, longueur_motif, rapides[i], references[i]);
+        }
+    }
+    return 0;
+}
+
+int verifier_comptage_motif(BilanVerification *bilan, const IndexSuffixes *index, const char *motif,
+                            int longueur_motif, int start_exclusion, int longueur_exclusion,
+                            const MasqueExclusion *masque, int mismatches_max) {
+    // Les parcours de référence (strstr) demandent un motif terminé par '\0'
+    char *copie = strndup(motif, longueur_motif);
+    if (copie == NULL) return -1;
+    const char *genome = index->genome;
+    int n = index->longueur_genome;
+    int divergences = comparer_resultat(bilan, "compte exact", copie, longueur_motif,
+        compter_occurrences_index(index, copie, longueur_motif, start_exclusion, longueur_exclusion, masque),
+        rechercher_motif_masque(copie, genome, start_exclusion, longueur_exclusion, masque));
+
+    int nombre_rapides = 0, nombre_references = 0;
+    int *rapides = positions_occurrences(index, copie, longueur_motif, masque, &nombre_rapides);
+    int *references = positions_reference(genome, n, copie, longueur_motif, 0, masque, &nombre_references);
+    int erreur = references == NULL || (rapides == NULL && nombre_rapides > 0);
+    if (!erreur) {
+        divergences += comparer_positions(bilan, "positions exactes", copie, longueur_motif, rapides, nombre_rapides,
+                                          references, nombre_references);
+    }
+    free(rapides);
+    free(references);
+
+    // rechercher_motif_approche ne connaît pas les masques : les comptes approchés sont comparés sans masque
+    if (mismatches_max > 0 && !erreur) {
+        divergences += comparer_resultat(bilan, "compte approché", copie, longueur_motif,
+            compter_occurrences_approchees(index, copie, longueur_motif, mismatches_max, start_exclusion,
+                                           longueur_exclusion, NULL),
+            rechercher_motif_approche(copie, genome, mismatches_max, start_exclusion, longueur_exclusion));
+        rapides = positions_occurrences_approchees(index, copie, longueur_motif, mismatches_max, NULL,
+                                                   &nombre_rapides);
+        references = positions_reference(genome, n, copie, longueur_motif, mismatches_max, NULL, &nombre_references);
+        erreur = references == NULL || (rapides == NULL && nombre_rapides > 0);
+        if (!erreur) {
+            divergences += comparer_positions(bilan, "positions approchées", copie, longueur_motif, rapides,
+                                              nombre_rapides, references, nombre_references);
+        }
+        free(rapides);
+        free(references);
+    }
+    free(copie);
+    return erreur ? -1 : divergences;
+}
+
+// Génomes adverses : 0 aléatoire, 1 homopolymères, 2 répétitions en tandem, 3 copies plantées jusqu'aux bords
+static char* generer_genome_verification(int type, int longueur, uint64_t *etat) {
+    char *genome = generer_sequence_parallele(longueur, tirer(etat));
+    if (genome == NULL) return NULL;
+    const char bases[4] = {'A', 'C', 'G', 'T'};
+    if (type == 1) {
+        // Homopolymères de 5 à 60 bases, dont un au début et un à la fin du génome
+        for (int i = 0; i < longueur; i += 50 + (int)(tirer(etat) % 100)) {
+            int taille = 5 + (int)(tirer(etat) % 56);
+            int debut = i == 0 ? 0 : i + taille > longueur ? longueur - taille : i;
+            memset(genome + debut, bases[tirer(etat) % 4], taille);
+        }
+        memset(genome + longueur - 40, 'A', 40);
+    } else if (type == 2) {
+        // Motif unitaire de 2 à 40 bases répété sur trois segments (au début, au milieu, à la fin), 1 % de mutations
+        int unite = 2 + (int)(tirer(etat) % 39);
+        int debuts[3] = {0, longueur / 3, longueur - longueur / 5};
+        for (int s = 0; s < 3; s++) {
+            int fin = debuts[s] + longueur / 5 + (int)(tirer(etat) % (longueur / 10));
+            if (fin > longueur) fin = longueur;
+            for (int i = debuts[s]; i < fin; i++) {
+                genome[i] = tirer(etat) % 100 == 0 ? bases[tirer(etat) % 4] : genome[(i - debuts[s]) % unite];
+            }
+        }
+    } else if (type == 3) {
+        // Motif de 25 bases copié 30 fois, en position 0, à la fin et parfois chevauché par la copie suivante
+        char motif[25];
+        for (int j = 0; j < 25; j++) motif[j] = bases[tirer(etat) % 4];
+        for (int c = 0; c < 30; c++) {
+            int position = c == 0 ? 0 : c == 1 ? longueur - 25 : (int)(tirer(etat) % (longueur - 25));
+            memcpy(genome + position, motif, 25);
+            if (c % 7 == 6 && position + 30 <= longueur) memcpy(genome + position + 5, motif, 25);
+        }
+    }
+    return genome;
+}
+
+// Motifs tirés aux bords du génome, au hasard dans le génome ou hors du génome, avec des exclusions variées
+static int verifier_comptages_genome(BilanVerification *bilan, const IndexSuffixes *index,
+                                     const MasqueExclusion *masque, uint64_t *etat) {
+    int n = index->longueur_genome;
+    char aleatoire[30];
+    for (int q = 0; q < REQUETES_PAR_GENOME; q++) {
+        int longueur = 1 + (int)(tirer(etat) % 30);
+        int position = q % 5 == 0 ? 0 : q % 5 == 1 ? n - longueur : (int)(tirer(etat) % (n - longueur + 1));
+        const char *motif = index->genome + position;
+        if (q % 5 == 4) {
+            for (int j = 0; j < longueur; j++) aleatoire[j] = "ACGT"[tirer(etat) % 4];
+            motif = aleatoire;
+        }
+        int start_exclusion = 0, longueur_exclusion = 0;
+        if (q % 4 == 0) {
+            start_exclusion = position;
+            longueur_exclusion = longueur;
+        } else if (q % 4 == 1) {
+            longueur_exclusion = 1 + (int)(tirer(etat) % (n / 4));
+            start_exclusion = q % 3 == 0 ? n - longueur_exclusion : 0;
+        }
+        int mismatches = longueur >= 4 ? q % 3 : 0;
+        if (verifier_comptage_motif(bilan, index, motif, longueur, start_exclusion, longueur_exclusion, masque,
+                                    mismatches) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Extension gloutonne : comptes par strstr (etendre_k_uplet) et par la table des suffixes, étape par étape
+static int verifier_extensions(BilanVerification *bilan, const IndexSuffixes *index, uint64_t *etat) {
+    int n = index->longueur_genome;
+    for (int g = 0; g < GRAINES_PAR_GENOME; g++) {
+        int position = g == 0 ? 0 : g == 1 ? n - LONGUEUR_K_UPLET : (int)(tirer(etat) % (n - LONGUEUR_K_UPLET));
+        Motif reference = {strndup(index->genome + position, LONGUEUR_K_UPLET), position, LONGUEUR_K_UPLET,
+                           0, 0, 0, NULL, -1, -1};
+        Motif rapide = reference;
+        rapide.sequence = strndup(reference.sequence, LONGUEUR_K_UPLET);
+        int occurrences_reference = 0, occurrences_rapides = 0;
+        int erreur = reference.sequence == NULL || rapide.sequence == NULL;
+        for (int etape = 0; etape < ETAPES_EXTENSION_MAX && !erreur; etape++) {
+            int resultat_reference = etendre_k_uplet((char*)index->genome, n, &reference, &occurrences_reference);
+            int resultat_rapide = etendre_k_uplet_index(index, &rapide, &occurrences_rapides);
+            erreur = resultat_reference < 0 || resultat_rapide < 0;
+            if (erreur ||
+                comparer_resultat(bilan, "extension", reference.sequence, reference.length, resultat_rapide,
+                                  resultat_reference) ||
+                comparer_resultat(bilan, "position étendue", reference.sequence, reference.length,
+                                  rapide.start_pos, reference.start_pos) ||
+                comparer_resultat(bilan, "longueur étendue", reference.sequence, reference.length,
+                                  rapide.length, reference.length) ||
+                comparer_resultat(bilan, "copies après extension", reference.sequence, reference.length,
+                                  occurrences_rapides, occurrences_reference) ||
+                resultat_reference == 0) {
+                break;
+            }
+        }
+        free(reference.sequence);
+        free(rapide.sequence);
+        if (erreur) return -1;
+    }
+    return 0;
+}
+
+// Répétitions maximales : nombre de copies recompté par strstr, et aucune extension d'une base ne les garde toutes
+static int verifier_repetitions(BilanVerification *bilan, const IndexSuffixes *index, const int32_t *lcp,
+                                uint64_t *etat) {
+    int n = index->longueur_genome;
+    int taille_region = n / 8;
+    int debut_region = tirer(etat) % 2 == 0 ? 0 : (int)(tirer(etat) % (n - taille_region));
+    int nombre = 0;
+    RepetitionMaximale *repetitions = rechercher_repetitions_maximales(index, lcp, debut_region,
+                                                                       debut_region + taille_region, 8, 3, &nombre);
+    if (repetitions == NULL && nombre > 0) return -1;
+    char *motif = malloc(n + 2);
+    if (motif == NULL) {
+        free(repetitions);
+        return -1;
+    }
+    for (int r = 0; r < nombre && r < REPETITIONS_MAX_VERIFIEES; r++) {
+        int position = repetitions[r].position, longueur = repetitions[r].longueur;
+        memcpy(motif, index->genome + position, longueur);
+        motif[longueur] = '\0';
+        comparer_resultat(bilan, "copies de la répétition", motif, longueur, repetitions[r].copies,
+                          rechercher_motif_rapide(motif, (char*)index->genome, 0, 0));
+        comparer_resultat(bilan, "répétition hors de la région", motif, longueur,
+                          position < debut_region + taille_region && longueur >= 8 && repetitions[r].copies >= 3, 1);
+        if (position > 0) {
+            motif[0] = index->genome[position - 1];
+            memcpy(motif + 1, index->genome + position, longueur);
+            motif[longueur + 1] = '\0';
+            comparer_resultat(bilan, "répétition prolongeable à gauche", motif, longueur + 1,
+                              rechercher_motif_rapide(motif, (char*)index->genome, 0, 0) < repetitions[r].copies, 1);
+        }
+        if (position + longueur < n) {
+            memcpy(motif, index->genome + position, longueur + 1);
+            motif[longueur + 1] = '\0';
+            comparer_resultat(bilan, "répétition prolongeable à droite", motif, longueur + 1,
+                              rechercher_motif_rapide(motif, (char*)index->genome, 0, 0) < repetitions[r].copies, 1);
+        }
+    }
+    free(motif);
+    free(repetitions);
+    return 0;
+}
+
+// Comptage des k-mers : table séquentielle, table par blocs et spectre, contre strstr
+static int verifier_kmers(BilanVerification *bilan, const IndexSuffixes *index, const MasqueExclusion *masque,
+                          int longueur_kmer, uint64_t *etat) {
+    const char *genome = index->genome;
+    int n = index->longueur_genome;
+    TableKmers *sequentielle = creer_table_kmers(longueur_kmer, KMERS_PAR_GENOME);
+    TableKmers *parallele = creer_table_kmers(longueur_kmer, KMERS_PAR_GENOME);
+    SpectreKmers *spectre = calculer_spectre_kmers(genome, n, longueur_kmer);
+    int erreur = sequentielle == NULL || parallele == NULL || spectre == NULL;
+    int positions[KMERS_PAR_GENOME];
+    for (int i = 0; i < KMERS_PAR_GENOME && !erreur; i++) {
+        positions[i] = i == 0 ? 0 : i == 1 ? n - longueur_kmer : (int)(tirer(etat) % (n - longueur_kmer + 1));
+        uint64_t code;
+        erreur = coder_kmer(genome + positions[i], longueur_kmer, &code) != 0 ||
+                 inserer_kmer(sequentielle, code) != 0 || inserer_kmer(parallele, code) != 0;
+    }
+    if (!erreur) {
+        compter_kmers_genome(sequentielle, genome, n, masque);
+        compter_kmers_genome_parallele(parallele, genome, n, masque);
+    }
+    char kmer[LONGUEUR_MAX_KMER_CODE + 1];
+    for (int i = 0; i < KMERS_PAR_GENOME && !erreur; i++) {
+        uint64_t code;
+        coder_kmer(genome + positions[i], longueur_kmer, &code);
+        memcpy(kmer, genome + positions[i], longueur_kmer);
+        kmer[longueur_kmer] = '\0';
+        int reference_masquee = rechercher_motif_masque(kmer, genome, 0, 0, masque);
+        comparer_resultat(bilan, "k-mer (table)", kmer, longueur_kmer, *trouver_kmer(sequentielle, code),
+                          reference_masquee);
+        comparer_resultat(bilan, "k-mer (table par blocs)", kmer, longueur_kmer, *trouver_kmer(parallele, code),
+                          reference_masquee);
+        comparer_resultat(bilan, "k-mer (spectre)", kmer, longueur_kmer, occurrences_kmer_spectre(spectre, code),
+                          rechercher_motif_masque(kmer, genome, 0, 0, NULL));
+    }
+    liberer_table_kmers(sequentielle);
+    liberer_table_kmers(parallele);
+    liberer_spectre_kmers(spectre);
+    return erreur ? -1 : 0;
+}
+
+typedef struct {
+    int64_t *positions;            // Positions des boîtes -35 et -10, deux à deux
+    int nombre;
+    int capacite;
+    int erreur;
+} PairesVerifiees;
+
+static void ajouter_paire_verifiee(int64_t position_boite_35, int64_t position_boite_10, void *contexte) {
+    PairesVerifiees *paires = contexte;
+    if (paires->nombre == paires->capacite) {
+        int capacite = paires->capacite == 0 ? 64 : paires->capacite * 2;
+        int64_t *agrandi = realloc(paires->positions, 2 * capacite * sizeof(int64_t));
+        if (agrandi == NULL) {
+            paires->erreur = 1;
+            return;
+        }
+        paires->positions = agrandi;
+        paires->capacite = capacite;
+    }
+    paires->positions[2 * paires->nombre] = position_boite_35;
+    paires->positions[2 * paires->nombre + 1] = position_boite_10;
+    paires->nombre++;
+}
+
+// Copie d'une boîte avec 0, 1 ou 2 mésappariements (seules les deux premières sont des boîtes valides)
+static void planter_boite(char *destination, const char *boite, uint64_t *etat) {
+    int longueur = strlen(boite);
+    memcpy(destination, boite, longueur);
+    int mesappariements = (int)(tirer(etat) % 3);
+    for (int m = 0; m < mesappariements; m++) {
+        int j = (int)(tirer(etat) % longueur);
+        destination[j] = "ACGT"[(strchr("ACGT", boite[j]) - "ACGT" + 1 + tirer(etat) % 3) % 4];
+    }
+}
+
+// Paires de boîtes consensus : chaque implémentation du pré-filtre contre le parcours position par position,
+// sur un génome où sont plantés des promoteurs (espacements de 14 à 20, jusqu'aux bords)
+static int verifier_consensus(BilanVerification *bilan, const IndexSuffixes *index, uint64_t *etat) {
+    int n = index->longueur_genome;
+    int longueur_35 = strlen(BOITE_35), longueur_10 = strlen(BOITE_10);
+    char *genome = malloc(n + 1);
+    if (genome == NULL) return -1;
+    memcpy(genome, index->genome, n + 1);
+    for (int p = 0; p < PROMOTEURS_PAR_GENOME; p++) {
+        int espacement = 14 + (int)(tirer(etat) % 7);
+        int longueur = longueur_35 + espacement + longueur_10;
+        int debut = p == 0 ? 0 : p == 1 ? n - longueur : (int)(tirer(etat) % (n - longueur + 1));
+        planter_boite(genome + debut, BOITE_35, etat);
+        planter_boite(genome + debut + longueur_35 + espacement, BOITE_10, etat);
+    }
+
+    int erreur = 0;
+    for (int r = 0; r < REGIONS_CONSENSUS && !erreur; r++) {
+        int64_t debut = 0, fin = n, limite = n;
+        if (r > 0) {
+            debut = tirer(etat) % n;
+            limite = debut + tirer(etat) % (n - debut + 1);
+            fin = debut + tirer(etat) % (limite - debut + 1);
+        }
+        // Référence : la définition des paires, sans masque
+        PairesVerifiees reference = {NULL, 0, 0, 0};
+        for (int64_t i = debut; i < fin && i <= limite - longueur_35; i++) {
+            if (!comparer_avec_marge_erreur(genome + i, BOITE_35, longueur_35)) continue;
+            for (int distance = 15; distance <= 19; distance++) {
+                int64_t position_boite_10 = i + longueur_35 + distance;
+                if (position_boite_10 + longueur_10 <= limite &&
+                    comparer_avec_marge_erreur(genome + position_boite_10, BOITE_10, longueur_10)) {
+                    ajouter_paire_verifiee(i, position_boite_10, &reference);
+                }
+            }
+        }
+        const FiltreConsensus filtres[] = {FILTRE_CONSENSUS_SCALAIRE, FILTRE_CONSENSUS_SSE2, FILTRE_CONSENSUS_AVX2};
+        const char *noms[] = {"paires consensus (scalaire)", "paires consensus (SSE2)", "paires consensus (AVX2)"};
+        for (int f = 0; f < 3 && !erreur; f++) {
+            if (choisir_filtre_consensus(filtres[f]) != 0) continue;
+            PairesVerifiees paires = {NULL, 0, 0, 0};
+            int64_t nombre = parcourir_paires_consensus(genome, debut, fin, limite, BOITE_35, BOITE_10,
+                                                        ajouter_paire_verifiee, &paires);
+            erreur = reference.erreur || paires.erreur;
+            comparer_resultat(bilan, noms[f], BOITE_35, longueur_35, nombre, reference.nombre);
+            // Première paire différente (-1 : listes identiques)
+            int difference = paires.nombre == reference.nombre ? -1 : 0;
+            for (int k = 0; k < 2 * paires.nombre && k < 2 * reference.nombre && difference < 0; k++) {
+                if (paires.positions[k] != reference.positions[k]) difference = k / 2;
+            }
+            comparer_resultat(bilan, noms[f], BOITE_10, longueur_10, difference, -1);
+            free(paires.positions);
+        }
+        free(reference.positions);
+    }
+    choisir_filtre_consensus(FILTRE_CONSENSUS_AUTO);
+    free(genome);
+    return erreur ? -1 : 0;
+}
+
+int verifier_moteurs(uint64_t graine, int nombre_genomes, BilanVerification *bilan) {
+    int64_t divergences_initiales = bilan->divergences;
+    uint64_t etat = graine;
+    CompteurProgression *progression = ouvrir_compteur_progression("génomes vérifiés", nombre_genomes);
+    for (int g = 0; g < nombre_genomes; g++) {
+        int longueur = 2000 + (int)(tirer(&etat) % 6000);
+        char *genome = generer_genome_verification(g % 4, longueur, &etat);
+        IndexSuffixes *index = genome != NULL ? construire_index_suffixes(genome, longueur) : NULL;
+        int32_t *lcp = index != NULL ? calculer_lcp(index) : NULL;
+
+        // Un génome sur deux masqué, jusqu'aux bords
+        MasqueExclusion *masque = NULL;
+        if ((g / 4) % 2 == 1) {
+            masque = creer_masque_exclusion(longueur);
+            int debut = (int)(tirer(&etat) % longueur);
+            if (masque == NULL || ajouter_intervalle_masque(masque, 0, 7) != 0 ||
+                ajouter_intervalle_masque(masque, longueur - 9, longueur) != 0 ||
+                ajouter_intervalle_masque(masque, debut, debut + 100) != 0) {
+                liberer_masque_exclusion(masque);
+                masque = NULL;
+            }
+        }
+
+        int erreur = lcp == NULL || ((g / 4) % 2 == 1 && masque == NULL) ||
+                     verifier_comptages_genome(bilan, index, masque, &etat) != 0 ||
+                     verifier_extensions(bilan, index, &etat) != 0 ||
+                     verifier_repetitions(bilan, index, lcp, &etat) != 0 ||
+                     verifier_kmers(bilan, index, masque, g % 2 == 0 ? 5 : LONGUEUR_GRAINE_GENE, &etat) != 0 ||
+                     verifier_consensus(bilan, index, &etat) != 0;
+        liberer_masque_exclusion(masque);
+        free(lcp);
+        liberer_index_suffixes(index);
+        free(genome);
+        avancer_progression(progression, 1);
+        if (erreur) {
+            fermer_compteur_progression(progression);
+            return -1;
+        }
+    }
+    fermer_compteur_progression(progression);
+    return bilan->divergences > divergences_initiales ? 1 : 0;
+}